@@ -62,11 +62,13 @@ private:
 
 
     /*!
-     * @brief Method for gathering sel records from bmc
-     * @param ipmi Object for connecting to bmc
-     * @return vector of sel records
+     * @brief Method for processing sel records not processed yet
+     * @param log_service_uuid uuid of the log service
+     * @param bmc_id bmc id
+     * @param events events vector
      */
-    ipmi::Sel::RecordVect get_records(ipmi::IpmiController& ipmi);
+    void process_new_records(const std::string& log_service_uuid, const std::string& bmc_id,
+                             agent_framework::model::attribute::EventData::Vector& events);
 
 
     /*!
@@ -97,9 +99,25 @@ private:
                           agent_framework::model::attribute::EventData::Vector& events);
 
 
+    /*!
+     * @brief Remove log entry
+     * @param uuid uuid of the log entry
+     * @param events events vector
+     */
+    void remove_entry(const std::string& uuid, agent_framework::model::attribute::EventData::Vector& events);
+
+
     SelTimestamp m_last_add_timestamp{};
     SelTimestamp m_last_remove_timestamp{};
 
+    /* SEL is kept between readings, only records added since last reading are read */
+    std::unique_ptr<ipmi::IpmiController> m_ipmi{};
+    std::unique_ptr<ipmi::Sel> m_sel{};
+    std::uint32_t m_sel_generation{};
+
+    /* log entries of already processed records */
+    std::map<ipmi::command::generic::SelEntryId, std::string> m_entries{};
+
     agent::compute::ComputeStabilizer m_stabilizer{};
 
     static const std::map<IpmiSensorType, RedfishSensorType> m_ipmi_redfish_sensor_map;
@@ -80,35 +80,75 @@ const std::map<SELReader::IpmiSensorType, SELReader::RedfishSensorType> SELReade
 
 
 void SELReader::read(agent::compute::Bmc& bmc) {
-    auto ipmi = bmc.ipmi();
-
     auto log_services = get_manager<LogService>().get_entries(bmc.get_manager_uuid());
 
     if (!log_services.empty()) {
-        if (was_sel_changed(ipmi)) {
+        if (!m_sel) {
+            m_ipmi.reset(new IpmiController(bmc.ipmi()));
+            m_sel.reset(new Sel(*m_ipmi));
+        }
+        if (was_sel_changed(*m_ipmi)) {
             agent_framework::model::attribute::EventData::Vector events{};
 
-            auto sel_records = get_records(ipmi);
-            auto sel_service = log_services.front();
-            LogEntry log_entry{sel_service.get_uuid()};
-            log_entry.set_agent_id(bmc.get_id());
+            m_sel->process_records();
+            process_new_records(log_services.front().get_uuid(), bmc.get_id(), events);
+
+            agent_framework::eventing::EventsQueue::get_instance()->push_back(events);
+        }
+    }
+}
 
-            const auto before_change_epoch = get_manager<LogEntry>().get_current_epoch();
 
-            for(auto sel_record : sel_records) {
-                auto record = std::static_pointer_cast<SelRecordGeneric>(sel_record);
-                if (record->is_evm_1_5()) {
-                    fill_entry(log_entry, record);
-                    m_stabilizer.stabilize(log_entry);
-                    add_or_update(events, log_entry);
-                }
+void SELReader::process_new_records(const std::string& log_service_uuid, const std::string& bmc_id,
+                                    agent_framework::model::attribute::EventData::Vector& events) {
+    LogEntry log_entry{log_service_uuid};
+    log_entry.set_agent_id(bmc_id);
+
+    const auto sel_records = m_sel->get_records();
+
+    /* all entries are to be checked if records were read from the scratch */
+    const bool all_records = m_entries.empty() || (m_sel->get_generation() != m_sel_generation);
+    m_sel_generation = m_sel->get_generation();
+    if (all_records) {
+        const auto before_change_epoch = get_manager<LogEntry>().get_current_epoch();
+
+        m_entries.clear();
+        for (const auto& sel_record : sel_records) {
+            auto record = std::static_pointer_cast<SelRecordGeneric>(sel_record);
+            if (record->is_evm_1_5()) {
+                fill_entry(log_entry, record);
+                m_stabilizer.stabilize(log_entry);
+                add_or_update(events, log_entry);
+                m_entries[record->get_id()] = log_entry.get_uuid();
             }
+        }
 
-            remove_untouched(bmc.get_id(), before_change_epoch, events);
+        remove_untouched(bmc_id, before_change_epoch, events);
+        return;
+    }
 
-            agent_framework::eventing::EventsQueue::get_instance()->push_back(events);
+    /* records are only appended, or rolled out from the SEL */
+    std::map<command::generic::SelEntryId, std::string> entries{};
+    for (const auto& sel_record : sel_records) {
+        auto record = std::static_pointer_cast<SelRecordGeneric>(sel_record);
+        auto it = m_entries.find(record->get_id());
+        if (it != m_entries.end()) {
+            entries.insert(*it);
+            m_entries.erase(it);
         }
+        else if (record->is_evm_1_5()) {
+            fill_entry(log_entry, record);
+            m_stabilizer.stabilize(log_entry);
+            add_or_update(events, log_entry);
+            entries[record->get_id()] = log_entry.get_uuid();
+        }
+    }
+
+    /* entries of rolled-out records */
+    for (const auto& entry : m_entries) {
+        remove_entry(entry.second, events);
     }
+    m_entries = std::move(entries);
 }
 
 
@@ -149,18 +189,23 @@ void SELReader::remove_untouched(const std::string& bmc_id,
     );
 
     for (const auto& to_remove_uuid : not_touched) {
-        agent_framework::model::attribute::EventData event{};
+        remove_entry(to_remove_uuid, events);
+    }
+}
 
-        get_manager<LogEntry>().remove_entry(to_remove_uuid,
-            [&event](const LogEntry& elem) {
-                event.set_parent(elem.get_parent_uuid());
-                event.set_component(elem.get_uuid());
-                event.set_type(elem.get_component());
-                event.set_notification(agent_framework::model::enums::Notification::Remove);
-            });
-        if (!event.get_component().empty()) {
-            events.push_back(std::move(event));
-        }
+
+void SELReader::remove_entry(const std::string& uuid, agent_framework::model::attribute::EventData::Vector& events) {
+    agent_framework::model::attribute::EventData event{};
+
+    get_manager<LogEntry>().remove_entry(uuid,
+        [&event](const LogEntry& elem) {
+            event.set_parent(elem.get_parent_uuid());
+            event.set_component(elem.get_uuid());
+            event.set_type(elem.get_component());
+            event.set_notification(agent_framework::model::enums::Notification::Remove);
+        });
+    if (!event.get_component().empty()) {
+        events.push_back(std::move(event));
     }
 }
 
@@ -203,13 +248,6 @@ bool SELReader::was_sel_changed(IpmiController& ipmi) {
 }
 
 
-Sel::RecordVect SELReader::get_records(IpmiController& ipmi) {
-    ipmi::Sel sel(ipmi);
-    sel.process_records();
-    return sel.get_records();
-}
-
-
 OptionalField<SELReader::RedfishSensorType> SELReader::ipmi_sensor_to_redfish(IpmiSensorType sensor_type) {
     if (m_ipmi_redfish_sensor_map.find(sensor_type) == m_ipmi_redfish_sensor_map.end()) {
         return OptionalField<RedfishSensorType>{};
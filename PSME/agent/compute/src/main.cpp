@@ -231,8 +231,9 @@ BmcCollection load_bmcs(const json::Json& config) {
         connection.set_username(decrypt_value(manager["username"].get<std::string>()));
         connection.set_password(decrypt_value(manager["password"].get<std::string>()));
         connection.set_port(manager["port"].get<std::uint16_t>());
+        connection.set_interface_type(manager.value("interface-type", connection.get_interface_type()));
         ipmi::manager::ipmitool::ManagementController mc{
-            connection.get_ip_address(), connection.get_port(),
+            connection.get_interface_type(), connection.get_ip_address(), connection.get_port(),
             connection.get_username(), connection.get_password()
         };
 
@@ -403,7 +403,8 @@ namespace compute {
 Bmc::Bmc(const ConnectionData& conn, Bmc::Duration state_update_interval,
          ReadPresenceFn read_presence, ReadOnlineStatusFn read_online_state)
     : agent_framework::Bmc(conn, state_update_interval, read_presence, read_online_state),
-      m_ipmi{conn.get_ip_address(), conn.get_port(), conn.get_username(), conn.get_password()} {
+      m_ipmi{conn.get_interface_type(), conn.get_ip_address(), conn.get_port(), conn.get_username(),
+             conn.get_password()} {
 }
 
 bool Bmc::on_become_online(const Transition&) {
@@ -129,6 +129,16 @@ public:
     virtual bool update_port(agent_framework::model::Port& port,
                              const gas::GlobalAddressSpaceRegisters& gas, const tools::Toolset& tools) const;
 
+    /*!
+     * Updates port from already read link status. Speeds and status are updated.
+     * @param port modified port. Raw reference is modified
+     * @param link_status link status of the port, nullptr if it could not be read
+     * @param tools toolset to be used
+     * @return true if port was modified (any value was changed)
+     */
+    virtual bool update_port(agent_framework::model::Port& port,
+                             const gas::mrpc::LinkStatusRetrieve* link_status, const tools::Toolset& tools) const;
+
     /*!
      * @brief Full discovery of the host/root complex endpoint_uuid
      * @param[in] fabric_uuid Uuid of the parent fabric
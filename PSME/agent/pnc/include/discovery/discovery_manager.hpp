@@ -117,6 +117,16 @@ public:
     bool update_port_status(const gas::GlobalAddressSpaceRegisters& gas, const std::string& port_uuid) const;
 
 
+    /*!
+     * @brief Function updates status and width/speed of the link of several ports, link statuses are read at once
+     * @param[in] gas Instance of GAS registers
+     * @param[in] port_uuids Uuids of the physical ports to be updated
+     * @return True if update of all ports was successful
+     * */
+    bool update_ports_status(const gas::GlobalAddressSpaceRegisters& gas,
+                             const std::vector<std::string>& port_uuids) const;
+
+
     /*!
      * @brief Handles removal of the resources on a specific port
      * @param[in] gas Instance of GAS registers
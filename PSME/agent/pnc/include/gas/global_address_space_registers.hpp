@@ -31,6 +31,7 @@
 #include "csr/configuration_space_register.hpp"
 #include "access_interface_factory.hpp"
 
+#include <future>
 #include <memory>
 #include <mutex>
 
@@ -44,10 +45,6 @@ namespace gas {
 /*! Global Address Space Registers */
 class GlobalAddressSpaceRegisters {
 
-/*! Required delay for polling mrpc commands status */
-    static constexpr std::uint16_t MRPC_DELAY_MS = 10;
-
-    static std::mutex m_mrpc_mutex;
     static std::mutex m_top_mutex;
     static std::mutex m_partition_mutex;
     static std::mutex m_csr_mutex;
@@ -103,6 +100,14 @@ public:
     mrpc::CommandStatus execute_cmd(mrpc::Command& cmd) const;
 
 
+    /*!
+     * @brief Submits MRPC command to the MRPC queue without waiting for its completion
+     * @param cmd MRPC Command, must be valid until the returned future is ready
+     * @return Future with the MRPC Command status
+     * */
+    std::future<mrpc::CommandStatus> submit_cmd(mrpc::Command& cmd) const;
+
+
     /*! Update TopLevelRegisters */
     void read_top();
 
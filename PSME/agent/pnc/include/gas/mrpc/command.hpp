@@ -79,6 +79,14 @@ public:
     /*! Read output data */
     virtual void read_output() = 0;
 
+    /*!
+     * @brief Returns interface used to access MRPC registers
+     * @return Access interface
+     * */
+    AccessInterface* get_interface() const {
+        return m_iface;
+    }
+
     virtual ~Command();
 };
 
@@ -0,0 +1,100 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file link_status_retrieve_batch.hpp
+ * @brief Link Status Retrieve Command executed for several ports at once
+ * */
+
+#pragma once
+
+#include "link_status_retrieve.hpp"
+
+#include <vector>
+
+/*! Agent namespace */
+namespace agent {
+/*! PNC namespace */
+namespace pnc {
+/*! GAS namespace */
+namespace gas {
+/*! MRPC namespace */
+namespace mrpc {
+
+/*!
+ * @brief Link Status Retrieve Command for several ports.
+ *
+ * Input of the command is a bitmask of physical ports, output contains one entry per requested port.
+ * The batch merges Link Status Retrieve commands of single ports: it is run instead of them and
+ * the entry of each port is stored in the output of its command.
+ */
+class LinkStatusRetrieveBatch final : public Command {
+public:
+    /*! Default constructor */
+    LinkStatusRetrieveBatch(AccessInterface* iface) : Command(iface, CommandCode::LINK_STATUS_RETRIEVE) {}
+    /*! Copy constructor */
+    LinkStatusRetrieveBatch(const LinkStatusRetrieveBatch&) = default;
+    /*! Copy assignment operator */
+    LinkStatusRetrieveBatch& operator=(const LinkStatusRetrieveBatch&) = default;
+
+    /*!
+     * @brief Checks if a command may be merged into a batch
+     * @param cmd Command to be checked
+     * @return True for Link Status Retrieve commands of a single port
+     */
+    static bool is_mergeable(const Command& cmd);
+
+    /*!
+     * @brief Adds command of a single port to the batch, the command must be valid until the batch is read
+     * @param cmd Command to be added
+     * @return False if the command is not mergeable, uses other interface or its port is already in the batch
+     */
+    bool add(LinkStatusRetrieve& cmd);
+
+    /*!
+     * @brief Returns merged commands
+     * @return Merged commands
+     */
+    const std::vector<LinkStatusRetrieve*>& get_commands() const {
+        return m_commands;
+    }
+
+    /*!
+     * @brief Checks if output of a merged command was read
+     * @param cmd Merged command
+     * @return True if the output contained an entry for the port of the command
+     */
+    bool is_output_read(const LinkStatusRetrieve& cmd) const;
+
+    /*! Write input data */
+    void write_input();
+
+    /*! Read output data */
+    void read_output();
+
+    virtual ~LinkStatusRetrieveBatch();
+
+private:
+    std::vector<LinkStatusRetrieve*> m_commands{};
+    std::uint64_t m_port_mask{};
+    std::uint64_t m_read_mask{};
+};
+}
+}
+}
+}
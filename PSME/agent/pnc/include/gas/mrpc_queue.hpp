@@ -0,0 +1,149 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file mrpc_queue.hpp
+ * @brief MRPC command submission queue
+ * */
+
+#pragma once
+
+#include "mrpc/command.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+/*! Agent namespace */
+namespace agent {
+/*! PNC namespace */
+namespace pnc {
+/*! GAS namespace */
+namespace gas {
+
+/*! Delays used while waiting for MRPC commands */
+struct MrpcPollingPolicy final {
+    /*! Delay between running the command and the first status read */
+    std::chrono::microseconds first_poll_delay{1000};
+    /*! Interval between the first and the second status read, doubled after each next read */
+    std::chrono::microseconds min_poll_interval{500};
+    /*! Maximal interval between status reads */
+    std::chrono::microseconds max_poll_interval{10000};
+    /*! Minimal delay between completion of a command and running the next one */
+    std::chrono::microseconds command_gap{1000};
+    /*! Delay before the first retry of reading status of a failed command, extended by 50ms for each retry */
+    std::chrono::microseconds failure_retry_delay{20000};
+};
+
+
+/*!
+ * @brief Queue of MRPC commands.
+ *
+ * The switch executes one MRPC command at a time, so all commands are executed by a single worker thread
+ * in the order of submission. Completion of a command is reported through a future, so several commands
+ * may be submitted before waiting for any of them. Consecutive Link Status Retrieve commands of single ports
+ * are merged and executed as one command for all of the ports.
+ */
+class MrpcQueue final {
+public:
+    /*! Queue statistics */
+    struct Statistics final {
+        /*! Number of executed commands */
+        std::uint64_t commands{0};
+        /*! Number of MRPC commands run on the switch, lower than commands if any were merged */
+        std::uint64_t mrpc_calls{0};
+    };
+
+    /*!
+     * @brief Constructor starting the worker thread
+     * @param policy Delays used while waiting for commands
+     */
+    explicit MrpcQueue(const MrpcPollingPolicy& policy = {});
+
+    /*! Destructor, waits until all submitted commands are executed */
+    ~MrpcQueue();
+
+    MrpcQueue(const MrpcQueue&) = delete;
+    MrpcQueue& operator=(const MrpcQueue&) = delete;
+
+    /*!
+     * @brief Returns queue shared by all GAS instances
+     * @return Queue instance
+     */
+    static MrpcQueue& get_instance();
+
+    /*!
+     * @brief Submits command for execution
+     * @param cmd MRPC Command, must be valid until the returned future is ready
+     * @return Future with the MRPC command status, exceptions thrown while accessing the switch are rethrown by it
+     */
+    std::future<mrpc::CommandStatus> submit(mrpc::Command& cmd);
+
+    /*!
+     * @brief Executes command and waits for its completion
+     * @param cmd MRPC Command
+     * @return MRPC Command status
+     */
+    mrpc::CommandStatus execute(mrpc::Command& cmd) {
+        return submit(cmd).get();
+    }
+
+    /*!
+     * @brief Sets delays used while waiting for commands
+     * @param policy New delays
+     */
+    void set_polling_policy(const MrpcPollingPolicy& policy);
+
+    /*!
+     * @brief Returns statistics of the queue
+     * @return Queue statistics
+     */
+    Statistics get_statistics() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request final {
+        mrpc::Command* command;
+        std::promise<mrpc::CommandStatus> completion;
+    };
+
+    void task();
+
+    /* executes requests merged into one MRPC command */
+    void execute_requests(std::deque<Request>& requests);
+
+    /* runs the command and waits for its completion */
+    mrpc::CommandStatus run_command(mrpc::Command& cmd, const MrpcPollingPolicy& policy);
+
+    mutable std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    std::deque<Request> m_requests{};
+    MrpcPollingPolicy m_policy{};
+    Statistics m_statistics{};
+    bool m_is_running{true};
+    Clock::time_point m_last_completion{};
+    std::thread m_thread{};
+};
+
+}
+}
+}
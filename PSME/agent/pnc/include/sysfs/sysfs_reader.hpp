@@ -25,8 +25,10 @@
 
 #include "sysfs/sysfs_reader_interface.hpp"
 #include "sysfs/sysfs_interface.hpp"
+#include "sysfs/pci_topology.hpp"
 
 #include <memory>
+#include <regex>
 
 namespace agent {
 namespace pnc {
@@ -80,14 +82,17 @@ public:
 
 private:
 
-    /* checks if the sys_device has a path that has a part mathing 'path' parameter */
-    bool is_path_matched(const ::sysfs::Path& device_path, const std::string& path) const;
+    /* reads PCI and block devices topology, logs links which could not be resolved and unreadable block devices */
+    ::sysfs::PciTopology read_topology() const;
+
+    /* checks if the sys_device has a path that has a part mathing 'path_regex' parameter */
+    bool is_path_matched(const ::sysfs::Path& device_path, const std::regex& path_regex) const;
 
     /* updates drive data, if successful, adds drive to the device */
     void update_drive_info(const std::string& drive_name, RawSysfsDevice& device) const;
 
     /* updates pci device drives (if present), result is stored in provided device reference */
-    void update_pci_device_drives(const ::sysfs::Path& device_path, RawSysfsDevice& device) const;
+    void update_pci_device_drives(const ::sysfs::PciTopology& topology, RawSysfsDevice& device) const;
 
     /* used to check if given device is a virtual function, result is stored in provided device reference */
     void update_pci_device_virtual(const ::sysfs::Path& device_path, RawSysfsDevice& device) const;
@@ -96,10 +101,11 @@ private:
     bool update_pci_device_config(const ::sysfs::Path& device_path, RawSysfsDevice& device) const;
 
     /* parses device name to read ids, result is stored in provided device reference */
-    bool update_pci_device_ids(const ::sysfs::Path& device_path, RawSysfsDevice& device) const;
+    bool update_pci_device_ids(const ::sysfs::PciFunction& function, RawSysfsDevice& device) const;
 
     /* updates all information about the device, result is stored in provided device reference */
-    bool update_pci_device(const ::sysfs::Path& device_path, RawSysfsDevice& device) const;
+    bool update_pci_device(const ::sysfs::PciFunction& function, const ::sysfs::PciTopology& topology,
+                           RawSysfsDevice& device) const;
 
     std::shared_ptr<::sysfs::AbstractSysfsInterface> m_sysfs_interface{nullptr};
 };
@@ -37,6 +37,9 @@
 #include "gas/mrpc/unbind_port.hpp"
 #include "gas/mrpc/link_status_retrieve.hpp"
 
+#include <map>
+#include <vector>
+
 
 
 namespace agent {
@@ -124,6 +127,16 @@ public:
                                                           std::uint8_t phys_port_id) const;
 
 
+    /*!
+     * @brief Gets link statuses of several ports, commands of all ports are submitted together and merged
+     * @param[in] gas GAS registers instance
+     * @param[in] phys_port_ids Physical port ids of the ports
+     * @return Link statuses of the ports which were read successfully, by physical port id
+     * */
+    virtual std::map<std::uint8_t, gas::mrpc::LinkStatusRetrieve> get_link_statuses(
+        const gas::GlobalAddressSpaceRegisters& gas, const std::vector<std::uint8_t>& phys_port_ids) const;
+
+
     /*!
      * @brief Gets logical bridge number (as on switch) from read PortBindingInfo
      * @param[in] pbi Result of the PortBindingInfo called on a queried port
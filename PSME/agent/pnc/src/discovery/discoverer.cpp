@@ -104,10 +104,26 @@ Zone Discoverer::discover_zone(const std::string& fabric_uuid, const tools::Tool
 
 
 bool Discoverer::update_port(Port& port, const GlobalAddressSpaceRegisters& gas, const Toolset& tools) const {
-    bool changed = false;
     try {
         // throw exception if anything went wrong
         auto lsr = tools.gas_tool->get_link_status(gas, uint8_t(port.get_phys_port_id()));
+        return update_port(port, &lsr, tools);
+    }
+    catch (const std::exception& e) {
+        log_error("pnc-discovery", "Cannot update status on port " << port.get_uuid() <<
+                                                                   ", exception: " << e.what());
+        return tools.model_tool->set_status_offline(port);
+    }
+}
+
+
+bool Discoverer::update_port(Port& port, const LinkStatusRetrieve* link_status, const Toolset& tools) const {
+    bool changed = false;
+    try {
+        if (nullptr == link_status) {
+            throw std::runtime_error("Cannot get PCIe Port Link status.");
+        }
+        const auto& lsr = *link_status;
 
         uint32_t width{};
         uint32_t max_width{};
@@ -161,12 +161,21 @@ void DiscoveryManager::discover_ports(const std::string& fabric_uuid, const std:
         return;
     }
 
+    // Read link status of all ports at once
+    std::vector<std::uint8_t> phys_port_ids{};
+    for (uint8_t entry_id = 0; entry_id < cmd.output.fields.info_count; entry_id++) {
+        phys_port_ids.push_back(cmd.output.fields.port_binding_info[entry_id].phy_port_id);
+    }
+    const auto link_statuses = m_tools.gas_tool->get_link_statuses(gas, phys_port_ids);
+
     for (uint8_t entry_id = 0; entry_id < cmd.output.fields.info_count; entry_id++) {
 
         try {
 
             Port port = m_discoverer->discover_port(switch_uuid, m_tools, gas, cmd, entry_id);
-            m_discoverer->update_port(port, gas, m_tools);
+            const auto link_status = link_statuses.find(uint8_t(port.get_phys_port_id()));
+            m_discoverer->update_port(port, link_status != link_statuses.end() ? &link_status->second : nullptr,
+                                      m_tools);
             Metric metric = m_discoverer->discover_port_health_metric(port, m_tools);
             log_and_add(std::move(metric));
 
@@ -394,26 +403,44 @@ bool DiscoveryManager::update_port_health_metric(const agent_framework::model::P
 
 
 bool DiscoveryManager::update_port_status(const GlobalAddressSpaceRegisters& gas, const std::string& port_uuid) const {
+    return update_ports_status(gas, {port_uuid});
+}
 
-    try {
-        auto port_ref = get_manager<Port>().get_entry_reference(port_uuid);
-        auto& port = port_ref.get_raw_ref();
-        log_debug("pnc-discovery", "Updating status of port id = " << port.get_port_id());
-
-        if (m_discoverer->update_port(port, gas, m_tools)) {
-            agent_framework::eventing::send_event(port.get_uuid(),
-                                                  enums::Component::Port,
-                                                  enums::Notification::Update,
-                                                  port.get_parent_uuid());
-            return update_port_health_metric(port);
+
+bool DiscoveryManager::update_ports_status(const GlobalAddressSpaceRegisters& gas,
+                                           const std::vector<std::string>& port_uuids) const {
+
+    std::vector<std::uint8_t> phys_port_ids{};
+    for (const auto& port_uuid : port_uuids) {
+        if (get_manager<Port>().entry_exists(port_uuid)) {
+            phys_port_ids.push_back(uint8_t(get_manager<Port>().get_entry(port_uuid).get_phys_port_id()));
         }
-        return true;
     }
-    catch (const ::agent_framework::exceptions::InvalidUuid& iue) {
-        log_error("pnc-discovery", "Cannot update status on nonexisting port " << port_uuid <<
-                                                                               ", exception: " << iue.what());
-        return false;
+    const auto link_statuses = m_tools.gas_tool->get_link_statuses(gas, phys_port_ids);
+
+    bool result = true;
+    for (const auto& port_uuid : port_uuids) {
+        try {
+            auto port_ref = get_manager<Port>().get_entry_reference(port_uuid);
+            auto& port = port_ref.get_raw_ref();
+            log_debug("pnc-discovery", "Updating status of port id = " << port.get_port_id());
+
+            const auto it = link_statuses.find(uint8_t(port.get_phys_port_id()));
+            if (m_discoverer->update_port(port, it != link_statuses.end() ? &it->second : nullptr, m_tools)) {
+                agent_framework::eventing::send_event(port.get_uuid(),
+                                                      enums::Component::Port,
+                                                      enums::Notification::Update,
+                                                      port.get_parent_uuid());
+                result &= update_port_health_metric(port);
+            }
+        }
+        catch (const ::agent_framework::exceptions::InvalidUuid& iue) {
+            log_error("pnc-discovery", "Cannot update status on nonexisting port " << port_uuid <<
+                                                                                   ", exception: " << iue.what());
+            result = false;
+        }
     }
+    return result;
 }
 
 
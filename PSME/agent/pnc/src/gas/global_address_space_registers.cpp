@@ -22,9 +22,7 @@
  * */
 
 #include "gas/global_address_space_registers.hpp"
-
-#include <chrono>
-#include <thread>
+#include "gas/mrpc_queue.hpp"
 
 
 
@@ -34,52 +32,18 @@ using namespace agent::pnc::gas;
 GlobalAddressSpaceRegisters::~GlobalAddressSpaceRegisters() {}
 
 
-constexpr std::uint16_t GlobalAddressSpaceRegisters::MRPC_DELAY_MS;
-
-std::mutex GlobalAddressSpaceRegisters::m_mrpc_mutex{};
 std::mutex GlobalAddressSpaceRegisters::m_top_mutex{};
 std::mutex GlobalAddressSpaceRegisters::m_partition_mutex{};
 std::mutex GlobalAddressSpaceRegisters::m_csr_mutex{};
 
 
 mrpc::CommandStatus GlobalAddressSpaceRegisters::execute_cmd(mrpc::Command& cmd) const {
-    std::lock_guard<std::mutex> lock(m_mrpc_mutex);
-
-    mrpc::CommandStatus status{mrpc::CommandStatus::IN_PROGRESS};
-
-    cmd.write_input();
-    cmd.run();
-
-    // Waits until operation is IN_PROGRESS or IDLE (device is busy/waiting).
-    std::this_thread::sleep_for(std::chrono::milliseconds(GlobalAddressSpaceRegisters::MRPC_DELAY_MS));
-    while (mrpc::CommandStatus::IN_PROGRESS == status) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(GlobalAddressSpaceRegisters::MRPC_DELAY_MS));
-        status = cmd.read_status();
-    }
-
-    // If error occurs we try to read MRPC status 3 times and extend delay.
-    auto error_delay_ms = 2 * GlobalAddressSpaceRegisters::MRPC_DELAY_MS; // 20ms.
-    unsigned tries = 3;
-    while (mrpc::CommandStatus::FAILED == status && tries > 0) {
-        log_warning("gas-tool", "MRPC status: FAILED. Will try again...");
-        std::this_thread::sleep_for(std::chrono::milliseconds(error_delay_ms));
-        status = cmd.read_status();
-        tries--;
-        error_delay_ms += 50;
-    }
-
-    // If still error we return status without command status read.
-    if (mrpc::CommandStatus::FAILED == status) {
-        log_error("gas-tool", "MRPC FAILED after 3 tries.");
-        return status;
-    }
-
-    // MRPC is DONE. We read command status.
-    cmd.read_output();
+    return MrpcQueue::get_instance().execute(cmd);
+}
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(GlobalAddressSpaceRegisters::MRPC_DELAY_MS));
 
-    return status;
+std::future<mrpc::CommandStatus> GlobalAddressSpaceRegisters::submit_cmd(mrpc::Command& cmd) const {
+    return MrpcQueue::get_instance().submit(cmd);
 }
 
 
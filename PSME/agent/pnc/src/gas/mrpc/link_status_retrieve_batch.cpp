@@ -0,0 +1,131 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file link_status_retrieve_batch.cpp
+ * @brief Link Status Retrieve Command for several ports implementation
+ * */
+
+#include "logger/logger_factory.hpp"
+#include "gas/mrpc/link_status_retrieve_batch.hpp"
+#include "safe-string/safe_lib.hpp"
+
+using namespace agent::pnc::gas;
+using namespace agent::pnc::gas::mrpc;
+
+namespace {
+
+constexpr unsigned MAX_PORTS = 64;
+
+
+bool is_single_port(std::uint64_t mask) {
+    return 0 != mask && 0 == (mask & (mask - 1));
+}
+
+
+unsigned count_ports(std::uint64_t mask) {
+    unsigned count{0};
+    for (; 0 != mask; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+}
+
+}
+
+
+LinkStatusRetrieveBatch::~LinkStatusRetrieveBatch() {}
+
+
+bool LinkStatusRetrieveBatch::is_mergeable(const Command& cmd) {
+    const auto* link_status = dynamic_cast<const LinkStatusRetrieve*>(&cmd);
+    return nullptr != link_status && is_single_port(link_status->input.fields.input_data);
+}
+
+
+bool LinkStatusRetrieveBatch::add(LinkStatusRetrieve& cmd) {
+    if (!is_mergeable(cmd) || cmd.get_interface() != m_iface || 0 != (m_port_mask & cmd.input.fields.input_data)) {
+        return false;
+    }
+    m_port_mask |= cmd.input.fields.input_data;
+    m_commands.push_back(&cmd);
+    return true;
+}
+
+
+bool LinkStatusRetrieveBatch::is_output_read(const LinkStatusRetrieve& cmd) const {
+    return 0 != (m_read_mask & cmd.input.fields.input_data);
+}
+
+
+void LinkStatusRetrieveBatch::write_input() {
+
+    std::uint8_t data[LinkStatusRetrieve::LINK_STATUS_RETRIEVE_INPUT_MEMORY_SIZE];
+
+    memcpy_s(data, LinkStatusRetrieve::LINK_STATUS_RETRIEVE_INPUT_MEMORY_SIZE,
+             &m_port_mask, LinkStatusRetrieve::LINK_STATUS_RETRIEVE_INPUT_MEMORY_SIZE);
+
+    log_debug("pnc-link-status", "LinkStatusRetrieve command input data:"
+                                   << " InputData=" << std::hex << m_port_mask << " (" << std::dec
+                                   << m_commands.size() << " ports)");
+
+    m_iface->write(data, LinkStatusRetrieve::LINK_STATUS_RETRIEVE_INPUT_MEMORY_SIZE, MRPC_INPUT_DATA_REG_OFFSET);
+}
+
+
+void LinkStatusRetrieveBatch::read_output() {
+    static constexpr std::uint32_t ENTRY_SIZE = LinkStatusRetrieve::LINK_STATUS_RETRIEVE_OUTPUT_MEMORY_SIZE;
+
+    m_read_mask = 0;
+    std::uint8_t ret_value[MRPC_COMMAND_RETURN_VALUE_REG_SIZE];
+
+    m_iface->read(ret_value, MRPC_COMMAND_RETURN_VALUE_REG_SIZE, MRPC_COMMAND_RETURN_VALUE_REG_OFFSET);
+
+    const auto result = LinkStatusRetrieveReturnValue(
+            ret_value[0] | (ret_value[1] << 8) | (ret_value[2] << 16) | (ret_value[3] << 24));
+
+    for (auto* cmd : m_commands) {
+        cmd->output.fields.ret_value = result;
+    }
+    if (LinkStatusRetrieveReturnValue::COMMAND_SUCCEED != result) {
+        return;
+    }
+
+    // one entry per requested port, each entry starts with the physical port id
+    const auto entries = count_ports(m_port_mask);
+    std::vector<std::uint8_t> data(entries * ENTRY_SIZE);
+    m_iface->read(data.data(), std::uint32_t(data.size()), MRPC_OUTPUT_DATA_REG_OFFSET);
+
+    for (unsigned entry = 0; entry < entries; ++entry) {
+        const std::uint8_t* entry_data = data.data() + entry * ENTRY_SIZE;
+        if (entry_data[0] >= MAX_PORTS) {
+            continue;
+        }
+        const std::uint64_t port_bit = std::uint64_t(1u) << entry_data[0];
+        for (auto* cmd : m_commands) {
+            if (port_bit == cmd->input.fields.input_data) {
+                memcpy_s(&cmd->output.fields.port_id, ENTRY_SIZE, entry_data, ENTRY_SIZE);
+                m_read_mask |= port_bit;
+                break;
+            }
+        }
+    }
+
+    log_debug("pnc-link-status", "LinkStatusRetrieve command output data read for " << count_ports(m_read_mask)
+                                   << " of " << entries << " ports");
+}
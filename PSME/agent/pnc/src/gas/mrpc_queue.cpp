@@ -0,0 +1,215 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file mrpc_queue.cpp
+ * @brief MRPC command submission queue implementation
+ * */
+
+#include "gas/mrpc_queue.hpp"
+#include "gas/mrpc/link_status_retrieve_batch.hpp"
+#include "logger/logger_factory.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+using namespace agent::pnc::gas;
+using namespace agent::pnc::gas::mrpc;
+
+namespace {
+
+/*! Number of retries of reading status of a failed command */
+constexpr unsigned FAILURE_RETRIES = 3;
+
+/*! Extension of the retry delay after each retry */
+constexpr std::chrono::milliseconds FAILURE_RETRY_DELAY_STEP{50};
+
+
+std::uint64_t get_port_mask(const Command& cmd) {
+    return static_cast<const LinkStatusRetrieve&>(cmd).input.fields.input_data;
+}
+
+}
+
+
+MrpcQueue::MrpcQueue(const MrpcPollingPolicy& policy) : m_policy(policy) {
+    m_thread = std::thread(&MrpcQueue::task, this);
+}
+
+
+MrpcQueue::~MrpcQueue() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_is_running = false;
+    }
+    m_condition.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+
+MrpcQueue& MrpcQueue::get_instance() {
+    static MrpcQueue queue{};
+    return queue;
+}
+
+
+std::future<CommandStatus> MrpcQueue::submit(Command& cmd) {
+    std::future<CommandStatus> completion{};
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_requests.push_back(Request{&cmd, std::promise<CommandStatus>{}});
+        completion = m_requests.back().completion.get_future();
+    }
+    m_condition.notify_one();
+    return completion;
+}
+
+
+void MrpcQueue::set_polling_policy(const MrpcPollingPolicy& policy) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_policy = policy;
+}
+
+
+MrpcQueue::Statistics MrpcQueue::get_statistics() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_statistics;
+}
+
+
+void MrpcQueue::task() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (true) {
+        m_condition.wait(lock, [this] { return !m_is_running || !m_requests.empty(); });
+        if (m_requests.empty()) {
+            // stopped and all submitted commands are executed
+            break;
+        }
+
+        std::deque<Request> requests{};
+        requests.push_back(std::move(m_requests.front()));
+        m_requests.pop_front();
+
+        // read-only commands waiting right behind are merged, order of commands changing the switch is kept
+        if (LinkStatusRetrieveBatch::is_mergeable(*requests.front().command)) {
+            auto* iface = requests.front().command->get_interface();
+            auto port_mask = get_port_mask(*requests.front().command);
+            while (!m_requests.empty() && LinkStatusRetrieveBatch::is_mergeable(*m_requests.front().command)
+                   && m_requests.front().command->get_interface() == iface
+                   && 0 == (port_mask & get_port_mask(*m_requests.front().command))) {
+                port_mask |= get_port_mask(*m_requests.front().command);
+                requests.push_back(std::move(m_requests.front()));
+                m_requests.pop_front();
+            }
+        }
+
+        lock.unlock();
+        execute_requests(requests);
+        lock.lock();
+    }
+}
+
+
+void MrpcQueue::execute_requests(std::deque<Request>& requests) {
+    MrpcPollingPolicy policy{};
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        policy = m_policy;
+    }
+
+    std::vector<CommandStatus> statuses(requests.size(), CommandStatus::FAILED);
+    std::exception_ptr exception{};
+    try {
+        if (1 == requests.size()) {
+            statuses.front() = run_command(*requests.front().command, policy);
+        }
+        else {
+            LinkStatusRetrieveBatch batch{requests.front().command->get_interface()};
+            for (auto& request : requests) {
+                batch.add(static_cast<LinkStatusRetrieve&>(*request.command));
+            }
+            const auto status = run_command(batch, policy);
+            for (std::size_t i = 0; i < requests.size(); ++i) {
+                const auto& cmd = static_cast<const LinkStatusRetrieve&>(*requests[i].command);
+                statuses[i] = (CommandStatus::DONE == status && !batch.is_output_read(cmd))
+                              ? CommandStatus::FAILED : status;
+            }
+        }
+    }
+    catch (...) {
+        exception = std::current_exception();
+    }
+    m_last_completion = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_statistics.commands += requests.size();
+        ++m_statistics.mrpc_calls;
+    }
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        if (exception) {
+            requests[i].completion.set_exception(exception);
+        }
+        else {
+            requests[i].completion.set_value(statuses[i]);
+        }
+    }
+}
+
+
+CommandStatus MrpcQueue::run_command(Command& cmd, const MrpcPollingPolicy& policy) {
+    // the switch needs some time after the previous command
+    std::this_thread::sleep_until(m_last_completion + policy.command_gap);
+
+    cmd.write_input();
+    cmd.run();
+
+    // Waits until operation is IN_PROGRESS or IDLE (device is busy/waiting), status is read less often over time.
+    std::this_thread::sleep_for(policy.first_poll_delay);
+    CommandStatus status = cmd.read_status();
+    auto poll_interval = policy.min_poll_interval;
+    while (CommandStatus::IN_PROGRESS == status) {
+        std::this_thread::sleep_for(poll_interval);
+        poll_interval = std::min(2 * poll_interval, policy.max_poll_interval);
+        status = cmd.read_status();
+    }
+
+    // If error occurs we try to read MRPC status 3 times and extend delay.
+    auto error_delay = policy.failure_retry_delay;
+    unsigned tries = FAILURE_RETRIES;
+    while (CommandStatus::FAILED == status && tries > 0) {
+        log_warning("gas-tool", "MRPC status: FAILED. Will try again...");
+        std::this_thread::sleep_for(error_delay);
+        status = cmd.read_status();
+        tries--;
+        error_delay += FAILURE_RETRY_DELAY_STEP;
+    }
+
+    // If still error we return status without command status read.
+    if (CommandStatus::FAILED == status) {
+        log_error("gas-tool", "MRPC FAILED after " << FAILURE_RETRIES << " tries.");
+        return status;
+    }
+
+    // MRPC is DONE. We read command status.
+    cmd.read_output();
+    return status;
+}
@@ -64,6 +64,15 @@ bool get_is_being_erased(const Drive& drive) {
 }
 
 
+StringVector get_port_uuids(const PsmVector& psms) {
+    StringVector uuids{};
+    for (const auto& psm : psms) {
+        uuids.push_back(psm->get_port_uuid());
+    }
+    return uuids;
+}
+
+
 std::tuple<bool, bool> get_is_bound(const GlobalAddressSpaceRegisters& gas, const PortBindingInfo& pbi,
                                     uint8_t port_id) {
     for (unsigned i = 0; i <= pbi.output.fields.info_count; ++i) {
@@ -136,6 +145,7 @@ uint64_t initialize_dsps(const PsmVector& psms, const DiscoveryManager& dm, cons
                          const Toolset& tools) {
     uint64_t presence_mask{0u};
     auto pbi = tools.gas_tool->get_all_port_binding_info(gas);
+    dm.update_ports_status(gas, get_port_uuids(psms));
     for (auto& psm : psms) {
         auto port_uuid = psm->get_port_uuid();
         Port port = get_manager<Port>().get_entry(port_uuid);
@@ -143,7 +153,6 @@ uint64_t initialize_dsps(const PsmVector& psms, const DiscoveryManager& dm, cons
         bool is_bound_to_host{false};
         std::tie(is_bound, is_bound_to_host) = get_is_bound(gas, pbi, uint8_t(port.get_phys_port_id()));
         psm->init_binding(is_bound, is_bound_to_host);
-        dm.update_port_status(gas, port_uuid);
         // model was updated - get new status
         bool is_link_up = get_is_link_up(get_manager<Port>().get_entry(port_uuid));
         psm->init_presence(is_link_up);
@@ -158,6 +167,9 @@ uint64_t initialize_dsps(const PsmVector& psms, const DiscoveryManager& dm, cons
 void update_downstream_ports(const PsmVector& psms, const DiscoveryManager& dm, const GlobalAddressSpaceRegisters& gas,
                              const Toolset&, uint64_t presence_bitmask, const PortBindingInfo& pbi) {
 
+    // update status of all ports at once, state variables do not depend on it
+    dm.update_ports_status(gas, get_port_uuids(psms));
+
     for (auto& psm : psms) {
 
         Port port = get_manager<Port>().get_entry(psm->get_port_uuid());
@@ -173,8 +185,6 @@ void update_downstream_ports(const PsmVector& psms, const DiscoveryManager& dm,
         bool is_being_erased =
             (is_drive_present ? get_is_being_erased(get_manager<Drive>().get_entry(psm->get_device_uuid())) : false);
 
-        // update status, state variables must not change
-        dm.update_port_status(gas, psm->get_port_uuid());
         if (is_drive_present) {
             auto drive_ref = get_manager<Drive>().get_entry_reference(psm->get_device_uuid());
             // we only 'touch' drives that have no state overrides
@@ -206,9 +216,7 @@ void update_downstream_ports(const PsmVector& psms, const DiscoveryManager& dm,
 void
 update_upstream_ports(const StringVector& uuids, const DiscoveryManager& dm, const GlobalAddressSpaceRegisters& gas,
                       const Toolset&) {
-    for (const auto& uuid : uuids) {
-        dm.update_port_status(gas, uuid);
-    }
+    dm.update_ports_status(gas, uuids);
 }
 
 
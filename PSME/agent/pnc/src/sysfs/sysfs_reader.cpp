@@ -69,38 +69,21 @@ void SysfsReader::update_drive_info(const std::string& drive_name, RawSysfsDevic
 }
 
 
-void SysfsReader::update_pci_device_drives(const Path& device_path, RawSysfsDevice& device) const {
-
-    // read all block devices
-    SysfsDir block_devices{};
-    try {
-        block_devices = m_sysfs_interface->get_dir(Path(PATH_CLASS_BLOCK));
+PciTopology SysfsReader::read_topology() const {
+    PciTopology topology{*m_sysfs_interface, Path(PATH_BUS_PCI_DEVICES), Path(PATH_CLASS_BLOCK)};
+    if (!topology.are_block_devices_read()) {
+        log_error("sysfs-reader", "Unable to read block devices from " << PATH_CLASS_BLOCK);
     }
-    catch (const std::exception& e) {
-        log_error("sysfs-reader", "Exception while reading block devices: " << e.what());
-        return;
+    for (const auto& link_path : topology.get_unresolved_links()) {
+        log_error("sysfs-reader", "Unable to resolve symlink " << link_path.to_string());
     }
+    return topology;
+}
 
-    // prepare regexp
-    std::string reg_expr_str_pre = "/sys/devices/pci....:../(?:....:..:..\\../)*";
-    std::string reg_expr_str_post = "/(.*)";
-    std::string reg_expr_str = reg_expr_str_pre + device_path.basename() + reg_expr_str_post;
-    static const int NUM_OF_SUB_EXPR = 2;
-
-    for (const auto& link_path : block_devices.links) {
-        try {
-            std::string absolute_path_str = m_sysfs_interface->get_absolute_path(link_path).to_string();
-            std::smatch matches{};
 
-            std::regex_match(absolute_path_str, matches, std::regex(reg_expr_str, std::regex_constants::icase));
-            if (NUM_OF_SUB_EXPR == matches.size()) {
-                update_drive_info(link_path.basename(), device);
-            }
-        }
-        catch (const std::exception& e) {
-            log_error("sysfs-reader", "Exception while reading symlink " << link_path.to_string()
-                                                                         << ": " << e.what());
-        }
+void SysfsReader::update_pci_device_drives(const PciTopology& topology, RawSysfsDevice& device) const {
+    for (const auto& drive_name : topology.get_block_device_names(device.name)) {
+        update_drive_info(drive_name, device);
     }
 }
 
@@ -128,9 +111,9 @@ bool SysfsReader::update_pci_device_config(const Path& device_path, RawSysfsDevi
 }
 
 
-bool SysfsReader::update_pci_device_ids(const Path& device_path, RawSysfsDevice& device) const {
-    device.path = m_sysfs_interface->get_absolute_path(device_path).to_string();
-    device.name = device_path.basename();
+bool SysfsReader::update_pci_device_ids(const PciFunction& function, RawSysfsDevice& device) const {
+    device.path = function.path.to_string();
+    device.name = function.link.basename();
     try {
         device.id = SysfsId::from_string(device.name);
     }
@@ -142,12 +125,13 @@ bool SysfsReader::update_pci_device_ids(const Path& device_path, RawSysfsDevice&
 }
 
 
-bool SysfsReader::update_pci_device(const Path& device_path, RawSysfsDevice& device) const {
+bool SysfsReader::update_pci_device(const PciFunction& function, const PciTopology& topology,
+                                    RawSysfsDevice& device) const {
     RawSysfsDevice result{};
-    if (update_pci_device_config(device_path, result) && update_pci_device_ids(device_path, result)) {
+    if (update_pci_device_config(function.link, result) && update_pci_device_ids(function, result)) {
 
-        update_pci_device_virtual(device_path, result);
-        update_pci_device_drives(device_path, result);
+        update_pci_device_virtual(function.link, result);
+        update_pci_device_drives(topology, result);
         device = result;
         return true;
     }
@@ -156,16 +140,13 @@ bool SysfsReader::update_pci_device(const Path& device_path, RawSysfsDevice& dev
 }
 
 
-bool SysfsReader::is_path_matched(const Path& device_path, const std::string& path) const {
+bool SysfsReader::is_path_matched(const Path& device_path, const std::regex& path_regex) const {
     std::string device_path_str = device_path.to_string();
     if (device_path_str.empty()) {
         return false;
     }
-    if (path.empty()) {
-        return true;
-    }
     std::smatch matches{};
-    std::regex_match(device_path_str, matches, std::regex(".*" + path + ".*", std::regex_constants::icase));
+    std::regex_match(device_path_str, matches, path_regex);
     return (matches.size() == 1);
 }
 
@@ -174,26 +155,28 @@ std::vector<RawSysfsDevice> SysfsReader::get_raw_sysfs_devices(const std::string
 
     std::vector<RawSysfsDevice> devices{};
 
-    // open bus directory
-    SysfsDir pci_devices{};
     try {
-        pci_devices = m_sysfs_interface->get_dir(PATH_BUS_PCI_DEVICES);
+        // read all PCI and block devices once, drives of all devices are taken from the topology
+        const auto topology = read_topology();
+
+        // compile the filter once, empty path matches all devices
+        const std::regex path_regex(".*" + path + ".*", std::regex_constants::icase);
+
+        // check all PCI functions
+        for (const auto& function : topology.get_pci_functions()) {
+            RawSysfsDevice sysfs_device{};
+
+            // if path is matched, try reading device data and add it to the returned vector
+            if (is_path_matched(function.link, path_regex) && update_pci_device(function, topology, sysfs_device)) {
+                devices.push_back(std::move(sysfs_device));
+            }
+        }
     }
     catch (const std::exception& e) {
         log_error("sysfs-reader", "Exception while reading PCI devices: " << e.what());
         return {};
     }
 
-    // check all links in the dir
-    for (const Path& device_link_path : pci_devices.links) {
-        RawSysfsDevice sysfs_device{};
-
-        // if path is matched, try reading device data and add it to the returned vector
-        if (is_path_matched(device_link_path, path) && update_pci_device(device_link_path, sysfs_device)) {
-            devices.push_back(std::move(sysfs_device));
-        }
-    }
-
     return devices;
 }
 
@@ -224,6 +207,9 @@ PcieAddress SysfsReader::get_pcie_address_for_fpga_device(
     std::string regex_str = str_dev.str();
 
 
+    // value of the device link is in format "../../../0000:3d:00.0"
+    static const std::regex pcie_address_regex("(..\\/..\\/..\\/(0000):(..):(..).(.))");
+
     // for each link in that fpga, only one matching pcie_address_regex
     for (const auto& link_path : fpga_devices.links) {
         try {
@@ -242,7 +228,6 @@ PcieAddress SysfsReader::get_pcie_address_for_fpga_device(
 
             // value is in format "../../../0000:3d:00.0"
             std::string fpga_link_string(fpga_pcie_link.value);
-            std::regex pcie_address_regex("(..\\/..\\/..\\/(0000):(..):(..).(.))");
 
             auto pcie_address_begin = std::sregex_iterator(fpga_link_string.begin(), fpga_link_string.end(),
                                                     pcie_address_regex);
@@ -281,40 +266,26 @@ std::vector<std::string> SysfsReader::get_drives_for_device(
 
     std::vector<std::string> drives{};
 
-    // open bus directory
-    SysfsDir block_devices{};
     try {
-        block_devices = m_sysfs_interface->get_dir(PATH_CLASS_BLOCK);
+        const auto topology = read_topology();
+        const Path bridge_path{switch_bridge_path};
+
+        // namespaces below the functions of the device connected directly to the switch bridge
+        for (const auto& function : topology.get_pci_functions()) {
+            if (!(function.path.dirname() == bridge_path) || !PciTopology::is_pci_address(function.address)) {
+                continue;
+            }
+            const auto id = SysfsId::from_string(function.address);
+            if (id.bus_num == bus_num && id.device_num == device_num) {
+                const auto namespaces = topology.get_namespace_names(function.address);
+                drives.insert(drives.end(), namespaces.begin(), namespaces.end());
+            }
+        }
     }
     catch (const std::exception& e) {
         log_error("sysfs-reader", "Exception while reading block devices: " << e.what());
         return {};
     }
-
-    // build device name
-    std::stringstream str_dev{};
-    // there is '.' in the switch name - but that should not be a problem
-    str_dev << std::hex << switch_bridge_path << "/....:";
-    str_dev << std::setw(2) << std::setfill('0') << unsigned(bus_num) << ":";
-    str_dev << std::setw(2) << std::setfill('0') << unsigned(device_num) << "\\../";
-    str_dev << "(?:....:..:..\\../)*(.*)/(\\1.*)/(\\2.*)";
-    std::string regex_str = str_dev.str();
-    static constexpr int NUM_OF_SUB_EXPR = 4;
-
-    for (const auto& link_path : block_devices.links) {
-        try {
-            std::string absolute_path_str = m_sysfs_interface->get_absolute_path(link_path).to_string();
-
-            std::smatch matches{};
-            std::regex_match(absolute_path_str, matches, std::regex(regex_str, std::regex_constants::icase));
-            if (NUM_OF_SUB_EXPR == matches.size()) {
-                drives.push_back(matches[3]);
-            }
-        }
-        catch (const std::exception& e) {
-            log_error("sysfs-reader", "Exception while reading symlink " << link_path.to_string() << ": " << e.what());
-        }
-    }
     return drives;
 }
 
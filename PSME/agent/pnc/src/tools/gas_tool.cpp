@@ -162,6 +162,44 @@ LinkStatusRetrieve GasTool::get_link_status(const GlobalAddressSpaceRegisters& g
 }
 
 
+std::map<std::uint8_t, LinkStatusRetrieve> GasTool::get_link_statuses(const GlobalAddressSpaceRegisters& gas,
+    const std::vector<std::uint8_t>& phys_port_ids) const {
+
+    // all commands are queued before waiting for any of them, so they are executed as one MRPC command
+    std::vector<std::pair<std::uint8_t, LinkStatusRetrieve>> commands{};
+    commands.reserve(phys_port_ids.size());
+    for (const auto phys_port_id : phys_port_ids) {
+        if (phys_port_id >= PM85X6_PHY_PORTS_NUMBER) {
+            log_debug("gas-tool", "Invalid physical port id = " << unsigned(phys_port_id));
+            continue;
+        }
+        commands.emplace_back(phys_port_id, LinkStatusRetrieve{gas.get_interface()});
+        commands.back().second.input.fields.input_data = std::uint64_t(std::uint64_t(1u) << phys_port_id);
+    }
+    std::vector<std::future<CommandStatus>> completions{};
+    for (auto& command : commands) {
+        completions.push_back(gas.submit_cmd(command.second));
+    }
+
+    std::map<std::uint8_t, LinkStatusRetrieve> link_statuses{};
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        const auto& cmd = commands[i].second;
+        try {
+            if (CommandStatus::DONE == completions[i].get()
+                && LinkStatusRetrieveReturnValue::COMMAND_SUCCEED == cmd.output.fields.ret_value) {
+                link_statuses.emplace(commands[i].first, cmd);
+                continue;
+            }
+        }
+        catch (const std::exception& e) {
+            log_debug("gas-tool", "Exception while reading link status: " << e.what());
+        }
+        log_debug("gas-tool", "Cannot get PCIe Port Link status for port " << unsigned(commands[i].first));
+    }
+    return link_statuses;
+}
+
+
 uint8_t GasTool::get_logical_bridge_for_port(const PortBindingInfo& pbi) const {
 
     if (pbi.output.fields.info_count != 1) {
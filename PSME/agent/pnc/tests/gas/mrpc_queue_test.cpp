@@ -0,0 +1,296 @@
+/*!
+ * @section LICENSE
+ *
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @section DESCRIPTION
+ * MRPC queue tests and polling benchmark using simulated GAS memory region
+ * */
+
+#include "gas/mrpc_queue.hpp"
+#include "gas/mrpc/bind_port.hpp"
+#include "gas/mrpc/link_status_retrieve.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace agent::pnc::gas;
+using namespace agent::pnc::gas::mrpc;
+
+namespace {
+
+/*!
+ * GAS memory region with simulated switch firmware: a command is completed when its status is read
+ * after the processing time. Link Status Retrieve returns an entry for each requested port.
+ */
+class SimulatedGas final : public AccessInterface {
+public:
+    explicit SimulatedGas(std::chrono::microseconds processing_time) : m_processing_time(processing_time) {}
+
+    void init(const std::string&) override {}
+
+    void deinit() override {}
+
+    void write(uint8_t* data, uint32_t size, uint32_t offset) override {
+        if (fail_writes) {
+            throw std::runtime_error("GAS write failed");
+        }
+        std::memcpy(m_memory.data() + offset, data, size);
+        if (MRPC_COMMAND_REG_OFFSET == offset) {
+            m_commands.push_back(CommandCode(data[0]));
+            m_completion = std::chrono::steady_clock::now() + m_processing_time;
+            set_status(CommandStatus::IN_PROGRESS);
+        }
+    }
+
+    void read(uint8_t* data, uint32_t size, uint32_t offset) override {
+        if (MRPC_STATUS_REG_OFFSET == offset) {
+            ++status_reads;
+        }
+        if (MRPC_STATUS_REG_OFFSET == offset && CommandStatus::IN_PROGRESS == CommandStatus(m_memory[offset])
+            && std::chrono::steady_clock::now() >= m_completion) {
+            complete();
+        }
+        std::memcpy(data, m_memory.data() + offset, size);
+    }
+
+    const std::vector<CommandCode>& get_commands() const {
+        return m_commands;
+    }
+
+    /*! Ports without an entry in the Link Status Retrieve output */
+    std::uint64_t missing_ports{0};
+    /*! Status reported for all commands */
+    CommandStatus result{CommandStatus::DONE};
+    /*! Simulates access errors */
+    bool fail_writes{false};
+    /*! Number of MRPC status polls */
+    unsigned status_reads{0};
+
+private:
+    void set_status(CommandStatus status) {
+        m_memory[MRPC_STATUS_REG_OFFSET] = std::uint8_t(status);
+    }
+
+    void complete() {
+        std::memset(m_memory.data() + MRPC_COMMAND_RETURN_VALUE_REG_OFFSET, 0, MRPC_COMMAND_RETURN_VALUE_REG_SIZE);
+        if (CommandCode::LINK_STATUS_RETRIEVE == m_commands.back()) {
+            std::uint64_t mask{};
+            std::memcpy(&mask, m_memory.data() + MRPC_INPUT_DATA_REG_OFFSET, sizeof(mask));
+            std::uint32_t offset = MRPC_OUTPUT_DATA_REG_OFFSET;
+            for (std::uint8_t port = 0; port < 64; ++port) {
+                const auto port_bit = std::uint64_t(1u) << port;
+                if ((mask & port_bit) && !(missing_ports & port_bit)) {
+                    std::uint8_t entry[LinkStatusRetrieve::LINK_STATUS_RETRIEVE_OUTPUT_MEMORY_SIZE]{};
+                    entry[0] = port;
+                    entry[4] = 4;
+                    entry[5] = std::uint8_t(port % 4 + 1);
+                    std::memcpy(m_memory.data() + offset, entry, sizeof(entry));
+                    offset += std::uint32_t(sizeof(entry));
+                }
+            }
+        }
+        set_status(result);
+    }
+
+    std::chrono::microseconds m_processing_time;
+    std::chrono::steady_clock::time_point m_completion{};
+    std::vector<std::uint8_t> m_memory = std::vector<std::uint8_t>(TOP_SETTING_REG_OFFSET, 0);
+    std::vector<CommandCode> m_commands{};
+};
+
+
+MrpcPollingPolicy fast_policy() {
+    MrpcPollingPolicy policy{};
+    policy.first_poll_delay = std::chrono::microseconds{100};
+    policy.min_poll_interval = std::chrono::microseconds{100};
+    policy.max_poll_interval = std::chrono::microseconds{1000};
+    policy.command_gap = std::chrono::microseconds{0};
+    policy.failure_retry_delay = std::chrono::microseconds{0};
+    return policy;
+}
+
+
+LinkStatusRetrieve make_link_status(AccessInterface* iface, std::uint8_t port) {
+    LinkStatusRetrieve cmd{iface};
+    cmd.input.fields.input_data = std::uint64_t(1u) << port;
+    return cmd;
+}
+
+}
+
+
+TEST(MrpcQueueTest, SingleCommandIsExecuted) {
+    SimulatedGas gas{std::chrono::microseconds{500}};
+    MrpcQueue queue{fast_policy()};
+
+    auto cmd = make_link_status(&gas, 5);
+    ASSERT_EQ(CommandStatus::DONE, queue.execute(cmd));
+    EXPECT_EQ(LinkStatusRetrieveReturnValue::COMMAND_SUCCEED, cmd.output.fields.ret_value);
+    EXPECT_EQ(5, cmd.output.fields.port_id);
+    EXPECT_EQ(2, cmd.output.fields.neg_link_width);
+    EXPECT_EQ(1u, queue.get_statistics().mrpc_calls);
+}
+
+
+TEST(MrpcQueueTest, PendingLinkStatusCommandsAreMergedInOrder) {
+    SimulatedGas gas{std::chrono::milliseconds{5}};
+    MrpcQueue queue{fast_policy()};
+
+    BindPort first_bind{&gas};
+    BindPort second_bind{&gas};
+    std::vector<LinkStatusRetrieve> commands{};
+    for (std::uint8_t port = 0; port < 5; ++port) {
+        commands.push_back(make_link_status(&gas, port));
+    }
+
+    // the worker is busy with the first command while the others are queued
+    std::vector<std::future<CommandStatus>> completions{};
+    completions.push_back(queue.submit(first_bind));
+    completions.push_back(queue.submit(commands[0]));
+    completions.push_back(queue.submit(commands[1]));
+    completions.push_back(queue.submit(second_bind));
+    completions.push_back(queue.submit(commands[2]));
+    completions.push_back(queue.submit(commands[3]));
+    completions.push_back(queue.submit(commands[4]));
+    for (auto& completion : completions) {
+        EXPECT_EQ(CommandStatus::DONE, completion.get());
+    }
+
+    for (std::uint8_t port = 0; port < 5; ++port) {
+        EXPECT_EQ(port, commands[port].output.fields.port_id);
+        EXPECT_EQ(port % 4 + 1, commands[port].output.fields.neg_link_width);
+    }
+    EXPECT_EQ((std::vector<CommandCode>{CommandCode::PORT_PARTITION_P2P_BINDING, CommandCode::LINK_STATUS_RETRIEVE,
+                                        CommandCode::PORT_PARTITION_P2P_BINDING, CommandCode::LINK_STATUS_RETRIEVE}),
+              gas.get_commands());
+    EXPECT_EQ(7u, queue.get_statistics().commands);
+    EXPECT_EQ(4u, queue.get_statistics().mrpc_calls);
+}
+
+
+TEST(MrpcQueueTest, MergedCommandWithoutPortEntryFails) {
+    SimulatedGas gas{std::chrono::milliseconds{5}};
+    gas.missing_ports = std::uint64_t(1u) << 2;
+    MrpcQueue queue{fast_policy()};
+
+    BindPort bind{&gas};
+    auto present = make_link_status(&gas, 1);
+    auto missing = make_link_status(&gas, 2);
+    auto bind_completion = queue.submit(bind);
+    auto present_completion = queue.submit(present);
+    auto missing_completion = queue.submit(missing);
+
+    EXPECT_EQ(CommandStatus::DONE, bind_completion.get());
+    EXPECT_EQ(CommandStatus::DONE, present_completion.get());
+    EXPECT_EQ(CommandStatus::FAILED, missing_completion.get());
+    EXPECT_EQ(1, present.output.fields.port_id);
+}
+
+
+TEST(MrpcQueueTest, FailedCommandIsReported) {
+    SimulatedGas gas{std::chrono::microseconds{100}};
+    gas.result = CommandStatus::FAILED;
+    MrpcQueue queue{fast_policy()};
+
+    auto cmd = make_link_status(&gas, 1);
+    EXPECT_EQ(CommandStatus::FAILED, queue.execute(cmd));
+}
+
+
+TEST(MrpcQueueTest, AccessErrorIsRethrown) {
+    SimulatedGas gas{std::chrono::microseconds{100}};
+    gas.fail_writes = true;
+    MrpcQueue queue{fast_policy()};
+
+    BindPort cmd{&gas};
+    EXPECT_THROW(queue.execute(cmd), std::runtime_error);
+
+    gas.fail_writes = false;
+    EXPECT_EQ(CommandStatus::DONE, queue.execute(cmd));
+}
+
+
+namespace {
+
+constexpr std::uint8_t BENCHMARK_PORTS = 16;
+constexpr std::chrono::microseconds FIRMWARE_PROCESSING_TIME{1000};
+constexpr unsigned FIXED_DELAY_MS = 10;
+
+
+/* Reference: execution with fixed delays, as done before the MRPC queue */
+CommandStatus execute_with_fixed_delays(Command& cmd) {
+    CommandStatus status{CommandStatus::IN_PROGRESS};
+    cmd.write_input();
+    cmd.run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(FIXED_DELAY_MS));
+    while (CommandStatus::IN_PROGRESS == status) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(FIXED_DELAY_MS));
+        status = cmd.read_status();
+    }
+    cmd.read_output();
+    std::this_thread::sleep_for(std::chrono::milliseconds(FIXED_DELAY_MS));
+    return status;
+}
+
+}
+
+
+TEST(MrpcQueueBenchmark, LinkStatusOfAllPortsPolling) {
+    SimulatedGas gas{FIRMWARE_PROCESSING_TIME};
+    MrpcQueue queue{};
+    std::vector<LinkStatusRetrieve> commands{};
+    for (std::uint8_t port = 0; port < BENCHMARK_PORTS; ++port) {
+        commands.push_back(make_link_status(&gas, port));
+    }
+    unsigned checksum{0};
+
+    for (auto& cmd : commands) {
+        checksum += unsigned(CommandStatus::DONE == execute_with_fixed_delays(cmd));
+    }
+    EXPECT_EQ(BENCHMARK_PORTS, gas.status_reads);
+
+    // the first poll is not done before the firmware processing time, so the status is not polled more often
+    gas.status_reads = 0;
+    for (auto& cmd : commands) {
+        checksum += unsigned(CommandStatus::DONE == queue.execute(cmd));
+    }
+    EXPECT_EQ(BENCHMARK_PORTS, gas.status_reads);
+    EXPECT_EQ(BENCHMARK_PORTS, queue.get_statistics().mrpc_calls);
+
+    // commands submitted while the worker is busy are merged into a single MRPC command
+    gas.status_reads = 0;
+    BindPort bind{&gas};
+    auto bind_completion = queue.submit(bind);
+    std::vector<std::future<CommandStatus>> completions{};
+    for (auto& cmd : commands) {
+        completions.push_back(queue.submit(cmd));
+    }
+    for (auto& completion : completions) {
+        checksum += unsigned(CommandStatus::DONE == completion.get());
+    }
+    EXPECT_EQ(CommandStatus::DONE, bind_completion.get());
+    EXPECT_EQ(2u, gas.status_reads);
+    EXPECT_EQ(BENCHMARK_PORTS + 2u, queue.get_statistics().mrpc_calls);
+    EXPECT_EQ(3u * BENCHMARK_PORTS, checksum);
+}
@@ -31,7 +31,7 @@
 #include "agent-framework/database/database_entities.hpp"
 
 #include "json-rpc/connectors/http_server_connector.hpp"
-#include "json-rpc/connectors/unix_domain_socket_client_connector.hpp"
+#include "json-rpc/connectors/persistent_unix_domain_socket_client_connector.hpp"
 #include "configuration/configuration.hpp"
 #include "configuration/configuration_validator.hpp"
 #include "database/database.hpp"
@@ -110,7 +110,8 @@ int main(int argc, const char* argv[]) {
         std::make_shared<interface_reader::UdevInterfaceReader>(context->configuration->get_nic_drivers());
 
     auto connector =
-        std::make_shared<json_rpc::UnixDomainSocketClientConnector>(context->configuration->get_spdk_socket());
+        std::make_shared<json_rpc::PersistentUnixDomainSocketClientConnector>(
+            context->configuration->get_spdk_socket());
     auto invoker = std::make_shared<json_rpc::JsonRpcRequestInvoker>();
     context->spdk_api = std::make_shared<::spdk::SpdkApi>(connector, invoker);
 
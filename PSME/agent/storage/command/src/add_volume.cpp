@@ -245,7 +245,9 @@ void create_new_volume(AgentContext::SPtr context,
 
     task_creator.add_subtask(lvm_create_volume_subtask);
     if (clone) {
-        task_creator.add_subtask(::storage::lvm::LvmCloneTask{lvm_create_data});
+        task_creator.add_subtask(::storage::lvm::LvmCloneTask{
+            lvm_create_data, make_task_progress_callback(task_creator.get_task_resource().get_uuid())
+        });
     }
     task_creator.set_promised_response(promised_response_builder);
     task_creator.set_promised_error_thrower(promised_exception_builder);
@@ -172,7 +172,8 @@ Uuid initialize_volume_task(agent::storage::SetComponentAttributes::ContextPtr c
     task_creator.prepare_task();
     task_creator.add_subtask([uuid]() { agent::storage::utils::lock_volume_for_initialization(uuid); });
     task_creator.add_subtask(::storage::lvm::LvmEraseTask{
-        volume_path, (std::uint64_t) volume.get_capacity().get_allocated_bytes(), fast_flag
+        volume_path, (std::uint64_t) volume.get_capacity().get_allocated_bytes(), fast_flag,
+        make_task_progress_callback(task_creator.get_task_resource().get_uuid())
     });
 
     auto rediscovery_subtask = [context, volume]() {
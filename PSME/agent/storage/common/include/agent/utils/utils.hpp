@@ -22,6 +22,9 @@
 
 #include "agent-framework/module/utils/uuid.hpp"
 
+#include <cstdint>
+#include <functional>
+
 
 namespace agent {
 namespace storage {
@@ -52,6 +55,17 @@ void unlock_volume_for_initialization(const Uuid& uuid, bool success = true);
 void update_storage_pool_relations(const Uuid& old_uuid, const Uuid& new_uuid);
 
 
+/*!
+ * @brief Creates callback reporting progress of a task in its messages.
+ *
+ * When the percentage changes, the task message is updated and Task Update event is sent,
+ * at most once per second. Completion of the task is reported immediately.
+ * @param task_uuid UUID of the task resource.
+ * @return Callback to be called with number of processed and total bytes.
+ */
+std::function<void(std::uint64_t, std::uint64_t)> make_task_progress_callback(const Uuid& task_uuid);
+
+
 }
 }
 }
@@ -18,14 +18,32 @@
 
 #include "agent-framework/exceptions/exception.hpp"
 #include "agent-framework/module/storage_components.hpp"
+#include "agent-framework/module/common_components.hpp"
+#include "agent-framework/eventing/utils.hpp"
 
 #include "agent/utils/utils.hpp"
+#include "logger/logger.hpp"
+
+#include <chrono>
+#include <memory>
 
 
 
 using namespace agent_framework::module;
 using namespace agent_framework::model;
 
+namespace {
+
+/* Minimal interval between progress updates of a task, the completion is always reported */
+constexpr std::chrono::seconds PROGRESS_UPDATE_INTERVAL{1};
+
+struct TaskProgress {
+    std::uint64_t percent{0};
+    std::chrono::steady_clock::time_point updated{};
+};
+
+}
+
 
 void agent::storage::utils::lock_volume_for_initialization(const Uuid& uuid) {
     auto volume_ref = get_manager<Volume>().get_entry_reference(uuid);
@@ -50,3 +68,40 @@ void agent::storage::utils::unlock_volume_for_initialization(const Uuid& uuid, b
 void agent::storage::utils::update_storage_pool_relations(const Uuid& old_uuid, const Uuid& new_uuid) {
     get_m2m_manager<StoragePool, Volume>().update_parent(old_uuid, new_uuid);
 }
+
+
+std::function<void(std::uint64_t, std::uint64_t)>
+agent::storage::utils::make_task_progress_callback(const Uuid& task_uuid) {
+    auto progress = std::make_shared<TaskProgress>();
+    return [task_uuid, progress](std::uint64_t processed_bytes, std::uint64_t total_bytes) {
+        const auto percent = (0 == total_bytes) ? 100 : processed_bytes * 100 / total_bytes;
+        const auto now = std::chrono::steady_clock::now();
+        if (percent == progress->percent || (percent < 100 && now < progress->updated + PROGRESS_UPDATE_INTERVAL)) {
+            return;
+        }
+        progress->percent = percent;
+        progress->updated = now;
+
+        attribute::Message::MessageArgs args{};
+        args.add_entry(task_uuid);
+        args.add_entry(std::to_string(percent));
+        attribute::Message message{};
+        message.set_message_id("TaskEvent.1.0.TaskProgressChanged");
+        message.set_content("The task with id " + task_uuid + " has changed to progress "
+                            + std::to_string(percent) + " percent complete.");
+        message.set_severity(enums::Health::OK);
+        message.set_message_args(args);
+        try {
+            {
+                auto task = get_manager<Task>().get_entry_reference(task_uuid);
+                Task::Messages messages{};
+                messages.add_entry(message);
+                task->set_messages(messages);
+            }
+            agent_framework::eventing::send_event(task_uuid, enums::Component::Task, enums::Notification::Update);
+        }
+        catch (const std::exception& error) {
+            log_debug("storage-agent", "Cannot report progress of task " << task_uuid << ": " << error.what());
+        }
+    };
+}
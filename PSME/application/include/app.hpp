@@ -83,6 +83,7 @@ private:
      */
     void init();
     void init_database();
+    void init_model();
     void init_logger();
     void init_network_change_notifier();
     void init_ssdp_service();
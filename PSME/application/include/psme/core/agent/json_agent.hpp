@@ -22,11 +22,13 @@
 #define PSME_CORE_AGENT_JSON_AGENT_HPP
 
 #include "agent-framework/module/utils/utils.hpp"
+#include "agent-framework/module/managers/utils/read_tracker.hpp"
 
 #include "agent.hpp"
 #include "agent_unreachable.hpp"
 #include "rpc_client.hpp"
 #include "logger/logger_factory.hpp"
+#include "json-rpc/connectors/http_client_connector.hpp"
 
 #include <memory>
 #include <atomic>
@@ -58,14 +60,19 @@ public:
 
     template <typename Response, typename Request>
     Response execute(const Request& req) {
-        std::lock_guard<std::mutex> lock(m_single_request_mutex);
+        // Result built from the agent response cannot be validated with epochs of the model
+        agent_framework::module::ReadTracker::record_untracked();
         try {
             auto res = m_client.CallMethod(Request::get_command(), req.to_json());
-            m_connection_error_observed_at = std::experimental::nullopt;
+            {
+                std::lock_guard<std::mutex> lock(m_connection_error_mutex);
+                m_connection_error_observed_at = std::experimental::nullopt;
+            }
 
             return Response::from_json(res);
         }
         catch (const json_rpc::JsonRpcException& e) {
+            std::lock_guard<std::mutex> lock(m_connection_error_mutex);
             if (json_rpc::common::ERROR_CLIENT_CONNECTOR == e.get_code()) {
                 auto now = std::chrono::high_resolution_clock::now();
                 if (m_connection_error_observed_at) {
@@ -90,6 +97,14 @@ public:
         }
     }
 
+    /*!
+     * @brief Gets counters of the connector used to communicate with the agent
+     * @return Connector statistics
+     */
+    json_rpc::HttpClientConnector::Statistics get_connection_statistics() const {
+        return m_connector->get_statistics();
+    }
+
     /*!
      * @brief Method unregisters agent from agent manager
      */
@@ -125,10 +140,10 @@ private:
     std::string make_connection_url(const std::string& ipv4_address, const int port) const;
 
     std::experimental::optional<std::chrono::time_point<std::chrono::system_clock>> m_connection_error_observed_at{};
-    json_rpc::AbstractClientConnectorPtr m_connector{};
-    json_rpc::JsonRpcRequestInvokerPtr m_invoker{};
+    std::shared_ptr<json_rpc::HttpClientConnector> m_connector{};
     RpcClient m_client;
-    std::mutex m_single_request_mutex{};
+    /*! @brief Requests are sent concurrently, only the connection error state is guarded */
+    std::mutex m_connection_error_mutex{};
     std::mutex m_transaction_mutex{};
     std::atomic<std::uint64_t> m_transaction_id{};
 };
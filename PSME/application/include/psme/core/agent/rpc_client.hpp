@@ -30,11 +30,13 @@ namespace psme {
 namespace core {
 namespace agent {
 
-/*! Implementation of JSON RPC Client which can handle framework exceptions. */
+/*!
+ * Implementation of JSON RPC Client which can handle framework exceptions.
+ * Methods may be called concurrently if the connector allows it, each call uses its own invoker.
+ */
 class RpcClient {
 public:
-    RpcClient(json_rpc::AbstractClientConnectorPtr conn, json_rpc::JsonRpcRequestInvokerPtr inv):
-        m_connector(conn), m_invoker(inv) {}
+    explicit RpcClient(json_rpc::AbstractClientConnectorPtr conn): m_connector(conn) {}
 
 
     json::Json CallMethod(const std::string& name, const json::Json& parameter);
@@ -46,7 +48,6 @@ public:
 private:
 
     json_rpc::AbstractClientConnectorPtr m_connector;
-    json_rpc::JsonRpcRequestInvokerPtr m_invoker;
 
 };
 
@@ -91,6 +91,7 @@ extern const char MESSAGE_REGISTRY_FILE_ID[];
 extern const char PSU_ID[];
 extern const char METRIC_DEFINITION_ID[];
 extern const char METRIC_REPORT_DEFINITION_ID[];
+extern const char METRIC_REPORT_ID[];
 extern const char TRIGGER_ID[];
 extern const char SESSION_ID[];
 extern const char ACCOUNT_ID[];
@@ -191,6 +192,7 @@ extern const char RESOLUTION[];
  */
 namespace Collection {
 extern const char ODATA_COUNT[];
+extern const char ODATA_NEXT_LINK[];
 extern const char MEMBERS[];
 }
 
@@ -213,6 +215,14 @@ extern const char TELEMETRY_SERVICE[];
 extern const char UPDATE_SERVICE[];
 extern const char SERVICE[];
 extern const char ACCOUNT_SERVICE[];
+extern const char PROTOCOL_FEATURES_SUPPORTED[];
+extern const char EXPAND_QUERY[];
+extern const char EXPAND_ALL[];
+extern const char LEVELS[];
+extern const char NO_LINKS[];
+extern const char MAX_LEVELS[];
+extern const char SELECT_QUERY[];
+extern const char FILTER_QUERY[];
 }
 
 /*!
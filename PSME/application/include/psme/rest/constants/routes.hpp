@@ -166,6 +166,8 @@ public:
     static const std::string METRIC_DEFINITIONS_COLLECTION_PATH;
     static const std::string METRIC_REPORT_DEFINITION_PATH;
     static const std::string METRIC_REPORT_DEFINITIONS_COLLECTION_PATH;
+    static const std::string METRIC_REPORT_PATH;
+    static const std::string METRIC_REPORTS_COLLECTION_PATH;
     static const std::string TRIGGER_PATH;
     static const std::string TRIGGERS_COLLECTION_PATH;
 
@@ -25,6 +25,7 @@ namespace constants {
 namespace TelemetryService {
 extern const char METRIC_DEFINITIONS[];
 extern const char METRIC_REPORT_DEFINITIONS[];
+extern const char METRIC_REPORTS[];
 extern const char TRIGGERS[];
 }
 
@@ -73,6 +74,14 @@ extern const char REPORT_INTERVAL_MS[];
 extern const char TRANSMIT_FORMAT[];
 }
 
+namespace MetricReport {
+extern const char REPORT_SEQUENCE[];
+extern const char METRIC_VALUES[];
+extern const char METRIC_ID[];
+extern const char METRIC_PROPERTY[];
+extern const char TIMESTAMP[];
+}
+
 namespace Trigger {
 extern const char TRIGGER_TYPE[];
 extern const char TRIGGER_ACTIONS[];
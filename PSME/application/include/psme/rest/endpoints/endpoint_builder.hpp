@@ -23,6 +23,9 @@
 
 namespace psme {
 namespace rest {
+namespace server {
+class Multiplexer;
+}
 namespace endpoint {
 
 class EndpointBuilder {
@@ -31,7 +34,17 @@ public:
     ~EndpointBuilder();
 
 
+    /*!
+     * @brief Register handlers of all endpoints in the REST server multiplexer
+     */
     void build_endpoints();
+
+
+    /*!
+     * @brief Register handlers of all endpoints
+     * @param mp Multiplexer the handlers are registered in
+     */
+    void build_endpoints(server::Multiplexer& mp);
 };
 
 }
@@ -151,6 +151,8 @@
 #include "telemetry/metric_definitions_collection.hpp"
 #include "telemetry/metric_report_definition.hpp"
 #include "telemetry/metric_report_definitions_collection.hpp"
+#include "telemetry/metric_report.hpp"
+#include "telemetry/metric_reports_collection.hpp"
 #include "telemetry/telemetry_service.hpp"
 #include "telemetry/trigger.hpp"
 #include "telemetry/triggers_collection.hpp"
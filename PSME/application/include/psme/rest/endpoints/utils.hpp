@@ -131,11 +131,7 @@ void set_location_header(const server::Request& req, server::Response& res, cons
 template<typename Resource, typename QueryResult>
 std::vector<QueryResult> query_entries(const std::string& parent_uuid,
                                        std::function<QueryResult(const Resource&)> query) {
-    std::vector<QueryResult> results{};
-    for (const auto& resource : agent_framework::module::get_manager<Resource>().get_entries(parent_uuid)) {
-        results.emplace_back(query(resource));
-    }
-    return results;
+    return agent_framework::module::get_manager<Resource>().project(parent_uuid, query);
 }
 
 
@@ -22,6 +22,7 @@
  * This class represents Event.Event metadata EntityType
  */
 
+#pragma once
 #include "event.hpp"
 #include "agent-framework/module/utils/optional_field.hpp"
 
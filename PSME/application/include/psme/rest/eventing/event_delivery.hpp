@@ -0,0 +1,172 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file event_delivery.hpp
+ * @brief Parallel delivery of event arrays to the subscribers
+ * */
+
+#pragma once
+
+#include "psme/rest/eventing/event_array.hpp"
+#include "psme/rest/eventing/rest_client.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace psme {
+namespace rest {
+namespace eventing {
+
+/*!
+ * @brief Delivers event arrays to the subscribers using a pool of workers.
+ *
+ * Each subscriber has its own queue, so a slow or unreachable listener only delays
+ * its own events. Event arrays of a subscriber are delivered one at a time and in order,
+ * by the same RestClient, which keeps the connection to the listener alive.
+ * Subscriber queues are bounded, the oldest event array is dropped when the queue is full.
+ */
+class EventDelivery {
+public:
+    using SubscriberId = std::uint64_t;
+    using Clock = std::chrono::steady_clock;
+
+    /*!
+     * @brief Function delivering event array to its subscriber
+     *
+     * @param client RestClient dedicated to the subscriber
+     * @param event_array Event array to be delivered
+     *
+     * @return true if event array was delivered
+     */
+    using Sender = std::function<bool(RestClient& client, const EventArray& event_array)>;
+
+    /*! @brief Delivery statistics */
+    struct Metrics {
+        /*! @brief Number of event arrays waiting for delivery */
+        std::size_t queue_depth{};
+        /*! @brief Number of event arrays waiting in the longest subscriber queue */
+        std::size_t max_subscriber_queue_depth{};
+        /*! @brief Number of delivered event arrays */
+        std::uint64_t delivered{};
+        /*! @brief Number of failed deliveries */
+        std::uint64_t failed{};
+        /*! @brief Number of event arrays dropped because of full subscriber queue */
+        std::uint64_t dropped{};
+        /*! @brief Average time from enqueueing until the end of the delivery */
+        std::chrono::microseconds average_latency{};
+        /*! @brief Maximal time from enqueueing until the end of the delivery */
+        std::chrono::microseconds max_latency{};
+    };
+
+    /*!
+     * @brief Constructor
+     *
+     * @param sender Function delivering event arrays
+     * @param workers Number of worker threads
+     * @param max_queue_depth Maximal number of event arrays waiting for a single subscriber
+     */
+    EventDelivery(Sender sender, std::size_t workers, std::size_t max_queue_depth);
+
+    EventDelivery(const EventDelivery&) = delete;
+    EventDelivery& operator=(const EventDelivery&) = delete;
+
+    /*! @brief Destructor, stops the workers */
+    ~EventDelivery();
+
+    /*! @brief Start worker threads */
+    void start();
+
+    /*! @brief Stop worker threads, undelivered event arrays are discarded */
+    void stop();
+
+    /*!
+     * @brief Enqueue event array for delivery to its subscriber
+     *
+     * @param event_array Event array with subscriber id set
+     *
+     * @return false if the oldest event array of the subscriber was dropped to make room
+     */
+    bool enqueue(EventArray event_array);
+
+    /*!
+     * @brief Get delivery statistics
+     *
+     * @return Current metrics
+     */
+    Metrics get_metrics() const;
+
+    /*!
+     * @brief Get number of event arrays waiting for the subscriber
+     *
+     * @param subscriber_id Subscriber id
+     *
+     * @return Subscriber queue depth
+     */
+    std::size_t get_queue_depth(SubscriberId subscriber_id) const;
+
+private:
+    /*! @brief Event array with time it was enqueued */
+    using QueuedEventArray = std::pair<EventArray, Clock::time_point>;
+
+    /*! @brief Delivery state of a subscriber */
+    struct Destination {
+        std::deque<QueuedEventArray> queue{};
+        /*! @brief Worker is delivering an event array to the subscriber */
+        bool busy{false};
+        /*! @brief Subscriber waits in the ready queue for a worker */
+        bool scheduled{false};
+        std::unique_ptr<RestClient> client{};
+        Clock::time_point last_used{};
+    };
+
+    void run_worker();
+    void prune_idle_destinations();
+
+    Sender m_sender;
+    std::size_t m_worker_count;
+    std::size_t m_max_queue_depth;
+
+    mutable std::mutex m_mutex{};
+    std::condition_variable m_ready_cv{};
+    bool m_running{false};
+    std::vector<std::thread> m_workers{};
+
+    std::map<SubscriberId, Destination> m_destinations{};
+    /*! @brief Subscribers with waiting event arrays and no delivery in progress */
+    std::deque<SubscriberId> m_ready{};
+
+    std::size_t m_queue_depth{};
+    std::uint64_t m_delivered{};
+    std::uint64_t m_failed{};
+    std::uint64_t m_dropped{};
+    Clock::duration m_total_latency{};
+    Clock::duration m_max_latency{};
+};
+
+}
+}
+}
@@ -23,6 +23,7 @@
  * */
 #pragma once
 #include "event_array_queue.hpp"
+#include "event_delivery.hpp"
 
 #include <atomic>
 #include <thread>
@@ -54,6 +55,16 @@ public:
      */
     static constexpr char DELIVERY_RETRY_INTERVAL_PROP[] = "delivery-retry-interval-seconds";
 
+    /*!
+     * @brief Delivery workers property
+     */
+    static constexpr char DELIVERY_WORKERS_PROP[] = "delivery-workers";
+
+    /*!
+     * @brief Delivery queue depth property
+     */
+    static constexpr char DELIVERY_QUEUE_DEPTH_PROP[] = "delivery-queue-depth";
+
     /*!
      * @brief Default constructor
      */
@@ -109,17 +120,29 @@ public:
         return m_delivery_retry_attempts;
     }
 
+    /*!
+     * @brief Get event delivery statistics
+     *
+     * @return Queue depth and delivery latency metrics
+     */
+    EventDelivery::Metrics get_delivery_metrics() const {
+        return m_delivery.get_metrics();
+    }
+
     /*! @brief Destructor */
     ~EventService();
 private:
     void m_handle_events();
     std::vector<EventArray> select_events_for_subscribers(const EventArray& event);
-    void send_event_array(const EventArray& event_array);
+    bool send_event_array(RestClient& rest_client, const EventArray& event_array);
+    void log_delivery_metrics();
 
     std::thread m_thread{};
     std::atomic<bool> m_running{false};
     std::chrono::seconds m_delivery_retry_interval{60};
     unsigned int m_delivery_retry_attempts{3};
+    EventDelivery m_delivery;
+    steady_clock::time_point m_metrics_logged{};
 };
 
 }
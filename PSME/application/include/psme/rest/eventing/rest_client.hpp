@@ -166,6 +166,14 @@ public:
     RestClient(const std::string& base_url) : m_base_url(base_url) {
     }
 
+    /*!
+     * @brief Destructor, closes all kept connections
+     */
+    ~RestClient();
+
+    RestClient(const RestClient&) = delete;
+    RestClient& operator=(const RestClient&) = delete;
+
     /*!
      * @brief Set basic auth
      *
@@ -257,6 +265,8 @@ private:
     std::string m_content_type{};
     std::string m_basic_auth{};
 
+    /*! @brief Curl handle reused by all requests, it keeps connections alive between them */
+    void* m_handle{nullptr};
 };
 
 }
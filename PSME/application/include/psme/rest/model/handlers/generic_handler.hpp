@@ -31,6 +31,9 @@
 #include "psme/rest/server/error/server_exception.hpp"
 #include "psme/core/agent/agent_unreachable.hpp"
 
+#include <exception>
+#include <mutex>
+
 
 
 namespace psme {
@@ -38,6 +41,7 @@ namespace rest {
 
 namespace endpoint {
 class RollupTest;
+class RollupBenchmarkTest;
 }
 
 namespace model {
@@ -89,7 +93,10 @@ public:
 
     virtual void poll(JsonAgentSPtr agent,
                       const std::string& parent, const Component parent_component,
-                      const std::string& uuid) override;
+                      const std::string& uuid,
+                      ParallelRunner* runner = nullptr,
+                      std::chrono::steady_clock::time_point deadline =
+                          std::chrono::steady_clock::time_point::max()) override;
 
 
     virtual std::uint64_t load(JsonAgentSPtr agent,
@@ -157,6 +164,17 @@ protected:
     void fetch_subcomponents(Context& ctx, const std::string& parent, const Array <Collection>& collections);
 
 
+    /*!
+     * @brief Downloads recursively a single subcollection
+     *
+     * @param[in] ctx State of the handler passed down when handling request
+     * @param[in] parent uuid of parent node
+     * @param[in] sub_handler Name of the collection and handler of its components
+     */
+    void fetch_collection(Context& ctx, const std::string& parent,
+                          const std::pair<std::string, HandlerInterface*>& sub_handler);
+
+
     /*!
      * @brief removes entity with given uuid
      *
@@ -204,10 +222,22 @@ protected:
      * @param[in] sub_handler Handler of sub-component to remember
      */
     void remember_sub_handler(HandlerInterface* sub_handler) {
+        std::lock_guard<std::mutex> lock{m_sub_components_mutex};
         m_sub_components.insert(sub_handler->get_component());
     }
 
 
+    /*!
+     * @brief Gets learned subcomponents, safe while sub handlers are remembered by parallel polling
+     *
+     * @return Copy of the set of subcomponents
+     */
+    std::set<Component> get_sub_components() const {
+        std::lock_guard<std::mutex> lock{m_sub_components_mutex};
+        return m_sub_components;
+    }
+
+
     /*!
      * @brief assigns rest id number to new resource
      *
@@ -274,12 +304,14 @@ protected:
 
 
     std::set<Component> m_sub_components{}; // each handler learns set of possible subcomponents
+    mutable std::mutex m_sub_components_mutex{};
     agent_framework::model::enums::CollectionName m_collection_name{Model::get_collection_name()};
     IdPolicy m_id_policy{};
 
     friend class HandlerTest;
     friend class FabricHandlersTest;
     friend class psme::rest::endpoint::RollupTest;
+    friend class psme::rest::endpoint::RollupBenchmarkTest;
 
 private:
 
@@ -395,12 +427,16 @@ template<typename Request, typename Model, typename IdPolicy>
 void GenericHandler<Request, Model, IdPolicy>
 ::poll(JsonAgentSPtr agent,
        const std::string& parent_uuid, const Component parent_component,
-       const std::string& uuid) {
+       const std::string& uuid,
+       ParallelRunner* runner,
+       std::chrono::steady_clock::time_point deadline) {
 
     Context ctx;
     ctx.agent = agent.get();
     ctx.mode = Context::Mode::POLLING;
     ctx.stack.emplace(parent_component);
+    ctx.runner = runner;
+    ctx.deadline = deadline;
 
     try {
         log_info("rest", ctx.indent << "[" << char(ctx.mode) << "] " << "Polling started on "
@@ -412,6 +448,11 @@ void GenericHandler<Request, Model, IdPolicy>
 
         SubscriptionManager::get_instance()->notify(ctx.events);
     }
+    catch (const PollingDeadlineExceeded&) {
+        log_error("rest", ctx.indent << "[" << char(ctx.mode) << "] "
+                                                 << "Polling stopped, deadline exceeded. State may be incomplete.");
+        SubscriptionManager::get_instance()->notify(ctx.events);
+    }
     catch (const core::agent::AgentUnreachable&) {
         log_error("rest", ctx.indent << "[" << char(ctx.mode) << "] "
                                                  << "Polling failed due to agent error (unreachable).");
@@ -629,23 +670,46 @@ void GenericHandler<Request, Model, IdPolicy>
     // collections of the same type (with different names)
     std::map<Component, uint64_t> epochs{};
 
-    for (auto sub_handler = sub_handlers.begin(); sub_handler != sub_handlers.end(); ++sub_handler) {
+    // all epochs are taken before any collection is fetched, so components touched by collections
+    // fetched in parallel are never taken for untouched ones
+    for (const auto& sub_handler : sub_handlers) {
+        // we only want the lowest epoch
+        if (epochs.find(sub_handler.second->get_component()) == epochs.end()) {
+            epochs[sub_handler.second->get_component()] = sub_handler.second->get_manager_epoch();
+        }
+    }
+
+    if (nullptr != ctx.runner && Context::Mode::POLLING == ctx.mode && sub_handlers.size() > 1) {
+        // each collection is fetched with its own context, events and statistics are merged afterwards
+        std::vector<Context> forked_contexts{};
+        std::vector<ParallelRunner::Task> tasks{};
+        forked_contexts.reserve(sub_handlers.size());
+        for (const auto& sub_handler : sub_handlers) {
+            forked_contexts.emplace_back(ctx.fork());
+            auto& forked_context = forked_contexts.back();
+            tasks.emplace_back([this, &forked_context, &parent, &sub_handler] {
+                fetch_collection(forked_context, parent, sub_handler);
+            });
+        }
+
+        std::exception_ptr error{};
         try {
-            // we only want the lowest epoch
-            if (epochs.find((*sub_handler).second->get_component()) == epochs.end()) {
-                epochs[(*sub_handler).second->get_component()] = (*sub_handler).second->get_manager_epoch();
-            }
-            (*sub_handler).second->fetch_siblings(ctx, parent, (*sub_handler).first);
-            remember_sub_handler((*sub_handler).second);
+            ctx.runner->run(tasks);
         }
-        catch (const psme::core::agent::AgentUnreachable&) {
-            throw; // connection error should stop transaction (polling, event handling)
+        catch (...) {
+            error = std::current_exception();
+        }
+        for (const auto& forked_context : forked_contexts) {
+            ctx.join(forked_context);
+        }
+        if (error) {
+            std::rethrow_exception(error); // connection error should stop transaction
+        }
+    }
+    else {
+        for (const auto& sub_handler : sub_handlers) {
+            fetch_collection(ctx, parent, sub_handler);
         }
-            /*
-             * other exceptions should not stop us from reading.
-             * note, that error was already logged
-             */
-        catch (...) {}
     }
 
     // After all fetching we remove nodes that could not be found
@@ -656,6 +720,25 @@ void GenericHandler<Request, Model, IdPolicy>
 }
 
 
+template<typename Request, typename Model, typename IdPolicy>
+void GenericHandler<Request, Model, IdPolicy>
+::fetch_collection(Context& ctx, const std::string& parent,
+                   const std::pair<std::string, HandlerInterface*>& sub_handler) {
+    try {
+        sub_handler.second->fetch_siblings(ctx, parent, sub_handler.first);
+        remember_sub_handler(sub_handler.second);
+    }
+    catch (const psme::core::agent::AgentUnreachable&) {
+        throw; // connection error should stop transaction (polling, event handling)
+    }
+        /*
+         * other exceptions should not stop us from reading.
+         * note, that error was already logged
+         */
+    catch (...) {}
+}
+
+
 template<typename Request, typename Model, typename IdPolicy>
 void GenericHandler<Request, Model, IdPolicy>
 ::remove_untouched(Context& ctx, const std::string& parent_uuid, std::uint64_t epoch) {
@@ -688,6 +771,7 @@ Model GenericHandler<Request, Model, IdPolicy>
     Request request{uuid};
     log_debug("rest", ctx.indent << "[" << char(ctx.mode) << "] "
                                              << "Fetching [" << component_s() << " " << uuid << "]");
+    ctx.check_deadline();
     try {
         auto element = ctx.agent->execute<Model>(request);
         element.set_parent_uuid(parent);
@@ -758,6 +842,7 @@ GenericHandler<Request, Model, IdPolicy>
         << "Fetching list of all components of type [" << component_s()
         << "] from collection [" << collection_name
         << "] for parent " << parent_uuid);
+    ctx.check_deadline();
     try {
         auto res = ctx.agent->execute < Array < SubcomponentEntry >> (collection);
         log_debug("rest", ctx.indent
@@ -802,7 +887,8 @@ void GenericHandler<Request, Model, IdPolicy>::remove(const std::string& uuid) {
 
 template<typename Request, typename Model, typename IdPolicy>
 void GenericHandler<Request, Model, IdPolicy>::do_remove(Context& ctx, const std::string& uuid) {
-    for (auto component = m_sub_components.begin(); component != m_sub_components.end(); ++component) {
+    const auto sub_components = get_sub_components();
+    for (auto component = sub_components.begin(); component != sub_components.end(); ++component) {
         auto handler = ::psme::rest::model::handler::HandlerManager::get_instance()->get_handler(*component);
         handler->remove_all(ctx, uuid);
     }
@@ -871,7 +957,8 @@ bool GenericHandler<Request, Model, IdPolicy>::do_accept(ResourceVisitor& visito
         }
         visitor.visited.insert(uuid);
 
-        for (auto component = m_sub_components.begin(); component != m_sub_components.end(); ++component) {
+        const auto sub_components = get_sub_components();
+        for (auto component = sub_components.begin(); component != sub_components.end(); ++component) {
             auto handler = ::psme::rest::model::handler::HandlerManager::get_instance()->get_handler(*component);
             if (!handler->do_accept_recursively(visitor, uuid, get_component())) {
                 return false; // break
@@ -22,11 +22,14 @@
 #pragma once
 
 #include "psme/rest/endpoints/utils.hpp"
+#include "psme/rest/model/parallel_runner.hpp"
+#include "psme/core/agent/agent_unreachable.hpp"
 
 #include "agent-framework/module/enum/common.hpp"
 #include "agent-framework/module/model/resource.hpp"
 #include "agent-framework/module/model/attributes/event_data.hpp"
 
+#include <chrono>
 #include <stack>
 
 namespace psme {
@@ -37,6 +40,16 @@ namespace handler {
 template<typename Request, typename Model, typename IdPolicy>
 class GenericHandler;
 
+/*!
+ * @brief Thrown when polling of the agent takes longer than allowed.
+ *
+ * Handled as AgentUnreachable: polling of the agent is stopped and resources not polled yet are kept intact.
+ * */
+class PollingDeadlineExceeded : public psme::core::agent::AgentUnreachable {
+public:
+    using AgentUnreachable::AgentUnreachable;
+};
+
 /*!
 * @brief Base class for all handlers.
 *
@@ -90,6 +103,55 @@ public:
         u_int32_t num_status_changed{0};
         u_int32_t num_alerts{0};
 
+        /*!
+         * @brief time when polling of the agent has to be finished
+         * */
+        std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+
+        /*!
+         * @brief runner used to fetch sibling collections in parallel, none if null
+         * */
+        ParallelRunner* runner{nullptr};
+
+        /*!
+         * @brief throws PollingDeadlineExceeded if polling of the agent takes too long
+         * */
+        void check_deadline() const {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                throw PollingDeadlineExceeded(agent ? agent->get_gami_id() : std::string{});
+            }
+        }
+
+        /*!
+         * @brief creates context for processing done in parallel with this one
+         *
+         * @return Copy of the context without collected events and statistics
+         * */
+        Context fork() const {
+            Context forked{};
+            forked.mode = mode;
+            forked.stack = stack;
+            forked.indent = indent;
+            forked.agent = agent;
+            forked.deadline = deadline;
+            forked.runner = runner;
+            return forked;
+        }
+
+        /*!
+         * @brief merges events and statistics collected by the forked context
+         *
+         * @param[in] forked Context created by fork()
+         * */
+        void join(const Context& forked) {
+            events.insert(events.end(), forked.events.begin(), forked.events.end());
+            num_added += forked.num_added;
+            num_removed += forked.num_removed;
+            num_updated += forked.num_updated;
+            num_status_changed += forked.num_status_changed;
+            num_alerts += forked.num_alerts;
+        }
+
         void add_event(Component component, EventType event_type, const std::string& uuid) {
             std::string url{};
             try {
@@ -164,10 +226,15 @@ public:
      * @param[in] parent_uuid UUID of parent node
      * @param[in] parent_component parent component type
      * @param[in] uuid Start polling from this node
+     * @param[in] runner Runner used to fetch sibling collections in parallel, collections fetched one by one if null
+     * @param[in] deadline Time when polling has to be finished, remaining resources are not polled after it
      * */
     virtual void poll(JsonAgentSPtr agent,
                       const std::string& parent_uuid, const Component parent_component,
-                      const std::string& uuid) = 0;
+                      const std::string& uuid,
+                      ParallelRunner* runner = nullptr,
+                      std::chrono::steady_clock::time_point deadline =
+                          std::chrono::steady_clock::time_point::max()) = 0;
 
     /*!
      * @brief can be used by client to load resource on-demand.
@@ -26,6 +26,7 @@
 #include "database/database.hpp"
 
 #include <memory>
+#include <mutex>
 
 namespace psme {
 namespace rest {
@@ -120,6 +121,13 @@ private:
      * Memoizer static object will be constructed in IdPolicy constructor.
      */
     static IdMemoizer::SPtr memoizer;
+
+    /*!
+     * @brief Guards read-modify-write of IDs in the database and the memoizer
+     *
+     * Components of the same type may be polled in parallel (i.e. from different agents).
+     */
+    static std::mutex mutex;
     static constexpr agent_framework::model::enums::Component component = CT;
 };
 
@@ -129,6 +137,9 @@ database::Database::SPtr IdPolicy<CT, NZ>::database {};
 template <agent_framework::model::enums::Component::Component_enum CT, NumberingZone NZ>
 IdMemoizer::SPtr IdPolicy<CT, NZ>::memoizer {};
 
+template <agent_framework::model::enums::Component::Component_enum CT, NumberingZone NZ>
+std::mutex IdPolicy<CT, NZ>::mutex {};
+
 template <agent_framework::model::enums::Component::Component_enum CT, NumberingZone NZ>
 constexpr agent_framework::model::enums::Component IdPolicy<CT, NZ>::component;
 
@@ -147,6 +158,7 @@ IdPolicy<CT, NZ>::~IdPolicy() { }
 template <agent_framework::model::enums::Component::Component_enum CT, NumberingZone NZ>
 database::IdValue::IdType IdPolicy<CT, NZ>::IdPolicy::get_id(const UuidType& uuid, const UuidType& parent_uuid) {
     const UuidType& parent = (NZ == NumberingZone::SHARED) ? "" : parent_uuid;
+    std::lock_guard<std::mutex> lock{mutex};
 
     /* parent might be empty, then 'last' name is assumed */
     database::UuidKey last_key{database::ResourceLastKey::LAST, parent};
@@ -216,6 +228,7 @@ database::IdValue::IdType IdPolicy<CT, NZ>::IdPolicy::get_id(const UuidType& uui
 template <agent_framework::model::enums::Component::Component_enum CT, NumberingZone NZ>
 void IdPolicy<CT, NZ>::purge(const UuidType& uuid, const UuidType& parent_uuid) {
     const UuidType& parent = (NZ == NumberingZone::SHARED) ? "" : parent_uuid;
+    std::lock_guard<std::mutex> lock{mutex};
 
     database::UuidKey entity_key{uuid, parent};
     database::IdValue entity_id{};
@@ -241,6 +254,7 @@ void IdPolicy<CT, NZ>::purge(const UuidType& uuid, const UuidType& parent_uuid)
 
 template <agent_framework::model::enums::Component::Component_enum CT, NumberingZone NZ>
 void IdPolicy<CT, NZ>::reset() {
+    std::lock_guard<std::mutex> lock{mutex};
     database::UuidKey entity_key{};
     database->drop(entity_key);
     database->remove();
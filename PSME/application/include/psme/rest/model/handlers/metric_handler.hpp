@@ -18,6 +18,7 @@
 
 #include "agent-framework/module/model/metric.hpp"
 #include "agent-framework/module/requests/common/get_metrics.hpp"
+#include "psme/rest/telemetry/metric_reports.hpp"
 
 
 namespace psme {
@@ -100,6 +101,7 @@ public:
             element.set_parent_uuid(parent);
             element.set_uuid(uuid);
             element.set_parent_type(ctx.get_parent_component());
+            telemetry::MetricReports::get_instance()->get_history().add_sample(uuid, element.get_value());
             return element;
         }
         catch (const json_rpc::JsonRpcException& e) {
@@ -0,0 +1,82 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file parallel_runner.hpp
+ * @brief Bounded parallel execution of polling tasks
+ * */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace psme {
+namespace rest {
+namespace model {
+
+/*!
+ * @brief Runs groups of tasks in parallel, using at most max_threads additional threads at once.
+ *
+ * The limit is shared by all groups run concurrently (also by groups run from within the tasks).
+ * When no thread is available, the task is executed by the calling thread, so nested groups
+ * never wait for each other and cannot deadlock.
+ */
+class ParallelRunner {
+public:
+    using Task = std::function<void()>;
+
+    /*!
+     * @brief Constructor
+     * @param max_threads Maximum number of threads running tasks at once (besides callers of run)
+     */
+    explicit ParallelRunner(std::size_t max_threads);
+
+    ParallelRunner(const ParallelRunner&) = delete;
+    ParallelRunner& operator=(const ParallelRunner&) = delete;
+
+    /*!
+     * @brief Executes all tasks and waits for them to finish.
+     *
+     * If any of the tasks throws, the exception of the first (in order of the tasks) failed one
+     * is rethrown, after all tasks are finished.
+     *
+     * @param tasks Tasks to be executed
+     */
+    void run(const std::vector<Task>& tasks);
+
+    /*! @brief Get maximum number of threads running tasks at once */
+    std::size_t get_max_threads() const {
+        return m_max_threads;
+    }
+
+private:
+    bool try_acquire_thread();
+
+    void release_thread();
+
+    const std::size_t m_max_threads;
+    std::atomic<std::size_t> m_busy_threads{0};
+};
+
+}
+}
+}
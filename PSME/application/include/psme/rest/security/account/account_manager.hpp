@@ -28,6 +28,7 @@
 
 #include "agent-framework/generic/singleton.hpp"
 #include "psme/rest/security/account/account.hpp"
+#include "psme/rest/security/account/credential_cache.hpp"
 
 
 
@@ -77,6 +78,14 @@ public:
     uint64_t add(Account account);
 
 
+    /*!
+     * @brief Remove account
+     *
+     * @param account_id Id of the account to remove
+     */
+    void remove(uint64_t account_id);
+
+
     /*!
      * @brief Calculate hash from password
      *
@@ -97,6 +106,10 @@ public:
 
     /*!
      * @brief Validates credentials given as arguments.
+     *
+     * Password hash is not calculated if the credentials were successfully validated recently
+     * and are still kept in the credential cache.
+     *
      * @param user_name name of the user
      * @param password user password
      * @return true if credentials are valid, false otherwise.
@@ -104,6 +117,15 @@ public:
     bool validate_credentials(const std::string& user_name, const std::string& password) const;
 
 
+    /*!
+     * @brief Get cache of validated credentials
+     * @return Credential cache
+     */
+    CredentialCache& get_credential_cache() const {
+        return m_credential_cache;
+    }
+
+
 private:
     /*!
      * @brief Authentication user name property name
@@ -115,6 +137,11 @@ private:
      */
     static constexpr char PASSWORD_HASH[] = "password";
 
+    /*!
+     * @brief Credential cache property name
+     */
+    static constexpr char CREDENTIAL_CACHE[] = "credential-cache";
+
     using AccountMap = std::map<std::uint64_t, Account>;
 
 
@@ -126,6 +153,7 @@ private:
 
     AccountMap m_accounts{};
     mutable std::mutex m_mutex{};
+    mutable CredentialCache m_credential_cache{};
 
     /*! @brief Last assigned ID */
     std::uint64_t m_id{0};
@@ -0,0 +1,162 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file credential_cache.hpp
+ *
+ * @brief Declaration of CredentialCache class.
+ * */
+
+#pragma once
+
+
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+
+
+namespace psme {
+namespace rest {
+namespace security {
+namespace account {
+
+/*!
+ * @brief Cache of successfully verified credentials.
+ *
+ * Verification of a password requires PBKDF2 hash to be calculated, which is slow by design. Credentials
+ * verified once are accepted without the hash calculation until the entry expires. Entries are kept under
+ * a keyed digest (HMAC with a random key generated on start) of the user name and password, so plain text
+ * passwords are never stored. Each entry holds the password hash of the account it was verified against,
+ * entry is not valid anymore if the account password is changed.
+ *
+ * The cache is disabled until its capacity is set, least recently used entries are dropped when the
+ * capacity is exceeded.
+ */
+class CredentialCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /*! @brief Cache usage counters */
+    struct Statistics {
+        std::uint64_t hits{};
+        std::uint64_t misses{};
+        std::uint64_t expirations{};
+        std::uint64_t invalidations{};
+        std::size_t entries{};
+    };
+
+
+    /*!
+     * @brief Default constructor, generates key of the digests
+     */
+    CredentialCache();
+
+
+    /*!
+     * @brief Set cache capacity and lifetime of the entries
+     * @param max_entries Capacity of the cache, 0 disables the cache
+     * @param time_to_live Time after which credentials have to be verified again
+     */
+    void configure(std::size_t max_entries, Clock::duration time_to_live);
+
+
+    /*!
+     * @brief Check if the cache is enabled
+     * @return true if verified credentials are cached
+     */
+    bool is_enabled() const;
+
+
+    /*!
+     * @brief Get capacity of the cache
+     * @return Maximum number of cached credentials, 0 if the cache is disabled
+     */
+    std::size_t get_max_entries() const;
+
+
+    /*!
+     * @brief Get lifetime of the entries
+     * @return Time after which credentials have to be verified again
+     */
+    Clock::duration get_time_to_live() const;
+
+
+    /*!
+     * @brief Check if credentials were verified
+     * @param user_name name of the user
+     * @param password user password
+     * @param password_hash current password hash of the user account
+     * @return true if the credentials were verified against the same password hash and the entry hasn't expired
+     */
+    bool contains(const std::string& user_name, const std::string& password, const std::string& password_hash);
+
+
+    /*!
+     * @brief Store successfully verified credentials
+     * @param user_name name of the user
+     * @param password user password
+     * @param password_hash password hash of the user account
+     */
+    void put(const std::string& user_name, const std::string& password, const std::string& password_hash);
+
+
+    /*!
+     * @brief Drop all entries, all credentials have to be verified again
+     */
+    void invalidate();
+
+
+    /*!
+     * @brief Get cache usage counters
+     * @return Counters of hits, misses, expired and invalidated entries
+     */
+    Statistics get_statistics() const;
+
+private:
+    struct Entry {
+        std::string digest{};
+        std::string password_hash{};
+        Clock::time_point expires{};
+    };
+
+    using Entries = std::list<Entry>;
+
+
+    std::string get_digest(const std::string& user_name, const std::string& password) const;
+
+
+    const std::string m_key;
+
+    mutable std::mutex m_mutex{};
+    std::size_t m_max_entries{0};
+    Clock::duration m_time_to_live{};
+    /* Most recently used entries first */
+    Entries m_entries{};
+    std::unordered_map<std::string, Entries::iterator> m_index{};
+    Statistics m_statistics{};
+};
+
+}
+}
+}
+}
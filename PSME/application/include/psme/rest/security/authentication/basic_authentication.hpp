@@ -61,10 +61,21 @@ public:
     AuthStatus perform(MHD_Connection* connection, const std::string& url, server::Response& response) override;
 
 
-private:
-    bool credentials_valid(MHD_Connection* connection);
+    /*!
+     * @brief Performs basic authentication of credentials decoded from the Authorization header.
+     *
+     * @param user_name User name sent by the client, nullptr if the request has no basic credentials.
+     * @param password Password sent by the client, nullptr if the request has no basic credentials.
+     * @param url Url of the resource requested by client.
+     * @param response Response object to set and send if basic authentication fails.
+     * @return AuthStatus indicating basic authentication result - FAIL if authentication failed, SUCCESS if succeeded.
+     */
+    AuthStatus perform(const char* user_name, const char* password, const std::string& url,
+                       server::Response& response);
 
 
+private:
+
     const char* m_LOGIN = "root";
     const char* m_PASSWORD = "password";
 };
@@ -27,6 +27,7 @@
 
 
 #include "json-wrapper/json-wrapper.hpp"
+#include <atomic>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -52,6 +53,27 @@ public:
     friend class SessionManager;
 
 
+    /*!
+     * @brief Default constructor
+     */
+    Session() = default;
+
+
+    /*!
+     * @brief Copy constructor
+     * @param other Session to be copied
+     */
+    Session(const Session& other);
+
+
+    /*!
+     * @brief Copy assignment
+     * @param other Session to be copied
+     * @return this session
+     */
+    Session& operator=(const Session& other);
+
+
     /*!
      * @brief Set Session id
      *
@@ -137,7 +159,7 @@ public:
      * @param[in] timepoint Timepoint object representing last session usage time.
      */
     void set_last_used(const Timepoint& timepoint) {
-        m_last_used = timepoint;
+        m_last_used = timepoint.time_since_epoch().count();
     }
 
 
@@ -146,7 +168,7 @@ public:
      * @return last session usage timepoint.
      */
     const Timepoint get_last_used() const {
-        return m_last_used;
+        return Timepoint{Timepoint::duration{m_last_used.load()}};
     }
 
 
@@ -183,17 +205,22 @@ public:
     bool is_session_valid(const std::chrono::seconds& session_timeout) const;
 
 
-private:
-    void update_last_used(void) {
-        set_last_used(std::chrono::steady_clock::now());
-    }
+    /*!
+     * Check if session is valid at given time.
+     * @param session_timeout SessionService's timeout for session validity.
+     * @param now Time of the check.
+     * @return true is session is valid, false if outdated.
+     */
+    bool is_session_valid(const std::chrono::seconds& session_timeout, const Timepoint& now) const;
 
 
+private:
     uint64_t m_id{};
     std::string m_user_name{};
     std::string m_session_auth_token{};
     std::string m_origin_header{};
-    Timepoint m_last_used{};
+    /* Updated on each request authenticated by the session, also by concurrent ones */
+    std::atomic<Timepoint::rep> m_last_used{};
 };
 
 
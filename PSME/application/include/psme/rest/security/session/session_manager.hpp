@@ -28,8 +28,12 @@
 
 #include "agent-framework/generic/singleton.hpp"
 #include "psme/rest/security/session/session.hpp"
+#include <functional>
 #include <mutex>
 #include <map>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 
 
@@ -40,6 +44,10 @@ namespace session {
 
 /*!
  * SessionManager class declaration.
+ *
+ * Sessions are indexed by their tokens, requests authenticated by sessions share the lock and
+ * only mark the session as used. Expiration times are kept in a timer wheel with one second
+ * slots, so removing outdated sessions visits only the sessions which could have expired.
  */
 class SessionManager : public agent_framework::generic::Singleton<SessionManager> {
 public:
@@ -49,12 +57,26 @@ public:
     using SessionCallback = std::function<void(const Session&)>;
 
 
+    /*!
+     * @brief Source of the current time, sessions are used and expire according to it
+     */
+    using Clock = std::function<Session::Timepoint()>;
+
+
     /*!
      * @brief Default constructor
      *
      * Session manager keeps tracking sessions. Sessions are not persistent.
      */
-    SessionManager() = default;
+    SessionManager();
+
+
+    /*!
+     * @brief Constructor with the source of the current time, lets tests expire sessions without waiting
+     *
+     * @param clock Source of the current time
+     */
+    explicit SessionManager(Clock clock);
 
 
     /*!
@@ -108,12 +130,19 @@ public:
 
     /*!
      * Removes sessions which exceeded session timeout.
+     *
+     * @return Number of sessions checked, i.e. scheduled in the processed slots of the timer wheel.
      */
-    void remove_outdated_sessions(void);
+    std::size_t remove_outdated_sessions(void);
 
 
 private:
     using SessionMap = std::map<std::uint64_t, Session>;
+    using TokenMap = std::unordered_map<std::string, SessionMap::iterator>;
+    using Tick = std::chrono::seconds::rep;
+
+    /*! @brief Number of one second slots of the timer wheel */
+    static constexpr std::size_t WHEEL_SLOTS = 256;
 
 
     /*!
@@ -122,8 +151,29 @@ private:
     void update_next_id(void);
 
 
+    /*!
+     * Remove session and its token.
+     */
+    void erase(SessionMap::iterator it);
+
+
+    /*!
+     * Put session into the timer wheel slot of its expiration time.
+     */
+    void schedule(const Session& session, const std::chrono::seconds& session_timeout);
+
+
+    const Clock m_clock;
     SessionMap m_sessions{};
-    mutable std::mutex m_mutex{};
+    TokenMap m_tokens{};
+    mutable std::shared_timed_mutex m_mutex{};
+
+    /*! @brief Session IDs by expiration tick, modulo number of slots */
+    std::vector<std::vector<std::uint64_t>> m_wheel;
+    /*! @brief Last tick of the timer wheel processed */
+    Tick m_wheel_tick{};
+    /*! @brief Session timeout used to schedule the sessions */
+    std::chrono::seconds m_wheel_timeout{};
 
     /*! @brief Last assigned ID */
     std::uint64_t m_id{};
@@ -0,0 +1,93 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#pragma once
+
+#include "agent-framework/module/managers/utils/read_tracker.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace psme {
+namespace rest {
+namespace server {
+
+/*!
+ * @brief Strong entity tags of GET responses derived from modification epochs of the model.
+ *
+ * Entity tag of a response is computed from the modification epochs of all model tables read
+ * while the response was built. The tables are remembered with the tag, so the tag of the
+ * next request for the same resource can be validated (and If-None-Match answered) without
+ * building the response, as long as none of these tables has been modified.
+ */
+class EntityTags {
+public:
+    using Dependencies = agent_framework::module::ReadTracker::Dependencies;
+
+    /*! @brief Maximum number of remembered tags, stale tags are dropped when it is exceeded */
+    static constexpr std::size_t MAX_ENTRIES = 4096;
+
+    EntityTags();
+
+    /*!
+     * @brief Get entity tag of a resource which is still valid
+     * @param key Resource URL with query parameters
+     * @return Entity tag, empty if the resource has no tag or the tag is no longer valid
+     */
+    std::string get(const std::string& key) const;
+
+    /*!
+     * @brief Compute entity tag of a resource and remember it
+     * @param key Resource URL with query parameters
+     * @param dependencies Tables read while the resource was built
+     * @return Computed entity tag
+     */
+    std::string put(const std::string& key, const Dependencies& dependencies);
+
+    /*!
+     * @brief Forget tags of a modified resource, its parents and its subordinate resources
+     * @param url URL of the modified resource
+     */
+    void invalidate(const std::string& url);
+
+    /*!
+     * @brief Check if value of If-None-Match header matches the entity tag
+     * @param if_none_match Value of the header: "*" or comma separated list of (possibly weak) tags
+     * @param etag Entity tag of the resource
+     * @return true if the tag is listed in the header
+     */
+    static bool matches(const std::string& if_none_match, const std::string& etag);
+
+private:
+    struct Entry {
+        Dependencies dependencies{};
+        std::string etag{};
+    };
+
+    /* Entity tags of the resources are different in each run of the service */
+    const std::string m_instance;
+    mutable std::mutex m_mutex{};
+    std::unordered_map<std::string, Entry> m_entries{};
+};
+
+}
+}
+}
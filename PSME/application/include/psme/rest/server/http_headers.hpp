@@ -70,6 +70,18 @@ namespace Location {
 extern const char LOCATION[];
 }
 
+namespace ETag {
+/*! @brief ETag header constant */
+extern const char ETAG[];
+}
+
+namespace IfNoneMatch {
+/*! @brief If-None-Match header constant */
+extern const char IF_NONE_MATCH[];
+/*! @brief If-None-Match header value matching any entity tag */
+extern const char ANY[];
+}
+
 }
 }
 }
@@ -49,8 +49,13 @@
 #include "psme/rest/server/response.hpp"
 #include "psme/rest/server/methods_handler.hpp"
 #include "psme/rest/server/mux/matchers.hpp"
+#include "psme/rest/server/mux/route_trie.hpp"
+#include "psme/rest/server/entity_tags.hpp"
+#include "psme/rest/server/response_cache.hpp"
+#include "json-wrapper/json-wrapper.hpp"
 
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 
@@ -70,6 +75,20 @@ namespace server {
  * configured before the server is run with all endpoints registered.
  * The multiplexer must not be modified after running the HTTP server,
  * as its internal components will be accessible to all HTTP threads.
+ *
+ * Endpoint paths are compiled into a trie of segments when handlers are registered,
+ * so selecting a handler does not depend on the number of registered endpoints.
+ *
+ * Redfish query options ($expand, $select, $top, $skip) of GET requests are applied to the
+ * responses of the handlers. Expanded resources are obtained in-process from the GET handlers
+ * of their endpoints, so the client does not need a request for each of them.
+ *
+ * GET responses built from the model get strong entity tags (ETag header). If-None-Match
+ * requests for resources whose tables have not been modified are answered with 304 Not Modified
+ * without calling the handler. Their serialized bodies may also be kept in the response cache
+ * (disabled by default) and served without calling the handler until any of their tables is modified.
+ * Successful PATCH, POST, PUT and DELETE requests invalidate tags and cached responses of the
+ * modified resource, its parents and its subordinate resources.
  * */
 class Multiplexer : public agent_framework::generic::Singleton<Multiplexer> {
 
@@ -173,6 +192,24 @@ public:
     Parameters try_get_params(const std::string& path, const std::string& path_template) const;
 
 
+    /*!
+     * @brief Get path templates of all registered handlers
+     *
+     * @return path templates in order of registration
+     */
+    std::vector<std::string> get_path_templates() const;
+
+
+    /*!
+     * @brief Get cache of GET responses, used to enable the cache and read its statistics
+     *
+     * @return the response cache
+     */
+    ResponseCache& get_response_cache() {
+        return m_response_cache;
+    }
+
+
 private:
     const PathHandlerCandidate& select_handler(const std::vector<std::string>& segments, const std::string& uri) const;
 
@@ -181,7 +218,30 @@ private:
                            const PathHandlerCandidate& candidate) const;
 
 
+    const PathHandlerCandidate& get_candidate(const std::string& path_template) const;
+
+
+    void execute_get(MethodsHandler& handler, const Request& request, Response& response);
+
+
+    void invalidate(const std::string& url);
+
+
+    void apply_query_options(const Request& request, Response& response);
+
+
+    void expand_references(const Request& request, json::Json& json, std::uint32_t levels, bool in_links,
+                           std::vector<std::string>& expanded_urls);
+
+
+    bool get_resource(const Request& request, const std::string& url, json::Json& resource);
+
+
     PathHandlerCandidates m_handler_candidates{};
+    std::unordered_map<std::string, std::size_t> m_candidate_indexes{};
+    mux::RouteTrie m_routes{};
+    EntityTags m_entity_tags{};
+    ResponseCache m_response_cache{};
 
     PluginHandler m_plugin_pre_handlers{};
     PluginHandler m_plugin_post_handlers{};
@@ -44,6 +44,7 @@
 #include "psme/rest/server/mux/empty_matcher.hpp"
 #include "psme/rest/server/mux/static_matcher.hpp"
 #include "psme/rest/server/mux/regex_matcher.hpp"
+#include "psme/rest/server/mux/numeric_matcher.hpp"
 #include "psme/rest/server/mux/variable_matcher.hpp"
 
 #include <string>
@@ -0,0 +1,87 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#pragma once
+
+#include "psme/rest/server/mux/segment_matcher.hpp"
+
+#include <string>
+
+namespace psme {
+namespace rest {
+namespace server {
+namespace mux {
+
+/*!
+ * @brief Matches non empty path segments consisting of decimal digits only.
+ *
+ * Replaces RegexMatcher for the "[0-9]+" expression used by all numeric resource IDs,
+ * so matching them does not run the regex engine.
+ */
+class NumericMatcher : public SegmentMatcher {
+public:
+    ~NumericMatcher();
+
+    /*!
+     * @brief Constructs a numeric matcher.
+     *
+     * @param variable_name the name of the REST param this segment matches.
+     */
+    explicit NumericMatcher(const std::string& variable_name);
+
+    /*!
+     * @brief Checks whether a segment of path is a decimal number.
+     *
+     * @param path_segment the segment of path to check.
+     *
+     * @return true if the path segment is not empty and consists of digits only, false otherwise
+     */
+    virtual bool check_match(const std::string& path_segment) override;
+
+    /*!
+     * @brief Appends any parameters extracted from the path segment to a list of params.
+     *
+     * This is used to propagate any REST parameters.
+     *
+     * @param params the list of parameters to append to
+     * @param path_segment the segment of path the variable should be extracted from
+     */
+    virtual void get_param(Parameters& params, const std::string& path_segment) override;
+
+    /*!
+     * @brief Checks whether a string is a non empty decimal number.
+     *
+     * @param path_segment the segment of path to check.
+     *
+     * @return true if the path segment is not empty and consists of digits only, false otherwise
+     */
+    static bool is_number(const std::string& path_segment);
+
+    /*! @brief Regular expression replaced by this matcher */
+    static constexpr const char REGEX[] = "[0-9]+";
+
+private:
+    const std::string m_variable_name;
+};
+
+}
+}
+}
+}
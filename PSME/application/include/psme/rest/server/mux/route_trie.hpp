@@ -0,0 +1,89 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#pragma once
+
+#include "psme/rest/server/mux/segment_matcher.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psme {
+namespace rest {
+namespace server {
+namespace mux {
+
+/*!
+ * @brief Routes compiled into a tree of path segments.
+ *
+ * Each node has static children (looked up by the exact segment), a numeric child
+ * (for "{name:[0-9]+}" segments, of any variable name) and children matched by segment
+ * matchers (other regexes, variables and empty segments). Looking up a path costs
+ * O(path depth) as long as static segments and numeric IDs are not ambiguous.
+ *
+ * When several routes match the path, the one inserted first is found, exactly as
+ * if routes were checked one by one in order of insertion.
+ */
+class RouteTrie {
+public:
+    /*! @brief Index returned when no route matches */
+    static constexpr std::size_t NO_ROUTE = std::numeric_limits<std::size_t>::max();
+
+    RouteTrie();
+
+    ~RouteTrie();
+
+    RouteTrie(const RouteTrie&) = delete;
+    RouteTrie& operator=(const RouteTrie&) = delete;
+
+    /*!
+     * @brief Adds route to the trie.
+     *
+     * @param path Endpoint path template
+     * @param route Index of the route, returned when the route is found
+     */
+    void insert(const std::string& path, std::size_t route);
+
+    /*!
+     * @brief Finds route of the lowest index matching the path
+     *
+     * @param request_segments The path split into segments
+     * @return Index of the route, NO_ROUTE if none matches
+     */
+    std::size_t find(const std::vector<std::string>& request_segments) const;
+
+private:
+    struct Node;
+    using NodePtr = std::unique_ptr<Node>;
+
+    static void find(const Node& node, const std::vector<std::string>& request_segments,
+                     std::size_t depth, std::size_t& found);
+
+    NodePtr m_root;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,162 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#pragma once
+
+#include "agent-framework/module/utils/optional_field.hpp"
+#include "psme/rest/server/parameters.hpp"
+#include "json-wrapper/json-wrapper.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace psme {
+namespace rest {
+namespace server {
+
+/*!
+ * @brief Redfish query parameters ($expand, $select, $top and $skip) of a GET request.
+ *
+ * Options are parsed from the query string of the request by the Multiplexer and applied
+ * to the body of the response produced by the endpoint.
+ */
+class QueryOptions {
+public:
+    /*! @brief Which references are replaced by the referenced resources */
+    enum class ExpandType {
+        NONE,
+        /*! @brief "*": all references */
+        ALL,
+        /*! @brief ".": references not placed in the Links property */
+        SUBORDINATE,
+        /*! @brief "~": references placed in the Links property */
+        LINKS
+    };
+
+    static constexpr const char EXPAND[] = "$expand";
+    static constexpr const char SELECT[] = "$select";
+    static constexpr const char TOP[] = "$top";
+    static constexpr const char SKIP[] = "$skip";
+
+    /*! @brief Maximum value of the $levels expand option */
+    static constexpr std::uint32_t MAX_EXPAND_LEVELS = 3;
+
+    /*!
+     * @brief Parses query options from the query parameters of a request.
+     *
+     * Parameters not defined by Redfish are ignored.
+     *
+     * @param query Query parameters of the request.
+     * @return Parsed query options.
+     * @throw ServerException if a value of any option is invalid.
+     */
+    static QueryOptions from_query(const Parameters& query);
+
+    /*!
+     * @brief Checks whether any option is set.
+     * @return true if no option is set, false otherwise.
+     */
+    bool empty() const;
+
+    ExpandType get_expand() const {
+        return m_expand;
+    }
+
+    std::uint32_t get_expand_levels() const {
+        return m_expand_levels;
+    }
+
+    /*!
+     * @brief Sets expand option.
+     * @param expand Type of expanded references.
+     * @param levels Number of levels of the expanded resources.
+     */
+    void set_expand(ExpandType expand, std::uint32_t levels = 1) {
+        m_expand = expand;
+        m_expand_levels = levels;
+    }
+
+    /*!
+     * @brief Get selected properties, nested properties are separated with '/'.
+     * @return Selected properties, empty if all properties are returned.
+     */
+    const std::vector<std::string>& get_select() const {
+        return m_select;
+    }
+
+    void set_select(const std::vector<std::string>& select) {
+        m_select = select;
+    }
+
+    const OptionalField<std::uint64_t>& get_top() const {
+        return m_top;
+    }
+
+    void set_top(const OptionalField<std::uint64_t>& top) {
+        m_top = top;
+    }
+
+    const OptionalField<std::uint64_t>& get_skip() const {
+        return m_skip;
+    }
+
+    void set_skip(const OptionalField<std::uint64_t>& skip) {
+        m_skip = skip;
+    }
+
+    /*!
+     * @brief Applies $skip and $top options to members of a collection.
+     *
+     * Members@odata.count still holds the number of all members. If any members are left behind
+     * the returned page, Members@odata.nextLink with the URL of the next page is added.
+     *
+     * @param[in,out] json Collection to be paged, other resources are left untouched.
+     * @param url URL of the collection.
+     */
+    void apply_paging(json::Json& json, const std::string& url) const;
+
+    /*!
+     * @brief Removes properties which are not selected.
+     *
+     * OData annotations of the resource (@odata.id, @odata.type, ...) are always kept.
+     *
+     * @param[in,out] json Resource to be trimmed.
+     */
+    void apply_select(json::Json& json) const;
+
+    /*!
+     * @brief Checks whether a reference should be expanded.
+     * @param in_links true if the reference is placed in the Links property.
+     * @return true if the reference is expanded.
+     */
+    bool is_expanded(bool in_links) const;
+
+private:
+    ExpandType m_expand{ExpandType::NONE};
+    std::uint32_t m_expand_levels{1};
+    std::vector<std::string> m_select{};
+    OptionalField<std::uint64_t> m_top{};
+    OptionalField<std::uint64_t> m_skip{};
+};
+
+}
+}
+}
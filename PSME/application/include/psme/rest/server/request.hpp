@@ -43,6 +43,7 @@
 
 #include "psme/rest/server/methods.hpp"
 #include "psme/rest/server/parameters.hpp"
+#include "psme/rest/server/query_options.hpp"
 
 #include <unordered_map>
 
@@ -122,6 +123,12 @@ public:
      * */
     void set_secure(bool is_request_secure);
 
+    /*!
+     * @brief Set Redfish query options parsed from the query parameters.
+     * @param query_options parsed query options.
+     * */
+    void set_query_options(const QueryOptions& query_options);
+
     /*!
      * @brief Get the HTTP method of the request.
      * @return HTTP method of the request.
@@ -165,6 +172,12 @@ public:
      * */
     bool is_secure() const;
 
+    /*!
+     * @brief Get Redfish query options of the request.
+     * @return Query options, empty if they were not requested.
+     * */
+    const QueryOptions& get_query_options() const;
+
 public:
     //  -----  public members  -----
     Parameters params{};
@@ -181,6 +194,7 @@ private:
     HeaderList m_headers{};
     std::string m_body{};
     bool m_is_secure{false};
+    QueryOptions m_query_options{};
 };
 
 }
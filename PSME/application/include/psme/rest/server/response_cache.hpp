@@ -0,0 +1,124 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#pragma once
+
+#include "agent-framework/module/managers/utils/read_tracker.hpp"
+#include "psme/rest/server/response.hpp"
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace psme {
+namespace rest {
+namespace server {
+
+/*!
+ * @brief Cache of serialized GET responses.
+ *
+ * A response is cached together with the modification epochs of all model tables read while it
+ * was built. Cached response is served only if none of these tables has been modified since, so
+ * entries are invalidated selectively whenever agent notifications (or polling) change the model.
+ * Resources modified by local PATCH/POST/PUT/DELETE requests are invalidated explicitly.
+ *
+ * The cache is disabled until its capacity is set, least recently used responses are dropped
+ * when the capacity is exceeded.
+ */
+class ResponseCache {
+public:
+    using Dependencies = agent_framework::module::ReadTracker::Dependencies;
+
+    /*! @brief Cache usage counters */
+    struct Statistics {
+        std::uint64_t hits{};
+        std::uint64_t misses{};
+        std::uint64_t invalidations{};
+        std::size_t entries{};
+    };
+
+    /*!
+     * @brief Set maximum number of cached responses
+     * @param max_entries Capacity of the cache, 0 disables the cache
+     */
+    void set_max_entries(std::size_t max_entries);
+
+    /*!
+     * @brief Check if the cache is enabled
+     * @return true if responses are cached
+     */
+    bool is_enabled() const;
+
+    /*!
+     * @brief Get cached response which is still valid
+     * @param key Access context, resource URL and query parameters of the request
+     * @param[out] response Response filled with cached status, headers and body
+     * @return true on cache hit
+     */
+    bool get(const std::string& key, Response& response);
+
+    /*!
+     * @brief Store a response in the cache
+     * @param key Access context, resource URL and query parameters of the request
+     * @param url URL of the resource, used for invalidation
+     * @param dependencies Tables read while the response was built
+     * @param response Response to be cached
+     */
+    void put(const std::string& key, const std::string& url, const Dependencies& dependencies,
+             const Response& response);
+
+    /*!
+     * @brief Drop cached responses of a modified resource, its parents and its subordinate resources
+     * @param url URL of the modified resource
+     */
+    void invalidate(const std::string& url);
+
+    /*!
+     * @brief Get cache usage counters
+     * @return Counters of hits, misses and invalidated responses
+     */
+    Statistics get_statistics() const;
+
+private:
+    struct Entry {
+        std::string key{};
+        std::string url{};
+        Dependencies dependencies{};
+        Response::HeaderList headers{};
+        std::string body{};
+    };
+
+    using Entries = std::list<Entry>;
+
+    void erase(Entries::iterator entry);
+
+    mutable std::mutex m_mutex{};
+    std::size_t m_max_entries{0};
+    /* Most recently used entries first */
+    Entries m_entries{};
+    std::unordered_map<std::string, Entries::iterator> m_index{};
+    Statistics m_statistics{};
+};
+
+}
+}
+}
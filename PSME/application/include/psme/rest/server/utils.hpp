@@ -61,6 +61,16 @@ std::string build_location_header(const std::string& host_header,
                         const std::string& resource_path,
                         const std::uint16_t port = 0);
 
+/*!
+ * @brief Checks whether resources are placed in the same branch of the resource tree.
+ *
+ * @param url Path to resource.
+ * @param other_url Path to another resource.
+ *
+ * @return true if the paths are equal or one of them is a parent (at any level) of the other
+ **/
+bool is_related_url(const std::string& url, const std::string& other_url);
+
 }
 }
 }
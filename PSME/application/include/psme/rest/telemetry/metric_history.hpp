@@ -0,0 +1,168 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file metric_history.hpp
+ * @brief Bounded in-memory history of metric values
+ * */
+
+#pragma once
+
+#include "agent-framework/module/managers/utils/read_tracker.hpp"
+#include "json-wrapper/json-wrapper.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psme {
+namespace rest {
+namespace telemetry {
+
+/*!
+ * @brief Time series of metric values, stored per metric in compactly encoded chunks.
+ *
+ * Samples of a metric are appended to its last chunk, a new chunk is started after SAMPLES_PER_CHUNK samples.
+ * Within a chunk timestamps are stored as millisecond deltas and each value is stored relative to the previous
+ * one: a repeated value takes no space besides the timestamp, integers are stored as zigzag deltas, doubles are
+ * XORed with the previous double, so slowly changing readings take a few bytes per sample.
+ *
+ * The history is bounded by the retention period and by the memory used by the chunks. Chunks are dropped
+ * in order of creation, the oldest first, whenever a sample is added.
+ *
+ * The history is disabled (samples are ignored) until the memory limit is set. Reads of the history are
+ * recorded by the ReadTracker as reads of a single table modified whenever a sample is added or dropped.
+ */
+class MetricHistory {
+public:
+    using Clock = std::chrono::system_clock;
+    using TimePoint = Clock::time_point;
+
+    /*! @brief Number of samples of a metric encoded in a single chunk */
+    static constexpr std::uint32_t SAMPLES_PER_CHUNK = 128;
+
+    /*! @brief Value of a metric at a given time */
+    struct Sample {
+        TimePoint timestamp{};
+        json::Json value{};
+    };
+
+    using Samples = std::vector<Sample>;
+
+    /*! @brief Size of the history */
+    struct Statistics {
+        std::uint64_t samples{};
+        std::size_t metrics{};
+        std::size_t chunks{};
+        std::size_t memory_bytes{};
+        std::uint64_t dropped_chunks{};
+    };
+
+    /*!
+     * @brief Set limits of the history, samples exceeding the new limits are dropped
+     * @param retention Samples older than the retention period are dropped
+     * @param max_memory_bytes Memory used by the chunks, 0 disables the history
+     */
+    void set_limits(std::chrono::seconds retention, std::size_t max_memory_bytes);
+
+    /*!
+     * @brief Check if the history is enabled
+     * @return true if samples are stored
+     */
+    bool is_enabled() const;
+
+    /*!
+     * @brief Append a sample of a metric, samples of a metric are expected in order of timestamps
+     * @param metric_uuid UUID of the metric
+     * @param value Value of the metric
+     * @param timestamp Time of the sample
+     */
+    void add_sample(const std::string& metric_uuid, const json::Json& value, TimePoint timestamp = Clock::now());
+
+    /*!
+     * @brief Get stored samples of a metric
+     * @param metric_uuid UUID of the metric
+     * @param from Samples older than this time are skipped
+     * @return Samples in order of timestamps, with millisecond precision
+     */
+    Samples get_samples(const std::string& metric_uuid, TimePoint from = TimePoint::min()) const;
+
+    /*!
+     * @brief Get UUIDs of metrics with stored samples
+     * @return UUIDs of metrics in no particular order
+     */
+    std::vector<std::string> get_metric_uuids() const;
+
+    /*!
+     * @brief Get size of the history
+     * @return Number of stored samples, chunks and the memory they use
+     */
+    Statistics get_statistics() const;
+
+    /*! @brief Drop all samples */
+    void clear();
+
+private:
+    struct Chunk {
+        std::uint64_t id{};
+        std::int64_t first_ms{};
+        std::int64_t last_ms{};
+        std::uint32_t samples{};
+        std::vector<std::uint8_t> data{};
+    };
+
+    /*! @brief Chunks of a metric and state of the encoder of its last chunk */
+    struct Series {
+        std::deque<Chunk> chunks{};
+        json::Json last_value{};
+        std::int64_t last_integer{};
+        std::uint64_t last_double{};
+    };
+
+    static std::size_t get_memory_usage(const Chunk& chunk);
+
+    static void encode(Series& series, const json::Json& value, std::int64_t timestamp_ms);
+
+    static void decode(const Chunk& chunk, std::int64_t from_ms, Samples& samples);
+
+    void drop_oldest_chunk();
+
+    void enforce_limits(std::int64_t now_ms);
+
+    std::chrono::milliseconds m_retention{};
+    std::size_t m_max_memory_bytes{};
+    std::size_t m_memory_bytes{};
+    std::uint64_t m_samples{};
+    std::uint64_t m_next_chunk_id{};
+    std::uint64_t m_dropped_chunks{};
+    agent_framework::module::ReadTracker::Epoch m_modification_epoch{1};
+    mutable std::mutex m_mutex{};
+    /* Series are never removed (except by clear), so pointers to them stay valid */
+    std::unordered_map<std::string, Series> m_series{};
+    /* All chunks in order of creation */
+    std::deque<std::pair<Series*, std::uint64_t>> m_chunks{};
+};
+
+}
+}
+}
@@ -0,0 +1,111 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file metric_reports.hpp
+ * @brief Metric reports generated from the history of metric values
+ * */
+
+#pragma once
+
+#include "agent-framework/generic/singleton.hpp"
+#include "psme/rest/telemetry/metric_history.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace psme {
+namespace rest {
+namespace telemetry {
+
+/*! @brief Configured metric report */
+struct ReportDefinition {
+    enum class Type {
+        Periodic,
+        OnChange
+    };
+
+    std::string id{};
+    Type type{Type::Periodic};
+    std::chrono::seconds interval{};
+};
+
+
+/*!
+ * @brief History of metric values and reports generated from it.
+ *
+ * The history is fed with values of metrics fetched from the agents. Reports are generated on request:
+ * - Periodic report contains all values of metrics sampled during the last complete report interval,
+ * - OnChange report contains the values which differ from the previous values of the same metrics,
+ *   from the whole history.
+ */
+class MetricReports final : public agent_framework::generic::Singleton<MetricReports> {
+public:
+    virtual ~MetricReports();
+
+    /*!
+     * @brief Configure the history and the reports
+     * @param config Configuration of the telemetry history, the history is disabled if it is not enabled
+     */
+    void configure(const json::Json& config);
+
+    /*!
+     * @brief Get the history of metric values
+     * @return History of metric values
+     */
+    MetricHistory& get_history() {
+        return m_history;
+    }
+
+    /*!
+     * @brief Get configured reports
+     * @return Configured reports
+     */
+    const std::vector<ReportDefinition>& get_definitions() const {
+        return m_definitions;
+    }
+
+    /*!
+     * @brief Find configured report
+     * @param id Id of the report
+     * @return Report definition or nullptr if there is no such report
+     */
+    const ReportDefinition* find_definition(const std::string& id) const;
+
+    /*!
+     * @brief Generate content of a report: ReportSequence, Timestamp and MetricValues properties
+     * @param definition Report definition
+     * @param now Time of the report generation
+     * @return Report properties
+     */
+    json::Json make_report(const ReportDefinition& definition,
+                           MetricHistory::TimePoint now = MetricHistory::Clock::now()) const;
+
+private:
+    friend class agent_framework::generic::Singleton<MetricReports>;
+
+    MetricReports() = default;
+
+    MetricHistory m_history{};
+    std::vector<ReportDefinition> m_definitions{};
+};
+
+}
+}
+}
@@ -25,6 +25,7 @@
 #include "psme/rest/model/handlers/handler_manager.hpp"
 #include "psme/rest/model/handlers/generic_handler_deps.hpp"
 #include "psme/rest/model/handlers/handler_interface.hpp"
+#include "agent-framework/module/managers/utils/health_rollup_index.hpp"
 #include <algorithm>
 
 
@@ -52,7 +53,8 @@ public:
     /*!
      * @brief Computes Health rollup starting from node identified by uuid
      *
-     * Executes visitor pattern implemented by GenericHandler.
+     * Reads the rollup from the HealthRollupIndex if it is enabled,
+     * executes visitor pattern implemented by GenericHandler otherwise.
      *
      * @param[in] uuid Node for which health rollup is to be computed
      * @param[in] filter Optional parameter that limits rollup computation to given component type
@@ -62,6 +64,11 @@ public:
         const Uuid& uuid,
         const Component filter = Component::None) {
 
+        const auto* index = agent_framework::module::HealthRollupIndex::get_instance();
+        if (index->is_enabled()) {
+            return index->get(uuid, filter);
+        }
+
         my_uuid = uuid;
         component_filter = filter;
         auto handler = psme::rest::model::handler::HandlerManager::get_instance()->get_handler(T::get_component());
@@ -33,6 +33,8 @@
 #include "configuration/configuration_validator.hpp"
 #include "agent-framework/version.hpp"
 #include "agent-framework/module/service_uuid.hpp"
+#include "agent-framework/module/managers/generic_manager_registry.hpp"
+#include "agent-framework/module/managers/utils/health_rollup_index.hpp"
 #include "agent-framework/logger_loader.hpp"
 #include "agent-framework/eventing/events_queue.hpp"
 #include "ssdp/ssdp_service.hpp"
@@ -95,6 +97,22 @@ void App::init_database() {
     if (m_configuration.value("database", json::Json::object()).value("location", json::Json()).is_string()) {
         database::Database::set_default_location(m_configuration["database"]["location"].get<std::string>());
     }
+    if (m_configuration.value("database", json::Json::object()).value("backend", json::Json()).is_string()) {
+        const auto backend = m_configuration["database"]["backend"].get<std::string>();
+        if (!database::Database::set_default_backend(backend)) {
+            log_warning("app", "Unknown database backend " << backend << ", file database is used.");
+        }
+    }
+}
+
+void App::init_model() {
+    // Health rollups are maintained when the tables are modified, so they are not computed on each GET
+    agent_framework::module::HealthRollupIndex::get_instance()->set_enabled(true);
+    const auto& model = m_configuration.value("model", json::Json::object());
+    if (model.value("snapshot-reads", false)) {
+        log_info("app", "Model tables serve reads from snapshots.");
+        agent_framework::module::GenericManagerRegistry::get_instance()->set_snapshot_reads(true);
+    }
 }
 
 void App::init_logger() {
@@ -155,6 +173,7 @@ void App::init() {
     try {
         init_database();
         init_logger();
+        init_model();
         agent_framework::module::ServiceUuid::get_instance();
         init_network_change_notifier();
         init_ssdp_service();
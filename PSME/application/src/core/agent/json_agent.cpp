@@ -26,6 +26,7 @@
 #include "psme/rest/model/handlers/handler_manager.hpp"
 #include "psme/rest/server/error/error_factory.hpp"
 #include "json-rpc/connectors/http_client_connector.hpp"
+#include "configuration/configuration.hpp"
 
 
 
@@ -33,14 +34,27 @@ using namespace agent_framework;
 using namespace psme::core::agent;
 using namespace psme::rest::error;
 
+namespace {
+
+/*! @brief Gets maximal number of concurrent requests to a single agent */
+std::size_t get_max_agent_connections() {
+    constexpr const std::size_t DEFAULT_AGENT_CONNECTIONS = 4;
+    const json::Json& configuration = configuration::Configuration::get_instance().to_json();
+    const auto connections = configuration.value("registration", json::Json::object())
+        .value("agent-connections", static_cast<int>(DEFAULT_AGENT_CONNECTIONS));
+    return connections > 0 ? static_cast<std::size_t>(connections) : DEFAULT_AGENT_CONNECTIONS;
+}
+
+}
 
 JsonAgent::JsonAgent(const std::string& gami_id,
                      const std::string& ipv4_address,
                      const int port) :
     Agent{gami_id, ipv4_address, port},
-    m_connector{new json_rpc::HttpClientConnector(make_connection_url(ipv4_address, port))},
-    m_invoker{new json_rpc::JsonRpcRequestInvoker()},
-    m_client{m_connector, m_invoker} {}
+    m_connector{new json_rpc::HttpClientConnector(make_connection_url(ipv4_address, port),
+                                                  json_rpc::HttpClientConnector::DEFAULT_TIMEOUT_MS,
+                                                  get_max_agent_connections())},
+    m_client{m_connector} {}
 
 
 JsonAgent::JsonAgent(const std::string& gami_id,
@@ -50,9 +64,10 @@ JsonAgent::JsonAgent(const std::string& gami_id,
                      const std::string& vendor,
                      const Capabilities& caps) :
     Agent{gami_id, ipv4_address, port, version, vendor, caps},
-    m_connector{new json_rpc::HttpClientConnector(make_connection_url(ipv4_address, port))},
-    m_invoker{new json_rpc::JsonRpcRequestInvoker()},
-    m_client{m_connector, m_invoker} {}
+    m_connector{new json_rpc::HttpClientConnector(make_connection_url(ipv4_address, port),
+                                                  json_rpc::HttpClientConnector::DEFAULT_TIMEOUT_MS,
+                                                  get_max_agent_connections())},
+    m_client{m_connector} {}
 
 
 JsonAgent::~JsonAgent() {}
@@ -29,9 +29,10 @@ using namespace agent_framework::exceptions;
 
 json::Json RpcClient::CallMethod(const std::string& name, const json::Json& parameter) {
     try {
-        m_invoker->prepare_method(name, parameter);
-        m_invoker->call(m_connector);
-        return m_invoker->get_result();
+        json_rpc::JsonRpcRequestInvoker invoker{};
+        invoker.prepare_method(name, parameter);
+        invoker.call(m_connector);
+        return invoker.get_result();
     }
     catch (const json_rpc::JsonRpcException& ex) {
         const auto error_code = static_cast<ErrorCode>(ex.get_code());
@@ -76,6 +76,7 @@ const char MESSAGE_REGISTRY_FILE_ID[] = "messageRegistryFileId";
 const char PSU_ID[] = "psuId";
 const char METRIC_DEFINITION_ID[] = "metricDefinitionId";
 const char METRIC_REPORT_DEFINITION_ID[] = "metricReportDefinitionId";
+const char METRIC_REPORT_ID[] = "metricReportId";
 const char TRIGGER_ID[] = "triggerId";
 const char SESSION_ID[] = "sessionId";
 const char ACCOUNT_ID[] = "accountId";
@@ -167,6 +168,7 @@ const char RESOLUTION[] = "Resolution";
 
 namespace Collection {
 const char ODATA_COUNT[] = "Members@odata.count";
+const char ODATA_NEXT_LINK[] = "Members@odata.nextLink";
 const char MEMBERS[] = "Members";
 }
 
@@ -186,6 +188,14 @@ const char TELEMETRY_SERVICE[] = "TelemetryService";
 const char UPDATE_SERVICE[] = "UpdateService";
 const char SERVICE[] = "Service";
 const char ACCOUNT_SERVICE[] = "AccountService";
+const char PROTOCOL_FEATURES_SUPPORTED[] = "ProtocolFeaturesSupported";
+const char EXPAND_QUERY[] = "ExpandQuery";
+const char EXPAND_ALL[] = "ExpandAll";
+const char LEVELS[] = "Levels";
+const char NO_LINKS[] = "NoLinks";
+const char MAX_LEVELS[] = "MaxLevels";
+const char SELECT_QUERY[] = "SelectQuery";
+const char FILTER_QUERY[] = "FilterQuery";
 }
 
 namespace Redfish {
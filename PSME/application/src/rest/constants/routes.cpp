@@ -791,6 +791,18 @@ const std::string Routes::METRIC_REPORT_DEFINITION_PATH =
         .append_regex(constants::PathParam::METRIC_REPORT_DEFINITION_ID, constants::PathParam::ID_REGEX)
         .build();
 
+// "/redfish/v1/TelemetryService/MetricReports"
+const std::string Routes::METRIC_REPORTS_COLLECTION_PATH =
+    endpoint::PathBuilder(TELEMETRY_SERVICE_PATH)
+        .append(constants::TelemetryService::METRIC_REPORTS)
+        .build();
+
+// "/redfish/v1/TelemetryService/MetricReports/{metricReportId}"
+const std::string Routes::METRIC_REPORT_PATH =
+    endpoint::PathBuilder(METRIC_REPORTS_COLLECTION_PATH)
+        .append_regex(constants::PathParam::METRIC_REPORT_ID, constants::PathParam::STRING_ID_REGEX)
+        .build();
+
 // "/redfish/v1/TelemetryService/Triggers"
 const std::string Routes::TRIGGERS_COLLECTION_PATH =
     endpoint::PathBuilder(TELEMETRY_SERVICE_PATH)
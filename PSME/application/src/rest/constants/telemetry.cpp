@@ -26,6 +26,7 @@ namespace constants {
 namespace TelemetryService {
 const char METRIC_DEFINITIONS[] = "MetricDefinitions";
 const char METRIC_REPORT_DEFINITIONS[] = "MetricReportDefinitions";
+const char METRIC_REPORTS[] = "MetricReports";
 const char TRIGGERS[] = "Triggers";
 }
 
@@ -75,6 +76,14 @@ const char REPORT_INTERVAL_MS[] = "ReportIntervalMilliseconds";
 const char TRANSMIT_FORMAT[] = "TransmitFormat";
 }
 
+namespace MetricReport {
+const char REPORT_SEQUENCE[] = "ReportSequence";
+const char METRIC_VALUES[] = "MetricValues";
+const char METRIC_ID[] = "MetricId";
+const char METRIC_PROPERTY[] = "MetricProperty";
+const char TIMESTAMP[] = "Timestamp";
+}
+
 namespace Trigger {
 const char TRIGGER_TYPE[] = "TriggerType";
 const char TRIGGER_ACTIONS[] = "TriggerActions";
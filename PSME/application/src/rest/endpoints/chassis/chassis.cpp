@@ -208,34 +208,34 @@ void fill_links(const agent_framework::model::Chassis& chassis, json::Json& r) {
     // systems and storage subsystems in chassis
     auto& system_manager = agent_framework::module::get_manager<agent_framework::model::System>();
     auto& storage_manager = agent_framework::module::get_manager<agent_framework::model::StorageSubsystem>();
-    auto system_uuids = system_manager.get_keys();
-    for (const auto& system_uuid : system_uuids) {
-        auto system = system_manager.get_entry(system_uuid);
+    std::vector<std::pair<std::string, std::uint64_t>> systems_in_chassis{};
+    system_manager.for_each([&chassis, &systems_in_chassis](const agent_framework::model::System& system) {
         if (system.get_chassis() == chassis.get_uuid()) {
-            json::Json link = json::Json();
-            link[Common::ODATA_ID] = endpoint::PathBuilder(PathParam::BASE_URL)
+            systems_in_chassis.emplace_back(system.get_uuid(), system.get_id());
+        }
+    });
+    for (const auto& system : systems_in_chassis) {
+        json::Json link = json::Json();
+        link[Common::ODATA_ID] = endpoint::PathBuilder(PathParam::BASE_URL)
+            .append(constants::Root::SYSTEMS)
+            .append(system.second).build();
+        r[Common::LINKS][constants::Chassis::COMPUTER_SYSTEMS].push_back(std::move(link));
+
+        for (const auto storage_id : storage_manager.get_ids(system.first)) {
+            json::Json storage_link = json::Json();
+            storage_link[Common::ODATA_ID] = endpoint::PathBuilder(PathParam::BASE_URL)
                 .append(constants::Root::SYSTEMS)
-                .append(system.get_id()).build();
-            r[Common::LINKS][constants::Chassis::COMPUTER_SYSTEMS].push_back(std::move(link));
-
-            for (const auto storage_id : storage_manager.get_ids(system.get_uuid())) {
-                json::Json storage_link = json::Json();
-                storage_link[Common::ODATA_ID] = endpoint::PathBuilder(PathParam::BASE_URL)
-                    .append(constants::Root::SYSTEMS)
-                    .append(system.get_id())
-                    .append(constants::System::STORAGE)
-                    .append(storage_id).build();
-                r[Common::LINKS][constants::Chassis::STORAGE].push_back(std::move(storage_link));
-            }
+                .append(system.second)
+                .append(constants::System::STORAGE)
+                .append(storage_id).build();
+            r[Common::LINKS][constants::Chassis::STORAGE].push_back(std::move(storage_link));
         }
     }
 
 
     // switches in chassis
     auto& switch_manager = agent_framework::module::NetworkComponents::get_instance()->get_switch_manager();
-    auto switch_uuids = switch_manager.get_keys();
-    for (const auto& switch_uuid : switch_uuids) {
-        auto s = switch_manager.get_entry(switch_uuid);
+    switch_manager.for_each([&chassis, &r](const agent_framework::model::EthernetSwitch& s) {
         if (s.get_chassis() == chassis.get_uuid()) {
             json::Json link = json::Json();
             link[Common::ODATA_ID] = endpoint::PathBuilder(PathParam::BASE_URL)
@@ -244,7 +244,7 @@ void fill_links(const agent_framework::model::Chassis& chassis, json::Json& r) {
             r[Common::LINKS][Common::OEM][Common::RACKSCALE][constants::Chassis::ETHERNET_SWITCHES]
                 .push_back(std::move(link));
         }
-    }
+    });
 
 
     // drives in chassis
@@ -152,21 +152,28 @@ void add_links(const agent_framework::model::Drive& drive, json::Json& json) {
     }
 
     // fill UsedBy links
-    for (const auto& pool : agent_framework::module::get_manager<agent_framework::model::StoragePool>().get_entries()) {
-        for (const auto& source : pool.get_capacity_sources()) {
-            for (const auto& drive_uuid : source.get_providing_drives()) {
-                if (drive.get_uuid() == drive_uuid) {
-                    json::Json used_link = json::Json();
-                    try {
-                        used_link[Common::ODATA_ID] = psme::rest::endpoint::utils::get_component_url(
-                            agent_framework::model::enums::Component::StoragePool, pool.get_uuid());
-                        json[Common::OEM][Common::RACKSCALE][Drive::USED_BY].push_back(std::move(used_link));
-                    }
-                    catch (agent_framework::exceptions::InvalidUuid&) {
-                        log_error("rest", "Drive " + drive.get_uuid() + " is used by a non existent storage pool!");
+    std::vector<std::string> using_pools{};
+    agent_framework::module::get_manager<agent_framework::model::StoragePool>().for_each(
+        [&drive, &using_pools](const agent_framework::model::StoragePool& pool) {
+            for (const auto& source : pool.get_capacity_sources()) {
+                for (const auto& drive_uuid : source.get_providing_drives()) {
+                    if (drive.get_uuid() == drive_uuid) {
+                        using_pools.emplace_back(pool.get_uuid());
                     }
                 }
             }
+        });
+
+    // URLs are built outside of the visitor, it must not lock other tables
+    for (const auto& pool_uuid : using_pools) {
+        json::Json used_link = json::Json();
+        try {
+            used_link[Common::ODATA_ID] = psme::rest::endpoint::utils::get_component_url(
+                agent_framework::model::enums::Component::StoragePool, pool_uuid);
+            json[Common::OEM][Common::RACKSCALE][Drive::USED_BY].push_back(std::move(used_link));
+        }
+        catch (agent_framework::exceptions::InvalidUuid&) {
+            log_error("rest", "Drive " + drive.get_uuid() + " is used by a non existent storage pool!");
         }
     }
 }
@@ -57,14 +57,12 @@ void endpoint::NetworkAdapter::get(const server::Request& req, server::Response&
 
     psme::rest::server::Parameters request_parameters;
     auto chassis = psme::rest::model::find<agent_framework::model::Chassis>(req.params).get();
-    auto &system_manager = agent_framework::module::get_manager<agent_framework::model::System>();
-    auto system_uuids = system_manager.get_keys();
-    for (const auto& system_uuid : system_uuids) {
-        auto system = system_manager.get_entry(system_uuid);
-        if (system.get_chassis() == chassis.get_uuid()) {
-            request_parameters.set(PathParam::SYSTEM_ID, std::to_string(system_manager.uuid_to_rest_id(system_uuid)));
-        }
-    }
+    agent_framework::module::get_manager<agent_framework::model::System>().for_each(
+        [&chassis, &request_parameters](const agent_framework::model::System& system) {
+            if (system.get_chassis() == chassis.get_uuid()) {
+                request_parameters.set(PathParam::SYSTEM_ID, std::to_string(system.get_id()));
+            }
+        });
 
     request_parameters.set(PathParam::NETWORK_INTERFACE_ID, req.params[PathParam::NETWORK_ADAPTER_ID]);
     auto device = psme::rest::model::find<agent_framework::model::System, agent_framework::model::NetworkDevice>(
@@ -51,20 +51,18 @@ void NetworkAdapterCollection::get(const server::Request& req, server::Response&
     auto json = ::make_prototype();
     json[Common::ODATA_ID] = PathBuilder(req).build();
     auto chassis = psme::rest::model::find<agent_framework::model::Chassis>(req.params).get();
-    auto& system_manager = agent_framework::module::get_manager<agent_framework::model::System>();
-    auto system_uuids = system_manager.get_keys();
+    auto system_uuids = agent_framework::module::get_manager<agent_framework::model::System>().get_keys(
+        [&chassis](const agent_framework::model::System& system) {
+            return system.get_chassis() == chassis.get_uuid();
+        });
     for (const auto& system_uuid : system_uuids) {
-        auto system = system_manager.get_entry(system_uuid);
-        if (system.get_chassis() == chassis.get_uuid()) {
+        auto keys = get_manager<agent_framework::model::NetworkDevice>().get_ids(system_uuid);
 
-            auto keys = get_manager<agent_framework::model::NetworkDevice>().get_ids(system_uuid);
-
-            json[Collection::ODATA_COUNT] = static_cast<std::uint32_t>(keys.size());
-            for (const auto& key : keys) {
-                json::Json link_elem(json::Json::value_t::object);
-                link_elem[Common::ODATA_ID] = PathBuilder(req).append(key).build();
-                json[Collection::MEMBERS].push_back(std::move(link_elem));
-            }
+        json[Collection::ODATA_COUNT] = static_cast<std::uint32_t>(keys.size());
+        for (const auto& key : keys) {
+            json::Json link_elem(json::Json::value_t::object);
+            link_elem[Common::ODATA_ID] = PathBuilder(req).append(key).build();
+            json[Collection::MEMBERS].push_back(std::move(link_elem));
         }
     }
     set_response(res, json);
@@ -298,10 +298,10 @@ void fill_actions(const std::vector<std::string>& power_zones, const std::string
     for (const auto& power_zone_uuid : power_zones) {
         auto power_zone = agent_framework::module::get_manager<agent_framework::model::PowerZone>()
             .get_entry(power_zone_uuid);
-        auto power_supplies = agent_framework::module::get_manager<agent_framework::model::Psu>()
-            .get_entries(power_zone.get_uuid());
-        for (const auto& psu : power_supplies) {
-            state_change_action[PowerZone::MEMBER_ID_ALLOWABLE_VALUES].push_back(std::to_string(psu.get_id()));
+        auto psu_ids = agent_framework::module::get_manager<agent_framework::model::Psu>()
+            .get_ids(power_zone.get_uuid());
+        for (const auto psu_id : psu_ids) {
+            state_change_action[PowerZone::MEMBER_ID_ALLOWABLE_VALUES].push_back(std::to_string(psu_id));
         }
     }
 
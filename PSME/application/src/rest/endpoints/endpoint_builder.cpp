@@ -34,7 +34,11 @@ EndpointBuilder::~EndpointBuilder() {}
 
 
 void EndpointBuilder::build_endpoints() {
-    auto& mp = *(psme::rest::server::Multiplexer::get_instance());
+    build_endpoints(*(psme::rest::server::Multiplexer::get_instance()));
+}
+
+
+void EndpointBuilder::build_endpoints(server::Multiplexer& mp) {
     mp.use_before([this](const Request&, Response& res) {
         res.set_header(ContentType::CONTENT_TYPE, ContentType::JSON);
     });
@@ -453,6 +457,13 @@ void EndpointBuilder::build_endpoints() {
     // "/redfish/v1/TelemetryService/MetricDefinitions/{metricDefinitionId}"
     mp.register_handler(MetricDefinition::UPtr(new MetricDefinition(constants::Routes::METRIC_DEFINITION_PATH)));
 
+    // "/redfish/v1/TelemetryService/MetricReports"
+    mp.register_handler(MetricReportsCollection::UPtr(
+        new MetricReportsCollection(constants::Routes::METRIC_REPORTS_COLLECTION_PATH)));
+
+    // "/redfish/v1/TelemetryService/MetricReports/{metricReportId}"
+    mp.register_handler(MetricReport::UPtr(new MetricReport(constants::Routes::METRIC_REPORT_PATH)));
+
     // "/redfish/v1/AccountService"
     mp.register_handler(AccountService::UPtr(new AccountService(constants::Routes::ACCOUNT_SERVICE_PATH)));
 
@@ -126,33 +126,30 @@ bool handle_pcie_device_target(json::Json& json, const agent_framework::model::a
         // fill identifiers
         fill_identifiers<Device>(json, device);
 
-        const auto pcie_functions = agent_framework::module::get_manager<agent_framework::model::PcieFunction>()
-            .get_entries();
-
-        for (const auto& function: pcie_functions) {
-            if (function.get_functional_device() == entity.get_entity()) {
+        // only the first function of the device is described
+        bool has_function{false};
+        agent_framework::module::get_manager<agent_framework::model::PcieFunction>().for_each(
+            [&has_function, &json, &entity](const agent_framework::model::PcieFunction& function) {
+                if (has_function || function.get_functional_device() != entity.get_entity()) {
+                    return;
+                }
+                has_function = true;
                 try {
-                    try {
-                        if (function.get_function_id().has_value()) {
-                            json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::FUNCTION_NUMBER] = std::stoi(function.get_function_id());
-                        }
+                    if (function.get_function_id().has_value()) {
+                        json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::FUNCTION_NUMBER] = std::stoi(function.get_function_id());
                     }
-                    catch (const std::exception& ex) {
-                        log_warning("rest", "Invalid function id type:" << ex.what());
-                    }
-                    json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::CLASS_CODE] = function.get_pci_class_code();
-                    json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::DEVICE_ID] = function.get_pci_device_id();
-                    json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::VENDOR_ID] = function.get_pci_vendor_id();
-                    json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::SUBSYSTEM_ID] = function.get_pci_subsystem_id();
-                    json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::SUBSYSTEM_VENDOR_ID] = function.get_pci_subsystem_vendor_id();
                 }
-                catch (agent_framework::exceptions::InvalidUuid&) {
-                    log_error("rest",
-                              Device::get_component() << " " << device.get_uuid() << " has non-existing PCIeFunctions!");
-                    return false;
+                catch (const std::exception& ex) {
+                    log_warning("rest", "Invalid function id type:" << ex.what());
                 }
-                return true;
-            }
+                json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::CLASS_CODE] = function.get_pci_class_code();
+                json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::DEVICE_ID] = function.get_pci_device_id();
+                json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::VENDOR_ID] = function.get_pci_vendor_id();
+                json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::SUBSYSTEM_ID] = function.get_pci_subsystem_id();
+                json[constants::Endpoint::ENTITY_PCI_ID][PcieFunction::SUBSYSTEM_VENDOR_ID] = function.get_pci_subsystem_vendor_id();
+            });
+        if (has_function) {
+            return true;
         }
 
         log_info("rest", Device::get_component() << " " << device.get_uuid() << " has no PCIeFunctions!");
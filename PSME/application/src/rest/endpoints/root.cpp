@@ -60,6 +60,15 @@ json::Json make_prototype() {
     r[Common::OEM][Common::RACKSCALE][Root::ETHERNET_SWITCHES][Common::ODATA_ID] = "/redfish/v1/EthernetSwitches";
     r[Root::TELEMETRY_SERVICE][Common::ODATA_ID] = "/redfish/v1/TelemetryService";
     r[Common::LINKS][SessionService::SESSIONS][Common::ODATA_ID] = "/redfish/v1/SessionService/Sessions";
+
+    auto& expand_query = r[Root::PROTOCOL_FEATURES_SUPPORTED][Root::EXPAND_QUERY];
+    expand_query[Common::LINKS] = true;
+    expand_query[Root::NO_LINKS] = true;
+    expand_query[Root::EXPAND_ALL] = true;
+    expand_query[Root::LEVELS] = true;
+    expand_query[Root::MAX_LEVELS] = server::QueryOptions::MAX_EXPAND_LEVELS;
+    r[Root::PROTOCOL_FEATURES_SUPPORTED][Root::SELECT_QUERY] = true;
+    r[Root::PROTOCOL_FEATURES_SUPPORTED][Root::FILTER_QUERY] = false;
     return r;
 }
 }
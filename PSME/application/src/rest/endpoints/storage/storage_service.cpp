@@ -72,12 +72,12 @@ void endpoint::StorageService::get(const server::Request& request, server::Respo
     endpoint::status_to_json(storage_service, r);
 
     const Uuid& manager_uuid = storage_service.get_parent_uuid();
-    auto fabrics = agent_framework::module::get_manager<agent_framework::model::Fabric>().get_entries(manager_uuid);
-    if (!fabrics.empty()) {
+    auto fabric_ids = agent_framework::module::get_manager<agent_framework::model::Fabric>().get_ids(manager_uuid);
+    if (!fabric_ids.empty()) {
         r[constants::StorageService::ENDPOINTS][constants::Common::ODATA_ID] =
                 endpoint::PathBuilder(PathParam::BASE_URL)
                         .append(Root::FABRICS)
-                        .append(fabrics.front().get_id())
+                        .append(fabric_ids.front())
                         .append(constants::Fabric::ENDPOINTS)
                         .build();
     }
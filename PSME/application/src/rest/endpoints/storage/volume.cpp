@@ -166,16 +166,21 @@ void endpoint::Volume::get(const server::Request& req, server::Response& res) {
         agent_framework::model::Volume::is_volume_shared_over_fabrics(volume.get_uuid());
 
     r[Common::LINKS][Common::OEM][Common::RACKSCALE][StorageService::ENDPOINTS] = json::Json::value_t::array;
-    for (const auto& endpoint : agent_framework::module::get_manager<agent_framework::model::Endpoint>().get_entries()) {
-        for (const auto& entity : endpoint.get_connected_entities()) {
-            if (volume.get_uuid() == entity.get_entity()) {
-                json::Json link = json::Json();
-                link[Common::ODATA_ID] = endpoint::PathBuilder(
-                    endpoint::utils::get_component_url(agent_framework::model::enums::Component::Endpoint,
-                                                       endpoint.get_uuid())).build();
-                r[Common::LINKS][Common::OEM][Common::RACKSCALE][StorageService::ENDPOINTS].push_back(std::move(link));
+    std::vector<std::string> volume_endpoints{};
+    agent_framework::module::get_manager<agent_framework::model::Endpoint>().for_each(
+        [&volume, &volume_endpoints](const agent_framework::model::Endpoint& endpoint) {
+            for (const auto& entity : endpoint.get_connected_entities()) {
+                if (volume.get_uuid() == entity.get_entity()) {
+                    volume_endpoints.emplace_back(endpoint.get_uuid());
+                }
             }
-        }
+        });
+    for (const auto& endpoint_uuid : volume_endpoints) {
+        json::Json link = json::Json();
+        link[Common::ODATA_ID] = endpoint::PathBuilder(
+            endpoint::utils::get_component_url(agent_framework::model::enums::Component::Endpoint,
+                                               endpoint_uuid)).build();
+        r[Common::LINKS][Common::OEM][Common::RACKSCALE][StorageService::ENDPOINTS].push_back(std::move(link));
     }
 
     r[Common::OEM][Common::RACKSCALE][Common::METRICS][Common::ODATA_ID] = endpoint::PathBuilder(req)
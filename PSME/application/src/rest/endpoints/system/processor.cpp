@@ -196,26 +196,29 @@ void fill_pcie_links(const agent_framework::model::Processor& processor, json::J
     const auto& pcie_devices_uuids = pcie_device_manager.get_keys();
 
     for (const auto& pcie_device_uuid: pcie_devices_uuids) {
-        const auto& pcie_functions = pcie_function_manager.get_entries(pcie_device_uuid);
-        for (const auto& pcie_function: pcie_functions) {
-            if (pcie_function.get_functional_device().has_value() &&
+        // We assume 1 PCIeDevice and 1 PCIeFunction, so only the first matching function is taken
+        std::string pcie_function_uuid{};
+        pcie_function_manager.for_each(pcie_device_uuid, [&pcie_function_uuid, &processor](
+            const agent_framework::model::PcieFunction& pcie_function) {
+            if (pcie_function_uuid.empty() && pcie_function.get_functional_device().has_value() &&
                 pcie_function.get_functional_device() == processor.get_uuid()) {
-
-                // Add PCIeFunction
-                json::Json pcie_function_link = json::Json();
-                pcie_function_link[Common::ODATA_ID] = psme::rest::endpoint::utils::get_component_url(
-                    agent_framework::model::enums::Component::PcieFunction, pcie_function.get_uuid());
-                json[Common::LINKS][constants::Processor::PCIE_FUNCTIONS].push_back(
-                    std::move(pcie_function_link));
-
-                // Add PCIeDevice
-                json::Json pcie_device_link = json::Json();
-                pcie_device_link[Common::ODATA_ID] = psme::rest::endpoint::utils::get_component_url(
-                    agent_framework::model::enums::Component::PcieDevice, pcie_device_uuid);
-                json[Common::LINKS][constants::Processor::PCIE_DEVICE] = std::move(pcie_device_link);
-
-                break;  // We assume 1 PCIeDevice and 1 PCIeFunction
+                pcie_function_uuid = pcie_function.get_uuid();
             }
+        });
+
+        if (!pcie_function_uuid.empty()) {
+            // Add PCIeFunction
+            json::Json pcie_function_link = json::Json();
+            pcie_function_link[Common::ODATA_ID] = psme::rest::endpoint::utils::get_component_url(
+                agent_framework::model::enums::Component::PcieFunction, pcie_function_uuid);
+            json[Common::LINKS][constants::Processor::PCIE_FUNCTIONS].push_back(
+                std::move(pcie_function_link));
+
+            // Add PCIeDevice
+            json::Json pcie_device_link = json::Json();
+            pcie_device_link[Common::ODATA_ID] = psme::rest::endpoint::utils::get_component_url(
+                agent_framework::model::enums::Component::PcieDevice, pcie_device_uuid);
+            json[Common::LINKS][constants::Processor::PCIE_DEVICE] = std::move(pcie_device_link);
         }
     }
 }
@@ -177,19 +177,22 @@ void add_processors_summary(const agent_framework::model::System& system, json::
     const agent_framework::model::enums::State ENABLED = agent_framework::model::enums::State::Enabled;
 
     // PROCESSORS SUMMARY
-    auto procs = agent_framework::module::get_manager<agent_framework::model::Processor>()
-        .get_keys(system.get_uuid());
+    auto& processor_manager = agent_framework::module::get_manager<agent_framework::model::Processor>();
 
+    // model name of the first processor, no processor is copied
+    bool has_processors{false};
     response[constants::System::PROCESSOR_SUMMARY][Common::MODEL] = json::Json::value_t::null;
-    auto processors_count = static_cast<std::uint32_t>(procs.size());
-    if (processors_count > 0) {
-        const auto& proc = agent_framework::module::get_manager<agent_framework::model::Processor>()
-            .get_entry(procs.front());
-        response[constants::System::PROCESSOR_SUMMARY][Common::MODEL] = proc.get_model_name();
-    }
+    processor_manager.for_each(system.get_uuid(), [&has_processors, &response](
+        const agent_framework::model::Processor& processor) {
+        if (!has_processors) {
+            response[constants::System::PROCESSOR_SUMMARY][Common::MODEL] = processor.get_model_name();
+            has_processors = true;
+        }
+    });
+    auto processors_count = static_cast<std::uint32_t>(processor_manager.get_entry_count(system.get_uuid()));
 
     response[constants::System::PROCESSOR_SUMMARY][Common::STATUS][Common::STATE] =
-        procs.empty() ? json::Json(nullptr) : json::Json(ENABLED.to_string());
+        has_processors ? json::Json(ENABLED.to_string()) : json::Json(nullptr);
     auto summarized_proc_health = psme::rest::endpoint::HealthRollup<agent_framework::model::System>()
         .get(system.get_uuid(), agent_framework::model::enums::Component::Processor);
 
@@ -198,30 +201,24 @@ void add_processors_summary(const agent_framework::model::System& system, json::
     response[constants::System::PROCESSOR_SUMMARY][Common::STATUS][Common::HEALTH_ROLLUP] = summarized_proc_health;
 
     auto is_processor_present = [](const agent_framework::model::Processor& p) {
-        return (p.get_status().get_state() == agent_framework::model::enums::State::Absent) ? 0 : 1;
+        return p.get_status().get_state() != agent_framework::model::enums::State::Absent;
     };
-    auto available_processors =
-        psme::rest::endpoint::utils::query_entries<agent_framework::model::Processor, std::uint32_t>(
-            system.get_uuid(), is_processor_present);
     response[constants::System::PROCESSOR_SUMMARY][constants::System::COUNT] =
-        std::accumulate(available_processors.begin(), available_processors.end(), 0u);
+        static_cast<std::uint32_t>(processor_manager.count_if(system.get_uuid(), is_processor_present));
 }
 
 
 void add_memory_summary(const agent_framework::model::System& system, json::Json& response) {
     const agent_framework::model::enums::State ENABLED = agent_framework::model::enums::State::Enabled;
 
-    auto memory_modules = agent_framework::module::get_manager<agent_framework::model::Memory>()
-        .get_keys(system.get_uuid());
-
-    OptionalField<std::uint32_t> total_size_mb{};
-    auto get_memory_size = [](const agent_framework::model::Memory& m) { return m.get_capacity_mib(); };
-    auto memory_sizes = psme::rest::endpoint::utils::query_entries
-        <agent_framework::model::Memory, OptionalField<std::uint32_t>>(system.get_uuid(), get_memory_size);
+    auto& memory_manager = agent_framework::module::get_manager<agent_framework::model::Memory>();
+    const auto memory_modules_count = memory_manager.get_entry_count(system.get_uuid());
 
-    for (const auto& mem_size: memory_sizes) {
-        total_size_mb = total_size_mb + mem_size;
-    }
+    auto add_memory_size = [](OptionalField<std::uint32_t> total, const agent_framework::model::Memory& m) {
+        return total + m.get_capacity_mib();
+    };
+    const auto total_size_mb = memory_manager.accumulate(system.get_uuid(), OptionalField<std::uint32_t>{},
+                                                         add_memory_size);
 
     response[constants::System::MEMORY_SUMMARY][constants::System::TOTAL_SYSTEM_MEMORY_GIB] =
         (total_size_mb.has_value() ?
@@ -230,14 +227,14 @@ void add_memory_summary(const agent_framework::model::System& system, json::Json
          json::Json(json::Json::value_t::null));
 
     response[constants::System::MEMORY_SUMMARY][Common::STATUS][Common::STATE] =
-        memory_modules.empty() ? json::Json(nullptr) : json::Json(ENABLED.to_string());
+        (0 == memory_modules_count) ? json::Json(nullptr) : json::Json(ENABLED.to_string());
     auto summarized_memory_health = psme::rest::endpoint::HealthRollup<agent_framework::model::System>()
         .get(system.get_uuid(), agent_framework::model::enums::Component::Memory);
 
     response[constants::System::MEMORY_SUMMARY][Common::STATUS][Common::HEALTH] = summarized_memory_health;
     response[constants::System::MEMORY_SUMMARY][Common::STATUS][Common::HEALTH_ROLLUP] = summarized_memory_health;
 
-    response[Common::OEM][Common::RACKSCALE][System::MEMORY_SOCKETS] = memory_modules.size();
+    response[Common::OEM][Common::RACKSCALE][System::MEMORY_SOCKETS] = memory_modules_count;
 }
 
 
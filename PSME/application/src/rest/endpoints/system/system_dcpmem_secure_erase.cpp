@@ -55,11 +55,11 @@ void check_response_errors(const agent_framework::model::responses::SetComponent
 }
 
 void check_dcpmem_presence(const agent_framework::model::System& system) {
-    auto dcpmem_modules = agent_framework::module::get_manager<agent_framework::model::Memory>()
-        .get_entries(system.get_uuid(), [](const agent_framework::model::Memory& memory) -> bool {
+    auto dcpmem_modules_count = agent_framework::module::get_manager<agent_framework::model::Memory>()
+        .count_if(system.get_uuid(), [](const agent_framework::model::Memory& memory) -> bool {
             return memory.get_memory_type() == enums::MemoryType::IntelOptane;
         });
-    if (dcpmem_modules.empty()) {
+    if (0 == dcpmem_modules_count) {
         // TODO replace invalid_payload_error with new appropriate error type
         throw error::ServerException(
             error::ErrorFactory::create_invalid_payload_error(
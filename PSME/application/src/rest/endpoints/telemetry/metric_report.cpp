@@ -0,0 +1,71 @@
+/*!
+ * @brief Metric report endpoint
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file metric_report.cpp
+ */
+
+#include "psme/rest/endpoints/telemetry/metric_report.hpp"
+#include "psme/rest/telemetry/metric_reports.hpp"
+
+
+
+using namespace psme::rest;
+using namespace psme::rest::constants;
+
+
+namespace {
+json::Json make_prototype() {
+    json::Json r(json::Json::value_t::object);
+
+    r[Common::ODATA_CONTEXT] = "/redfish/v1/$metadata#MetricReport.MetricReport";
+    r[Common::ODATA_ID] = json::Json::value_t::null;
+    r[Common::ODATA_TYPE] = "#MetricReport.v1_1_0.MetricReport";
+    r[Common::ID] = json::Json::value_t::null;
+    r[Common::NAME] = "Metric Report";
+    r[Common::DESCRIPTION] = json::Json::value_t::null;
+    r[MetricReport::REPORT_SEQUENCE] = json::Json::value_t::null;
+    r[MetricReport::TIMESTAMP] = json::Json::value_t::null;
+    r[MetricReport::METRIC_VALUES] = json::Json::value_t::array;
+
+    return r;
+}
+}
+
+
+endpoint::MetricReport::MetricReport(const std::string& path) : EndpointBase(path) {}
+
+
+endpoint::MetricReport::~MetricReport() {}
+
+
+void endpoint::MetricReport::get(const server::Request& request, server::Response& response) {
+    const auto reports = telemetry::MetricReports::get_instance();
+    const auto definition = reports->find_definition(request.params[PathParam::METRIC_REPORT_ID]);
+    if (nullptr == definition) {
+        throw agent_framework::exceptions::NotFound("Requested metric report does not exist.");
+    }
+
+    auto json = make_prototype();
+    json[Common::ODATA_ID] = PathBuilder(request).build();
+    json[Common::ID] = definition->id;
+    json[Common::DESCRIPTION] = telemetry::ReportDefinition::Type::Periodic == definition->type ?
+        "Values of metrics sampled during the last report interval" : "Changes of values of metrics";
+    const auto report = reports->make_report(*definition);
+    for (auto it = report.begin(); it != report.end(); ++it) {
+        json[it.key()] = it.value();
+    }
+
+    set_response(response, json);
+}
@@ -0,0 +1,66 @@
+/*!
+ * @brief Metric reports collection endpoint
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file metric_reports_collection.cpp
+ */
+
+#include "psme/rest/endpoints/telemetry/metric_reports_collection.hpp"
+#include "psme/rest/telemetry/metric_reports.hpp"
+
+
+
+using namespace psme::rest::constants;
+using namespace psme::rest::endpoint;
+
+namespace {
+json::Json make_prototype() {
+    json::Json r(json::Json::value_t::object);
+
+    r[Common::ODATA_CONTEXT] = "/redfish/v1/$metadata#MetricReportCollection.MetricReportCollection";
+    r[Common::ODATA_ID] = json::Json::value_t::null;
+    r[Common::ODATA_TYPE] = "#MetricReportCollection.MetricReportCollection";
+    r[Common::NAME] = "Metric Report Collection";
+    r[Common::DESCRIPTION] = "Metric Report Collection";
+    r[Collection::ODATA_COUNT] = 0;
+    r[Collection::MEMBERS] = json::Json::value_t::array;
+
+    return r;
+}
+}
+
+MetricReportsCollection::MetricReportsCollection(const std::string& path) : EndpointBase(path) {}
+
+
+MetricReportsCollection::~MetricReportsCollection() {}
+
+
+void MetricReportsCollection::get(const server::Request& request, server::Response& response) {
+    auto json = ::make_prototype();
+
+    json[Common::ODATA_ID] = PathBuilder(request).build();
+
+    // reports are configured on startup
+    const auto& definitions = psme::rest::telemetry::MetricReports::get_instance()->get_definitions();
+
+    json[Collection::ODATA_COUNT] = std::uint32_t(definitions.size());
+
+    for (const auto& definition : definitions) {
+        json::Json link = json::Json();
+        link[Common::ODATA_ID] = PathBuilder(request).append(definition.id).build();
+        json[Collection::MEMBERS].push_back(std::move(link));
+    }
+
+    set_response(response, json);
+}
@@ -41,6 +41,9 @@ json::Json make_prototype() {
     r[TelemetryService::METRIC_DEFINITIONS][Common::ODATA_ID] = endpoint::PathBuilder(PathParam::BASE_URL)
         .append(Root::TELEMETRY_SERVICE)
         .append(TelemetryService::METRIC_DEFINITIONS).build();
+    r[TelemetryService::METRIC_REPORTS][Common::ODATA_ID] = endpoint::PathBuilder(PathParam::BASE_URL)
+        .append(Root::TELEMETRY_SERVICE)
+        .append(TelemetryService::METRIC_REPORTS).build();
 
     return r;
 }
@@ -482,23 +482,31 @@ void string_array_to_json(json::Json& json, const agent_framework::model::attrib
 }
 
 
+namespace {
+void populate_metric(json::Json& component_json, const agent_framework::model::Metric& metric) {
+    try {
+        auto ptr = json::Json::json_pointer(metric.get_name());
+        component_json[ptr] = metric.get_value();
+    }
+    catch (const std::exception& e) {
+        log_error("rest", "Populate metric " << metric.get_name() << " failed: " << e.what());
+    }
+}
+}
+
+
 void populate_metrics(json::Json& component_json, const std::string& component_uuid) {
-    auto metrics = agent_framework::module::get_manager<Metric>().get_entries([&component_uuid](const Metric& m) {
-        return m.get_component_uuid() == component_uuid;
+    agent_framework::module::get_manager<Metric>().for_each([&component_json, &component_uuid](const Metric& metric) {
+        if (metric.get_component_uuid() == component_uuid) {
+            populate_metric(component_json, metric);
+        }
     });
-    populate_metrics(component_json, metrics);
 }
 
 
 void populate_metrics(json::Json& component_json, const std::vector<agent_framework::model::Metric>& metrics) {
     for (const auto& metric: metrics) {
-        try {
-            auto ptr = json::Json::json_pointer(metric.get_name());
-            component_json[ptr] = metric.get_value();
-        }
-        catch (const std::exception& e) {
-            log_error("rest", "Populate metric " << metric.get_name() << " failed: " << e.what());
-        }
+        populate_metric(component_json, metric);
     }
 }
 
@@ -510,15 +518,13 @@ psme::rest::server::Parameters get_network_device_request_parameters(const psme:
     }
     else { // chassis system
         auto chassis = psme::rest::model::find<agent_framework::model::Chassis>(parameters).get();
-        auto& system_manager = agent_framework::module::get_manager<agent_framework::model::System>();
-        auto system_uuids = system_manager.get_keys();
-        for (const auto& system_uuid : system_uuids) {
-            auto system = system_manager.get_entry(system_uuid);
-            if (system.get_chassis() == chassis.get_uuid()) {
-                request_parameters.set(constants::PathParam::SYSTEM_ID, std::to_string(system_manager.uuid_to_rest_id(system_uuid)));
-                request_parameters.set(constants::PathParam::NETWORK_INTERFACE_ID, parameters.get(constants::PathParam::NETWORK_ADAPTER_ID));
-            }
-        }
+        agent_framework::module::get_manager<agent_framework::model::System>().for_each(
+            [&chassis, &parameters, &request_parameters](const agent_framework::model::System& system) {
+                if (system.get_chassis() == chassis.get_uuid()) {
+                    request_parameters.set(constants::PathParam::SYSTEM_ID, std::to_string(system.get_id()));
+                    request_parameters.set(constants::PathParam::NETWORK_INTERFACE_ID, parameters.get(constants::PathParam::NETWORK_ADAPTER_ID));
+                }
+            });
     }
     return request_parameters;
 }
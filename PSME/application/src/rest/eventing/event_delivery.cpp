@@ -0,0 +1,216 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file event_delivery.cpp
+ * @brief EventDelivery implementation
+ * */
+
+#include "psme/rest/eventing/event_delivery.hpp"
+#include "logger/logger_factory.hpp"
+
+#include <algorithm>
+
+using namespace psme::rest::eventing;
+
+namespace {
+
+/*! @brief Idle workers check for unused destinations with this interval */
+constexpr std::chrono::seconds PRUNE_INTERVAL{10};
+
+/*! @brief Destination (and its connection) is released when not used for this time */
+constexpr std::chrono::seconds IDLE_TIMEOUT{60};
+
+}
+
+EventDelivery::EventDelivery(Sender sender, std::size_t workers, std::size_t max_queue_depth) :
+    m_sender(sender),
+    m_worker_count(std::max<std::size_t>(workers, 1)),
+    m_max_queue_depth(std::max<std::size_t>(max_queue_depth, 1)) { }
+
+EventDelivery::~EventDelivery() {
+    stop();
+}
+
+void EventDelivery::start() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (m_running) {
+        return;
+    }
+    m_running = true;
+    for (std::size_t i = 0; i < m_worker_count; ++i) {
+        m_workers.emplace_back(&EventDelivery::run_worker, this);
+    }
+}
+
+void EventDelivery::stop() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+    }
+    m_ready_cv.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (m_queue_depth > 0) {
+        log_warning("rest", "Event service stopped, " << m_queue_depth << " event arrays not delivered.");
+    }
+    m_destinations.clear();
+    m_ready.clear();
+    m_queue_depth = 0;
+}
+
+bool EventDelivery::enqueue(EventArray event_array) {
+    if (!event_array.get_subscriber_id().has_value()) {
+        log_error("rest", "Event array with Id: " << event_array.get_id() << " has no subscriber.");
+        return true;
+    }
+    const auto subscriber_id = event_array.get_subscriber_id().value();
+
+    bool has_room = true;
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        auto& destination = m_destinations[subscriber_id];
+        if (destination.queue.size() >= m_max_queue_depth) {
+            log_warning("rest", "Subscriber " << subscriber_id << " does not keep up, event array with Id: "
+                << destination.queue.front().first.get_id() << " dropped.");
+            destination.queue.pop_front();
+            --m_queue_depth;
+            ++m_dropped;
+            has_room = false;
+        }
+        destination.queue.emplace_back(std::move(event_array), Clock::now());
+        ++m_queue_depth;
+
+        // subscriber is either being served or already waits for a worker
+        if (destination.busy || destination.scheduled) {
+            return has_room;
+        }
+        destination.scheduled = true;
+        m_ready.push_back(subscriber_id);
+    }
+    m_ready_cv.notify_one();
+    return has_room;
+}
+
+EventDelivery::Metrics EventDelivery::get_metrics() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    Metrics metrics{};
+    metrics.queue_depth = m_queue_depth;
+    for (const auto& destination : m_destinations) {
+        metrics.max_subscriber_queue_depth = std::max(metrics.max_subscriber_queue_depth,
+                                                      destination.second.queue.size());
+    }
+    metrics.delivered = m_delivered;
+    metrics.failed = m_failed;
+    metrics.dropped = m_dropped;
+    const auto deliveries = m_delivered + m_failed;
+    if (deliveries > 0) {
+        metrics.average_latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            m_total_latency / static_cast<Clock::rep>(deliveries));
+    }
+    metrics.max_latency = std::chrono::duration_cast<std::chrono::microseconds>(m_max_latency);
+    return metrics;
+}
+
+std::size_t EventDelivery::get_queue_depth(SubscriberId subscriber_id) const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    const auto it = m_destinations.find(subscriber_id);
+    return (m_destinations.cend() != it) ? it->second.queue.size() : 0;
+}
+
+void EventDelivery::run_worker() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (m_running) {
+        if (m_ready.empty()) {
+            if (!m_ready_cv.wait_for(lock, PRUNE_INTERVAL, [this] { return !m_running || !m_ready.empty(); })) {
+                prune_idle_destinations();
+            }
+            continue;
+        }
+
+        const auto subscriber_id = m_ready.front();
+        m_ready.pop_front();
+        auto& destination = m_destinations[subscriber_id];
+        destination.scheduled = false;
+        auto queued = std::move(destination.queue.front());
+        destination.queue.pop_front();
+        --m_queue_depth;
+        destination.busy = true;
+        if (!destination.client) {
+            destination.client.reset(new RestClient(""));
+        }
+        auto& client = *destination.client;
+
+        lock.unlock();
+        bool delivered = false;
+        try {
+            delivered = m_sender(client, queued.first);
+        }
+        catch (const std::exception& e) {
+            log_error("rest", "Exception occurred when delivering event array with Id: "
+                << queued.first.get_id() << " : " << e.what());
+        }
+        catch (...) {
+            log_error("rest", "Exception occurred when delivering event array with Id: "
+                << queued.first.get_id());
+        }
+        const auto now = Clock::now();
+        lock.lock();
+
+        const auto latency = now - queued.second;
+        m_total_latency += latency;
+        m_max_latency = std::max(m_max_latency, latency);
+        if (delivered) {
+            ++m_delivered;
+        }
+        else {
+            ++m_failed;
+        }
+
+        destination.busy = false;
+        destination.last_used = now;
+        if (!destination.queue.empty()) {
+            destination.scheduled = true;
+            m_ready.push_back(subscriber_id);
+            m_ready_cv.notify_one();
+        }
+    }
+}
+
+void EventDelivery::prune_idle_destinations() {
+    const auto now = Clock::now();
+    for (auto it = m_destinations.begin(); it != m_destinations.end();) {
+        const auto& destination = it->second;
+        if (!destination.busy && destination.queue.empty() && (now - destination.last_used > IDLE_TIMEOUT)) {
+            it = m_destinations.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
@@ -36,10 +36,27 @@ using namespace psme::rest::eventing::model;
 
 constexpr char EventService::DELIVERY_RETRY_ATTEMPTS_PROP[];
 constexpr char EventService::DELIVERY_RETRY_INTERVAL_PROP[];
+constexpr char EventService::DELIVERY_WORKERS_PROP[];
+constexpr char EventService::DELIVERY_QUEUE_DEPTH_PROP[];
 
-EventService::EventService() {
-    const json::Json& config = configuration::Configuration::get_instance().to_json();
-    const auto& event_service_config = config["event-service"];
+namespace {
+
+/*! @brief Delivery metrics are logged with this interval */
+constexpr std::chrono::minutes METRICS_LOG_INTERVAL{1};
+
+const json::Json& get_event_service_config() {
+    return configuration::Configuration::get_instance().to_json()["event-service"];
+}
+
+}
+
+EventService::EventService() :
+    m_delivery{[this](RestClient& rest_client, const EventArray& event_array) {
+                   return send_event_array(rest_client, event_array);
+               },
+               get_event_service_config().value(DELIVERY_WORKERS_PROP, std::uint16_t{4}),
+               get_event_service_config().value(DELIVERY_QUEUE_DEPTH_PROP, std::uint16_t{100})} {
+    const auto& event_service_config = get_event_service_config();
     m_delivery_retry_attempts = event_service_config.value(DELIVERY_RETRY_ATTEMPTS_PROP, std::uint16_t{});
     m_delivery_retry_interval = std::chrono::seconds(event_service_config.value(DELIVERY_RETRY_INTERVAL_PROP, std::uint16_t{}));
 }
@@ -48,6 +65,7 @@ void EventService::start() {
     log_info("rest", "Starting REST event service ...");
     if (!m_running) {
         m_running = true;
+        m_delivery.start();
         m_thread = std::thread(&EventService::m_handle_events, this);
         log_info("rest", "REST event service started.");
     }
@@ -60,6 +78,7 @@ void EventService::stop() {
         if (m_thread.joinable()) {
             m_thread.join();
         }
+        m_delivery.stop();
         log_info("rest", "REST event service stopped.");
     }
 }
@@ -78,24 +97,24 @@ EventArrayQueue& EventService::get_event_array_queue() {
     return g_event_queue;
 }
 
-void EventService::send_event_array(const EventArray& event_array) {
+bool EventService::send_event_array(RestClient& rest_client, const EventArray& event_array) {
     Subscription subscription;
     try {
         subscription =  SubscriptionManager::get_instance()->get(event_array.get_subscriber_id());
     }
     catch (const agent_framework::exceptions::NotFound&) {
         // The subscriber has been deleted while the EventArray waited in the queue for processing. Do nothing.
-        return;
+        return true;
     }
 
     const auto& destination = subscription.get_destination();
     try {
         std::string notification = event_array.to_json().dump();
-        psme::rest::eventing::RestClient rest_client("");
         rest_client.set_default_content_type(psme::rest::server::ContentType::JSON);
         rest_client.post(destination, notification);
         log_debug("rest", " Subscriber: " << destination
                                     << " notified with: " << notification);
+        return true;
     } catch (std::runtime_error&) {
         EventArrayUPtr retry_event_array(new EventArray(event_array));
         auto retry_attempts = retry_event_array->increment_retry_attempts();
@@ -111,6 +130,7 @@ void EventService::send_event_array(const EventArray& event_array) {
                     << destination << " is unreachable");
             SubscriptionManager::get_instance()->del(subscription.get_id());
         }
+        return false;
     }
 }
 
@@ -133,8 +153,23 @@ std::vector<EventArray> EventService::select_events_for_subscribers(const EventA
     return selections;
 }
 
+void EventService::log_delivery_metrics() {
+    const auto now = steady_clock::now();
+    if (now - m_metrics_logged < METRICS_LOG_INTERVAL) {
+        return;
+    }
+    m_metrics_logged = now;
+
+    const auto metrics = m_delivery.get_metrics();
+    log_debug("rest", "Event delivery: queued " << metrics.queue_depth
+        << " (max per subscriber " << metrics.max_subscriber_queue_depth << ")"
+        << ", delivered " << metrics.delivered << ", failed " << metrics.failed << ", dropped " << metrics.dropped
+        << ", latency avg " << metrics.average_latency.count() << "us max " << metrics.max_latency.count() << "us");
+}
+
 void EventService::m_handle_events() {
     while (m_running) {
+        log_delivery_metrics();
         if (const auto event_array = get_event_array_queue().wait_for_and_pop(std::chrono::seconds(1))) {
 
             log_debug("rest", " Popped Event Array: "
@@ -147,11 +182,10 @@ void EventService::m_handle_events() {
                     auto filtered_event_arrays = select_events_for_subscribers(*event_array);
 
                     for (auto& events_for_subscriber : filtered_event_arrays) {
-                        // @TODO parallelize sending event array by using tasks processed by a threadpool
-                        send_event_array(events_for_subscriber);
+                        m_delivery.enqueue(std::move(events_for_subscriber));
                     }
                 } else {
-                    send_event_array(*event_array);
+                    m_delivery.enqueue(*event_array);
                 }
             }
             catch (const std::runtime_error& e) {
@@ -92,6 +92,12 @@ namespace {
 
 }
 
+RestClient::~RestClient() {
+    if (m_handle) {
+        curl_easy_cleanup(m_handle);
+    }
+}
+
 void RestClient::set_basic_auth(const std::string& user, const std::string& password) {
     m_basic_auth.clear();
     m_basic_auth += user;
@@ -130,7 +136,14 @@ RestClient::Response RestClient::rest_method_template(Method method,
     RestClient::Response response;
     response.set_response_code(-1);
 
-    CURL* curl = curl_easy_init();
+    /* reused handle keeps the connection and the DNS cache, options are set again for each request */
+    if (m_handle) {
+        curl_easy_reset(m_handle);
+    }
+    else {
+        m_handle = curl_easy_init();
+    }
+    CURL* curl = m_handle;
     if (!curl) {
         return response;
     }
@@ -152,6 +165,8 @@ RestClient::Response RestClient::rest_method_template(Method method,
     }
 
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "psme 0.0");
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
     curl_easy_setopt(curl, CURLOPT_URL, target_url.c_str());
 
     if (method == Method::POST) {
@@ -190,7 +205,6 @@ RestClient::Response RestClient::rest_method_template(Method method,
     }
     else {
         curl_slist_free_all(custom_headers);
-        curl_easy_cleanup(curl);
         log_warning("rest", "Curl exit code "
              << static_cast<int>(res)
              << " : " << curl_easy_strerror(res));
@@ -202,7 +216,6 @@ RestClient::Response RestClient::rest_method_template(Method method,
              << " (code " << static_cast<int>(res) << ")");
 
     curl_slist_free_all(custom_headers);
-    curl_easy_cleanup(curl);
 
     return response;
 }
@@ -0,0 +1,94 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file parallel_runner.cpp
+ * @brief Bounded parallel execution of polling tasks
+ * */
+
+#include "psme/rest/model/parallel_runner.hpp"
+
+#include <exception>
+#include <future>
+#include <system_error>
+
+using namespace psme::rest::model;
+
+ParallelRunner::ParallelRunner(std::size_t max_threads) : m_max_threads(max_threads) { }
+
+
+void ParallelRunner::run(const std::vector<Task>& tasks) {
+    std::vector<std::exception_ptr> errors(tasks.size());
+    std::vector<std::future<void>> futures{};
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        auto& error = errors[i];
+        const auto& task = tasks[i];
+        auto guarded_task = [&task, &error] {
+            try {
+                task();
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        };
+
+        /* last task is always executed by the caller, it would wait for the others anyway */
+        if (i + 1 < tasks.size() && try_acquire_thread()) {
+            try {
+                futures.emplace_back(std::async(std::launch::async, [this, guarded_task] {
+                    guarded_task();
+                    release_thread();
+                }));
+            }
+            catch (const std::system_error&) {
+                release_thread();
+                guarded_task();
+            }
+        }
+        else {
+            guarded_task();
+        }
+    }
+
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+
+bool ParallelRunner::try_acquire_thread() {
+    auto busy = m_busy_threads.load();
+    while (busy < m_max_threads) {
+        if (m_busy_threads.compare_exchange_weak(busy, busy + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void ParallelRunner::release_thread() {
+    --m_busy_threads;
+}
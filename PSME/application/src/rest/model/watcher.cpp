@@ -23,6 +23,7 @@
 
 #include "psme/core/agent/agent_manager.hpp"
 #include "psme/rest/model/handlers/root_handler.hpp"
+#include "psme/rest/model/parallel_runner.hpp"
 #include "agent-framework/eventing/events_queue.hpp"
 
 #include "configuration/configuration.hpp"
@@ -30,6 +31,7 @@
 namespace {
     constexpr const auto DEFAULT_INTERVAL_SECONDS = 0;
     constexpr const auto DEFAULT_OUTDATED_HOURS = std::chrono::hours(24);
+    constexpr const std::size_t DEFAULT_POLL_WORKERS = 4;
 }
 
 namespace psme {
@@ -52,9 +54,39 @@ public:
     void execute() override;
 
 private:
+    using Clock = std::chrono::steady_clock;
+
+    /*! @brief Result of polling a single agent */
+    struct AgentPollResult {
+        std::string gami_id{};
+        Clock::duration duration{};
+        bool failed{false};
+        bool timed_out{false};
+    };
+
+    /*!
+     * @brief Poll single agent, errors are recorded in the result
+     *
+     * Deadline of the agent is counted from the start of its polling, so agents waiting
+     * for a free worker do not lose their time.
+     *
+     * @param agent Agent to be polled
+     * @param[out] result Result of the polling
+     */
+    void poll_agent(const psme::core::agent::JsonAgentSPtr& agent, AgentPollResult& result);
+
+    /*!
+     * @brief Log duration of the poll cycle and its slowest agent
+     * @param results Results of polling of all agents
+     * @param duration Duration of the whole cycle
+     */
+    void report(const std::vector<AgentPollResult>& results, Clock::duration duration) const;
+
     std::chrono::seconds interval{};
+    std::chrono::seconds agent_deadline{};
 
     handler::RootHandler root_handler{};
+    std::unique_ptr<ParallelRunner> runner{};
 
     static const constexpr char TASK_NAME[] = "Polling";
 };
@@ -63,22 +95,84 @@ const constexpr char PollingTask::TASK_NAME[];
 
 PollingTask::PollingTask() : WatcherTask(PollingTask::TASK_NAME) {
     auto config = configuration::Configuration::get_instance().to_json();
-    interval = std::chrono::seconds(config.value("eventing", json::Json::object()).value("poll-interval-sec", uint16_t{}));
+    const auto eventing = config.value("eventing", json::Json::object());
+    interval = std::chrono::seconds(eventing.value("poll-interval-sec", uint16_t{}));
+    agent_deadline = std::chrono::seconds(eventing.value("poll-agent-deadline-sec",
+                                                         static_cast<std::uint32_t>(interval.count())));
+    runner.reset(new ParallelRunner(eventing.value("poll-workers", DEFAULT_POLL_WORKERS)));
 }
 
 void PollingTask::execute() {
     auto agents = psme::core::agent::AgentManager::get_instance()->get_agents();
-    for (auto& agent : agents) {
-        try {
-            auto polling = [this,agent] {
-                this->root_handler.poll(agent, "" /* parent_uuid */, agent_framework::model::enums::Component::None, "" /* uuid */);
-            };
-            agent->execute_in_transaction(PollingTask::TASK_NAME, polling);
-        }
-        catch (const psme::core::agent::AgentUnreachable&)  {
-            log_error("rest", "Polling failed due to agent (id:" << agent.get()->get_gami_id() << ") unreachable");
+    const auto started_at = Clock::now();
+
+    // agents are polled in parallel, the same threads are used to fetch collections of each agent
+    std::vector<AgentPollResult> results(agents.size());
+    std::vector<ParallelRunner::Task> tasks{};
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        const auto& agent = agents[i];
+        auto& result = results[i];
+        tasks.emplace_back([this, &agent, &result] {
+            poll_agent(agent, result);
+        });
+    }
+    runner->run(tasks);
+
+    report(results, Clock::now() - started_at);
+}
+
+void PollingTask::poll_agent(const psme::core::agent::JsonAgentSPtr& agent, AgentPollResult& result) {
+    result.gami_id = agent->get_gami_id();
+    const auto started_at = Clock::now();
+    const auto deadline = agent_deadline.count() > 0 ? started_at + agent_deadline : Clock::time_point::max();
+    try {
+        auto polling = [this, agent, deadline] {
+            this->root_handler.poll(agent, "" /* parent_uuid */, agent_framework::model::enums::Component::None,
+                                    "" /* uuid */, this->runner.get(), deadline);
+        };
+        agent->execute_in_transaction(PollingTask::TASK_NAME, polling);
+    }
+    catch (const psme::core::agent::AgentUnreachable&)  {
+        log_error("rest", "Polling failed due to agent (id:" << result.gami_id << ") unreachable");
+        result.failed = true;
+    }
+    catch (const std::exception& e) {
+        log_error("rest", "Polling of agent (id:" << result.gami_id << ") failed: " << e.what());
+        result.failed = true;
+    }
+    const auto finished_at = Clock::now();
+    result.duration = finished_at - started_at;
+    result.timed_out = finished_at >= deadline;
+
+    const auto statistics = agent->get_connection_statistics();
+    log_debug("rest", "Agent (id:" << result.gami_id << ") connections: opened " << statistics.connections_opened
+                      << ", reused " << statistics.connections_reused << ", throttled " << statistics.throttled);
+}
+
+void PollingTask::report(const std::vector<AgentPollResult>& results, Clock::duration duration) const {
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+
+    const AgentPollResult* slowest{nullptr};
+    std::size_t failed{0};
+    std::size_t timed_out{0};
+    for (const auto& result : results) {
+        if (nullptr == slowest || result.duration > slowest->duration) {
+            slowest = &result;
         }
+        failed += result.failed ? 1 : 0;
+        timed_out += result.timed_out ? 1 : 0;
+    }
+
+    if (nullptr == slowest) {
+        log_debug("rest", "Poll cycle finished, no agents registered");
+        return;
     }
+    log_info("rest", "Poll cycle of " << results.size() << " agent(s) finished after "
+                     << duration_cast<milliseconds>(duration).count() << "ms, slowest agent (id:"
+                     << slowest->gami_id << ") " << duration_cast<milliseconds>(slowest->duration).count() << "ms, "
+                     << failed << " failed, " << timed_out << " exceeded deadline of "
+                     << agent_deadline.count() << "s");
 }
 
 class RetentionPolicyTask : public WatcherTask {
@@ -22,6 +22,8 @@
 #include "psme/rest/rest_server.hpp"
 #include "psme/rest/endpoints/endpoint_builder.hpp"
 #include "psme/rest/server/multiplexer.hpp"
+#include "psme/rest/telemetry/metric_reports.hpp"
+#include "psme/rest/security/account/account_manager.hpp"
 #include "configuration/configuration.hpp"
 #include "logger/logger_factory.hpp"
 
@@ -29,6 +31,12 @@
 
 using namespace psme::rest::server;
 
+namespace {
+
+constexpr std::size_t DEFAULT_RESPONSE_CACHE_ENTRIES = 1024;
+
+}
+
 
 RestServer::RestServer() {
     const json::Json& config = configuration::Configuration::get_instance().to_json();
@@ -37,6 +45,16 @@ RestServer::RestServer() {
     endpoint::EndpointBuilder endpoint_builder;
     endpoint_builder.build_endpoints();
 
+    const auto& rest = config.value("rest", json::Json::object());
+    const auto& response_cache = rest.value("response-cache", json::Json::object());
+    if (response_cache.value("enabled", false)) {
+        const auto max_entries = response_cache.value("max-entries", DEFAULT_RESPONSE_CACHE_ENTRIES);
+        log_info("rest", "Caching up to " << max_entries << " GET responses.");
+        Multiplexer::get_instance()->get_response_cache().set_max_entries(max_entries);
+    }
+
+    telemetry::MetricReports::get_instance()->configure(rest.value("telemetry-history", json::Json::object()));
+
     ConnectorFactory connector_factory{};
     for (const auto& connector_options: connectors_options) {
         m_connectors.emplace_back(
@@ -72,5 +90,25 @@ void RestServer::stop() {
     for (const auto& connector : m_connectors) {
         connector->stop();
     }
+    const auto& response_cache = Multiplexer::get_instance()->get_response_cache();
+    if (response_cache.is_enabled()) {
+        const auto statistics = response_cache.get_statistics();
+        log_info("rest", "Response cache hits: " << statistics.hits << ", misses: " << statistics.misses
+            << ", invalidations: " << statistics.invalidations << ".");
+    }
+    const auto& history = telemetry::MetricReports::get_instance()->get_history();
+    if (history.is_enabled()) {
+        const auto statistics = history.get_statistics();
+        log_info("rest", "Metric history: " << statistics.samples << " samples of " << statistics.metrics
+            << " metrics in " << statistics.memory_bytes << " bytes, " << statistics.dropped_chunks
+            << " chunks dropped.");
+    }
+    const auto& credential_cache = psme::rest::security::account::AccountManager::get_instance()->get_credential_cache();
+    if (credential_cache.is_enabled()) {
+        const auto statistics = credential_cache.get_statistics();
+        log_info("rest", "Credential cache hits: " << statistics.hits << ", misses: " << statistics.misses
+            << ", expirations: " << statistics.expirations << ", invalidations: " << statistics.invalidations
+            << ".");
+    }
     log_info("rest", "REST server stopped.");
 }
@@ -25,12 +25,21 @@
 #include "configuration/configuration.hpp"
 #include "utils/crypt_utils.hpp"
 #include "utils/conversion.hpp"
+#include "logger/logger_factory.hpp"
 #include <algorithm>
 
 using namespace psme::rest::security::account;
 
 constexpr char AccountManager::USER_NAME[];
 constexpr char AccountManager::PASSWORD_HASH[];
+constexpr char AccountManager::CREDENTIAL_CACHE[];
+
+namespace {
+
+constexpr std::size_t DEFAULT_CREDENTIAL_CACHE_ENTRIES = 64;
+constexpr std::int64_t DEFAULT_CREDENTIAL_CACHE_TTL_SEC = 60;
+
+}
 
 AccountManager::AccountManager() {
     const json::Json& config = configuration::Configuration::get_instance().to_json();
@@ -45,6 +54,14 @@ AccountManager::AccountManager() {
         account.set_password_hash(password_hash);
         add(account);
     }
+
+    const auto& credential_cache = authentication_config.value(CREDENTIAL_CACHE, json::Json::object());
+    if (credential_cache.value("enabled", false)) {
+        const auto max_entries = credential_cache.value("max-entries", DEFAULT_CREDENTIAL_CACHE_ENTRIES);
+        const auto ttl_sec = credential_cache.value("ttl-sec", DEFAULT_CREDENTIAL_CACHE_TTL_SEC);
+        log_info("rest", "Caching up to " << max_entries << " validated credentials for " << ttl_sec << "s.");
+        m_credential_cache.configure(max_entries, std::chrono::seconds(ttl_sec));
+    }
 }
 
 AccountManager::~AccountManager() {}
@@ -59,6 +76,14 @@ bool AccountManager::validate_credentials(const std::string& user_name, const st
     std::lock_guard<std::mutex> lock{m_mutex};
     auto iter = std::find_if(std::begin(m_accounts), std::end(m_accounts),
                              [this, &user_name, &password](const auto& account) {
+                                 if (account.second.get_user_name() != user_name) {
+                                     return false;
+                                 }
+                                 if (m_credential_cache.contains(user_name, password,
+                                                                 account.second.get_password_hash())) {
+                                     return true;
+                                 }
+
                                  // Password hash read from configuration is actually salt and hash concatenated together
                                  std::string salt_and_hash = account.second.get_password_hash();
                                  std::transform(salt_and_hash.begin(), salt_and_hash.end(), salt_and_hash.begin(), ::toupper);
@@ -69,8 +94,12 @@ bool AccountManager::validate_credentials(const std::string& user_name, const st
                                  std::string salt = salt_and_hash.substr(0, salt_size);
                                  std::string password_hash = salt_and_hash.substr(salt_size, hash_size);
 
-                                 return account.second.get_user_name() == user_name &&
-                                     password_hash == this->calculate_hash(password, utils::hex_string_to_string(salt));
+                                 const auto salt_bytes = utils::hex_string_to_string(salt);
+                                 if (password_hash != this->calculate_hash(password, salt_bytes)) {
+                                     return false;
+                                 }
+                                 m_credential_cache.put(user_name, password, account.second.get_password_hash());
+                                 return true;
                              });
     return iter != std::end(m_accounts);
 }
@@ -100,11 +129,22 @@ uint64_t AccountManager::add(Account account) {
     update_next_id();
     account.set_id(m_id);
     m_accounts[m_id] = std::move(account);
+    m_credential_cache.invalidate();
 
     return m_id;
 }
 
 
+void AccountManager::remove(uint64_t account_id) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (0 == m_accounts.erase(account_id)) {
+        throw agent_framework::exceptions::NotFound(std::string{"Account (ID: "}
+                                                    + std::to_string(account_id) + ") not found.");
+    }
+    m_credential_cache.invalidate();
+}
+
+
 void AccountManager::for_each(const AccountCallback& handle) const {
     std::lock_guard<std::mutex> lock{m_mutex};
     for (const auto& entry : m_accounts) {
@@ -0,0 +1,135 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file credential_cache.cpp
+ * */
+
+#include "psme/rest/security/account/credential_cache.hpp"
+#include "utils/crypt_utils.hpp"
+
+using namespace psme::rest::security::account;
+
+
+CredentialCache::CredentialCache() : m_key(utils::generate_key()) {}
+
+
+void CredentialCache::configure(std::size_t max_entries, Clock::duration time_to_live) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_max_entries = max_entries;
+    m_time_to_live = time_to_live;
+    while (m_entries.size() > m_max_entries) {
+        m_index.erase(m_entries.back().digest);
+        m_entries.pop_back();
+    }
+}
+
+
+bool CredentialCache::is_enabled() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return 0 != m_max_entries;
+}
+
+
+std::size_t CredentialCache::get_max_entries() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_max_entries;
+}
+
+
+CredentialCache::Clock::duration CredentialCache::get_time_to_live() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_time_to_live;
+}
+
+
+bool CredentialCache::contains(const std::string& user_name, const std::string& password,
+                               const std::string& password_hash) {
+    if (!is_enabled()) {
+        return false;
+    }
+    const auto digest = get_digest(user_name, password);
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = m_index.find(digest);
+    if (it == m_index.end()) {
+        ++m_statistics.misses;
+        return false;
+    }
+
+    auto entry = it->second;
+    if (entry->expires <= Clock::now()) {
+        ++m_statistics.expirations;
+    }
+    else if (entry->password_hash != password_hash) {
+        ++m_statistics.invalidations;
+    }
+    else {
+        ++m_statistics.hits;
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+        return true;
+    }
+    ++m_statistics.misses;
+    m_index.erase(it);
+    m_entries.erase(entry);
+    return false;
+}
+
+
+void CredentialCache::put(const std::string& user_name, const std::string& password,
+                          const std::string& password_hash) {
+    if (!is_enabled()) {
+        return;
+    }
+    const auto digest = get_digest(user_name, password);
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = m_index.find(digest);
+    if (it != m_index.end()) {
+        m_entries.erase(it->second);
+        m_index.erase(it);
+    }
+    m_entries.push_front(Entry{digest, password_hash, Clock::now() + m_time_to_live});
+    m_index[digest] = m_entries.begin();
+    while (m_entries.size() > m_max_entries) {
+        m_index.erase(m_entries.back().digest);
+        m_entries.pop_back();
+    }
+}
+
+
+void CredentialCache::invalidate() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_statistics.invalidations += m_entries.size();
+    m_entries.clear();
+    m_index.clear();
+}
+
+
+CredentialCache::Statistics CredentialCache::get_statistics() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto statistics = m_statistics;
+    statistics.entries = m_entries.size();
+    return statistics;
+}
+
+
+std::string CredentialCache::get_digest(const std::string& user_name, const std::string& password) const {
+    /* user name length is a part of the digested text, so user name and password cannot be shifted */
+    return utils::keyed_hash(std::to_string(user_name.size()) + ":" + user_name + password, m_key);
+}
@@ -34,16 +34,14 @@ using namespace psme::rest::security::account;
 using namespace psme::rest::server;
 
 
-bool BasicAuthentication::credentials_valid(MHD_Connection* connection) {
+AuthStatus
+BasicAuthentication::perform(MHD_Connection* connection, const std::string& url, server::Response& response) {
 
     char* user = nullptr;
     char* pass = nullptr;
 
     user = MHD_basic_auth_get_username_password(connection, &pass);
-    bool success = false;
-    if (user && pass) {
-        success = AccountManager::get_instance()->validate_credentials(std::string(user), std::string(pass));
-    }
+    const auto status = perform(user, pass, url, response);
 
     if (user != NULL) {
         free(user);
@@ -51,13 +49,14 @@ bool BasicAuthentication::credentials_valid(MHD_Connection* connection) {
     if (pass != NULL) {
         free(pass);
     }
-    return success;
+    return status;
 }
 
 
-AuthStatus
-BasicAuthentication::perform(MHD_Connection* connection, const std::string& url, server::Response& response) {
-    if (!credentials_valid(connection)) {
+AuthStatus BasicAuthentication::perform(const char* user_name, const char* password, const std::string& url,
+                                        server::Response& response) {
+    if (!user_name || !password
+        || !AccountManager::get_instance()->validate_credentials(std::string(user_name), std::string(password))) {
         response.set_status(server::status_4XX::UNAUTHORIZED);
         auto header_value = std::string(server::http_headers::WWWAuthenticate::BASIC)
                             + " " + std::string(server::http_headers::WWWAuthenticate::REALM)
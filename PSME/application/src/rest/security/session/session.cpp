@@ -35,6 +35,24 @@ namespace rest {
 namespace security {
 namespace session {
 
+Session::Session(const Session& other) :
+    m_id(other.m_id),
+    m_user_name(other.m_user_name),
+    m_session_auth_token(other.m_session_auth_token),
+    m_origin_header(other.m_origin_header),
+    m_last_used(other.m_last_used.load()) {}
+
+
+Session& Session::operator=(const Session& other) {
+    m_id = other.m_id;
+    m_user_name = other.m_user_name;
+    m_session_auth_token = other.m_session_auth_token;
+    m_origin_header = other.m_origin_header;
+    m_last_used = other.m_last_used.load();
+    return *this;
+}
+
+
 json::Json Session::to_json() const {
     json::Json j = json::Json();
     fill_json(j);
@@ -63,7 +81,12 @@ Session Session::from_json(const json::Json& json) {
 
 
 bool Session::is_session_valid(const std::chrono::seconds& session_timeout) const {
-    return get_last_used() + session_timeout >= std::chrono::steady_clock::now();
+    return is_session_valid(session_timeout, std::chrono::steady_clock::now());
+}
+
+
+bool Session::is_session_valid(const std::chrono::seconds& session_timeout, const Timepoint& now) const {
+    return get_last_used() + session_timeout >= now;
 }
 
 
@@ -24,19 +24,39 @@
 #include "psme/rest/security/session/session_service_manager.hpp"
 #include "psme/rest/server/error/server_exception.hpp"
 #include "uuid/uuid.hpp"
+#include <algorithm>
 #include <fstream>
 
 
+namespace {
+
+std::chrono::seconds::rep to_tick(const psme::rest::security::session::Session::Timepoint& timepoint) {
+    return std::chrono::duration_cast<std::chrono::seconds>(timepoint.time_since_epoch()).count();
+}
+
+}
+
+
 namespace psme {
 namespace rest {
 namespace security {
 namespace session {
 
+constexpr std::size_t SessionManager::WHEEL_SLOTS;
+
+
+SessionManager::SessionManager() : SessionManager(&std::chrono::steady_clock::now) {}
+
+
+SessionManager::SessionManager(Clock clock) :
+    m_clock(std::move(clock)), m_wheel(WHEEL_SLOTS), m_wheel_tick(to_tick(m_clock())) {}
+
+
 SessionManager::~SessionManager() {}
 
 
 const Session& SessionManager::get(uint64_t session_id) const {
-    std::lock_guard<std::mutex> lock{m_mutex};
+    std::shared_lock<std::shared_timed_mutex> lock{m_mutex};
     auto it = m_sessions.find(session_id);
     if (it == m_sessions.end()) {
         throw agent_framework::exceptions::NotFound(std::string{"Session (ID: "}
@@ -47,7 +67,7 @@ const Session& SessionManager::get(uint64_t session_id) const {
 
 
 void SessionManager::for_each(const SessionCallback& handle) const {
-    std::lock_guard<std::mutex> lock{m_mutex};
+    std::shared_lock<std::shared_timed_mutex> lock{m_mutex};
     for (const auto& entry : m_sessions) {
         handle(entry.second);
     }
@@ -68,64 +88,110 @@ void SessionManager::update_next_id(void) {
 
 
 uint64_t SessionManager::add(Session session) {
-    std::lock_guard<std::mutex> lock{m_mutex};
+    const std::chrono::seconds session_timeout = SessionServiceManager::get_instance()->get_session_timeout();
+    std::unique_lock<std::shared_timed_mutex> lock{m_mutex};
 
     /* find first not used session ID */
     update_next_id();
     session.set_id(m_id);
     session.set_session_auth_token(make_v1_uuid());
-    session.update_last_used();
-    m_sessions[m_id] = std::move(session);
+    session.set_last_used(m_clock());
+    auto it = m_sessions.emplace(m_id, std::move(session)).first;
+    m_tokens[it->second.get_session_auth_token()] = it;
+    schedule(it->second, session_timeout);
 
     return m_id;
 }
 
 
 void SessionManager::del(uint64_t subscription_id) {
-    std::lock_guard<std::mutex> lock{m_mutex};
+    std::unique_lock<std::shared_timed_mutex> lock{m_mutex};
     auto it = m_sessions.find(subscription_id);
     if (it == m_sessions.end()) {
         throw agent_framework::exceptions::NotFound(std::string{"Subscription (ID: "}
                                                     + std::to_string(subscription_id) + ") not found.");
     }
+    /* ID is left in the timer wheel, it is skipped when the slot is processed */
+    erase(it);
+}
+
+
+void SessionManager::erase(SessionMap::iterator it) {
+    m_tokens.erase(it->second.get_session_auth_token());
     m_sessions.erase(it);
 }
 
 
-void SessionManager::remove_outdated_sessions(void) {
-    std::lock_guard<std::mutex> lock{m_mutex};
+void SessionManager::schedule(const Session& session, const std::chrono::seconds& session_timeout) {
+    /* session is checked in the first tick after it has expired */
+    const auto tick = to_tick(session.get_last_used() + session_timeout) + 1;
+    m_wheel[std::size_t(tick) % WHEEL_SLOTS].push_back(session.get_id());
+}
+
 
-    auto it = m_sessions.begin();
-    auto endIter = m_sessions.end();
+std::size_t SessionManager::remove_outdated_sessions(void) {
+    const std::chrono::seconds session_timeout = SessionServiceManager::get_instance()->get_session_timeout();
+    std::unique_lock<std::shared_timed_mutex> lock{m_mutex};
 
-    while (it != endIter) {
-        if (it->second.get_last_used() +
-            std::chrono::seconds(SessionServiceManager::get_instance()->get_session_timeout()) <
-            std::chrono::steady_clock::now()) {
-            m_sessions.erase(it++);
+    if (session_timeout != m_wheel_timeout) {
+        /* all sessions are scheduled again with the new timeout */
+        for (auto& slot : m_wheel) {
+            slot.clear();
+        }
+        for (const auto& entry : m_sessions) {
+            schedule(entry.second, session_timeout);
         }
-        else {
-            ++it;
+        m_wheel_timeout = session_timeout;
+    }
+
+    const auto now = m_clock();
+    const auto now_tick = to_tick(now);
+
+    /* each slot is processed once at most. Sessions used in the meantime are scheduled again */
+    std::size_t checked{0};
+    for (auto tick = std::max(m_wheel_tick + 1, now_tick - Tick(WHEEL_SLOTS) + 1); tick <= now_tick; ++tick) {
+        std::vector<std::uint64_t> ids{};
+        ids.swap(m_wheel[std::size_t(tick) % WHEEL_SLOTS]);
+        for (const auto id : ids) {
+            auto it = m_sessions.find(id);
+            if (it == m_sessions.end()) {
+                continue;
+            }
+            ++checked;
+            if (!it->second.is_session_valid(session_timeout, now)) {
+                erase(it);
+            }
+            else {
+                schedule(it->second, session_timeout);
+            }
         }
     }
+    m_wheel_tick = std::max(m_wheel_tick, now_tick);
+    return checked;
 }
 
 
 bool SessionManager::is_session_valid(const std::string& token, const std::string& http_origin) {
-    std::lock_guard<std::mutex> lock{m_mutex};
-    auto it = std::find_if(begin(m_sessions), end(m_sessions), [&token, &http_origin](auto& pair) {
-        return pair.second.get_session_auth_token() == token && pair.second.get_origin_header() == http_origin;
-    });
-
-    if (it != std::end(m_sessions)) {
-        if (it->second.is_session_valid(SessionServiceManager::get_instance()->get_session_timeout())) {
-            m_sessions[it->first].update_last_used();
-            return true;
+    const std::chrono::seconds session_timeout = SessionServiceManager::get_instance()->get_session_timeout();
+    {
+        std::shared_lock<std::shared_timed_mutex> lock{m_mutex};
+        auto it = m_tokens.find(token);
+        if ((it == m_tokens.end()) || (it->second->second.get_origin_header() != http_origin)) {
+            return false;
         }
-        else {
-            m_sessions.erase(it);
+        const auto now = m_clock();
+        if (it->second->second.is_session_valid(session_timeout, now)) {
+            it->second->second.set_last_used(now);
+            return true;
         }
     }
+
+    /* outdated session is removed, unless it was used concurrently */
+    std::unique_lock<std::shared_timed_mutex> lock{m_mutex};
+    auto it = m_tokens.find(token);
+    if ((it != m_tokens.end()) && !it->second->second.is_session_valid(session_timeout, m_clock())) {
+        erase(it->second);
+    }
     return false;
 }
 
@@ -83,6 +83,15 @@ int add_request_headers(void* cls, enum MHD_ValueKind /*kind*/,
 }
 
 
+int add_query_parameters(void* cls, enum MHD_ValueKind /*kind*/,
+                         const char* key, const char* value) {
+    Request* request = static_cast<Request*>(cls);
+    request->query.set(key, nullptr != value ? value : "");
+
+    return MHD_YES;
+}
+
+
 Method get_request_method(const char* method) {
     try {
         return Method::from_string(method);
@@ -142,6 +151,8 @@ int access_handler_callback(void* cls, struct MHD_Connection* connection,
 
     MHD_get_connection_values(connection, MHD_HEADER_KIND,
                               &add_request_headers, request.get());
+    MHD_get_connection_values(connection, MHD_GET_ARGUMENT_KIND,
+                              &add_query_parameters, request.get());
 
     Response response;
 
@@ -0,0 +1,137 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#include "psme/rest/server/entity_tags.hpp"
+#include "psme/rest/server/http_headers.hpp"
+#include "psme/rest/server/utils.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+using namespace psme::rest::server;
+using agent_framework::module::ReadTracker;
+
+constexpr std::size_t EntityTags::MAX_ENTRIES;
+
+namespace {
+
+constexpr const char WEAK_PREFIX[] = "W/";
+
+
+std::string make_instance() {
+    std::random_device device{};
+    std::stringstream instance{};
+    instance << device() << '.' << std::chrono::system_clock::now().time_since_epoch().count();
+    return instance.str();
+}
+
+
+std::string trim(const std::string& value) {
+    const auto begin = value.find_first_not_of(' ');
+    if (std::string::npos == begin) {
+        return {};
+    }
+    return value.substr(begin, value.find_last_not_of(' ') - begin + 1);
+}
+
+}
+
+
+EntityTags::EntityTags() : m_instance{make_instance()} { }
+
+
+std::string EntityTags::get(const std::string& key) const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    const auto it = m_entries.find(key);
+    if (m_entries.end() != it && ReadTracker::is_up_to_date(it->second.dependencies)) {
+        return it->second.etag;
+    }
+    return {};
+}
+
+
+std::string EntityTags::put(const std::string& key, const Dependencies& dependencies) {
+    std::stringstream state{};
+    state << m_instance << ' ' << key;
+    for (const auto& dependency : dependencies) {
+        state << ' ' << dependency.first << ':' << dependency.second;
+    }
+    std::stringstream etag{};
+    etag << '"' << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>{}(state.str()) << '"';
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (m_entries.size() >= MAX_ENTRIES && !m_entries.count(key)) {
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (ReadTracker::is_up_to_date(it->second.dependencies)) {
+                ++it;
+            }
+            else {
+                it = m_entries.erase(it);
+            }
+        }
+        if (m_entries.size() >= MAX_ENTRIES) {
+            m_entries.clear();
+        }
+    }
+    m_entries[key] = Entry{dependencies, etag.str()};
+    return etag.str();
+}
+
+
+void EntityTags::invalidate(const std::string& url) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (is_related_url(it->first.substr(0, it->first.find('?')), url)) {
+            it = m_entries.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+
+bool EntityTags::matches(const std::string& if_none_match, const std::string& etag) {
+    if (etag.empty()) {
+        return false;
+    }
+    std::string::size_type begin = 0;
+    while (begin <= if_none_match.size()) {
+        auto end = if_none_match.find(',', begin);
+        if (std::string::npos == end) {
+            end = if_none_match.size();
+        }
+        auto tag = trim(if_none_match.substr(begin, end - begin));
+        if (http_headers::IfNoneMatch::ANY == tag) {
+            return true;
+        }
+        // If-None-Match uses the weak comparison
+        if (0 == tag.compare(0, sizeof(WEAK_PREFIX) - 1, WEAK_PREFIX)) {
+            tag.erase(0, sizeof(WEAK_PREFIX) - 1);
+        }
+        if (etag == tag) {
+            return true;
+        }
+        begin = end + 1;
+    }
+    return false;
+}
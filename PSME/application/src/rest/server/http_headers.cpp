@@ -71,6 +71,18 @@ namespace Location {
 const char LOCATION[] = "Location";
 }
 
+namespace ETag {
+/*! @brief ETag header constant */
+const char ETAG[] = "ETag";
+}
+
+namespace IfNoneMatch {
+/*! @brief If-None-Match header constant */
+const char IF_NONE_MATCH[] = "If-None-Match";
+/*! @brief If-None-Match header value matching any entity tag */
+const char ANY[] = "*";
+}
+
 }
 }
 }
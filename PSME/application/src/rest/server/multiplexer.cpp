@@ -38,13 +38,18 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  * */
+#include "psme/rest/constants/constants.hpp"
 #include "psme/rest/constants/routes.hpp"
 #include "psme/rest/server/status.hpp"
 #include "psme/rest/server/mux/matchers.hpp"
 #include "psme/rest/server/multiplexer.hpp"
 #include "psme/rest/server/utils.hpp"
+#include "psme/rest/server/http_headers.hpp"
 #include "psme/rest/server/error/error_factory.hpp"
 
+#include <algorithm>
+#include <map>
+
 
 
 using namespace psme::rest::server;
@@ -60,6 +65,24 @@ void collect_request_params(Request& req, const mux::SegmentsVec& segments,
 }
 
 
+std::string make_entity_key(const Request& request) {
+    const std::map<std::string, std::string> query{request.query.begin(), request.query.end()};
+    std::string key = request.get_url();
+    char separator = '?';
+    for (const auto& parameter : query) {
+        key.append(1, separator).append(parameter.first).append(1, '=').append(parameter.second);
+        separator = '&';
+    }
+    return key;
+}
+
+
+bool is_reference(const json::Json& json) {
+    return json.is_object() && 1 == json.size() && json.count(psme::rest::constants::Common::ODATA_ID) &&
+        json[psme::rest::constants::Common::ODATA_ID].is_string();
+}
+
+
 void execute_handler(MethodsHandler& h, Request& req, Response& res) {
     switch (req.get_method()) {
         case Method::GET:
@@ -99,30 +122,36 @@ void Multiplexer::use_after(RequestHandler plugin) {
 
 
 void Multiplexer::register_handler(MethodsHandler::UPtr handler, AccessType access_type) {
-    const auto& path = handler->get_path();
+    const std::string path = handler->get_path();
     // Find existing candidate
-    for (auto& candidate : m_handler_candidates) {
-        if (std::get<2>(candidate) == path) {
-            log_error("rest", "Attempted to register a duplicate handler for " + handler->get_path() + ".");
-            return;
-        }
+    if (m_candidate_indexes.count(path)) {
+        log_error("rest", "Attempted to register a duplicate handler for " + path + ".");
+        return;
     }
 
+    const auto index = m_handler_candidates.size();
     m_handler_candidates.emplace_back(PathHandlerCandidate(mux::path_to_segments(path),
                                                            std::move(handler), path, access_type));
+    m_candidate_indexes.emplace(path, index);
+    m_routes.insert(path, index);
+}
+
+
+std::vector<std::string> Multiplexer::get_path_templates() const {
+    std::vector<std::string> path_templates{};
+    path_templates.reserve(m_handler_candidates.size());
+    for (const auto& candidate : m_handler_candidates) {
+        path_templates.emplace_back(std::get<2>(candidate));
+    }
+    return path_templates;
 }
 
 
 const Multiplexer::PathHandlerCandidate& Multiplexer::select_handler(const std::vector<std::string>& segments,
                                                                      const std::string& uri) const {
-    auto it = std::find_if(std::begin(m_handler_candidates),
-                           std::end(m_handler_candidates),
-                           [&segments](const PathHandlerCandidate& candidate) {
-                               return mux::segments_match(std::get<0>(candidate), segments);
-                           });
-
-    if (it != std::end(m_handler_candidates)) {
-        return *it;
+    const auto index = m_routes.find(segments);
+    if (mux::RouteTrie::NO_ROUTE != index) {
+        return m_handler_candidates[index];
     }
 
     // If no handler was matched throw a 404
@@ -164,34 +193,198 @@ void Multiplexer::forward_to_handler(Response& response, Request& request) {
     // Collect parameters from REST path segments
     collect_request_params(request, std::get<0>(candidate), request_segments);
 
-    execute_handler(method_handler, request, response);
+    request.set_query_options(QueryOptions::from_query(request.query));
+
+    if (Method::GET == request.get_method()) {
+        execute_get(method_handler, request, response);
+        return;
+    }
+
+    try {
+        execute_handler(method_handler, request, response);
+    }
+    catch (...) {
+        invalidate(url);
+        throw;
+    }
+    invalidate(url);
 }
 
 
-bool Multiplexer::is_correct_endpoint_url(const std::string& url) const {
-    auto request_segments = mux::split_path(url);
-    auto it = std::find_if(std::begin(m_handler_candidates),
-                           std::end(m_handler_candidates),
-                           [&request_segments](const PathHandlerCandidate& candidate) {
-                               return mux::segments_match(std::get<0>(candidate), request_segments);
-                           });
+void Multiplexer::execute_get(MethodsHandler& handler, const Request& request, Response& response) {
+    const auto key = make_entity_key(request);
+    const auto if_none_match = request.get_header(http_headers::IfNoneMatch::IF_NONE_MATCH);
+
+    // Resource is not built if the client has its current version
+    if (!if_none_match.empty()) {
+        const auto etag = m_entity_tags.get(key);
+        if (EntityTags::matches(if_none_match, etag)) {
+            response.set_status(status_3XX::NOT_MODIFIED);
+            response.set_header(http_headers::ETag::ETAG, etag);
+            return;
+        }
+    }
+
+    // Responses are cached separately for each access context
+    const auto cache_key = (request.is_secure() ? "https:" : "http:") + key;
+    const auto use_cache = m_response_cache.is_enabled();
+    if (use_cache && m_response_cache.get(cache_key, response)) {
+        const auto& headers = response.get_headers();
+        const auto etag = headers.find(http_headers::ETag::ETAG);
+        if (headers.end() != etag && EntityTags::matches(if_none_match, etag->second)) {
+            response.set_status(status_3XX::NOT_MODIFIED);
+            response.set_body({});
+        }
+        return;
+    }
+
+    agent_framework::module::ReadTracker tracker{};
+    handler.get(request, response);
+    if (!request.get_query_options().empty()) {
+        apply_query_options(request, response);
+    }
 
-    return it != std::end(m_handler_candidates);
+    // Responses which are not built from the model only have no entity tags and are not cached
+    if (status_2XX::OK == response.get_status() && tracker.is_tracked() && !tracker.get_dependencies().empty()) {
+        const auto etag = m_entity_tags.put(key, tracker.get_dependencies());
+        response.set_header(http_headers::ETag::ETAG, etag);
+        if (use_cache) {
+            m_response_cache.put(cache_key, request.get_url(), tracker.get_dependencies(), response);
+        }
+        if (EntityTags::matches(if_none_match, etag)) {
+            response.set_status(status_3XX::NOT_MODIFIED);
+            response.set_body({});
+        }
+    }
 }
 
 
-Parameters Multiplexer::get_params(const std::string& path, const std::string& path_template) const {
-    auto it = std::find_if(m_handler_candidates.begin(), m_handler_candidates.end(),
-                           [&path_template](const PathHandlerCandidate& candidate) {
-                               return std::get<2>(candidate) == path_template;
-                           }
-    );
-    if (it == m_handler_candidates.end()) {
+void Multiplexer::invalidate(const std::string& url) {
+    m_entity_tags.invalidate(url);
+    m_response_cache.invalidate(url);
+}
+
+
+void Multiplexer::apply_query_options(const Request& request, Response& response) {
+    if (status_2XX::OK != response.get_status()) {
+        return;
+    }
+
+    json::Json json{};
+    try {
+        json = json::Json::parse(response.get_body());
+    }
+    catch (const std::exception&) {
+        return;
+    }
+
+    const auto& options = request.get_query_options();
+    options.apply_paging(json, request.get_url());
+    if (QueryOptions::ExpandType::NONE != options.get_expand()) {
+        // Properties which are not selected are not expanded
+        options.apply_select(json);
+        std::vector<std::string> expanded_urls{request.get_url()};
+        expand_references(request, json, options.get_expand_levels(), false, expanded_urls);
+    }
+    options.apply_select(json);
+
+    response.set_body(json.dump());
+}
+
+
+void Multiplexer::expand_references(const Request& request, json::Json& json, std::uint32_t levels, bool in_links,
+                                    std::vector<std::string>& expanded_urls) {
+    if (is_reference(json)) {
+        const auto url = json[constants::Common::ODATA_ID].get<std::string>();
+        // Resources being expanded are not expanded again (references back to parents)
+        if (!request.get_query_options().is_expanded(in_links) ||
+            std::find(expanded_urls.begin(), expanded_urls.end(), url) != expanded_urls.end()) {
+            return;
+        }
+
+        json::Json resource{};
+        if (get_resource(request, url, resource)) {
+            if (levels > 1) {
+                expanded_urls.push_back(url);
+                expand_references(request, resource, levels - 1, false, expanded_urls);
+                expanded_urls.pop_back();
+            }
+            json = std::move(resource);
+        }
+    }
+    else if (json.is_array()) {
+        for (auto& element : json) {
+            expand_references(request, element, levels, in_links, expanded_urls);
+        }
+    }
+    else if (json.is_object()) {
+        for (auto it = json.begin(); it != json.end(); ++it) {
+            expand_references(request, it.value(), levels, in_links || constants::Common::LINKS == it.key(),
+                              expanded_urls);
+        }
+    }
+}
+
+
+bool Multiplexer::get_resource(const Request& request, const std::string& url, json::Json& resource) {
+    // References to properties of resources (JSON pointers) are not expanded
+    if (std::string::npos != url.find('#')) {
+        return false;
+    }
+
+    const auto segments = mux::split_path(url);
+    const auto index = m_routes.find(segments);
+    if (mux::RouteTrie::NO_ROUTE == index) {
+        return false;
+    }
+    const auto& candidate = m_handler_candidates[index];
+
+    // Headers, source and security of the original request are kept
+    Request resource_request{request};
+    resource_request.set_destination(url);
+    resource_request.set_body({});
+    resource_request.params = Parameters{};
+    resource_request.query = Parameters{};
+    resource_request.set_query_options(QueryOptions{});
+
+    Response resource_response{};
+    if (!is_access_allowed(resource_response, resource_request, candidate)) {
+        return false;
+    }
+    collect_request_params(resource_request, std::get<0>(candidate), segments);
+
+    try {
+        std::get<1>(candidate)->get(resource_request, resource_response);
+        if (status_2XX::OK != resource_response.get_status()) {
+            return false;
+        }
+        resource = json::Json::parse(resource_response.get_body());
+        return resource.is_object();
+    }
+    catch (const std::exception& e) {
+        log_debug("rest", "Resource " << url << " not expanded: " << e.what());
+        return false;
+    }
+}
+
+
+bool Multiplexer::is_correct_endpoint_url(const std::string& url) const {
+    return mux::RouteTrie::NO_ROUTE != m_routes.find(mux::split_path(url));
+}
+
+
+const Multiplexer::PathHandlerCandidate& Multiplexer::get_candidate(const std::string& path_template) const {
+    const auto it = m_candidate_indexes.find(path_template);
+    if (it == m_candidate_indexes.end()) {
         // path_template must be an existing endpoint path
         throw std::logic_error("Unrecognized path template supplied to multiplexer.");
     }
+    return m_handler_candidates[it->second];
+}
+
 
-    const auto& handler = *it;
+Parameters Multiplexer::get_params(const std::string& path, const std::string& path_template) const {
+    const auto& handler = get_candidate(path_template);
     const auto path_segments = mux::split_path(path);
 
     if (!mux::segments_match(std::get<0>(handler), path_segments)) {
@@ -210,17 +403,7 @@ Parameters Multiplexer::get_params(const std::string& path, const std::string& p
 
 
 Parameters Multiplexer::try_get_params(const std::string& path, const std::string& path_template) const {
-    auto it = std::find_if(m_handler_candidates.begin(), m_handler_candidates.end(),
-                           [&path_template](const PathHandlerCandidate& candidate) {
-                               return std::get<2>(candidate) == path_template;
-                           }
-    );
-    if (it == m_handler_candidates.end()) {
-        // path_template must be an existing endpoint path
-        throw std::logic_error("Unrecognized path template supplied to multiplexer.");
-    }
-
-    const auto& handler = *it;
+    const auto& handler = get_candidate(path_template);
     const auto path_segments = mux::split_path(path);
     Parameters params{};
 
@@ -0,0 +1,47 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#include "psme/rest/server/mux/numeric_matcher.hpp"
+
+#include <algorithm>
+
+using namespace psme::rest::server::mux;
+
+constexpr const char NumericMatcher::REGEX[];
+
+NumericMatcher::~NumericMatcher() {}
+
+NumericMatcher::NumericMatcher(const std::string& variable_name) :
+    m_variable_name(variable_name) {}
+
+bool NumericMatcher::check_match(const std::string& path_segment) {
+    return is_number(path_segment);
+}
+
+void NumericMatcher::get_param(Parameters& params, const std::string& path_segment) {
+    if (!m_variable_name.empty()) {
+        params[m_variable_name] = path_segment;
+    }
+}
+
+bool NumericMatcher::is_number(const std::string& path_segment) {
+    return !path_segment.empty() &&
+           std::all_of(path_segment.begin(), path_segment.end(), [](char ch) { return ch >= '0' && ch <= '9'; });
+}
@@ -0,0 +1,116 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#include "psme/rest/server/mux/route_trie.hpp"
+#include "psme/rest/server/mux/matchers.hpp"
+
+#include <algorithm>
+
+using namespace psme::rest::server::mux;
+
+constexpr std::size_t RouteTrie::NO_ROUTE;
+
+struct RouteTrie::Node {
+    /*! @brief Index of the route ending in this node */
+    std::size_t route{NO_ROUTE};
+
+    std::unordered_map<std::string, NodePtr> static_children{};
+    NodePtr numeric_child{};
+
+    /*! @brief Children matched by segment matchers, in order of insertion */
+    std::vector<std::pair<std::string, std::pair<SegmentMatcherPtr, NodePtr>>> matcher_children{};
+
+    Node& get_child(const std::string& path_segment) {
+        const auto matcher = path_segment_to_matcher(path_segment);
+        if (std::dynamic_pointer_cast<StaticMatcher>(matcher)) {
+            auto& child = static_children[path_segment];
+            if (!child) {
+                child.reset(new Node{});
+            }
+            return *child;
+        }
+        if (std::dynamic_pointer_cast<NumericMatcher>(matcher)) {
+            if (!numeric_child) {
+                numeric_child.reset(new Node{});
+            }
+            return *numeric_child;
+        }
+        // variable names do not matter, only the patterns matched
+        const auto colon_index = path_segment.find(':');
+        std::string key{};
+        if (!path_segment.empty()) {
+            key = std::string::npos == colon_index ? "{}" : path_segment.substr(colon_index);
+        }
+        auto it = std::find_if(matcher_children.begin(), matcher_children.end(),
+                               [&key](const decltype(matcher_children)::value_type& child) {
+                                   return child.first == key;
+                               });
+        if (matcher_children.end() == it) {
+            matcher_children.emplace_back(key, std::make_pair(matcher, NodePtr{new Node{}}));
+            it = matcher_children.end() - 1;
+        }
+        return *it->second.second;
+    }
+};
+
+
+RouteTrie::RouteTrie() : m_root{new Node{}} {}
+
+
+RouteTrie::~RouteTrie() {}
+
+
+void RouteTrie::insert(const std::string& path, std::size_t route) {
+    Node* node = m_root.get();
+    for (const auto& path_segment : split_path(path)) {
+        node = &node->get_child(path_segment);
+    }
+    node->route = std::min(node->route, route);
+}
+
+
+std::size_t RouteTrie::find(const std::vector<std::string>& request_segments) const {
+    std::size_t found{NO_ROUTE};
+    find(*m_root, request_segments, 0, found);
+    return found;
+}
+
+
+void RouteTrie::find(const Node& node, const std::vector<std::string>& request_segments,
+                     std::size_t depth, std::size_t& found) {
+    if (request_segments.size() == depth) {
+        found = std::min(found, node.route);
+        return;
+    }
+
+    const auto& path_segment = request_segments[depth];
+    const auto static_child = node.static_children.find(path_segment);
+    if (node.static_children.end() != static_child) {
+        find(*static_child->second, request_segments, depth + 1, found);
+    }
+    if (node.numeric_child && NumericMatcher::is_number(path_segment)) {
+        find(*node.numeric_child, request_segments, depth + 1, found);
+    }
+    for (const auto& child : node.matcher_children) {
+        if (child.second.first->check_match(path_segment)) {
+            find(*child.second.second, request_segments, depth + 1, found);
+        }
+    }
+}
@@ -76,9 +76,12 @@ SegmentMatcherPtr path_segment_to_matcher(const std::string& path_segment) {
         if (colon_index == std::string::npos) {
             return std::make_shared<VariableMatcher>(trimmed_segment);
         }
-        return std::make_shared<RegexMatcher>(
-                trimmed_segment.substr(0, colon_index),
-                trimmed_segment.substr(colon_index + 1, std::string::npos));
+        const auto variable_name = trimmed_segment.substr(0, colon_index);
+        const auto regex = trimmed_segment.substr(colon_index + 1, std::string::npos);
+        if (regex == NumericMatcher::REGEX) {
+            return std::make_shared<NumericMatcher>(variable_name);
+        }
+        return std::make_shared<RegexMatcher>(variable_name, regex);
     }
     return std::make_shared<StaticMatcher>(path_segment);
 }
@@ -0,0 +1,275 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#include "psme/rest/server/query_options.hpp"
+#include "psme/rest/server/error/error_factory.hpp"
+#include "psme/rest/constants/constants.hpp"
+
+#include <algorithm>
+#include <map>
+
+using namespace psme::rest;
+using namespace psme::rest::server;
+using namespace psme::rest::constants;
+
+constexpr const char QueryOptions::EXPAND[];
+constexpr const char QueryOptions::SELECT[];
+constexpr const char QueryOptions::TOP[];
+constexpr const char QueryOptions::SKIP[];
+constexpr std::uint32_t QueryOptions::MAX_EXPAND_LEVELS;
+
+namespace {
+
+constexpr const char LEVELS_OPTION[] = "($levels=";
+
+
+error::ServerException make_format_exception(const std::string& option, const std::string& value,
+                                             const std::string& message) {
+    return error::ServerException(error::ErrorFactory::create_value_format_error(option, value, message));
+}
+
+
+bool is_number(const std::string& value) {
+    return !value.empty() && std::all_of(value.begin(), value.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+
+std::uint64_t parse_number(const std::string& option, const std::string& value) {
+    if (is_number(value)) {
+        try {
+            return std::stoull(value);
+        }
+        catch (const std::out_of_range&) { }
+    }
+    throw make_format_exception(option, value, "Value of " + option + " must be a non-negative integer.");
+}
+
+
+void parse_expand(QueryOptions& options, const std::string& value) {
+    static const std::map<std::string, QueryOptions::ExpandType> EXPAND_TYPES = {
+        {"*", QueryOptions::ExpandType::ALL},
+        {".", QueryOptions::ExpandType::SUBORDINATE},
+        {"~", QueryOptions::ExpandType::LINKS}
+    };
+
+    const auto type = EXPAND_TYPES.find(value.substr(0, 1));
+    if (EXPAND_TYPES.end() == type) {
+        throw make_format_exception(QueryOptions::EXPAND, value, "Supported values are '*', '.' and '~'.");
+    }
+
+    std::uint64_t levels = 1;
+    const auto levels_option = value.substr(1);
+    if (!levels_option.empty()) {
+        const std::string prefix{LEVELS_OPTION};
+        if (0 != levels_option.compare(0, prefix.size(), prefix) || ')' != levels_option.back()) {
+            throw make_format_exception(QueryOptions::EXPAND, value, "Only $levels option is supported.");
+        }
+        levels = parse_number(QueryOptions::EXPAND,
+                              levels_option.substr(prefix.size(), levels_option.size() - prefix.size() - 1));
+        if (levels < 1 || levels > QueryOptions::MAX_EXPAND_LEVELS) {
+            throw make_format_exception(QueryOptions::EXPAND, value,
+                                        "Value of $levels must be between 1 and " +
+                                        std::to_string(QueryOptions::MAX_EXPAND_LEVELS) + ".");
+        }
+    }
+    options.set_expand(type->second, static_cast<std::uint32_t>(levels));
+}
+
+
+std::string format_expand(QueryOptions::ExpandType type, std::uint32_t levels) {
+    std::string value{};
+    switch (type) {
+        case QueryOptions::ExpandType::ALL:
+            value = "*";
+            break;
+        case QueryOptions::ExpandType::SUBORDINATE:
+            value = ".";
+            break;
+        case QueryOptions::ExpandType::LINKS:
+            value = "~";
+            break;
+        case QueryOptions::ExpandType::NONE:
+        default:
+            return value;
+    }
+    if (1 != levels) {
+        value += LEVELS_OPTION + std::to_string(levels) + ")";
+    }
+    return value;
+}
+
+
+std::vector<std::string> parse_select(const std::string& value) {
+    std::vector<std::string> select{};
+    std::string::size_type begin = 0;
+    while (begin <= value.size()) {
+        auto end = value.find(',', begin);
+        if (std::string::npos == end) {
+            end = value.size();
+        }
+        auto property = value.substr(begin, end - begin);
+        property.erase(0, property.find_first_not_of(' '));
+        property.erase(property.find_last_not_of(' ') + 1);
+        if (property.empty() || '/' == property.front() || '/' == property.back()) {
+            throw make_format_exception(QueryOptions::SELECT, value, "Invalid list of selected properties.");
+        }
+        select.push_back(property);
+        begin = end + 1;
+    }
+    return select;
+}
+
+
+void select_properties(json::Json& json, const std::vector<std::string>& select) {
+    if (json.is_array()) {
+        for (auto& element : json) {
+            select_properties(element, select);
+        }
+        return;
+    }
+    if (!json.is_object()) {
+        return;
+    }
+
+    /* selected property -> its selected nested properties, empty if selected as a whole */
+    std::map<std::string, std::vector<std::string>> selected{};
+    for (const auto& property : select) {
+        const auto separator = property.find('/');
+        auto& nested = selected[property.substr(0, separator)];
+        if (std::string::npos == separator) {
+            nested.clear();
+            nested.emplace_back();
+        }
+        else if (nested.empty() || !nested.front().empty()) {
+            nested.push_back(property.substr(separator + 1));
+        }
+    }
+
+    for (auto it = json.begin(); it != json.end();) {
+        const auto& key = it.key();
+        /* annotations of the resource and of the selected properties (e.g. Members@odata.count) are kept */
+        const auto property = selected.find(key.substr(0, key.find('@')));
+        if (!key.empty() && '@' == key.front()) {
+            ++it;
+        }
+        else if (selected.end() == property) {
+            it = json.erase(it);
+        }
+        else {
+            if (key == property->first && !property->second.front().empty()) {
+                select_properties(it.value(), property->second);
+            }
+            ++it;
+        }
+    }
+}
+
+}
+
+
+QueryOptions QueryOptions::from_query(const Parameters& query) {
+    QueryOptions options{};
+    for (const auto& parameter : query) {
+        const auto& option = parameter.first;
+        const auto& value = parameter.second;
+        if (EXPAND == option) {
+            parse_expand(options, value);
+        }
+        else if (SELECT == option) {
+            options.set_select(parse_select(value));
+        }
+        else if (TOP == option) {
+            options.set_top(parse_number(option, value));
+        }
+        else if (SKIP == option) {
+            options.set_skip(parse_number(option, value));
+        }
+    }
+    return options;
+}
+
+
+bool QueryOptions::empty() const {
+    return ExpandType::NONE == m_expand && m_select.empty() && !m_top.has_value() && !m_skip.has_value();
+}
+
+
+bool QueryOptions::is_expanded(bool in_links) const {
+    switch (m_expand) {
+        case ExpandType::ALL:
+            return true;
+        case ExpandType::SUBORDINATE:
+            return !in_links;
+        case ExpandType::LINKS:
+            return in_links;
+        case ExpandType::NONE:
+        default:
+            return false;
+    }
+}
+
+
+void QueryOptions::apply_paging(json::Json& json, const std::string& url) const {
+    if (!m_top.has_value() && !m_skip.has_value()) {
+        return;
+    }
+    if (!json.is_object() || !json.count(Collection::MEMBERS) || !json[Collection::MEMBERS].is_array()) {
+        return;
+    }
+
+    auto& members = json[Collection::MEMBERS];
+    const auto size = members.size();
+    const auto begin = std::min<std::uint64_t>(m_skip.has_value() ? m_skip.value() : 0, size);
+    /* $top may be as large as the type allows, so begin + $top is not computed unless it fits */
+    const auto end = (!m_top.has_value() || m_top.value() >= size - begin) ? size : begin + m_top.value();
+
+    json::Json page = json::Json::array();
+    for (auto index = begin; index < end; ++index) {
+        page.push_back(std::move(members[static_cast<std::size_t>(index)]));
+    }
+    members = std::move(page);
+
+    if (end < size) {
+        /* the next page is requested with the same options */
+        auto next_link = url + "?";
+        if (ExpandType::NONE != m_expand) {
+            next_link += std::string{EXPAND} + "=" + format_expand(m_expand, m_expand_levels) + "&";
+        }
+        if (!m_select.empty()) {
+            std::string select{};
+            for (const auto& property : m_select) {
+                select += (select.empty() ? "" : ",") + property;
+            }
+            next_link += std::string{SELECT} + "=" + select + "&";
+        }
+        next_link += std::string{SKIP} + "=" + std::to_string(end);
+        if (m_top.has_value()) {
+            next_link += std::string{"&"} + TOP + "=" + std::to_string(m_top.value());
+        }
+        json[Collection::ODATA_NEXT_LINK] = next_link;
+    }
+}
+
+
+void QueryOptions::apply_select(json::Json& json) const {
+    if (!m_select.empty()) {
+        select_properties(json, m_select);
+    }
+}
@@ -120,3 +120,11 @@ const std::string& Request::get_body() const {
 bool Request::is_secure() const {
     return m_is_secure;
 }
+
+void Request::set_query_options(const QueryOptions& query_options) {
+    m_query_options = query_options;
+}
+
+const QueryOptions& Request::get_query_options() const {
+    return m_query_options;
+}
@@ -0,0 +1,110 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#include "psme/rest/server/response_cache.hpp"
+#include "psme/rest/server/status.hpp"
+#include "psme/rest/server/utils.hpp"
+
+using namespace psme::rest::server;
+using agent_framework::module::ReadTracker;
+
+
+void ResponseCache::set_max_entries(std::size_t max_entries) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_max_entries = max_entries;
+    while (m_entries.size() > m_max_entries) {
+        erase(std::prev(m_entries.end()));
+    }
+}
+
+
+bool ResponseCache::is_enabled() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return 0 != m_max_entries;
+}
+
+
+bool ResponseCache::get(const std::string& key, Response& response) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    const auto it = m_index.find(key);
+    if (m_index.end() == it) {
+        ++m_statistics.misses;
+        return false;
+    }
+    if (!ReadTracker::is_up_to_date(it->second->dependencies)) {
+        erase(it->second);
+        ++m_statistics.misses;
+        return false;
+    }
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    const auto& entry = m_entries.front();
+    response.set_status(status_2XX::OK);
+    for (const auto& header : entry.headers) {
+        response.set_header(header.first, header.second);
+    }
+    response.set_body(entry.body);
+    ++m_statistics.hits;
+    return true;
+}
+
+
+void ResponseCache::put(const std::string& key, const std::string& url, const Dependencies& dependencies,
+                        const Response& response) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (0 == m_max_entries) {
+        return;
+    }
+    const auto it = m_index.find(key);
+    if (m_index.end() != it) {
+        erase(it->second);
+    }
+    else if (m_entries.size() >= m_max_entries) {
+        erase(std::prev(m_entries.end()));
+    }
+    m_entries.push_front(Entry{key, url, dependencies, response.get_headers(), response.get_body()});
+    m_index[key] = m_entries.begin();
+}
+
+
+void ResponseCache::invalidate(const std::string& url) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        const auto entry = it++;
+        if (is_related_url(entry->url, url)) {
+            erase(entry);
+            ++m_statistics.invalidations;
+        }
+    }
+}
+
+
+ResponseCache::Statistics ResponseCache::get_statistics() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto statistics = m_statistics;
+    statistics.entries = m_entries.size();
+    return statistics;
+}
+
+
+void ResponseCache::erase(Entries::iterator entry) {
+    m_index.erase(entry->key);
+    m_entries.erase(entry);
+}
@@ -59,3 +59,14 @@ std::string psme::rest::server::build_location_header(const std::string& host_he
     return scheme + tmp_host_header + resource_path;
 }
 
+bool psme::rest::server::is_related_url(const std::string& url, const std::string& other_url) {
+    const auto& shorter = url.size() < other_url.size() ? url : other_url;
+    const auto& longer = url.size() < other_url.size() ? other_url : url;
+    if (0 != longer.compare(0, shorter.size(), shorter)) {
+        return false;
+    }
+    if (longer.size() == shorter.size() || shorter.empty()) {
+        return true;
+    }
+    return '/' == longer[shorter.size()] || '/' == shorter.back();
+}
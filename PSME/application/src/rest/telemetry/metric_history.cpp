@@ -0,0 +1,365 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file metric_history.cpp
+ * */
+
+#include "psme/rest/telemetry/metric_history.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace psme::rest::telemetry;
+using agent_framework::module::ReadTracker;
+
+namespace {
+
+/*! Encoding of a value, stored in the lowest bits of the timestamp delta */
+enum Tag : std::uint8_t {
+    SAME = 0,
+    INTEGER = 1,
+    DOUBLE = 2,
+    NULL_VALUE = 3,
+    TRUE_VALUE = 4,
+    FALSE_VALUE = 5,
+    STRING = 6,
+    OTHER = 7
+};
+
+constexpr unsigned TAG_BITS = 3;
+constexpr std::uint64_t TAG_MASK = (1u << TAG_BITS) - 1;
+
+
+void put_varint(std::vector<std::uint8_t>& data, std::uint64_t value) {
+    while (value >= 0x80) {
+        data.push_back(std::uint8_t(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(std::uint8_t(value));
+}
+
+
+std::uint64_t get_varint(const std::vector<std::uint8_t>& data, std::size_t& position) {
+    std::uint64_t value{0};
+    unsigned shift{0};
+    while (data[position] & 0x80) {
+        value |= std::uint64_t(data[position++] & 0x7f) << shift;
+        shift += 7;
+    }
+    return value | (std::uint64_t(data[position++]) << shift);
+}
+
+
+void put_string(std::vector<std::uint8_t>& data, const std::string& value) {
+    put_varint(data, value.size());
+    data.insert(data.end(), value.begin(), value.end());
+}
+
+
+std::string get_string(const std::vector<std::uint8_t>& data, std::size_t& position) {
+    const auto size = std::size_t(get_varint(data, position));
+    std::string value(data.begin() + std::ptrdiff_t(position), data.begin() + std::ptrdiff_t(position + size));
+    position += size;
+    return value;
+}
+
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (std::uint64_t(value) << 1) ^ std::uint64_t(value >> 63);
+}
+
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return std::int64_t(value >> 1) ^ -std::int64_t(value & 1);
+}
+
+
+std::uint64_t to_bits(double value) {
+    std::uint64_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+
+double from_bits(std::uint64_t bits) {
+    double value{};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+/* XOR of similar doubles has zeros in the trailing bytes (short mantissas), they become leading zeros of varint */
+std::uint64_t swap_bytes(std::uint64_t value) {
+    std::uint64_t swapped{0};
+    for (unsigned i = 0; i < sizeof(value); ++i) {
+        swapped = (swapped << 8) | (value & 0xff);
+        value >>= 8;
+    }
+    return swapped;
+}
+
+
+bool is_int64(const json::Json& value) {
+    return value.is_number_integer() && !(value.is_number_unsigned() &&
+        value.get<std::uint64_t>() > std::uint64_t(std::numeric_limits<std::int64_t>::max()));
+}
+
+
+std::int64_t to_ms(MetricHistory::TimePoint timepoint) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(timepoint.time_since_epoch()).count();
+}
+
+}
+
+
+void MetricHistory::set_limits(std::chrono::seconds retention, std::size_t max_memory_bytes) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_retention = retention;
+    m_max_memory_bytes = max_memory_bytes;
+    enforce_limits(to_ms(Clock::now()));
+}
+
+
+bool MetricHistory::is_enabled() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_max_memory_bytes > 0;
+}
+
+
+void MetricHistory::add_sample(const std::string& metric_uuid, const json::Json& value, TimePoint timestamp) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (0 == m_max_memory_bytes) {
+        return;
+    }
+
+    const auto timestamp_ms = to_ms(timestamp);
+    auto& series = m_series[metric_uuid];
+    if (series.chunks.empty() || series.chunks.back().samples >= SAMPLES_PER_CHUNK) {
+        series.chunks.emplace_back();
+        series.chunks.back().id = m_next_chunk_id++;
+        m_chunks.emplace_back(&series, series.chunks.back().id);
+        m_memory_bytes += get_memory_usage(series.chunks.back());
+    }
+
+    auto& chunk = series.chunks.back();
+    const auto memory_before = get_memory_usage(chunk);
+    encode(series, value, timestamp_ms);
+    if (SAMPLES_PER_CHUNK == chunk.samples) {
+        chunk.data.shrink_to_fit();
+    }
+    m_memory_bytes = m_memory_bytes - memory_before + get_memory_usage(chunk);
+    ++m_samples;
+    ++m_modification_epoch;
+
+    enforce_limits(timestamp_ms);
+}
+
+
+MetricHistory::Samples MetricHistory::get_samples(const std::string& metric_uuid, TimePoint from) const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    ReadTracker::record(m_modification_epoch);
+
+    Samples samples{};
+    const auto it = m_series.find(metric_uuid);
+    if (it != m_series.end()) {
+        const auto from_ms = to_ms(from);
+        for (const auto& chunk : it->second.chunks) {
+            if (chunk.last_ms >= from_ms) {
+                decode(chunk, from_ms, samples);
+            }
+        }
+    }
+    return samples;
+}
+
+
+std::vector<std::string> MetricHistory::get_metric_uuids() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    ReadTracker::record(m_modification_epoch);
+
+    std::vector<std::string> uuids{};
+    for (const auto& series : m_series) {
+        if (!series.second.chunks.empty()) {
+            uuids.push_back(series.first);
+        }
+    }
+    return uuids;
+}
+
+
+MetricHistory::Statistics MetricHistory::get_statistics() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    Statistics statistics{};
+    statistics.samples = m_samples;
+    statistics.metrics = std::size_t(std::count_if(m_series.begin(), m_series.end(),
+        [](const std::pair<const std::string, Series>& series) { return !series.second.chunks.empty(); }));
+    statistics.chunks = m_chunks.size();
+    statistics.memory_bytes = m_memory_bytes;
+    statistics.dropped_chunks = m_dropped_chunks;
+    return statistics;
+}
+
+
+void MetricHistory::clear() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_chunks.clear();
+    m_series.clear();
+    m_memory_bytes = 0;
+    m_samples = 0;
+    ++m_modification_epoch;
+}
+
+
+std::size_t MetricHistory::get_memory_usage(const Chunk& chunk) {
+    return sizeof(Chunk) + chunk.data.capacity();
+}
+
+
+void MetricHistory::encode(Series& series, const json::Json& value, std::int64_t timestamp_ms) {
+    auto& chunk = series.chunks.back();
+    std::uint64_t delta_ms{0};
+    if (0 == chunk.samples) {
+        chunk.first_ms = chunk.last_ms = timestamp_ms;
+        series.last_integer = 0;
+        series.last_double = 0;
+    }
+    else if (timestamp_ms > chunk.last_ms) {
+        delta_ms = std::uint64_t(timestamp_ms - chunk.last_ms);
+        chunk.last_ms = timestamp_ms;
+    }
+
+    Tag tag{OTHER};
+    if (chunk.samples > 0 && value.type() == series.last_value.type() && value == series.last_value) {
+        tag = SAME;
+    }
+    else if (is_int64(value)) {
+        tag = INTEGER;
+    }
+    else if (value.is_number_float()) {
+        tag = DOUBLE;
+    }
+    else if (value.is_null()) {
+        tag = NULL_VALUE;
+    }
+    else if (value.is_boolean()) {
+        tag = value.get<bool>() ? TRUE_VALUE : FALSE_VALUE;
+    }
+    else if (value.is_string()) {
+        tag = STRING;
+    }
+
+    put_varint(chunk.data, (delta_ms << TAG_BITS) | tag);
+    switch (tag) {
+        case INTEGER: {
+            const auto integer = value.get<std::int64_t>();
+            put_varint(chunk.data, zigzag(integer - series.last_integer));
+            series.last_integer = integer;
+            break;
+        }
+        case DOUBLE: {
+            const auto bits = to_bits(value.get<double>());
+            put_varint(chunk.data, swap_bytes(bits ^ series.last_double));
+            series.last_double = bits;
+            break;
+        }
+        case STRING:
+            put_string(chunk.data, value.get<std::string>());
+            break;
+        case OTHER:
+            put_string(chunk.data, value.dump());
+            break;
+        case SAME:
+        case NULL_VALUE:
+        case TRUE_VALUE:
+        case FALSE_VALUE:
+        default:
+            break;
+    }
+    series.last_value = value;
+    ++chunk.samples;
+}
+
+
+void MetricHistory::decode(const Chunk& chunk, std::int64_t from_ms, Samples& samples) {
+    std::int64_t timestamp_ms{chunk.first_ms};
+    std::int64_t last_integer{0};
+    std::uint64_t last_double{0};
+    json::Json value{};
+    std::size_t position{0};
+    for (std::uint32_t i = 0; i < chunk.samples; ++i) {
+        const auto header = get_varint(chunk.data, position);
+        timestamp_ms += std::int64_t(header >> TAG_BITS);
+        switch (Tag(header & TAG_MASK)) {
+            case INTEGER:
+                last_integer += unzigzag(get_varint(chunk.data, position));
+                value = last_integer;
+                break;
+            case DOUBLE:
+                last_double ^= swap_bytes(get_varint(chunk.data, position));
+                value = from_bits(last_double);
+                break;
+            case NULL_VALUE:
+                value = nullptr;
+                break;
+            case TRUE_VALUE:
+                value = true;
+                break;
+            case FALSE_VALUE:
+                value = false;
+                break;
+            case STRING:
+                value = get_string(chunk.data, position);
+                break;
+            case OTHER:
+                value = json::Json::parse(get_string(chunk.data, position));
+                break;
+            case SAME:
+            default:
+                break;
+        }
+        if (timestamp_ms >= from_ms) {
+            samples.push_back(Sample{TimePoint{std::chrono::milliseconds{timestamp_ms}}, value});
+        }
+    }
+}
+
+
+void MetricHistory::drop_oldest_chunk() {
+    auto& series = *m_chunks.front().first;
+    const auto& chunk = series.chunks.front();
+    m_memory_bytes -= get_memory_usage(chunk);
+    m_samples -= chunk.samples;
+    series.chunks.pop_front();
+    m_chunks.pop_front();
+    ++m_dropped_chunks;
+    ++m_modification_epoch;
+}
+
+
+void MetricHistory::enforce_limits(std::int64_t now_ms) {
+    while (!m_chunks.empty()) {
+        const auto& oldest = m_chunks.front().first->chunks.front();
+        const bool expired = m_retention.count() > 0 && oldest.last_ms < now_ms - m_retention.count();
+        if (!expired && m_memory_bytes <= m_max_memory_bytes) {
+            break;
+        }
+        drop_oldest_chunk();
+    }
+}
@@ -0,0 +1,187 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file metric_reports.cpp
+ * */
+
+#include "psme/rest/telemetry/metric_reports.hpp"
+#include "psme/rest/constants/telemetry.hpp"
+#include "psme/rest/endpoints/utils.hpp"
+#include "agent-framework/module/utils/time.hpp"
+#include "logger/logger_factory.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace psme::rest::telemetry;
+using namespace psme::rest::constants;
+using agent_framework::model::Metric;
+using agent_framework::module::ReadTracker;
+
+namespace {
+
+constexpr std::chrono::seconds::rep DEFAULT_RETENTION_SEC = 3600;
+constexpr std::size_t DEFAULT_MAX_MEMORY_BYTES = 8 * 1024 * 1024;
+constexpr std::chrono::seconds::rep DEFAULT_REPORT_INTERVAL_SEC = 60;
+
+constexpr char PERIODIC[] = "Periodic";
+constexpr char ON_CHANGE[] = "OnChange";
+
+
+/* Reports are addressed by their ids, see Routes::METRIC_REPORT_PATH */
+bool is_valid_id(const std::string& id) {
+    return !id.empty() && std::all_of(id.begin(), id.end(), [](char c) {
+        return std::isalpha(static_cast<unsigned char>(c));
+    });
+}
+
+
+std::int64_t to_ms(MetricHistory::TimePoint timepoint) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(timepoint.time_since_epoch()).count();
+}
+
+
+std::string make_timestamp(MetricHistory::TimePoint timepoint) {
+    return agent_framework::utils::make_iso_8601_timestamp(MetricHistory::Clock::to_time_t(timepoint));
+}
+
+
+std::string get_metric_id(const Metric& metric) {
+    auto& definitions = agent_framework::module::get_manager<agent_framework::model::MetricDefinition>();
+    if (!definitions.entry_exists(metric.get_metric_definition_uuid())) {
+        return metric.get_name();
+    }
+    return std::to_string(definitions.uuid_to_rest_id(metric.get_metric_definition_uuid()));
+}
+
+}
+
+
+MetricReports::~MetricReports() {}
+
+
+void MetricReports::configure(const json::Json& config) {
+    m_definitions.clear();
+    if (!config.value("enabled", false)) {
+        m_history.set_limits(std::chrono::seconds{0}, 0);
+        return;
+    }
+
+    const auto retention = config.value("retention-sec", DEFAULT_RETENTION_SEC);
+    const auto max_memory_bytes = config.value("max-memory-bytes", DEFAULT_MAX_MEMORY_BYTES);
+    m_history.set_limits(std::chrono::seconds{retention}, max_memory_bytes);
+    log_info("rest", "Keeping history of metric values for " << retention << " s in up to "
+        << max_memory_bytes << " bytes.");
+
+    for (const auto& report : config.value("reports", json::Json::array())) {
+        ReportDefinition definition{};
+        definition.id = report.value("id", std::string{});
+        const auto type = report.value("type", std::string{PERIODIC});
+        definition.interval = std::chrono::seconds{report.value("interval-sec", DEFAULT_REPORT_INTERVAL_SEC)};
+        if (!is_valid_id(definition.id) || nullptr != find_definition(definition.id)) {
+            log_warning("rest", "Invalid or duplicated metric report id '" << definition.id << "', report skipped.");
+            continue;
+        }
+        if (type == ON_CHANGE) {
+            definition.type = ReportDefinition::Type::OnChange;
+        }
+        else if (type != PERIODIC || definition.interval.count() <= 0) {
+            log_warning("rest", "Invalid type or interval of metric report " << definition.id << ", report skipped.");
+            continue;
+        }
+        m_definitions.push_back(std::move(definition));
+    }
+}
+
+
+const ReportDefinition* MetricReports::find_definition(const std::string& id) const {
+    const auto it = std::find_if(m_definitions.begin(), m_definitions.end(),
+                                 [&id](const ReportDefinition& definition) { return definition.id == id; });
+    return it != m_definitions.end() ? &*it : nullptr;
+}
+
+
+json::Json MetricReports::make_report(const ReportDefinition& definition, MetricHistory::TimePoint now) const {
+    using std::chrono::milliseconds;
+
+    json::Json report(json::Json::value_t::object);
+    report[MetricReport::METRIC_VALUES] = json::Json::value_t::array;
+
+    auto from = MetricHistory::TimePoint::min();
+    auto to = MetricHistory::TimePoint::max();
+    if (ReportDefinition::Type::Periodic == definition.type) {
+        /* the last complete interval, the report changes with time */
+        ReadTracker::record_untracked();
+        const auto interval_ms = std::chrono::duration_cast<milliseconds>(definition.interval).count();
+        const auto period = to_ms(now) / interval_ms;
+        to = MetricHistory::TimePoint{milliseconds{period * interval_ms}};
+        from = to - definition.interval;
+        report[MetricReport::REPORT_SEQUENCE] = std::to_string(period);
+        report[MetricReport::TIMESTAMP] = make_timestamp(to);
+    }
+
+    auto metric_uuids = m_history.get_metric_uuids();
+    std::sort(metric_uuids.begin(), metric_uuids.end());
+    std::uint64_t changes{0};
+    auto last_change = MetricHistory::TimePoint::min();
+    auto& metrics = agent_framework::module::get_manager<Metric>();
+    for (const auto& metric_uuid : metric_uuids) {
+        json::Json metric_value(json::Json::value_t::object);
+        try {
+            if (!metrics.entry_exists(metric_uuid)) {
+                continue;
+            }
+            const auto metric = metrics.get_entry(metric_uuid);
+            metric_value[MetricReport::METRIC_ID] = get_metric_id(metric);
+            metric_value[MetricReport::METRIC_PROPERTY] = psme::rest::endpoint::utils::get_component_url(
+                Metric::get_component(), metric_uuid);
+        }
+        catch (const agent_framework::exceptions::GamiException& e) {
+            log_debug("rest", "Metric " << metric_uuid << " skipped in metric report: " << e.what());
+            continue;
+        }
+
+        const json::Json* previous{nullptr};
+        const auto samples = m_history.get_samples(metric_uuid, from);
+        for (const auto& sample : samples) {
+            if (sample.timestamp >= to) {
+                break;
+            }
+            const bool changed = nullptr == previous || sample.value.type() != previous->type()
+                                 || sample.value != *previous;
+            previous = &sample.value;
+            if (ReportDefinition::Type::OnChange == definition.type && !changed) {
+                continue;
+            }
+            metric_value[TelemetryCommon::METRIC_VALUE] =
+                sample.value.is_string() ? sample.value.get<std::string>() : sample.value.dump();
+            metric_value[MetricReport::TIMESTAMP] = make_timestamp(sample.timestamp);
+            report[MetricReport::METRIC_VALUES].push_back(metric_value);
+            last_change = std::max(last_change, sample.timestamp);
+            ++changes;
+        }
+    }
+
+    if (ReportDefinition::Type::OnChange == definition.type) {
+        /* the report changes only with the history */
+        report[MetricReport::REPORT_SEQUENCE] = std::to_string(changes);
+        report[MetricReport::TIMESTAMP] = changes > 0 ? json::Json(make_timestamp(last_change)) : json::Json();
+    }
+    return report;
+}
@@ -0,0 +1,229 @@
+/*!
+ * @brief Event delivery tests
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file event_delivery.cpp
+ */
+
+#include "psme/rest/eventing/event_delivery.hpp"
+#include "gtest/gtest.h"
+
+#include <set>
+
+using namespace psme::rest::eventing;
+
+namespace {
+
+constexpr std::chrono::seconds TIMEOUT{5};
+
+EventArray make_event_array(std::uint64_t subscriber_id, const std::string& origin = "path/to/resource") {
+    EventArray event_array{EventVec{Event{EventType::ResourceUpdated, origin}}};
+    event_array.set_subscriber_id(subscriber_id);
+    event_array.assign_new_id();
+    return event_array;
+}
+
+/*! @brief Records deliveries, deliveries to chosen subscribers wait until released */
+class RecordingSender {
+public:
+    bool send(RestClient& client, const EventArray& event_array) {
+        const auto subscriber_id = event_array.get_subscriber_id().value();
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_clients[subscriber_id].insert(&client);
+        if (++m_in_progress[subscriber_id] > 1) {
+            m_concurrent = true;
+        }
+        m_cv.notify_all();
+        m_cv.wait(lock, [this, subscriber_id] { return 0 == m_blocked.count(subscriber_id); });
+        --m_in_progress[subscriber_id];
+        m_delivered[subscriber_id].push_back(event_array.get_events().front().get_origin_of_condition());
+        m_cv.notify_all();
+        return !m_failing;
+    }
+
+    void block(std::uint64_t subscriber_id) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_blocked.insert(subscriber_id);
+    }
+
+    void release(std::uint64_t subscriber_id) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_blocked.erase(subscriber_id);
+        m_cv.notify_all();
+    }
+
+    void set_failing(bool failing) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_failing = failing;
+    }
+
+    bool wait_for_deliveries(std::uint64_t subscriber_id, std::size_t count) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_cv.wait_for(lock, TIMEOUT, [this, subscriber_id, count] {
+            return m_delivered[subscriber_id].size() >= count;
+        });
+    }
+
+    bool wait_for_start(std::uint64_t subscriber_id) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_cv.wait_for(lock, TIMEOUT, [this, subscriber_id] {
+            return !m_clients[subscriber_id].empty();
+        });
+    }
+
+    std::vector<std::string> get_delivered(std::uint64_t subscriber_id) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_delivered[subscriber_id];
+    }
+
+    std::size_t get_client_count(std::uint64_t subscriber_id) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_clients[subscriber_id].size();
+    }
+
+    bool was_concurrent() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_concurrent;
+    }
+
+    EventDelivery::Sender get_sender() {
+        return [this](RestClient& client, const EventArray& event_array) {
+            return send(client, event_array);
+        };
+    }
+
+private:
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+    std::set<std::uint64_t> m_blocked{};
+    std::map<std::uint64_t, std::set<const RestClient*>> m_clients{};
+    std::map<std::uint64_t, int> m_in_progress{};
+    std::map<std::uint64_t, std::vector<std::string>> m_delivered{};
+    bool m_concurrent{false};
+    bool m_failing{false};
+};
+
+}
+
+TEST(EventDeliveryTests, SlowSubscriberDoesNotDelayOthers) {
+    RecordingSender sender{};
+    EventDelivery delivery{sender.get_sender(), 2, 10};
+    delivery.start();
+
+    sender.block(1);
+    delivery.enqueue(make_event_array(1));
+    ASSERT_TRUE(sender.wait_for_start(1));
+
+    delivery.enqueue(make_event_array(2));
+    delivery.enqueue(make_event_array(2));
+    EXPECT_TRUE(sender.wait_for_deliveries(2, 2)) << "Blocked subscriber delays the others";
+    EXPECT_TRUE(sender.get_delivered(1).empty());
+
+    sender.release(1);
+    EXPECT_TRUE(sender.wait_for_deliveries(1, 1));
+    delivery.stop();
+}
+
+TEST(EventDeliveryTests, SubscriberEventsAreDeliveredInOrderByOneClient) {
+    RecordingSender sender{};
+    EventDelivery delivery{sender.get_sender(), 4, 100};
+    delivery.start();
+
+    std::vector<std::string> expected{};
+    for (int i = 0; i < 20; ++i) {
+        expected.push_back("resource/" + std::to_string(i));
+        delivery.enqueue(make_event_array(7, expected.back()));
+    }
+    ASSERT_TRUE(sender.wait_for_deliveries(7, expected.size()));
+    delivery.stop();
+
+    EXPECT_EQ(expected, sender.get_delivered(7));
+    EXPECT_FALSE(sender.was_concurrent()) << "Subscriber served by two workers at once";
+    EXPECT_EQ(1, sender.get_client_count(7)) << "Connection to the subscriber not reused";
+}
+
+TEST(EventDeliveryTests, FullQueueDropsOldestEventArray) {
+    RecordingSender sender{};
+    EventDelivery delivery{sender.get_sender(), 1, 2};
+    delivery.start();
+
+    sender.block(3);
+    delivery.enqueue(make_event_array(3, "in-flight"));
+    ASSERT_TRUE(sender.wait_for_start(3));
+
+    EXPECT_TRUE(delivery.enqueue(make_event_array(3, "first")));
+    EXPECT_TRUE(delivery.enqueue(make_event_array(3, "second")));
+    EXPECT_FALSE(delivery.enqueue(make_event_array(3, "third")));
+    EXPECT_EQ(2, delivery.get_queue_depth(3));
+
+    auto metrics = delivery.get_metrics();
+    EXPECT_EQ(2, metrics.queue_depth);
+    EXPECT_EQ(2, metrics.max_subscriber_queue_depth);
+    EXPECT_EQ(1, metrics.dropped);
+
+    sender.release(3);
+    ASSERT_TRUE(sender.wait_for_deliveries(3, 3));
+    delivery.stop();
+    EXPECT_EQ((std::vector<std::string>{"in-flight", "second", "third"}), sender.get_delivered(3));
+}
+
+TEST(EventDeliveryTests, SubscriberIsScheduledOnceWhenSingleEventArrayIsReplaced) {
+    RecordingSender sender{};
+    EventDelivery delivery{sender.get_sender(), 1, 1};
+    delivery.start();
+
+    /* the only worker is busy, so the subscriber waits in the ready queue */
+    sender.block(9);
+    delivery.enqueue(make_event_array(9));
+    ASSERT_TRUE(sender.wait_for_start(9));
+
+    EXPECT_TRUE(delivery.enqueue(make_event_array(3, "first")));
+    EXPECT_FALSE(delivery.enqueue(make_event_array(3, "second")));
+    EXPECT_FALSE(delivery.enqueue(make_event_array(3, "third")));
+    EXPECT_EQ(1, delivery.get_queue_depth(3));
+
+    sender.release(9);
+    ASSERT_TRUE(sender.wait_for_deliveries(3, 1));
+    delivery.enqueue(make_event_array(3, "fourth"));
+    ASSERT_TRUE(sender.wait_for_deliveries(3, 2));
+    delivery.stop();
+
+    EXPECT_EQ((std::vector<std::string>{"third", "fourth"}), sender.get_delivered(3));
+    const auto metrics = delivery.get_metrics();
+    EXPECT_EQ(3, metrics.delivered);
+    EXPECT_EQ(2, metrics.dropped);
+}
+
+TEST(EventDeliveryTests, MetricsAreCollected) {
+    RecordingSender sender{};
+    EventDelivery delivery{sender.get_sender(), 2, 10};
+    delivery.start();
+
+    delivery.enqueue(make_event_array(1));
+    delivery.enqueue(make_event_array(2));
+    ASSERT_TRUE(sender.wait_for_deliveries(1, 1));
+    ASSERT_TRUE(sender.wait_for_deliveries(2, 1));
+
+    sender.set_failing(true);
+    delivery.enqueue(make_event_array(1));
+    ASSERT_TRUE(sender.wait_for_deliveries(1, 2));
+    delivery.stop();
+
+    const auto metrics = delivery.get_metrics();
+    EXPECT_EQ(0, metrics.queue_depth);
+    EXPECT_EQ(2, metrics.delivered);
+    EXPECT_EQ(1, metrics.failed);
+    EXPECT_EQ(0, metrics.dropped);
+    EXPECT_LE(metrics.average_latency, metrics.max_latency);
+}
@@ -0,0 +1,126 @@
+/*!
+ * @brief ParallelRunner tests
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file parallel_runner_test.cpp
+ */
+
+#include "psme/rest/model/parallel_runner.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace psme::rest::model;
+
+namespace {
+
+/*! @brief Counts tasks in progress, each task waits until all expected tasks are running or timeout */
+class Barrier {
+public:
+    explicit Barrier(std::size_t expected) : m_expected(expected) { }
+
+    void arrive() {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_max_in_progress = std::max(m_max_in_progress, ++m_in_progress);
+        m_cv.notify_all();
+        m_cv.wait_for(lock, std::chrono::milliseconds{200}, [this] { return m_in_progress >= m_expected; });
+        --m_in_progress;
+    }
+
+    std::size_t get_max_in_progress() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_max_in_progress;
+    }
+
+private:
+    std::size_t m_expected;
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+    std::size_t m_in_progress{};
+    std::size_t m_max_in_progress{};
+};
+
+}
+
+TEST(ParallelRunnerTest, AllTasksAreExecuted) {
+    ParallelRunner runner{2};
+    std::vector<int> executed(10, 0);
+    std::vector<ParallelRunner::Task> tasks{};
+    for (auto& flag : executed) {
+        tasks.emplace_back([&flag] { ++flag; });
+    }
+    runner.run(tasks);
+    EXPECT_EQ(std::vector<int>(10, 1), executed);
+}
+
+TEST(ParallelRunnerTest, TasksRunInParallelUpToLimit) {
+    ParallelRunner runner{2};
+    /* two additional threads and the caller */
+    Barrier barrier{3};
+    std::vector<ParallelRunner::Task> tasks(6, [&barrier] { barrier.arrive(); });
+    runner.run(tasks);
+    EXPECT_EQ(3, barrier.get_max_in_progress());
+}
+
+TEST(ParallelRunnerTest, NoThreadsRunsTasksInCaller) {
+    ParallelRunner runner{0};
+    const auto caller = std::this_thread::get_id();
+    std::vector<std::thread::id> threads{};
+    std::vector<ParallelRunner::Task> tasks(3, [&threads] { threads.push_back(std::this_thread::get_id()); });
+    runner.run(tasks);
+    EXPECT_EQ(std::vector<std::thread::id>(3, caller), threads);
+}
+
+TEST(ParallelRunnerTest, NestedGroupsDoNotDeadlock) {
+    ParallelRunner runner{1};
+    std::mutex mutex{};
+    std::size_t executed{};
+    std::vector<ParallelRunner::Task> inner(4, [&mutex, &executed] {
+        std::lock_guard<std::mutex> lock{mutex};
+        ++executed;
+    });
+    std::vector<ParallelRunner::Task> outer(3, [&runner, &inner] { runner.run(inner); });
+    runner.run(outer);
+    EXPECT_EQ(12, executed);
+}
+
+TEST(ParallelRunnerTest, FirstExceptionIsRethrownAfterAllTasks) {
+    ParallelRunner runner{2};
+    std::size_t executed{};
+    std::mutex mutex{};
+    auto count = [&mutex, &executed] {
+        std::lock_guard<std::mutex> lock{mutex};
+        ++executed;
+    };
+    std::vector<ParallelRunner::Task> tasks{
+        count,
+        [] { throw std::runtime_error("first"); },
+        count,
+        [] { throw std::logic_error("second"); },
+        count
+    };
+    try {
+        runner.run(tasks);
+        FAIL() << "Exception not thrown";
+    }
+    catch (const std::runtime_error& e) {
+        EXPECT_STREQ("first", e.what());
+    }
+    EXPECT_EQ(3, executed);
+}
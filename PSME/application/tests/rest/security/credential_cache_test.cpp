@@ -0,0 +1,234 @@
+/*!
+ * @brief Credential cache tests
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file credential_cache_test.cpp
+ */
+
+#include "psme/rest/security/account/account_manager.hpp"
+#include "psme/rest/security/account/credential_cache.hpp"
+#include "psme/rest/security/authentication/basic_authentication.hpp"
+#include "configuration/configuration.hpp"
+#include "utils/crypt_utils.hpp"
+#include "utils/conversion.hpp"
+
+#include "gtest/gtest.h"
+
+#include <set>
+#include <thread>
+
+using namespace testing;
+using namespace psme::rest::security::account;
+using namespace psme::rest::security::authentication;
+
+namespace {
+
+constexpr const char USER[] = "admin";
+constexpr const char PASSWORD[] = "secret";
+constexpr const char URL[] = "/redfish/v1/Systems";
+
+/*! @brief Salt and password hash as expected in the configuration */
+std::string make_password_hash(const AccountManager& manager, const std::string& password) {
+    const auto salt = utils::generate_salt();
+    return utils::string_to_hex_string(salt) + manager.calculate_hash(password, salt);
+}
+
+void set_configuration(bool cache_enabled) {
+    json::Json config = json::Json::object();
+    config["authentication"] = json::Json::object();
+    config["authentication"]["credential-cache"] = json::Json::object();
+    config["authentication"]["credential-cache"]["enabled"] = cache_enabled;
+    config["authentication"]["credential-cache"]["max-entries"] = 16;
+    configuration::Configuration::get_instance().set_default_configuration(config.dump());
+}
+
+/*! @brief Adds account of the user unless it already exists */
+void add_account(AccountManager& manager, const std::string& user_name, const std::string& password) {
+    bool exists = false;
+    manager.for_each([&exists, &user_name](const Account& account) {
+        exists = exists || (account.get_user_name() == user_name);
+    });
+    if (!exists) {
+        Account account{};
+        account.set_user_name(user_name);
+        account.set_password_hash(make_password_hash(manager, password));
+        manager.add(account);
+    }
+}
+
+}
+
+class CredentialCacheTest : public ::testing::Test {
+public:
+    ~CredentialCacheTest();
+
+    void TearDown() override {
+        if (m_server_accounts) {
+            std::set<std::uint64_t> added_ids{};
+            m_server_accounts->for_each([this, &added_ids](const Account& account) {
+                if (!m_account_ids.count(account.get_id())) {
+                    added_ids.insert(account.get_id());
+                }
+            });
+            for (const auto id : added_ids) {
+                m_server_accounts->remove(id);
+            }
+            m_server_accounts->get_credential_cache().invalidate();
+            m_server_accounts->get_credential_cache().configure(m_max_entries, m_time_to_live);
+        }
+        configuration::Configuration::cleanup();
+    }
+
+    /*!
+     * @brief Get accounts of the server, restored after the test
+     * @return Account manager singleton
+     */
+    AccountManager& get_server_accounts() {
+        if (!m_server_accounts) {
+            m_server_accounts = AccountManager::get_instance();
+            m_server_accounts->for_each([this](const Account& account) { m_account_ids.insert(account.get_id()); });
+            m_max_entries = m_server_accounts->get_credential_cache().get_max_entries();
+            m_time_to_live = m_server_accounts->get_credential_cache().get_time_to_live();
+        }
+        return *m_server_accounts;
+    }
+
+private:
+    AccountManager* m_server_accounts{nullptr};
+    std::set<std::uint64_t> m_account_ids{};
+    std::size_t m_max_entries{};
+    CredentialCache::Clock::duration m_time_to_live{};
+};
+
+CredentialCacheTest::~CredentialCacheTest() { }
+
+
+TEST_F(CredentialCacheTest, DisabledByDefault) {
+    CredentialCache cache{};
+    ASSERT_FALSE(cache.is_enabled());
+    cache.put(USER, PASSWORD, "hash");
+    ASSERT_FALSE(cache.contains(USER, PASSWORD, "hash"));
+    ASSERT_EQ(0, cache.get_statistics().entries);
+}
+
+TEST_F(CredentialCacheTest, ValidatedCredentials) {
+    CredentialCache cache{};
+    cache.configure(2, std::chrono::minutes(1));
+
+    cache.put(USER, PASSWORD, "hash");
+    ASSERT_TRUE(cache.contains(USER, PASSWORD, "hash"));
+    ASSERT_FALSE(cache.contains(USER, "other", "hash"));
+    /* user name and password are not simply concatenated */
+    ASSERT_FALSE(cache.contains("admi", std::string("n") + PASSWORD, "hash"));
+
+    /* password of the account has been changed */
+    ASSERT_FALSE(cache.contains(USER, PASSWORD, "new hash"));
+    ASSERT_FALSE(cache.contains(USER, PASSWORD, "hash"));
+
+    /* least recently used entry is dropped */
+    cache.put("user1", PASSWORD, "hash");
+    cache.put("user2", PASSWORD, "hash");
+    ASSERT_TRUE(cache.contains("user1", PASSWORD, "hash"));
+    cache.put("user3", PASSWORD, "hash");
+    ASSERT_TRUE(cache.contains("user1", PASSWORD, "hash"));
+    ASSERT_FALSE(cache.contains("user2", PASSWORD, "hash"));
+
+    cache.invalidate();
+    ASSERT_FALSE(cache.contains("user1", PASSWORD, "hash"));
+
+    const auto statistics = cache.get_statistics();
+    ASSERT_EQ(3, statistics.hits);
+    ASSERT_EQ(6, statistics.misses);
+    ASSERT_EQ(3, statistics.invalidations);
+    ASSERT_EQ(0, statistics.entries);
+}
+
+TEST_F(CredentialCacheTest, Expiration) {
+    CredentialCache cache{};
+    cache.configure(2, std::chrono::milliseconds(10));
+
+    cache.put(USER, PASSWORD, "hash");
+    ASSERT_TRUE(cache.contains(USER, PASSWORD, "hash"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(cache.contains(USER, PASSWORD, "hash"));
+    ASSERT_EQ(1, cache.get_statistics().expirations);
+}
+
+TEST_F(CredentialCacheTest, AccountManager) {
+    set_configuration(true);
+    AccountManager manager{};
+    ASSERT_TRUE(manager.get_credential_cache().is_enabled());
+
+    Account account{};
+    account.set_user_name(USER);
+    account.set_password_hash(make_password_hash(manager, PASSWORD));
+    manager.add(account);
+
+    ASSERT_FALSE(manager.validate_credentials(USER, "other"));
+    ASSERT_TRUE(manager.validate_credentials(USER, PASSWORD));
+    ASSERT_TRUE(manager.validate_credentials(USER, PASSWORD));
+    ASSERT_EQ(1, manager.get_credential_cache().get_statistics().hits);
+
+    /* invalid credentials are never cached */
+    ASSERT_FALSE(manager.validate_credentials(USER, "other"));
+    ASSERT_EQ(1, manager.get_credential_cache().get_statistics().entries);
+}
+
+/*!
+ * @brief Basic authenticated requests, the password hash is calculated for the first request only
+ */
+TEST_F(CredentialCacheTest, BasicAuthenticationRequests) {
+    constexpr unsigned REQUESTS = 100;
+    constexpr const char BASIC_USER[] = "basic";
+
+    /* requests are authenticated against the accounts of the server */
+    set_configuration(true);
+    auto& manager = get_server_accounts();
+    add_account(manager, BASIC_USER, PASSWORD);
+    auto& cache = manager.get_credential_cache();
+    cache.configure(16, std::chrono::minutes(1));
+    cache.invalidate();
+    const auto initial = cache.get_statistics();
+
+    BasicAuthentication authentication{};
+    for (unsigned i = 0; i < REQUESTS; ++i) {
+        psme::rest::server::Response response{};
+        ASSERT_EQ(AuthStatus::SUCCESS, authentication.perform(BASIC_USER, PASSWORD, URL, response));
+    }
+    auto statistics = cache.get_statistics();
+    EXPECT_EQ(REQUESTS - 1, statistics.hits - initial.hits);
+    EXPECT_EQ(1, statistics.misses - initial.misses);
+    EXPECT_EQ(1, statistics.entries);
+
+    /* rejected credentials are verified each time and never cached */
+    for (unsigned i = 0; i < 2; ++i) {
+        psme::rest::server::Response response{};
+        ASSERT_EQ(AuthStatus::FAIL, authentication.perform(BASIC_USER, "other", URL, response));
+        ASSERT_EQ(psme::rest::server::status_4XX::UNAUTHORIZED, response.get_status());
+    }
+    psme::rest::server::Response response{};
+    ASSERT_EQ(AuthStatus::FAIL, authentication.perform(nullptr, nullptr, URL, response));
+    statistics = cache.get_statistics();
+    EXPECT_EQ(REQUESTS - 1, statistics.hits - initial.hits);
+    EXPECT_EQ(3, statistics.misses - initial.misses);
+    EXPECT_EQ(1, statistics.entries);
+
+    /* disabled cache is not consulted */
+    cache.configure(0, std::chrono::minutes(1));
+    ASSERT_EQ(AuthStatus::SUCCESS, authentication.perform(BASIC_USER, PASSWORD, URL, response));
+    statistics = cache.get_statistics();
+    EXPECT_EQ(REQUESTS - 1, statistics.hits - initial.hits);
+    EXPECT_EQ(3, statistics.misses - initial.misses);
+    EXPECT_EQ(0, statistics.entries);
+}
@@ -0,0 +1,148 @@
+/*!
+ * @brief Session manager tests
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file session_manager_test.cpp
+ */
+
+#include "psme/rest/security/session/session_manager.hpp"
+#include "psme/rest/security/session/session_service_manager.hpp"
+#include "configuration/configuration.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace testing;
+using namespace psme::rest::security::session;
+
+namespace {
+
+constexpr const char ORIGIN[] = "https://client";
+
+void set_session_timeout(std::chrono::seconds timeout) {
+    json::Json config = json::Json::object();
+    config["session-service"] = json::Json::object();
+    config["session-service"]["service-enabled"] = true;
+    config["session-service"]["session-timeout"] = timeout.count();
+    configuration::Configuration::get_instance().set_default_configuration(config.dump());
+    SessionServiceManager::get_instance()->set_session_timeout(timeout);
+}
+
+std::string add_session(SessionManager& manager, const std::string& user_name) {
+    Session session{};
+    session.set_user_name(user_name);
+    session.set_origin_header(ORIGIN);
+    const auto id = manager.add(session);
+    return manager.get(id).get_session_auth_token();
+}
+
+unsigned count_sessions(const SessionManager& manager) {
+    unsigned sessions = 0;
+    manager.for_each([&sessions](const Session&) { ++sessions; });
+    return sessions;
+}
+
+/*! @brief Time of the fake clock, sessions expire only when it is advanced */
+SessionManager::Clock make_clock(Session::Timepoint& now) {
+    return [&now]() { return now; };
+}
+
+}
+
+TEST(SessionManagerTest, Tokens) {
+    set_session_timeout(std::chrono::seconds(600));
+    SessionManager manager{};
+
+    const auto token1 = add_session(manager, "user1");
+    const auto token2 = add_session(manager, "user2");
+    ASSERT_NE(token1, token2);
+
+    ASSERT_TRUE(manager.is_session_valid(token1, ORIGIN));
+    ASSERT_TRUE(manager.is_session_valid(token2, ORIGIN));
+    ASSERT_FALSE(manager.is_session_valid(token1, "https://other"));
+    ASSERT_FALSE(manager.is_session_valid("unknown", ORIGIN));
+
+    std::uint64_t id{};
+    manager.for_each([&id, &token1](const Session& session) {
+        if (session.get_session_auth_token() == token1) {
+            id = session.get_id();
+        }
+    });
+    manager.del(id);
+    ASSERT_FALSE(manager.is_session_valid(token1, ORIGIN));
+    ASSERT_TRUE(manager.is_session_valid(token2, ORIGIN));
+
+    /* removed session is skipped in the timer wheel */
+    manager.remove_outdated_sessions();
+    ASSERT_TRUE(manager.is_session_valid(token2, ORIGIN));
+}
+
+TEST(SessionManagerTest, Expiration) {
+    set_session_timeout(std::chrono::seconds(1));
+    Session::Timepoint now{std::chrono::hours(1)};
+    SessionManager manager{make_clock(now)};
+
+    const auto unused = add_session(manager, "unused");
+    const auto used = add_session(manager, "used");
+    manager.remove_outdated_sessions();
+
+    for (unsigned i = 0; i < 5; ++i) {
+        now += std::chrono::milliseconds(500);
+        ASSERT_TRUE(manager.is_session_valid(used, ORIGIN));
+        manager.remove_outdated_sessions();
+    }
+
+    ASSERT_EQ(1, count_sessions(manager));
+    ASSERT_FALSE(manager.is_session_valid(unused, ORIGIN));
+
+    /* timeout change is applied to sessions already scheduled */
+    set_session_timeout(std::chrono::seconds(600));
+    manager.remove_outdated_sessions();
+    set_session_timeout(std::chrono::seconds(1));
+    now += std::chrono::milliseconds(2100);
+    manager.remove_outdated_sessions();
+    ASSERT_EQ(0, count_sessions(manager));
+}
+
+/*!
+ * @brief Removal of outdated sessions checks only the sessions which could have expired, not all of them
+ */
+TEST(SessionManagerTest, RemovalChecksOnlyDueSessions) {
+    constexpr unsigned SESSIONS_PER_SECOND = 100;
+    constexpr unsigned SECONDS = 30;
+    constexpr unsigned TIMEOUT_SECONDS = 10;
+    set_session_timeout(std::chrono::seconds(TIMEOUT_SECONDS));
+    Session::Timepoint now{std::chrono::hours(1)};
+    SessionManager manager{make_clock(now)};
+    ASSERT_EQ(0, manager.remove_outdated_sessions());
+
+    std::vector<std::string> tokens{};
+    for (unsigned second = 0; second < SECONDS; ++second) {
+        for (unsigned i = 0; i < SESSIONS_PER_SECOND; ++i) {
+            tokens.push_back(add_session(manager, "user" + std::to_string(tokens.size())));
+        }
+        now += std::chrono::seconds(1);
+
+        /* sessions added a timeout ago have just expired, the others are not visited */
+        const auto expired = (second >= TIMEOUT_SECONDS) ? SESSIONS_PER_SECOND : 0;
+        ASSERT_EQ(expired, manager.remove_outdated_sessions()) << second;
+        ASSERT_EQ(std::min(second + 1, TIMEOUT_SECONDS) * SESSIONS_PER_SECOND, count_sessions(manager)) << second;
+    }
+
+    /* remaining sessions are found by their tokens */
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        ASSERT_EQ(i >= (SECONDS - TIMEOUT_SECONDS) * SESSIONS_PER_SECOND, manager.is_session_valid(tokens[i], ORIGIN));
+    }
+}
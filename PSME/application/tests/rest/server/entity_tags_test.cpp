@@ -0,0 +1,156 @@
+/*!
+ * @brief Entity tags tests
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file entity_tags_test.cpp
+ */
+
+#include "psme/rest/server/multiplexer.hpp"
+#include "psme/rest/server/entity_tags.hpp"
+#include "psme/rest/server/http_headers.hpp"
+#include "psme/rest/constants/routes.hpp"
+
+#include "agent-framework/module/managers/generic_manager.hpp"
+#include "agent-framework/module/model/chassis.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace testing;
+using namespace psme::rest::constants;
+using namespace psme::rest::server;
+using namespace agent_framework::module;
+using agent_framework::model::Chassis;
+
+namespace {
+
+/*! @brief Endpoint listing chassis of the table, counts built responses */
+class ChassisEndpoint : public MethodsHandler {
+public:
+    explicit ChassisEndpoint(GenericManager<Chassis>& chassis) :
+        MethodsHandler(Routes::CHASSIS_COLLECTION_PATH), m_chassis(chassis) {}
+
+    virtual void get(const Request&, Response& response) override {
+        ++m_calls;
+        if (m_untracked) {
+            ReadTracker::record_untracked();
+        }
+        json::Json json = json::Json::object();
+        json["Members@odata.count"] = m_read_table ? m_chassis.get_entry_count() : 0;
+        response.set_body(json.dump());
+    }
+
+    virtual void patch(const Request&, Response&) override {}
+
+    virtual void post(const Request&, Response&) override {}
+
+    virtual void put(const Request&, Response&) override {}
+
+    virtual void del(const Request&, Response&) override {}
+
+    GenericManager<Chassis>& m_chassis;
+    int m_calls{0};
+    bool m_read_table{true};
+    bool m_untracked{false};
+};
+
+
+class EntityTagsTest : public Test {
+public:
+    EntityTagsTest() {
+        m_chassis.add_entry(Chassis{"parent"});
+        m_endpoint = new ChassisEndpoint(m_chassis);
+        m_multiplexer.register_handler(MethodsHandler::UPtr(m_endpoint), AccessType::ALL);
+    }
+
+    Response get(const std::string& if_none_match = {}) {
+        Request request{};
+        request.set_method(Method::GET);
+        request.set_destination("/redfish/v1/Chassis");
+        if (!if_none_match.empty()) {
+            request.set_header(http_headers::IfNoneMatch::IF_NONE_MATCH, if_none_match);
+        }
+        Response response{};
+        m_multiplexer.forward_to_handler(response, request);
+        return response;
+    }
+
+    static std::string get_etag(const Response& response) {
+        const auto& headers = response.get_headers();
+        const auto etag = headers.find(http_headers::ETag::ETAG);
+        return headers.end() == etag ? std::string{} : etag->second;
+    }
+
+    GenericManager<Chassis> m_chassis{};
+    ChassisEndpoint* m_endpoint{nullptr};
+    Multiplexer m_multiplexer{};
+};
+
+}
+
+
+TEST(EntityTagsMatchTest, IfNoneMatchValuesAreCompared) {
+    const std::string etag{"\"0123456789abcdef\""};
+    EXPECT_TRUE(EntityTags::matches("*", etag));
+    EXPECT_TRUE(EntityTags::matches(etag, etag));
+    EXPECT_TRUE(EntityTags::matches("W/" + etag, etag));
+    EXPECT_TRUE(EntityTags::matches("\"other\", " + etag, etag));
+    EXPECT_FALSE(EntityTags::matches("\"other\"", etag));
+    EXPECT_FALSE(EntityTags::matches("", etag));
+    EXPECT_FALSE(EntityTags::matches("*", ""));
+}
+
+
+TEST_F(EntityTagsTest, NotModifiedResourceIsNotBuilt) {
+    auto first = get();
+    EXPECT_EQ(status_2XX::OK, first.get_status());
+    const auto etag = get_etag(first);
+    ASSERT_FALSE(etag.empty());
+    EXPECT_EQ(1, m_endpoint->m_calls);
+
+    auto not_modified = get(etag);
+    EXPECT_EQ(status_3XX::NOT_MODIFIED, not_modified.get_status());
+    EXPECT_EQ(etag, get_etag(not_modified));
+    EXPECT_TRUE(not_modified.get_body().empty());
+    EXPECT_EQ(1, m_endpoint->m_calls);
+
+    /* polling the agent again with the same data does not change the tag */
+    m_chassis.add_or_update_entry(m_chassis.get_entries().front());
+    EXPECT_EQ(status_3XX::NOT_MODIFIED, get(etag).get_status());
+    EXPECT_EQ(1, m_endpoint->m_calls);
+}
+
+
+TEST_F(EntityTagsTest, ModifiedResourceHasNewTag) {
+    const auto etag = get_etag(get());
+
+    m_chassis.add_entry(Chassis{"parent"});
+    auto modified = get(etag);
+    EXPECT_EQ(status_2XX::OK, modified.get_status());
+    EXPECT_EQ(2, m_endpoint->m_calls);
+    EXPECT_FALSE(get_etag(modified).empty());
+    EXPECT_NE(etag, get_etag(modified));
+    EXPECT_EQ(2, json::Json::parse(modified.get_body())["Members@odata.count"].get<int>());
+}
+
+
+TEST_F(EntityTagsTest, ResourcesNotBuiltFromModelHaveNoTag) {
+    m_endpoint->m_read_table = false;
+    EXPECT_TRUE(get_etag(get()).empty());
+
+    m_endpoint->m_read_table = true;
+    m_endpoint->m_untracked = true;
+    EXPECT_TRUE(get_etag(get()).empty());
+    EXPECT_EQ(status_2XX::OK, get("*").get_status());
+    EXPECT_EQ(3, m_endpoint->m_calls);
+}
@@ -0,0 +1,121 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @section Multiplexer routing of all REST endpoints: route trie compared to linear scan
+ * */
+
+#include "psme/rest/server/multiplexer.hpp"
+#include "psme/rest/endpoints/endpoint_builder.hpp"
+#include "configuration/configuration.hpp"
+
+#include "gtest/gtest.h"
+
+namespace psme {
+namespace rest {
+namespace server {
+
+namespace {
+
+/*! @brief Registers all endpoints of the REST server, as done on start */
+void build_endpoints(Multiplexer& multiplexer) {
+    json::Json config = json::Json::object();
+    config["rest"] = json::Json::object();
+    config["rest"]["service-root-name"] = "PSME Service Root";
+    configuration::Configuration::get_instance().set_default_configuration(config.dump());
+    endpoint::EndpointBuilder{}.build_endpoints(multiplexer);
+    configuration::Configuration::cleanup();
+}
+
+/*! @brief Builds URL matching the path template, variable segments are replaced with valid values */
+std::string make_url(const std::string& path_template, std::size_t id) {
+    std::string url{};
+    for (const auto& segment : mux::split_path(path_template)) {
+        url += "/";
+        if (segment.empty() || '{' != segment.front()) {
+            url += segment;
+        }
+        else if (std::string::npos != segment.find(mux::NumericMatcher::REGEX)) {
+            url += std::to_string(id);
+        }
+        else if (std::string::npos != segment.find("xml")) {
+            url += "Resource.xml";
+        }
+        else {
+            url += "Administrator";
+        }
+    }
+    return url;
+}
+
+/*! @brief Compiles path the way it was done before numeric matchers: regex for all typed segments */
+mux::SegmentsVec path_to_regex_segments(const std::string& path) {
+    mux::SegmentsVec segments{};
+    for (const auto& segment : mux::split_path(path)) {
+        const auto colon_index = segment.find(':');
+        if (!segment.empty() && '{' == segment.front() && std::string::npos != colon_index) {
+            segments.emplace_back(std::make_shared<mux::RegexMatcher>(
+                segment.substr(1, colon_index - 1), segment.substr(colon_index + 1, segment.size() - colon_index - 2)));
+        }
+        else {
+            segments.emplace_back(mux::path_segment_to_matcher(segment));
+        }
+    }
+    return segments;
+}
+
+}
+
+TEST(MultiplexerBenchmark, RouteTableSelectsTheSameRoutesAsLinearScan) {
+    Multiplexer multiplexer{};
+    build_endpoints(multiplexer);
+    const auto routes = multiplexer.get_path_templates();
+    ASSERT_FALSE(routes.empty());
+
+    mux::RouteTrie trie{};
+    std::vector<mux::SegmentsVec> linear_routes{};
+    for (std::size_t i = 0; i < routes.size(); ++i) {
+        trie.insert(routes[i], i);
+        linear_routes.emplace_back(path_to_regex_segments(routes[i]));
+    }
+
+    std::vector<std::vector<std::string>> requests{};
+    for (std::size_t i = 0; i < routes.size(); ++i) {
+        const auto url = make_url(routes[i], i + 1);
+        ASSERT_TRUE(multiplexer.is_correct_endpoint_url(url)) << url;
+        ASSERT_NO_THROW(multiplexer.get_params(url, routes[i])) << url;
+        requests.emplace_back(mux::split_path(url));
+    }
+
+    // the first matching route is selected by both lookups
+    for (std::size_t request = 0; request < requests.size(); ++request) {
+        std::size_t linear_selected = mux::RouteTrie::NO_ROUTE;
+        for (std::size_t i = 0; i < linear_routes.size(); ++i) {
+            if (mux::segments_match(linear_routes[i], requests[request])) {
+                linear_selected = i;
+                break;
+            }
+        }
+        EXPECT_NE(mux::RouteTrie::NO_ROUTE, linear_selected) << routes[request];
+        EXPECT_EQ(linear_selected, trie.find(requests[request])) << routes[request];
+    }
+}
+
+}
+}
+}
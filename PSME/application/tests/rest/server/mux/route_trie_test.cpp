@@ -0,0 +1,131 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * */
+
+#include "psme/rest/server/mux/route_trie.hpp"
+#include "psme/rest/server/mux/matchers.hpp"
+
+#include "gtest/gtest.h"
+
+namespace psme {
+namespace rest {
+namespace server {
+namespace mux {
+
+using namespace testing;
+
+class RouteTrieTest : public Test {
+public:
+    ~RouteTrieTest();
+
+    std::size_t find(const std::string& path) const {
+        return m_trie.find(split_path(path));
+    }
+
+protected:
+    RouteTrie m_trie{};
+};
+
+RouteTrieTest::~RouteTrieTest() {}
+
+TEST_F(RouteTrieTest, StaticAndNumericSegments) {
+    m_trie.insert("/redfish/v1", 0);
+    m_trie.insert("/redfish/v1/Systems", 1);
+    m_trie.insert("/redfish/v1/Systems/{systemId:[0-9]+}", 2);
+    m_trie.insert("/redfish/v1/Systems/{systemId:[0-9]+}/Processors/{processorId:[0-9]+}", 3);
+
+    ASSERT_EQ(0, find("/redfish/v1"));
+    ASSERT_EQ(0, find("/redfish/v1/"));
+    ASSERT_EQ(1, find("/redfish/v1/Systems"));
+    ASSERT_EQ(2, find("/redfish/v1/Systems/12"));
+    ASSERT_EQ(3, find("/redfish/v1/Systems/1/Processors/007"));
+
+    ASSERT_EQ(RouteTrie::NO_ROUTE, find("/redfish"));
+    ASSERT_EQ(RouteTrie::NO_ROUTE, find("/redfish/v1/Systems/1a"));
+    ASSERT_EQ(RouteTrie::NO_ROUTE, find("/redfish/v1/Systems/-1"));
+    ASSERT_EQ(RouteTrie::NO_ROUTE, find("/redfish/v1/Systems/1/Processors"));
+    ASSERT_EQ(RouteTrie::NO_ROUTE, find("/redfish/v1/Systems/1/Processors/1/Memory"));
+}
+
+TEST_F(RouteTrieTest, NumericSegmentsOfDifferentNamesShareNode) {
+    m_trie.insert("/Chassis/{chassisId:[0-9]+}/Drives", 0);
+    m_trie.insert("/Chassis/{id:[0-9]+}/Power", 1);
+
+    ASSERT_EQ(0, find("/Chassis/1/Drives"));
+    ASSERT_EQ(1, find("/Chassis/1/Power"));
+}
+
+TEST_F(RouteTrieTest, RegexAndVariableSegments) {
+    m_trie.insert("/metadata/{file:.*.xml}", 0);
+    m_trie.insert("/Roles/{roleId:[A-Za-z]+}", 1);
+    m_trie.insert("/Anything/{name}", 2);
+
+    ASSERT_EQ(0, find("/metadata/Chassis.xml"));
+    ASSERT_EQ(RouteTrie::NO_ROUTE, find("/metadata/Chassis.json"));
+    ASSERT_EQ(1, find("/Roles/Administrator"));
+    ASSERT_EQ(RouteTrie::NO_ROUTE, find("/Roles/Admin1"));
+    ASSERT_EQ(2, find("/Anything/at-all"));
+}
+
+TEST_F(RouteTrieTest, FirstInsertedRouteWins) {
+    // the same order as checking routes one by one would give
+    m_trie.insert("/Items/{anything}", 0);
+    m_trie.insert("/Items/{itemId:[0-9]+}", 1);
+    m_trie.insert("/Items/Special", 2);
+    m_trie.insert("/Other/{otherId:[0-9]+}/Details", 3);
+    m_trie.insert("/Other/{name}/Details", 4);
+    m_trie.insert("/Other/Special/Details", 5);
+
+    ASSERT_EQ(0, find("/Items/1"));
+    ASSERT_EQ(0, find("/Items/Special"));
+    ASSERT_EQ(3, find("/Other/1/Details"));
+    ASSERT_EQ(4, find("/Other/Special/Details"));
+}
+
+TEST_F(RouteTrieTest, MatchesSameRoutesAsSegmentMatchers) {
+    const std::vector<std::string> routes{
+        "/redfish/v1/Fabrics/{fabricId:[0-9]+}/Zones/{zoneId:[0-9]+}",
+        "/redfish/v1/Fabrics/{fabricId:[0-9]+}/Zones",
+        "/redfish/v1/Fabrics/{fabricId:[0-9]+}/{collection}",
+        "/redfish/v1/Fabrics/Special/Zones",
+        "/redfish/v1/{service}",
+    };
+    for (std::size_t i = 0; i < routes.size(); ++i) {
+        m_trie.insert(routes[i], i);
+    }
+
+    for (const auto& path : {"/redfish/v1/Fabrics/1/Zones/2", "/redfish/v1/Fabrics/1/Zones",
+                             "/redfish/v1/Fabrics/1/Endpoints", "/redfish/v1/Fabrics/Special/Zones",
+                             "/redfish/v1/Fabrics", "/redfish/v1/Fabrics/a/Zones", "/redfish/v1"}) {
+        std::size_t expected{RouteTrie::NO_ROUTE};
+        for (std::size_t i = 0; i < routes.size(); ++i) {
+            if (segments_match(path_to_segments(routes[i]), split_path(path))) {
+                expected = i;
+                break;
+            }
+        }
+        EXPECT_EQ(expected, find(path)) << path;
+    }
+}
+
+}
+}
+}
+}
@@ -0,0 +1,280 @@
+/*!
+ * @brief Redfish query options tests
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file query_options_test.cpp
+ */
+
+#include "psme/rest/server/multiplexer.hpp"
+#include "psme/rest/server/query_options.hpp"
+#include "psme/rest/server/error/server_exception.hpp"
+#include "psme/rest/constants/routes.hpp"
+#include "psme/rest/constants/constants.hpp"
+
+#include "gtest/gtest.h"
+
+#include <functional>
+
+using namespace testing;
+using namespace psme::rest::constants;
+using namespace psme::rest::server;
+
+namespace {
+
+constexpr std::size_t SERVICES = 5;
+
+/*! @brief Endpoint returning JSON resource built from the request */
+class JsonEndpoint : public MethodsHandler {
+public:
+    using Builder = std::function<json::Json(const Request&)>;
+
+    JsonEndpoint(const std::string& path, Builder builder) : MethodsHandler(path), m_builder(builder) {}
+
+    virtual void get(const Request& request, Response& response) override {
+        response.set_body(m_builder(request).dump());
+    }
+
+    virtual void patch(const Request&, Response&) override {}
+
+    virtual void post(const Request&, Response&) override {}
+
+    virtual void put(const Request&, Response&) override {}
+
+    virtual void del(const Request&, Response&) override {}
+
+private:
+    Builder m_builder;
+};
+
+
+json::Json make_reference(const std::string& url) {
+    json::Json reference = json::Json::object();
+    reference[Common::ODATA_ID] = url;
+    return reference;
+}
+
+
+class QueryOptionsTest : public Test {
+public:
+    QueryOptionsTest() {
+        register_endpoint(Routes::STORAGE_SERVICES_COLLECTION_PATH, [](const Request& request) {
+            json::Json json = json::Json::object();
+            json[Common::ODATA_ID] = request.get_url();
+            json[Common::NAME] = "Storage Services Collection";
+            json[Collection::MEMBERS] = json::Json::array();
+            for (std::size_t id = 1; id <= SERVICES; ++id) {
+                json[Collection::MEMBERS].push_back(make_reference(request.get_url() + "/" + std::to_string(id)));
+            }
+            json[Collection::ODATA_COUNT] = SERVICES;
+            return json;
+        });
+        register_endpoint(Routes::STORAGE_SERVICE_PATH, [](const Request& request) {
+            json::Json json = json::Json::object();
+            json[Common::ODATA_ID] = request.get_url();
+            json[Common::ID] = request.params[PathParam::SERVICE_ID];
+            json[Common::NAME] = "Storage Service " + request.params[PathParam::SERVICE_ID];
+            json["Volumes"] = make_reference(request.get_url() + "/Volumes");
+            json[Common::LINKS]["Collection"] = make_reference("/redfish/v1/StorageServices");
+            return json;
+        });
+        register_endpoint(Routes::VOLUME_COLLECTION_PATH, [](const Request& request) {
+            json::Json json = json::Json::object();
+            json[Common::ODATA_ID] = request.get_url();
+            json[Collection::MEMBERS] = json::Json::array({make_reference(request.get_url() + "/1")});
+            json[Collection::ODATA_COUNT] = 1;
+            return json;
+        });
+        register_endpoint(Routes::VOLUME_PATH, [](const Request& request) {
+            json::Json json = json::Json::object();
+            json[Common::ODATA_ID] = request.get_url();
+            json["CapacityBytes"] = 1024;
+            return json;
+        });
+    }
+
+    json::Json get(const std::string& url, const Parameters& query) {
+        Request request{};
+        request.set_method(Method::GET);
+        request.set_destination(url);
+        request.query = query;
+        Response response{};
+        m_multiplexer.forward_to_handler(response, request);
+        return json::Json::parse(response.get_body());
+    }
+
+    Multiplexer m_multiplexer{};
+
+private:
+    void register_endpoint(const std::string& path, JsonEndpoint::Builder builder) {
+        m_multiplexer.register_handler(MethodsHandler::UPtr(new JsonEndpoint(path, builder)), AccessType::ALL);
+    }
+};
+
+}
+
+
+TEST(QueryOptionsParseTest, ParsesRedfishOptions) {
+    Parameters query{};
+    query[QueryOptions::EXPAND] = ".($levels=2)";
+    query[QueryOptions::SELECT] = "Name, Links/Collection";
+    query[QueryOptions::TOP] = "2";
+    query[QueryOptions::SKIP] = "1";
+    query["other"] = "ignored";
+
+    const auto options = QueryOptions::from_query(query);
+    ASSERT_FALSE(options.empty());
+    EXPECT_EQ(QueryOptions::ExpandType::SUBORDINATE, options.get_expand());
+    EXPECT_EQ(2, options.get_expand_levels());
+    EXPECT_EQ((std::vector<std::string>{"Name", "Links/Collection"}), options.get_select());
+    EXPECT_EQ(2, options.get_top().value());
+    EXPECT_EQ(1, options.get_skip().value());
+
+    EXPECT_TRUE(QueryOptions::from_query(Parameters{}).empty());
+}
+
+
+TEST(QueryOptionsParseTest, InvalidValuesAreRejected) {
+    const std::vector<std::pair<std::string, std::string>> invalid_options = {
+        {QueryOptions::TOP, "-1"},
+        {QueryOptions::SKIP, "abc"},
+        {QueryOptions::TOP, "99999999999999999999999"},
+        {QueryOptions::EXPAND, "x"},
+        {QueryOptions::EXPAND, "*($levels=0)"},
+        {QueryOptions::EXPAND, "*($levels=9)"},
+        {QueryOptions::EXPAND, "*($top=1)"},
+        {QueryOptions::SELECT, "Name,"},
+        {QueryOptions::SELECT, "/Name"}
+    };
+    for (const auto& option : invalid_options) {
+        Parameters query{};
+        query[option.first] = option.second;
+        try {
+            QueryOptions::from_query(query);
+            FAIL() << option.first << "=" << option.second << " accepted";
+        }
+        catch (const psme::rest::error::ServerException& e) {
+            EXPECT_EQ(status_4XX::BAD_REQUEST, e.get_error().get_http_status_code());
+        }
+    }
+}
+
+
+TEST_F(QueryOptionsTest, TopAndSkipPageMembers) {
+    Parameters query{};
+    query[QueryOptions::SKIP] = "1";
+    query[QueryOptions::TOP] = "2";
+    const auto json = get("/redfish/v1/StorageServices", query);
+
+    EXPECT_EQ(json::Json::array({make_reference("/redfish/v1/StorageServices/2"),
+                                 make_reference("/redfish/v1/StorageServices/3")}), json[Collection::MEMBERS]);
+    EXPECT_EQ(SERVICES, json[Collection::ODATA_COUNT].get<std::size_t>());
+    EXPECT_EQ("/redfish/v1/StorageServices?$skip=3&$top=2", json[Collection::ODATA_NEXT_LINK].get<std::string>());
+
+    query[QueryOptions::SKIP] = "3";
+    const auto last_page = get("/redfish/v1/StorageServices", query);
+    EXPECT_EQ(2, last_page[Collection::MEMBERS].size());
+    EXPECT_FALSE(last_page.count(Collection::ODATA_NEXT_LINK));
+}
+
+
+TEST_F(QueryOptionsTest, TopDoesNotOverflow) {
+    Parameters query{};
+    query[QueryOptions::SKIP] = "1";
+    query[QueryOptions::TOP] = "18446744073709551615";
+    const auto json = get("/redfish/v1/StorageServices", query);
+
+    EXPECT_EQ(SERVICES - 1, json[Collection::MEMBERS].size());
+    EXPECT_FALSE(json.count(Collection::ODATA_NEXT_LINK));
+}
+
+
+TEST_F(QueryOptionsTest, NextLinkKeepsOtherOptions) {
+    Parameters query{};
+    query[QueryOptions::EXPAND] = ".($levels=2)";
+    query[QueryOptions::SELECT] = "Members, Name";
+    query[QueryOptions::TOP] = "2";
+    const auto json = get("/redfish/v1/StorageServices", query);
+
+    EXPECT_EQ(2, json[Collection::MEMBERS].size());
+    EXPECT_EQ("/redfish/v1/StorageServices?$expand=.($levels=2)&$select=Members,Name&$skip=2&$top=2",
+              json[Collection::ODATA_NEXT_LINK].get<std::string>());
+
+    Parameters expand_query{};
+    expand_query[QueryOptions::EXPAND] = "*";
+    expand_query[QueryOptions::SKIP] = "1";
+    expand_query[QueryOptions::TOP] = "1";
+    EXPECT_EQ("/redfish/v1/StorageServices?$expand=*&$skip=2&$top=1",
+              get("/redfish/v1/StorageServices", expand_query)[Collection::ODATA_NEXT_LINK].get<std::string>());
+}
+
+
+TEST_F(QueryOptionsTest, ExpandAllReplacesReferencesWithResources) {
+    Parameters query{};
+    query[QueryOptions::EXPAND] = "*";
+    const auto json = get("/redfish/v1/StorageServices", query);
+
+    ASSERT_EQ(SERVICES, json[Collection::MEMBERS].size());
+    for (std::size_t id = 1; id <= SERVICES; ++id) {
+        const auto& member = json[Collection::MEMBERS][id - 1];
+        EXPECT_EQ("Storage Service " + std::to_string(id), member[Common::NAME].get<std::string>());
+        /* only one level is expanded */
+        EXPECT_EQ(make_reference(member[Common::ODATA_ID].get<std::string>() + "/Volumes"), member["Volumes"]);
+    }
+}
+
+
+TEST_F(QueryOptionsTest, ExpandLevelsFollowSubordinateResources) {
+    Parameters query{};
+    query[QueryOptions::EXPAND] = ".($levels=2)";
+    const auto json = get("/redfish/v1/StorageServices/1", query);
+
+    EXPECT_EQ(1024, json["Volumes"][Collection::MEMBERS][0]["CapacityBytes"].get<int>());
+    EXPECT_EQ(make_reference("/redfish/v1/StorageServices"), json[Common::LINKS]["Collection"]);
+
+    query[QueryOptions::EXPAND] = "~";
+    const auto links = get("/redfish/v1/StorageServices/1", query);
+    EXPECT_EQ(SERVICES, links[Common::LINKS]["Collection"][Collection::MEMBERS].size());
+    EXPECT_EQ(make_reference("/redfish/v1/StorageServices/1/Volumes"), links["Volumes"]);
+}
+
+
+TEST_F(QueryOptionsTest, ExpandDoesNotFollowReferencesBackToParents) {
+    Parameters query{};
+    query[QueryOptions::EXPAND] = "*($levels=3)";
+    const auto json = get("/redfish/v1/StorageServices", query);
+
+    const auto& member = json[Collection::MEMBERS][0];
+    EXPECT_EQ(make_reference("/redfish/v1/StorageServices"), member[Common::LINKS]["Collection"]);
+    EXPECT_EQ(1024, member["Volumes"][Collection::MEMBERS][0]["CapacityBytes"].get<int>());
+}
+
+
+TEST_F(QueryOptionsTest, SelectKeepsSelectedProperties) {
+    Parameters query{};
+    query[QueryOptions::SELECT] = "Name,Links/Collection";
+    const auto json = get("/redfish/v1/StorageServices/1", query);
+
+    json::Json expected = json::Json::object();
+    expected[Common::ODATA_ID] = "/redfish/v1/StorageServices/1";
+    expected[Common::NAME] = "Storage Service 1";
+    expected[Common::LINKS]["Collection"] = make_reference("/redfish/v1/StorageServices");
+    EXPECT_EQ(expected, json);
+
+    query[QueryOptions::SELECT] = "Members/Name";
+    query[QueryOptions::EXPAND] = "*";
+    const auto members = get("/redfish/v1/StorageServices", query);
+    EXPECT_EQ(SERVICES, members[Collection::ODATA_COUNT].get<std::size_t>());
+    EXPECT_EQ(2, members[Collection::MEMBERS][0].size());
+    EXPECT_EQ("Storage Service 1", members[Collection::MEMBERS][0][Common::NAME].get<std::string>());
+}
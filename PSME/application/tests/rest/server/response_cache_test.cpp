@@ -0,0 +1,191 @@
+/*!
+ * @brief Response cache tests
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file response_cache_test.cpp
+ */
+
+#include "psme/rest/server/multiplexer.hpp"
+#include "psme/rest/server/response_cache.hpp"
+#include "psme/rest/server/http_headers.hpp"
+#include "psme/rest/server/utils.hpp"
+#include "psme/rest/constants/routes.hpp"
+
+#include "agent-framework/module/managers/generic_manager.hpp"
+#include "agent-framework/module/model/chassis.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace testing;
+using namespace psme::rest::constants;
+using namespace psme::rest::server;
+using namespace agent_framework::module;
+using agent_framework::model::Chassis;
+
+namespace {
+
+/*! @brief Endpoint built from the chassis table, counts built responses */
+class CountingEndpoint : public MethodsHandler {
+public:
+    CountingEndpoint(const std::string& path, GenericManager<Chassis>& chassis) :
+        MethodsHandler(path), m_chassis(chassis) {}
+
+    virtual void get(const Request& request, Response& response) override {
+        ++m_calls;
+        json::Json json = json::Json::object();
+        json["@odata.id"] = request.get_url();
+        json["Members@odata.count"] = m_chassis.get_entry_count();
+        json["Description"] = m_description;
+        response.set_header("Content-Type", "application/json");
+        response.set_body(json.dump());
+    }
+
+    virtual void patch(const Request& request, Response&) override {
+        m_description = request.get_body();
+    }
+
+    virtual void post(const Request&, Response&) override {}
+
+    virtual void put(const Request&, Response&) override {}
+
+    virtual void del(const Request&, Response&) override {}
+
+    GenericManager<Chassis>& m_chassis;
+    std::string m_description{};
+    int m_calls{0};
+};
+
+
+class ResponseCacheTest : public Test {
+public:
+    ResponseCacheTest() {
+        m_chassis.add_entry(Chassis{"parent"});
+        m_collection = register_endpoint(Routes::CHASSIS_COLLECTION_PATH);
+        m_resource = register_endpoint(Routes::CHASSIS_PATH);
+        m_systems = register_endpoint(Routes::SYSTEMS_COLLECTION_PATH);
+        m_multiplexer.get_response_cache().set_max_entries(16);
+    }
+
+    Response execute(Method method, const std::string& url, const std::string& body = {}) {
+        Request request{};
+        request.set_method(method);
+        request.set_destination(url);
+        request.set_body(body);
+        Response response{};
+        m_multiplexer.forward_to_handler(response, request);
+        return response;
+    }
+
+    GenericManager<Chassis> m_chassis{};
+    CountingEndpoint* m_collection{nullptr};
+    CountingEndpoint* m_resource{nullptr};
+    CountingEndpoint* m_systems{nullptr};
+    Multiplexer m_multiplexer{};
+
+private:
+    CountingEndpoint* register_endpoint(const std::string& path) {
+        auto endpoint = new CountingEndpoint(path, m_chassis);
+        m_multiplexer.register_handler(MethodsHandler::UPtr(endpoint), AccessType::ALL);
+        return endpoint;
+    }
+};
+
+}
+
+
+TEST(ResponseCacheUrlTest, RelatedUrlsAreInTheSameBranch) {
+    EXPECT_TRUE(is_related_url("/redfish/v1/Chassis", "/redfish/v1/Chassis"));
+    EXPECT_TRUE(is_related_url("/redfish/v1/Chassis", "/redfish/v1/Chassis/1/Drives"));
+    EXPECT_TRUE(is_related_url("/redfish/v1/Chassis/1", "/redfish/v1/"));
+    EXPECT_FALSE(is_related_url("/redfish/v1/Chassis/1", "/redfish/v1/Chassis/10"));
+    EXPECT_FALSE(is_related_url("/redfish/v1/Chassis/1", "/redfish/v1/Systems"));
+}
+
+
+TEST_F(ResponseCacheTest, CachedResponseIsServedUntilModelChanges) {
+    auto first = execute(Method::GET, "/redfish/v1/Chassis");
+    auto second = execute(Method::GET, "/redfish/v1/Chassis");
+    EXPECT_EQ(1, m_collection->m_calls);
+    EXPECT_EQ(status_2XX::OK, second.get_status());
+    EXPECT_EQ(first.get_body(), second.get_body());
+    EXPECT_EQ(first.get_headers(), second.get_headers());
+
+    /* model is updated by an agent notification */
+    m_chassis.add_entry(Chassis{"parent"});
+    auto third = execute(Method::GET, "/redfish/v1/Chassis");
+    EXPECT_EQ(2, m_collection->m_calls);
+    EXPECT_EQ(2, json::Json::parse(third.get_body())["Members@odata.count"].get<int>());
+
+    const auto statistics = m_multiplexer.get_response_cache().get_statistics();
+    EXPECT_EQ(1, statistics.hits);
+    EXPECT_EQ(2, statistics.misses);
+    EXPECT_EQ(1, statistics.entries);
+}
+
+
+TEST_F(ResponseCacheTest, LocalModificationInvalidatesItsBranch) {
+    execute(Method::GET, "/redfish/v1/Chassis");
+    execute(Method::GET, "/redfish/v1/Chassis/1");
+    execute(Method::GET, "/redfish/v1/Systems");
+
+    execute(Method::PATCH, "/redfish/v1/Chassis/1", "patched");
+    EXPECT_EQ(2, m_multiplexer.get_response_cache().get_statistics().invalidations);
+
+    auto resource = execute(Method::GET, "/redfish/v1/Chassis/1");
+    EXPECT_EQ("patched", json::Json::parse(resource.get_body())["Description"].get<std::string>());
+    execute(Method::GET, "/redfish/v1/Chassis");
+    execute(Method::GET, "/redfish/v1/Systems");
+    EXPECT_EQ(2, m_collection->m_calls);
+    EXPECT_EQ(2, m_resource->m_calls);
+    EXPECT_EQ(1, m_systems->m_calls);
+}
+
+
+TEST_F(ResponseCacheTest, NotModifiedIsReturnedForCachedResponse) {
+    auto first = execute(Method::GET, "/redfish/v1/Chassis");
+    const auto etag = first.get_headers().at(http_headers::ETag::ETAG);
+
+    Request request{};
+    request.set_method(Method::GET);
+    request.set_destination("/redfish/v1/Chassis");
+    request.set_header(http_headers::IfNoneMatch::IF_NONE_MATCH, etag);
+    Response response{};
+    m_multiplexer.forward_to_handler(response, request);
+    EXPECT_EQ(status_3XX::NOT_MODIFIED, response.get_status());
+    EXPECT_EQ(1, m_collection->m_calls);
+}
+
+
+TEST_F(ResponseCacheTest, LeastRecentlyUsedResponsesAreDropped) {
+    m_multiplexer.get_response_cache().set_max_entries(2);
+    execute(Method::GET, "/redfish/v1/Chassis");
+    execute(Method::GET, "/redfish/v1/Chassis/1");
+    execute(Method::GET, "/redfish/v1/Chassis");
+    execute(Method::GET, "/redfish/v1/Systems");
+
+    execute(Method::GET, "/redfish/v1/Chassis");
+    execute(Method::GET, "/redfish/v1/Chassis/1");
+    EXPECT_EQ(1, m_collection->m_calls);
+    EXPECT_EQ(2, m_resource->m_calls);
+    EXPECT_EQ(2, m_multiplexer.get_response_cache().get_statistics().entries);
+}
+
+
+TEST_F(ResponseCacheTest, DisabledCacheDoesNotStoreResponses) {
+    m_multiplexer.get_response_cache().set_max_entries(0);
+    execute(Method::GET, "/redfish/v1/Chassis");
+    execute(Method::GET, "/redfish/v1/Chassis");
+    EXPECT_EQ(2, m_collection->m_calls);
+    EXPECT_EQ(0, m_multiplexer.get_response_cache().get_statistics().entries);
+}
@@ -0,0 +1,85 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @section Metric history benchmark: memory per sample of the encoded history
+ * */
+
+#include "psme/rest/telemetry/metric_history.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace psme::rest::telemetry;
+
+namespace {
+
+constexpr std::size_t METRICS = 200;
+constexpr std::size_t SAMPLES_PER_METRIC = 2000;
+constexpr std::size_t MAX_MEMORY_BYTES = 64 * 1024 * 1024;
+
+
+/*! @brief Typical readings: slowly changing temperatures and bandwidths, counters and constant states */
+json::Json make_value(std::size_t metric, std::size_t sample) {
+    switch (metric % 4) {
+        case 0:
+            return 40.0 + double((sample / 10 + metric) % 8) * 0.5;
+        case 1:
+            return std::uint64_t((sample * 7 + metric) % 100);
+        case 2:
+            return std::uint64_t(1000000 + sample * 4096);
+        default:
+            return "Enabled";
+    }
+}
+
+}
+
+
+TEST(MetricHistoryBenchmark, MemoryPerSample) {
+    MetricHistory history{};
+    history.set_limits(std::chrono::seconds{0}, MAX_MEMORY_BYTES);
+    std::vector<std::string> uuids{};
+    for (std::size_t metric = 0; metric < METRICS; ++metric) {
+        uuids.push_back("metric" + std::to_string(metric));
+    }
+
+    const auto start_time = MetricHistory::Clock::now();
+    for (std::size_t sample = 0; sample < SAMPLES_PER_METRIC; ++sample) {
+        const auto timestamp = start_time + std::chrono::milliseconds{1000 * sample + sample % 3};
+        for (std::size_t metric = 0; metric < METRICS; ++metric) {
+            history.add_sample(uuids[metric], make_value(metric, sample), timestamp);
+        }
+    }
+
+    const auto samples = METRICS * SAMPLES_PER_METRIC;
+    const auto statistics = history.get_statistics();
+    const auto bytes_per_sample = double(statistics.memory_bytes) / double(statistics.samples);
+    /* timestamp and value of a decoded sample, without the memory allocated by the value */
+    const auto decoded_bytes_per_sample = sizeof(MetricHistory::Sample);
+
+    ASSERT_EQ(samples, statistics.samples);
+    EXPECT_EQ(0u, statistics.dropped_chunks);
+    std::size_t checksum{0};
+    for (std::size_t metric = 0; metric < METRICS; ++metric) {
+        const auto decoded = history.get_samples(uuids[metric]);
+        ASSERT_EQ(SAMPLES_PER_METRIC, decoded.size());
+        checksum += std::size_t(decoded.back().value == make_value(metric, SAMPLES_PER_METRIC - 1));
+    }
+    EXPECT_EQ(METRICS, checksum);
+    EXPECT_LT(bytes_per_sample, double(decoded_bytes_per_sample));
+}
@@ -0,0 +1,290 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file metric_history_test.cpp
+ * */
+
+#include "psme/rest/telemetry/metric_history.hpp"
+#include "psme/rest/telemetry/metric_reports.hpp"
+#include "agent-framework/module/common_components.hpp"
+#include "agent-framework/module/compute_components.hpp"
+#include "agent-framework/module/utils/time.hpp"
+
+#include "gtest/gtest.h"
+
+#include <limits>
+
+using namespace psme::rest::telemetry;
+using namespace agent_framework::model;
+using agent_framework::module::ReadTracker;
+using agent_framework::module::get_manager;
+
+namespace {
+
+constexpr std::size_t MAX_MEMORY_BYTES = 1024 * 1024;
+
+const MetricHistory::TimePoint START{std::chrono::seconds{1546300800}};
+
+
+MetricHistory::TimePoint at(std::int64_t seconds) {
+    return START + std::chrono::seconds{seconds};
+}
+
+
+std::string timestamp(std::int64_t seconds) {
+    return agent_framework::utils::make_iso_8601_timestamp(MetricHistory::Clock::to_time_t(at(seconds)));
+}
+
+
+class MetricHistoryTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        history.set_limits(std::chrono::seconds{0}, MAX_MEMORY_BYTES);
+    }
+
+    MetricHistory history{};
+};
+
+}
+
+
+TEST_F(MetricHistoryTest, ValuesOfAllTypesAreRestored) {
+    const std::vector<json::Json> values{
+        42, 42, -7, std::int64_t(1) << 40, 21.5, 21.25, 21.25, -0.1, 1e300, nullptr, true, false, "Enabled", "Enabled",
+        json::Json::parse(R"({"Health": "OK"})"), std::numeric_limits<std::uint64_t>::max(), 42
+    };
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        history.add_sample("metric", values[i], at(std::int64_t(i)));
+    }
+
+    const auto samples = history.get_samples("metric");
+    ASSERT_EQ(values.size(), samples.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], samples[i].value) << "sample " << i;
+        EXPECT_EQ(values[i].is_number_float(), samples[i].value.is_number_float()) << "sample " << i;
+        EXPECT_EQ(at(std::int64_t(i)), samples[i].timestamp);
+    }
+    EXPECT_TRUE(history.get_samples("other").empty());
+}
+
+
+TEST_F(MetricHistoryTest, SamplesAreKeptInChunks) {
+    const auto count = 3 * MetricHistory::SAMPLES_PER_CHUNK + 1;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        history.add_sample("metric", 20.0 + (i % 10) / 4.0, at(i));
+        history.add_sample("other", i, at(i));
+    }
+
+    const auto statistics = history.get_statistics();
+    EXPECT_EQ(2 * count, statistics.samples);
+    EXPECT_EQ(2u, statistics.metrics);
+    EXPECT_EQ(8u, statistics.chunks);
+    EXPECT_EQ(0u, statistics.dropped_chunks);
+
+    const auto samples = history.get_samples("metric", at(count - 5));
+    ASSERT_EQ(5u, samples.size());
+    EXPECT_EQ(at(count - 5), samples.front().timestamp);
+    EXPECT_EQ(json::Json(20.0 + ((count - 1) % 10) / 4.0), samples.back().value);
+    EXPECT_EQ(count, history.get_samples("other").size());
+}
+
+
+TEST_F(MetricHistoryTest, RepeatedValuesAreStoredCompactly) {
+    MetricHistory changing{};
+    changing.set_limits(std::chrono::seconds{0}, MAX_MEMORY_BYTES);
+    for (std::uint32_t i = 0; i < MetricHistory::SAMPLES_PER_CHUNK; ++i) {
+        history.add_sample("metric", 35.5, at(i));
+        changing.add_sample("metric", 35.5 + 1e-3 * i, at(i));
+    }
+
+    /* repeated value takes two bytes: the timestamp delta and the tag */
+    EXPECT_LT(history.get_statistics().memory_bytes + 5 * MetricHistory::SAMPLES_PER_CHUNK,
+              changing.get_statistics().memory_bytes);
+}
+
+
+TEST_F(MetricHistoryTest, SamplesOlderThanRetentionAreDropped) {
+    history.set_limits(std::chrono::seconds{2 * MetricHistory::SAMPLES_PER_CHUNK}, MAX_MEMORY_BYTES);
+    const auto count = 4 * MetricHistory::SAMPLES_PER_CHUNK;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        history.add_sample("metric", i, at(i));
+    }
+
+    const auto samples = history.get_samples("metric");
+    ASSERT_FALSE(samples.empty());
+    /* samples are dropped with whole chunks */
+    EXPECT_EQ(at(MetricHistory::SAMPLES_PER_CHUNK), samples.front().timestamp);
+    EXPECT_EQ(at(count - 1), samples.back().timestamp);
+    EXPECT_EQ(1u, history.get_statistics().dropped_chunks);
+}
+
+
+TEST_F(MetricHistoryTest, OldestChunksAreDroppedAboveMemoryLimit) {
+    constexpr std::size_t LIMIT = 16 * 1024;
+    history.set_limits(std::chrono::seconds{0}, LIMIT);
+    for (std::uint32_t i = 0; i < 20 * MetricHistory::SAMPLES_PER_CHUNK; ++i) {
+        for (const auto& metric : {"first", "second", "third"}) {
+            history.add_sample(metric, i * 0.37, at(i));
+        }
+    }
+
+    const auto statistics = history.get_statistics();
+    EXPECT_LE(statistics.memory_bytes, LIMIT);
+    EXPECT_GT(statistics.dropped_chunks, 0u);
+    for (const auto& metric : {"first", "second", "third"}) {
+        const auto samples = history.get_samples(metric);
+        ASSERT_FALSE(samples.empty());
+        EXPECT_EQ(json::Json((20 * MetricHistory::SAMPLES_PER_CHUNK - 1) * 0.37), samples.back().value);
+    }
+
+    history.set_limits(std::chrono::seconds{0}, 1);
+    EXPECT_EQ(0u, history.get_statistics().samples);
+    EXPECT_TRUE(history.get_metric_uuids().empty());
+}
+
+
+TEST_F(MetricHistoryTest, DisabledHistoryIgnoresSamples) {
+    history.set_limits(std::chrono::seconds{60}, 0);
+    EXPECT_FALSE(history.is_enabled());
+    history.add_sample("metric", 1, at(0));
+    EXPECT_TRUE(history.get_samples("metric").empty());
+    EXPECT_EQ(0u, history.get_statistics().memory_bytes);
+}
+
+
+TEST_F(MetricHistoryTest, ReadsAreRecordedByReadTracker) {
+    history.add_sample("metric", 1, at(0));
+
+    ReadTracker tracker{};
+    history.get_samples("metric");
+    const auto dependencies = tracker.get_dependencies();
+    EXPECT_TRUE(tracker.is_tracked());
+    EXPECT_TRUE(ReadTracker::is_up_to_date(dependencies));
+
+    history.add_sample("metric", 1, at(1));
+    EXPECT_FALSE(ReadTracker::is_up_to_date(dependencies));
+}
+
+
+namespace {
+
+class MetricReportsTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        reports->configure(json::Json::parse(R"({
+            "enabled": true,
+            "retention-sec": 0,
+            "max-memory-bytes": 1048576,
+            "reports": [
+                {"id": "Periodic", "type": "Periodic", "interval-sec": 10},
+                {"id": "Changes", "type": "OnChange"},
+                {"id": "Invalid1", "type": "OnChange"},
+                {"id": "Changes", "type": "Periodic"}
+            ]
+        })"));
+
+        Manager manager{};
+        manager.set_uuid("manager");
+        get_manager<Manager>().add_entry(manager);
+        System system{"manager"};
+        system.set_uuid("system");
+        system.set_id(1);
+        get_manager<System>().add_entry(system);
+        MetricDefinition definition{};
+        definition.set_uuid("definition");
+        definition.set_id(3);
+        get_manager<MetricDefinition>().add_entry(definition);
+        Metric metric{"system"};
+        metric.set_uuid("metric");
+        metric.set_name("/ProcessorBandwidthPercent");
+        metric.set_component_uuid("system");
+        metric.set_component_type(enums::Component::System);
+        metric.set_metric_definition_uuid("definition");
+        get_manager<Metric>().add_entry(metric);
+    }
+
+    void TearDown() override {
+        reports->configure(json::Json::object());
+        get_manager<Metric>().clear_entries();
+        get_manager<MetricDefinition>().clear_entries();
+        get_manager<System>().clear_entries();
+        get_manager<Manager>().clear_entries();
+    }
+
+    MetricReports* reports{MetricReports::get_instance()};
+};
+
+}
+
+
+TEST_F(MetricReportsTest, InvalidReportsAreSkipped) {
+    ASSERT_EQ(2u, reports->get_definitions().size());
+    ASSERT_NE(nullptr, reports->find_definition("Changes"));
+    EXPECT_EQ(ReportDefinition::Type::OnChange, reports->find_definition("Changes")->type);
+    EXPECT_EQ(std::chrono::seconds{10}, reports->find_definition("Periodic")->interval);
+    EXPECT_EQ(nullptr, reports->find_definition("Invalid1"));
+}
+
+
+TEST_F(MetricReportsTest, PeriodicReportContainsValuesOfLastInterval) {
+    for (std::int64_t i = 0; i < 25; ++i) {
+        reports->get_history().add_sample("metric", i / 5, at(i));
+    }
+    /* samples of not existing metrics are skipped */
+    reports->get_history().add_sample("removed", 1, at(15));
+
+    ReadTracker tracker{};
+    const auto report = reports->make_report(*reports->find_definition("Periodic"), at(25));
+    EXPECT_FALSE(tracker.is_tracked());
+
+    const auto& values = report["MetricValues"];
+    ASSERT_EQ(10u, values.size());
+    EXPECT_EQ("2", values[0]["MetricValue"]);
+    EXPECT_EQ(timestamp(10), values[0]["Timestamp"]);
+    EXPECT_EQ("3", values[9]["MetricValue"]);
+    EXPECT_EQ("3", values[0]["MetricId"]);
+    EXPECT_EQ("/redfish/v1/Systems/1/Metrics#/ProcessorBandwidthPercent", values[0]["MetricProperty"]);
+    EXPECT_EQ(std::to_string(at(20).time_since_epoch() / std::chrono::seconds{10}), report["ReportSequence"]);
+    EXPECT_EQ(timestamp(20), report["Timestamp"]);
+}
+
+
+TEST_F(MetricReportsTest, OnChangeReportContainsChangedValues) {
+    for (std::int64_t i = 0; i < 25; ++i) {
+        reports->get_history().add_sample("metric", i / 10, at(i));
+    }
+
+    ReadTracker tracker{};
+    const auto report = reports->make_report(*reports->find_definition("Changes"), at(100));
+    EXPECT_TRUE(tracker.is_tracked());
+
+    const auto& values = report["MetricValues"];
+    ASSERT_EQ(3u, values.size());
+    EXPECT_EQ("0", values[0]["MetricValue"]);
+    EXPECT_EQ("1", values[1]["MetricValue"]);
+    EXPECT_EQ(timestamp(10), values[1]["Timestamp"]);
+    EXPECT_EQ("2", values[2]["MetricValue"]);
+    EXPECT_EQ("3", report["ReportSequence"]);
+    EXPECT_EQ(timestamp(20), report["Timestamp"]);
+
+    const auto dependencies = tracker.get_dependencies();
+    EXPECT_TRUE(ReadTracker::is_up_to_date(dependencies));
+    reports->get_history().add_sample("metric", 2, at(25));
+    EXPECT_FALSE(ReadTracker::is_up_to_date(dependencies));
+}
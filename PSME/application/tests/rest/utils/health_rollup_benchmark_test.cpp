@@ -0,0 +1,161 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @section Health rollup benchmark: resources visited for rollups of a System GET, by the visitor and the index
+ * */
+
+#include "agent-framework/module/managers/generic_manager.hpp"
+#include "agent-framework/module/managers/utils/health_rollup_index.hpp"
+#include "agent-framework/module/model/memory.hpp"
+#include "agent-framework/module/model/processor.hpp"
+#include "agent-framework/module/model/system.hpp"
+#include "agent-framework/module/requests/compute.hpp"
+#include "psme/rest/utils/status_helpers.hpp"
+#include "psme/rest/model/handlers/generic_handler.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace agent_framework;
+using namespace agent_framework::model;
+using namespace agent_framework::module;
+
+namespace psme {
+namespace rest {
+namespace endpoint {
+
+namespace {
+
+constexpr std::size_t SYSTEMS = 256;
+constexpr std::size_t PROCESSORS_PER_SYSTEM = 4;
+constexpr std::size_t MEMORIES_PER_SYSTEM = 24;
+
+using SystemHandler = model::handler::GenericHandler
+    <requests::GetSystemInfo, System,
+        model::handler::IdPolicy<enums::Component::System, model::handler::NumberingZone::SHARED>>;
+
+
+template <typename T>
+void add_resource(const std::string& parent_uuid, const std::string& uuid, OptionalField<enums::Health> health) {
+    T resource{parent_uuid};
+    resource.set_uuid(uuid);
+    attribute::Status status{};
+    status.set_health(health);
+    resource.set_status(status);
+    get_manager<T>().add_entry(resource);
+}
+
+
+/*! @brief Compute tree of a large rack, some of the components are unhealthy */
+void fill_compute_tree() {
+    for (std::size_t system = 0; system < SYSTEMS; ++system) {
+        const auto system_uuid = "system" + std::to_string(system);
+        add_resource<System>("manager", system_uuid, enums::Health::OK);
+        for (std::size_t processor = 0; processor < PROCESSORS_PER_SYSTEM; ++processor) {
+            add_resource<Processor>(system_uuid, system_uuid + "processor" + std::to_string(processor),
+                                    (system + processor) % 7 ? enums::Health::OK : enums::Health::Warning);
+        }
+        for (std::size_t memory = 0; memory < MEMORIES_PER_SYSTEM; ++memory) {
+            add_resource<Memory>(system_uuid, system_uuid + "memory" + std::to_string(memory),
+                                 (system + memory) % 29 ? enums::Health::OK : enums::Health::Critical);
+        }
+    }
+}
+
+
+void clear_compute_tree() {
+    get_manager<System>().clear_entries();
+    get_manager<Processor>().clear_entries();
+    get_manager<Memory>().clear_entries();
+}
+
+
+/*! @brief Health rollup counting resources visited to compute it */
+class CountingHealthRollup : public HealthRollup<System> {
+public:
+    bool visit(const Resource& resource, const enums::Component component) override {
+        ++visited;
+        return HealthRollup<System>::visit(resource, component);
+    }
+
+    std::size_t visited{0};
+};
+
+
+/*!
+ * @brief Rollups of processors and memory summaries of all System resources
+ * @param[out] visited Number of resources visited to compute the rollups
+ * @return Rollups of all systems
+ */
+std::vector<OptionalField<enums::Health>> get_system_summaries(std::size_t& visited) {
+    std::vector<OptionalField<enums::Health>> summaries{};
+    visited = 0;
+    for (const auto& system_uuid : get_manager<System>().get_keys()) {
+        for (const auto component : {enums::Component::Processor, enums::Component::Memory}) {
+            CountingHealthRollup rollup{};
+            summaries.push_back(rollup.get(system_uuid, component));
+            visited += rollup.visited;
+        }
+    }
+    return summaries;
+}
+
+}
+
+
+class RollupBenchmarkTest : public ::testing::Test {
+public:
+    ~RollupBenchmarkTest();
+
+    void SetUp() override {
+        auto handlers = psme::rest::model::handler::HandlerManager::get_instance();
+        auto system_handler = dynamic_cast<SystemHandler*>(handlers->get_handler(enums::Component::System));
+        system_handler->remember_sub_handler(handlers->get_handler(enums::Component::Processor));
+        system_handler->remember_sub_handler(handlers->get_handler(enums::Component::Memory));
+    }
+};
+
+RollupBenchmarkTest::~RollupBenchmarkTest() { }
+
+
+TEST_F(RollupBenchmarkTest, IndexedRollupsMatchVisitorWithoutVisitingResources) {
+    auto index = HealthRollupIndex::get_instance();
+    index->set_enabled(false);
+    fill_compute_tree();
+    std::size_t visitor_visited{0};
+    const auto visitor_summaries = get_system_summaries(visitor_visited);
+    clear_compute_tree();
+
+    // the index has to be enabled before the tables are filled
+    index->set_enabled(true);
+    fill_compute_tree();
+    std::size_t index_visited{0};
+    const auto index_summaries = get_system_summaries(index_visited);
+    clear_compute_tree();
+    index->set_enabled(false);
+
+    ASSERT_EQ(2 * SYSTEMS, visitor_summaries.size());
+    EXPECT_EQ(visitor_summaries, index_summaries);
+    // the visitor walks the whole subtree of the system for each rollup, the index reads a single node
+    EXPECT_EQ(2 * SYSTEMS * (1 + PROCESSORS_PER_SYSTEM + MEMORIES_PER_SYSTEM), visitor_visited);
+    EXPECT_EQ(0, index_visited);
+}
+
+}
+}
+}
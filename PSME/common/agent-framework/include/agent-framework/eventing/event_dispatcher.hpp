@@ -28,6 +28,7 @@
 #include "agent-framework/threading/thread.hpp"
 #include "agent-framework/eventing/event_sender.hpp"
 
+#include <chrono>
 #include <memory>
 
 /*! AGENT_FRAMEWORK namespace */
@@ -45,9 +46,18 @@ public:
 
     /*!
      * @brief Constructor.
+     *
+     * Coalescing window is read from "eventing"."coalescing-window-ms" configuration property.
      * */
     explicit EventDispatcher();
 
+    /*!
+     * @brief Constructor.
+     * @param coalescing_window Maximum time queued events are gathered for before they are merged
+     *        and sent as a single notification, zero disables coalescing.
+     * */
+    explicit EventDispatcher(const std::chrono::milliseconds& coalescing_window);
+
     /*!
      * @brief Destructor.
      * */
@@ -70,10 +80,25 @@ public:
      */
     void disable_send_notifications();
 
+    /*!
+     * @brief Gets coalescing window.
+     * @return Maximum time events are gathered for before they are sent.
+     */
+    const std::chrono::milliseconds& get_coalescing_window() const {
+        return m_coalescing_window;
+    }
+
 private:
     std::unique_ptr<EventSender> m_event_sender{};
+    std::chrono::milliseconds m_coalescing_window{};
 
     void execute();
+
+    /*!
+     * @brief Gathers already queued notifications (for at most the coalescing window) and merges their events.
+     * @param notification First notification of the batch, events are added to it.
+     */
+    void coalesce(model::requests::ComponentNotification& notification);
 };
 
 }
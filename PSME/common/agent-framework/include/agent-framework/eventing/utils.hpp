@@ -32,6 +32,20 @@ void send_event(const Uuid& component_uuid,
                 const Uuid& parent_uuid = "");
 
 
+/*!
+ * @brief Merge a burst of events into the smallest equivalent sequence
+ *
+ * Events are handled per component UUID, order of the remaining events is kept:
+ * - Update following Add or Update of the component is dropped,
+ * - Remove following Update of the component replaces the Update,
+ * - Remove following Add of the component drops both (component was never reported).
+ *
+ * @param events Events in the order they were generated
+ * @return Coalesced events
+ */
+model::attribute::EventData::Vector coalesce_events(const model::attribute::EventData::Vector& events);
+
+
 template<typename M>
 void send_add_notifications_for_each() {
     model::attribute::EventData::Vector notifications{};
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <functional>
 #include <mutex>
 #include <type_traits>
 
@@ -35,11 +36,15 @@ namespace generic {
 template <class T, class Mutex>
 class ObjReference {
 public:
+    /*! Function called on the referenced object just before the lock is released */
+    using ReleaseHook = std::function<void(T&)>;
+
     /*! @brief Default constructor */
     ObjReference() = delete;
 
     /*! @brief Copy constructors */
-    ObjReference(ObjReference& other) : m_mutex(other.m_mutex), m_data(other.m_data) {
+    ObjReference(ObjReference& other) :
+        m_mutex(other.m_mutex), m_data(other.m_data), m_release_hook(other.m_release_hook) {
         static_assert(
                 std::is_base_of<std::recursive_mutex, Mutex>::value,
                 "Works only with recursive mutex."
@@ -69,6 +74,21 @@ public:
         m_mutex.lock();
     }
 
+    /*!
+     * @brief Constructor with release hook
+     *
+     * The hook is called (still under the lock) when the reference is released,
+     * which allows the owner to react on in-place modifications of the object.
+     *
+     * @param[in] data Data reference
+     * @param[in] mutex Mutex data reference
+     * @param[in] release_hook Function called on the data before the mutex is unlocked
+     */
+    ObjReference(T& data, Mutex& mutex, ReleaseHook release_hook) :
+        m_mutex{mutex}, m_data{data}, m_release_hook{std::move(release_hook)} {
+        m_mutex.lock();
+    }
+
     /*!
      * @brief Get data pointer
      * @return Data pointer
@@ -101,12 +121,16 @@ public:
 
     /*! @brief Default destructor */
     virtual ~ObjReference() final {
+        if (m_release_hook) {
+            m_release_hook(m_data);
+        }
         m_mutex.unlock();
     }
 
 private:
     Mutex& m_mutex;
     T& m_data;
+    ReleaseHook m_release_hook{};
 };
 
 }
@@ -28,16 +28,24 @@
 #include "agent-framework/exceptions/exception.hpp"
 #include "agent-framework/generic/obj_reference.hpp"
 #include "agent-framework/module/managers/generic_manager_registry.hpp"
+#include "agent-framework/module/managers/utils/health_rollup_index.hpp"
+#include "agent-framework/module/managers/utils/ordered_index.hpp"
+#include "agent-framework/module/managers/utils/read_tracker.hpp"
+#include "agent-framework/module/managers/utils/table_snapshot.hpp"
 #include "agent-framework/module/model/task.hpp"
 #include "agent-framework/module/utils/utils.hpp"
 
 #include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
 #include <mutex>
 #include <algorithm>
 #include <iostream>
 #include <string>
 #include <functional>
 #include <atomic>
+#include <type_traits>
 
 /*! Psme namespace */
 namespace agent_framework {
@@ -55,9 +63,14 @@ public:
     using Reference = generic::ObjReference<T, std::recursive_mutex>;
     using ReferenceVec = std::vector<Reference>;
     using Filter = std::function<bool(const T&)>;
+    using Snapshot = TableSnapshot<T>;
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+    template <typename Projection>
+    using Projected = typename std::decay<decltype(std::declval<Projection&>()(std::declval<const T&>()))>::type;
 
     GenericManager() {
         GenericManagerRegistry::get_instance()->register_table(this);
+        m_snapshot_reads = GenericManagerRegistry::get_instance()->is_snapshot_reads_enabled();
     }
 
     virtual ~GenericManager();
@@ -76,7 +89,7 @@ public:
                   "Object with this UUID already exists. UUID = '" + entry.get_uuid() + "'.");
         }
         entry.touch(++m_current_epoch);
-        m_manager_data.push_back(std::move(entry));
+        append_entry(std::move(entry));
     }
 
     template <typename U>
@@ -88,36 +101,39 @@ public:
 
         auto it = find_entry(entry.get_uuid());
         if (m_manager_data.end() != it) {
-            if (it->get_parent_uuid() != entry.get_parent_uuid()) {
+            if (it->entry->get_parent_uuid() != entry.get_parent_uuid()) {
                 THROW(exceptions::InvalidUuid, "model",
                       std::string("Parent UUID cannot be updated. ") + T::get_collection_name().to_string()
                       + " with uuid " + entry.get_uuid() + "', parent changed from "
-                      + it->get_parent_uuid() + " to " + entry.get_parent_uuid());
+                      + it->entry->get_parent_uuid() + " to " + entry.get_parent_uuid());
             }
-            const auto& db_hash = model::utils::Hash::from_resource(*it);
-            const auto& entry_hash = model::utils::Hash::from_resource(entry);
-
-            if (db_hash.status != entry_hash.status) {
-                res = UpdateStatus::StatusChanged;
-            }
-            else if (db_hash.resource_without_status != entry_hash.resource_without_status) {
-                res = UpdateStatus::Updated;
+            res = get_update_status(*it->entry, entry);
+            replace_entry(it, std::move(entry));
+            if (UpdateStatus::NoUpdate != res) {
+                bump_modification_epoch();
             }
-
-            (*it) = std::move(entry);
         }
         else {
-            m_manager_data.push_back(std::move(entry));
+            append_entry(std::move(entry));
             res = UpdateStatus::Added;
         }
         return res;
     }
 
     T get_entry(const std::string& uuid) const {
-        std::lock_guard<std::recursive_mutex> lock{m_mutex};
-        const auto it = find_entry(uuid);
-        if (m_manager_data.end() != it) {
-            return *it;
+        track_read();
+        if (m_snapshot_reads) {
+            const auto entry = get_snapshot()->find(uuid);
+            if (nullptr != entry) {
+                return *entry;
+            }
+        }
+        else {
+            std::lock_guard<std::recursive_mutex> lock{m_mutex};
+            const auto it = find_entry(uuid);
+            if (m_manager_data.end() != it) {
+                return *it->entry;
+            }
         }
         THROW(exceptions::InvalidUuid, "model",
               std::string(T::get_collection_name().to_string()) + " [UUID = '" + uuid + "'] not found.");
@@ -126,31 +142,58 @@ public:
 
     ManagerDataVec get_entries(Filter filter = [](const T&) { return true; }) {
         ManagerDataVec ret{};
-        std::lock_guard<std::recursive_mutex> lock{m_mutex};
-        for (const auto& entry: m_manager_data) {
+        visit_entries([&ret, &filter](const T& entry) {
             if (filter(entry)) {
                 ret.emplace_back(entry);
             }
-        }
+        });
         return ret;
     }
 
 
     ManagerDataVec get_entries(const std::string& parent_uuid, Filter filter = [](const T&) { return true; }) {
-        std::lock_guard<std::recursive_mutex> lock{m_mutex};
-        return get_entries([&parent_uuid, &filter](const T& entry) {
-            return parent_uuid == entry.get_parent_uuid() && filter(entry);
+        ManagerDataVec ret{};
+        visit_children(parent_uuid, [&ret, &filter](const T& entry) {
+            if (filter(entry)) {
+                ret.emplace_back(entry);
+            }
         });
+        return ret;
     }
 
     Reference get_entry_reference(const std::string& uuid) {
+        track_read();
         std::lock_guard<std::recursive_mutex> lock{m_mutex};
-        auto it = std::find_if(m_manager_data.begin(),
-                            m_manager_data.end(), [&uuid](const T& entry) {
-                                return (entry.get_persistent_uuid() == uuid || entry.get_temporary_uuid() == uuid);
-                            });
+        auto it = find_entry(uuid);
         if (m_manager_data.end() != it) {
-            return Reference(*it, m_mutex);
+            // Published object must not be modified, the table gets a private copy for the reference.
+            // The published one is compared with it on release.
+            if (it->cell->load() == it->entry) {
+                it->entry = std::make_shared<T>(*it->entry);
+            }
+            if (!it->references) {
+                it->references = std::make_shared<bool>();
+            }
+            // Keys of the entry may be changed through the reference, indexes are refreshed on release.
+            return Reference(*it->entry, m_mutex, [this, it, references = it->references](T&) {
+                const auto published = it->cell->load();
+                const bool changed = reindex_entry(it) || published == it->entry ||
+                    model::utils::Difference::None != model::utils::compare_resources(*published, *it->entry);
+                // Attributes which are not compared (e.g. completion notifiers) may have changed too,
+                // so the entry is always published. It is published without a copy unless it may still be
+                // modified through another reference, the next reference makes a private copy again.
+                if (references.use_count() > 2) {
+                    it->cell->store(std::make_shared<const T>(*it->entry));
+                }
+                else {
+                    it->cell->store(it->entry);
+                }
+                if (changed) {
+                    ++m_current_epoch;
+                    update_health_index(*it->entry);
+                    bump_modification_epoch();
+                }
+            });
         }
         THROW(exceptions::InvalidUuid, "model",
               std::string(T::get_collection_name().to_string()) + " [UUID = '" + uuid + "'] not found.");
@@ -160,15 +203,22 @@ public:
     void remove_entry(const std::string& uuid, Hook pre_delete_hook = [](const T&) {}) {
         std::lock_guard<std::recursive_mutex> lock{m_mutex};
         const auto it = find_entry(uuid);
-        if (m_manager_data.cend() != it) {
-            pre_delete_hook(*it);
-            m_manager_data.erase(it);
+        if (m_manager_data.end() != it) {
+            pre_delete_hook(*it->entry);
+            erase_entry(it);
         }
     }
 
     void remove_by_parent(const std::string& uuid) {
         std::lock_guard<std::recursive_mutex> lock{m_mutex};
-        auto n = remove_if([&uuid](const T& entry) { return entry.get_parent_uuid() == uuid; });
+        std::size_t n{0};
+        const auto* children = m_parent_index.find(uuid);
+        while (nullptr != children) {
+            // erasing the last child removes the whole bucket, so it has to be looked up again
+            erase_entry(children->begin()->second);
+            ++n;
+            children = m_parent_index.find(uuid);
+        }
         if (n != 0) {
             log_info("model", "Removed " << n << " " << T::get_collection_name().to_string() << ", parent " << uuid);
         }
@@ -176,15 +226,25 @@ public:
 
     void clear_entries() {
         std::lock_guard<std::recursive_mutex> lock{m_mutex};
+        ++m_current_epoch;
+        ++m_structure_epoch;
+        for (const auto& slot : m_manager_data) {
+            remove_from_health_index(*slot.entry);
+        }
         m_manager_data.clear();
+        m_uuid_index.clear();
+        m_uuid_duplicates.clear();
+        m_id_index.clear();
+        m_parent_index.clear();
+        m_parent_id_index.clear();
+        bump_modification_epoch();
     }
 
     KeysVec get_keys() const {
         KeysVec keys{};
-        std::lock_guard<std::recursive_mutex> lock{m_mutex};
-        for (const auto& entry : m_manager_data) {
+        visit_entries([&keys](const T& entry) {
             keys.emplace_back(entry.get_uuid());
-        }
+        });
         return keys;
     }
 
@@ -196,21 +256,23 @@ public:
      * @return Vector of UUIDs
      * */
     KeysVec get_keys(Filter filter = [](const T&) { return true; }) {
-        std::lock_guard<std::recursive_mutex> lock{m_mutex};
         KeysVec keys{};
-        for (const auto& entry : m_manager_data) {
+        visit_entries([&keys, &filter](const T& entry) {
             if (filter(entry)) {
                 keys.emplace_back(entry.get_uuid());
             }
-        }
+        });
         return keys;
     }
 
     KeysVec get_keys(const std::string& parent_uuid, Filter filter = [](const T&) { return true; }) {
-        std::lock_guard<std::recursive_mutex> lock{m_mutex};
-        return get_keys([&parent_uuid, &filter](const T& entry) {
-            return parent_uuid == entry.get_parent_uuid() && filter(entry);
+        KeysVec keys{};
+        visit_children(parent_uuid, [&keys, &filter](const T& entry) {
+            if (filter(entry)) {
+                keys.emplace_back(entry.get_uuid());
+            }
         });
+        return keys;
     }
 
     /*!
@@ -219,41 +281,191 @@ public:
      * @return vector of ids
      */
     IdsVec get_ids() {
-        std::lock_guard<std::recursive_mutex> lock{m_mutex};
         IdsVec ids{};
-        for (const auto& entry : m_manager_data) {
+        visit_entries([&ids](const T& entry) {
             ids.emplace_back(entry.get_id());
-        }
+        });
         return ids;
     }
 
     IdsVec get_ids(const std::string& parent_uuid) {
-        std::lock_guard<std::recursive_mutex> lock{m_mutex};
         IdsVec ids{};
-        for (const auto& entry : m_manager_data) {
-            if (entry.get_parent_uuid() == parent_uuid) {
-                ids.emplace_back(entry.get_id());
-            }
-        }
+        visit_children(parent_uuid, [&ids](const T& entry) {
+            ids.emplace_back(entry.get_id());
+        });
         return ids;
     }
 
+    /*!
+     * @brief Call visitor for every entry without copying it.
+     *
+     * Visitor is called under the table lock (or on a snapshot if snapshot reads are enabled),
+     * so it should be short and must not modify this table.
+     *
+     * @param visitor Function called with const reference to each entry
+     */
+    template <typename Visitor>
+    void for_each(Visitor visitor) const {
+        visit_entries(visitor);
+    }
+
+    /*!
+     * @brief Call visitor for every child of the parent without copying it
+     * @param parent_uuid UUID of the parent
+     * @param visitor Function called with const reference to each child
+     */
+    template <typename Visitor>
+    void for_each(const std::string& parent_uuid, Visitor visitor) const {
+        visit_children(parent_uuid, visitor);
+    }
+
+    /*!
+     * @brief Count entries matching the predicate
+     * @param predicate Function called with const reference to each entry
+     * @return Number of matching entries
+     */
+    template <typename Predicate>
+    std::size_t count_if(Predicate predicate) const {
+        std::size_t count{0};
+        visit_entries([&count, &predicate](const T& entry) {
+            if (predicate(entry)) {
+                ++count;
+            }
+        });
+        return count;
+    }
+
+    /*!
+     * @brief Count children of the parent matching the predicate
+     * @param parent_uuid UUID of the parent
+     * @param predicate Function called with const reference to each child
+     * @return Number of matching children
+     */
+    template <typename Predicate>
+    std::size_t count_if(const std::string& parent_uuid, Predicate predicate) const {
+        std::size_t count{0};
+        visit_children(parent_uuid, [&count, &predicate](const T& entry) {
+            if (predicate(entry)) {
+                ++count;
+            }
+        });
+        return count;
+    }
+
+    /*!
+     * @brief Collect a single value (e.g. one attribute) of every entry instead of copying whole entries
+     * @param projection Function called with const reference to each entry
+     * @return Vector of projected values in table order
+     */
+    template <typename Projection>
+    std::vector<Projected<Projection>> project(Projection projection) const {
+        std::vector<Projected<Projection>> values{};
+        visit_entries([&values, &projection](const T& entry) {
+            values.emplace_back(projection(entry));
+        });
+        return values;
+    }
+
+    /*!
+     * @brief Collect a single value of every child of the parent instead of copying whole entries
+     * @param parent_uuid UUID of the parent
+     * @param projection Function called with const reference to each child
+     * @return Vector of projected values in table order
+     */
+    template <typename Projection>
+    std::vector<Projected<Projection>> project(const std::string& parent_uuid, Projection projection) const {
+        std::vector<Projected<Projection>> values{};
+        visit_children(parent_uuid, [&values, &projection](const T& entry) {
+            values.emplace_back(projection(entry));
+        });
+        return values;
+    }
+
+    /*!
+     * @brief Fold all entries into a single value
+     * @param init Initial value
+     * @param operation Function called with the current value and const reference to each entry
+     * @return Accumulated value
+     */
+    template <typename Result, typename Operation>
+    Result accumulate(Result init, Operation operation) const {
+        visit_entries([&init, &operation](const T& entry) {
+            init = operation(std::move(init), entry);
+        });
+        return init;
+    }
+
+    /*!
+     * @brief Fold all children of the parent into a single value
+     * @param parent_uuid UUID of the parent
+     * @param init Initial value
+     * @param operation Function called with the current value and const reference to each child
+     * @return Accumulated value
+     */
+    template <typename Result, typename Operation>
+    Result accumulate(const std::string& parent_uuid, Result init, Operation operation) const {
+        visit_children(parent_uuid, [&init, &operation](const T& entry) {
+            init = operation(std::move(init), entry);
+        });
+        return init;
+    }
+
     bool entry_exists(const std::string& uuid) override {
-        return m_manager_data.cend() != find_entry(uuid);
+        track_read();
+        if (m_snapshot_reads) {
+            return nullptr != get_snapshot()->find(uuid);
+        }
+        std::lock_guard<std::recursive_mutex> lock{m_mutex};
+        return m_manager_data.end() != find_entry(uuid);
     }
 
     std::size_t get_entry_count() const {
+        track_read();
+        if (m_snapshot_reads) {
+            return get_snapshot()->size();
+        }
         std::lock_guard<std::recursive_mutex> lock{m_mutex};
         return m_manager_data.size();
     }
 
-    std::size_t get_entry_count(const std::string& parent_uuid) {
-        return static_cast<unsigned long>(std::count_if(
-                             m_manager_data.cbegin(),
-                             m_manager_data.cend(),
-                             [&parent_uuid](const T& entry) {
-                                return entry.get_parent_uuid() == parent_uuid;
-                             }));
+    std::size_t get_entry_count(const std::string& parent_uuid) const {
+        track_read();
+        if (m_snapshot_reads) {
+            return get_snapshot()->count_children(parent_uuid);
+        }
+        std::lock_guard<std::recursive_mutex> lock{m_mutex};
+        return m_parent_index.count(parent_uuid);
+    }
+
+    /*!
+     * @brief Get immutable snapshot of the table.
+     *
+     * Snapshot is rebuilt only if entries were added or removed or their keys were changed since
+     * the last snapshot was taken, otherwise the same snapshot is shared by all readers without
+     * taking the table lock. Updates of the entries are published in the snapshot in place.
+     * Writers are never blocked by readers holding snapshots.
+     *
+     * @return Snapshot of the table at the current structure epoch
+     */
+    SnapshotPtr get_snapshot() const {
+        auto snapshot = std::atomic_load(&m_snapshot);
+        if (!snapshot || snapshot->get_version() != m_structure_epoch) {
+            std::lock_guard<std::recursive_mutex> lock{m_mutex};
+            snapshot = std::atomic_load(&m_snapshot);
+            if (!snapshot || snapshot->get_version() != m_structure_epoch) {
+                snapshot = make_snapshot();
+                std::atomic_store(&m_snapshot, snapshot);
+            }
+        }
+        return snapshot;
+    }
+
+    /*!
+     * @brief Enable or disable serving read requests (get_entry, get_entries, get_keys, etc.) from snapshots
+     * @param enabled If true, readers do not take the table lock
+     */
+    void set_snapshot_reads(bool enabled) override {
+        m_snapshot_reads = enabled;
     }
 
     /*!
@@ -269,6 +481,7 @@ public:
      * @return found object's uuid
      */
     const std::string& rest_id_to_uuid(std::uint64_t id, const std::string& parent_uuid = {}) const {
+        track_read();
         if (parent_uuid.empty()) {
             return find_uuid_by_id(id);
         }
@@ -285,6 +498,19 @@ public:
         return m_current_epoch;
     }
 
+    /*!
+     * @brief Get epoch of the last modification of the table.
+     *
+     * Unlike the current epoch, it is not changed when an entry is updated with the same content
+     * (e.g. by periodic polling of the agents). Reads of the table are reported to the ReadTracker
+     * of the reading thread together with this epoch.
+     *
+     * @return modification epoch number
+     */
+    std::uint64_t get_modification_epoch() const {
+        return m_modification_epoch;
+    }
+
     /*!
      * @brief rest_uuid_to_id - find REST url id by object's uuid
      *
@@ -293,6 +519,7 @@ public:
      * @return found object's id
      */
     uint64_t uuid_to_rest_id(const std::string& uuid) {
+        track_read();
         return find_id_by_uuid(uuid);
     }
 
@@ -310,28 +537,326 @@ public:
     }
 
 protected:
+
+    /*! @brief Keys under which an entry is indexed */
+    struct IndexKeys {
+        std::string temporary_uuid{};
+        std::string persistent_uuid{};
+        std::string parent_uuid{};
+        std::uint64_t id{};
+
+        bool operator==(const IndexKeys& other) const {
+            return id == other.id && temporary_uuid == other.temporary_uuid &&
+                   persistent_uuid == other.persistent_uuid && parent_uuid == other.parent_uuid;
+        }
+    };
+
+    /*!
+     * @brief Entry stored in the manager.
+     *
+     * Keys used for indexing are remembered with the entry, so the entry can be
+     * removed from the indexes even if it was modified in place via a Reference.
+     * Object published in the cell is shared with table snapshots and is never modified,
+     * the entry may be its private copy while it is changed via a Reference.
+     */
+    struct Slot {
+        std::shared_ptr<T> entry;
+        typename Snapshot::CellPtr cell;
+        std::uint64_t position;
+        IndexKeys keys;
+        /* Shared with release hooks of the References, so the alive ones can be counted */
+        std::shared_ptr<const bool> references{};
+    };
+
+    using ManagerDataList = std::list<Slot>;
+    using SlotIterator = typename ManagerDataList::iterator;
+
+    /*! @brief Key of the (parent UUID, REST id) index */
+    struct ParentIdKey {
+        std::string parent_uuid{};
+        std::uint64_t id{};
+
+        bool operator==(const ParentIdKey& other) const {
+            return id == other.id && parent_uuid == other.parent_uuid;
+        }
+    };
+
+    struct ParentIdKeyHash {
+        std::size_t operator()(const ParentIdKey& key) const {
+            return std::hash<std::string>{}(key.parent_uuid) ^ (std::hash<std::uint64_t>{}(key.id) << 1);
+        }
+    };
+
     mutable std::recursive_mutex m_mutex{};
-    ManagerDataVec m_manager_data{};
+    /* List keeps iterators stored in the indexes valid and preserves insertion order */
+    ManagerDataList m_manager_data{};
     std::atomic<std::uint64_t> m_current_epoch {1};
+    ReadTracker::Epoch m_modification_epoch {1};
+    /* Changed when entries are added or removed or their keys are changed, snapshots are rebuilt then */
+    std::atomic<std::uint64_t> m_structure_epoch {1};
+
+    std::unordered_map<std::string, SlotIterator> m_uuid_index{};
+    /* Number of entries with a UUID that is already indexed for another entry */
+    std::unordered_map<std::string, std::size_t> m_uuid_duplicates{};
+    OrderedIndex<std::uint64_t, SlotIterator> m_id_index{};
+    OrderedIndex<std::string, SlotIterator> m_parent_index{};
+    OrderedIndex<ParentIdKey, SlotIterator, ParentIdKeyHash> m_parent_id_index{};
+    std::uint64_t m_next_position{0};
+
+    mutable SnapshotPtr m_snapshot{};
+    std::atomic<bool> m_snapshot_reads{false};
 
 private:
 
-    typename ManagerDataVec::const_iterator find_entry(const std::string& uuid) const {
-        auto it = std::find_if(m_manager_data.cbegin(),
-                            m_manager_data.cend(),
-                            [&uuid](const T& entry) {
-                                  return ((entry.has_persistent_uuid() && entry.get_persistent_uuid() == uuid) || entry.get_temporary_uuid() == uuid);
-                            });
-        return it;
+    /*!
+     * @brief Check what was changed in the entry, compares attributes directly instead of hashing them
+     * @param stored Entry stored in the table
+     * @param entry New version of the entry
+     * @return NoUpdate, StatusChanged or Updated
+     */
+    static UpdateStatus get_update_status(const T& stored, const T& entry) {
+        switch (model::utils::compare_resources(stored, entry)) {
+            case model::utils::Difference::Status:
+                return UpdateStatus::StatusChanged;
+            case model::utils::Difference::Attributes:
+                return UpdateStatus::Updated;
+            case model::utils::Difference::None:
+            default:
+                return UpdateStatus::NoUpdate;
+        }
     }
 
-    typename ManagerDataVec::iterator find_entry(const std::string& uuid) {
-        auto it = std::find_if(m_manager_data.begin(),
-                               m_manager_data.end(),
-                               [&uuid](const T& entry) {
-                                   return ((entry.has_persistent_uuid() && entry.get_persistent_uuid() == uuid) || entry.get_temporary_uuid() == uuid);
-                               });
-        return it;
+    static IndexKeys make_index_keys(const T& entry) {
+        IndexKeys keys{};
+        keys.temporary_uuid = entry.get_temporary_uuid();
+        if (entry.has_persistent_uuid()) {
+            keys.persistent_uuid = entry.get_persistent_uuid();
+        }
+        keys.parent_uuid = entry.get_parent_uuid();
+        keys.id = entry.get_id();
+        return keys;
+    }
+
+    void index_entry(SlotIterator it) {
+        const auto& keys = it->keys;
+        index_uuid(keys.temporary_uuid, it);
+        if (!keys.persistent_uuid.empty()) {
+            index_uuid(keys.persistent_uuid, it);
+        }
+        m_id_index.insert(keys.id, it->position, it);
+        m_parent_index.insert(keys.parent_uuid, it->position, it);
+        m_parent_id_index.insert(ParentIdKey{keys.parent_uuid, keys.id}, it->position, it);
+    }
+
+    void unindex_entry(SlotIterator it) {
+        const auto& keys = it->keys;
+        unindex_uuid(keys.temporary_uuid, it);
+        if (!keys.persistent_uuid.empty()) {
+            unindex_uuid(keys.persistent_uuid, it);
+        }
+        m_id_index.erase(keys.id, it->position);
+        m_parent_index.erase(keys.parent_uuid, it->position);
+        m_parent_id_index.erase(ParentIdKey{keys.parent_uuid, keys.id}, it->position);
+    }
+
+    /*!
+     * @brief Add UUID of the entry to the index, the first entry in the table with the UUID wins
+     * @param uuid UUID to be indexed
+     * @param it Iterator to the entry
+     */
+    void index_uuid(const std::string& uuid, SlotIterator it) {
+        auto result = m_uuid_index.emplace(uuid, it);
+        if (!result.second && result.first->second != it) {
+            ++m_uuid_duplicates[uuid];
+            if (result.first->second->position > it->position) {
+                result.first->second = it;
+            }
+        }
+    }
+
+    /*!
+     * @brief Remove UUID of the entry from the index, next entry with the same UUID (if any) takes its place
+     * @param uuid UUID to be removed
+     * @param it Iterator to the entry
+     */
+    void unindex_uuid(const std::string& uuid, SlotIterator it) {
+        auto index_it = m_uuid_index.find(uuid);
+        if (m_uuid_index.end() == index_it) {
+            return;
+        }
+        auto duplicate_it = m_uuid_duplicates.find(uuid);
+        if (index_it->second == it) {
+            if (m_uuid_duplicates.end() == duplicate_it) {
+                m_uuid_index.erase(index_it);
+                return;
+            }
+            // duplicated UUIDs are not expected, so the table is scanned only in that case
+            for (auto slot = m_manager_data.begin(); slot != m_manager_data.end(); ++slot) {
+                if (slot != it && (slot->keys.temporary_uuid == uuid || slot->keys.persistent_uuid == uuid)) {
+                    index_it->second = slot;
+                    break;
+                }
+            }
+        }
+        else if (m_uuid_duplicates.end() == duplicate_it) {
+            return;
+        }
+        if (0 == --duplicate_it->second) {
+            m_uuid_duplicates.erase(duplicate_it);
+        }
+    }
+
+    /*!
+     * @brief Refresh indexes of the entry if any of its keys has changed
+     * @param it Iterator to the entry
+     * @return true if the keys were changed
+     */
+    bool reindex_entry(SlotIterator it) {
+        auto keys = make_index_keys(*it->entry);
+        if (keys == it->keys) {
+            return false;
+        }
+        ++m_structure_epoch;
+        unindex_entry(it);
+        it->keys = std::move(keys);
+        index_entry(it);
+        return true;
+    }
+
+    void track_read() const {
+        ReadTracker::record(m_modification_epoch);
+    }
+
+    /*!
+     * @brief Report modification of the table, must be called after the change is published.
+     *
+     * Snapshot readers record the epoch before reading the entries without the lock, so a reader
+     * which recorded the new epoch is guaranteed to read the published change.
+     */
+    void bump_modification_epoch() {
+        m_modification_epoch.fetch_add(1, std::memory_order_release);
+    }
+
+    /* Resources report their health to the health rollup index */
+    template <typename U = T>
+    typename std::enable_if<std::is_base_of<model::Resource, U>::value>::type
+    update_health_index(const U& entry) const {
+        auto index = HealthRollupIndex::get_instance();
+        if (index->is_enabled()) {
+            index->update(entry.get_uuid(), entry.get_parent_uuid(), U::get_component(),
+                          entry.get_status().get_health());
+        }
+    }
+
+    template <typename U = T>
+    typename std::enable_if<!std::is_base_of<model::Resource, U>::value>::type
+    update_health_index(const U&) const { }
+
+    template <typename U = T>
+    typename std::enable_if<std::is_base_of<model::Resource, U>::value>::type
+    remove_from_health_index(const U& entry) const {
+        auto index = HealthRollupIndex::get_instance();
+        if (index->is_enabled()) {
+            index->remove(entry.get_uuid());
+        }
+    }
+
+    template <typename U = T>
+    typename std::enable_if<!std::is_base_of<model::Resource, U>::value>::type
+    remove_from_health_index(const U&) const { }
+
+    void append_entry(T&& entry) {
+        ++m_structure_epoch;
+        auto keys = make_index_keys(entry);
+        auto stored = std::make_shared<T>(std::move(entry));
+        auto cell = std::make_shared<typename Snapshot::Cell>(stored);
+        auto it = m_manager_data.insert(m_manager_data.end(),
+            Slot{std::move(stored), std::move(cell), m_next_position++, std::move(keys)});
+        index_entry(it);
+        update_health_index(*it->entry);
+        bump_modification_epoch();
+    }
+
+    void replace_entry(SlotIterator it, T&& entry) {
+        // never assign to the stored object, it may be shared with a snapshot
+        it->entry = std::make_shared<T>(std::move(entry));
+        it->cell->store(it->entry);
+        reindex_entry(it);
+        update_health_index(*it->entry);
+    }
+
+    void erase_entry(SlotIterator it) {
+        ++m_current_epoch;
+        ++m_structure_epoch;
+        unindex_entry(it);
+        remove_from_health_index(*it->entry);
+        m_manager_data.erase(it);
+        bump_modification_epoch();
+    }
+
+    SlotIterator find_entry(const std::string& uuid) const {
+        const auto it = m_uuid_index.find(uuid);
+        if (m_uuid_index.cend() != it) {
+            return it->second;
+        }
+        // const_cast is used only to get the end iterator in the same type as ones stored in the index
+        return const_cast<ManagerDataList&>(m_manager_data).end();
+    }
+
+    template <typename Visitor>
+    void for_each_child(const std::string& parent_uuid, Visitor visitor) const {
+        const auto* children = m_parent_index.find(parent_uuid);
+        if (nullptr != children) {
+            for (const auto& child : *children) {
+                const T& entry = *child.second->entry;
+                visitor(entry);
+            }
+        }
+    }
+
+    /*!
+     * @brief Call visitor for every entry, on a snapshot if snapshot reads are enabled, under the lock otherwise
+     * @param visitor Function called with const reference to each entry
+     */
+    template <typename Visitor>
+    void visit_entries(Visitor visitor) const {
+        track_read();
+        if (m_snapshot_reads) {
+            get_snapshot()->for_each(visitor);
+        }
+        else {
+            std::lock_guard<std::recursive_mutex> lock{m_mutex};
+            for (const auto& slot : m_manager_data) {
+                const T& entry = *slot.entry;
+                visitor(entry);
+            }
+        }
+    }
+
+    /*!
+     * @brief Call visitor for every child of the parent, on a snapshot or under the lock
+     * @param parent_uuid UUID of the parent
+     * @param visitor Function called with const reference to each child
+     */
+    template <typename Visitor>
+    void visit_children(const std::string& parent_uuid, Visitor visitor) const {
+        track_read();
+        if (m_snapshot_reads) {
+            get_snapshot()->for_each_child(parent_uuid, visitor);
+        }
+        else {
+            std::lock_guard<std::recursive_mutex> lock{m_mutex};
+            for_each_child(parent_uuid, visitor);
+        }
+    }
+
+    SnapshotPtr make_snapshot() const {
+        typename Snapshot::Entries entries{};
+        entries.reserve(m_manager_data.size());
+        for (const auto& slot : m_manager_data) {
+            entries.emplace_back(slot.cell);
+        }
+        return std::make_shared<const Snapshot>(m_structure_epoch, std::move(entries));
     }
 
     /*!
@@ -343,10 +868,9 @@ private:
      */
     const std::string& find_uuid_by_id(std::uint64_t id) const {
         std::lock_guard<std::recursive_mutex> lock{m_mutex};
-        for (const auto& entry : m_manager_data) {
-            if (entry.get_id() == id) {
-                return entry.get_uuid();
-            }
+        const auto* entries = m_id_index.find(id);
+        if (nullptr != entries) {
+            return entries->begin()->second->entry->get_uuid();
         }
 
         const auto& message = std::string("Could not find ") +
@@ -366,10 +890,9 @@ private:
      */
     const std::string& find_uuid_by_id_and_parent(std::uint64_t id, const std::string& parent_uuid) const {
         std::lock_guard<std::recursive_mutex> lock{m_mutex};
-        for (const auto& entry : m_manager_data) {
-            if (entry.get_parent_uuid() == parent_uuid && entry.get_id() == id) {
-                return entry.get_uuid();
-            }
+        const auto* entries = m_parent_id_index.find(ParentIdKey{parent_uuid, id});
+        if (nullptr != entries) {
+            return entries->begin()->second->entry->get_uuid();
         }
 
         const auto& message = std::string("Could not find ") +
@@ -385,10 +908,10 @@ private:
      * @return object's REST id
      */
     uint64_t find_id_by_uuid(const std::string& uuid) {
-        for (const auto& entry : m_manager_data) {
-            if (entry.get_persistent_uuid() == uuid || entry.get_temporary_uuid() == uuid) {
-                return entry.get_id();
-            }
+        std::lock_guard<std::recursive_mutex> lock{m_mutex};
+        const auto it = find_entry(uuid);
+        if (m_manager_data.end() != it) {
+            return it->entry->get_id();
         }
 
         THROW(exceptions::InvalidUuid, "model",
@@ -401,12 +924,14 @@ private:
      * @return number of removed entities
      * */
     template<typename Predicate>
-    typename ManagerDataVec::difference_type remove_if(Predicate predicate){
-        auto last = m_manager_data.end();
-        auto first = std::remove_if(m_manager_data.begin(), last, predicate);
-        auto count_removed = std::distance(first, last);
-        if (count_removed) {
-            m_manager_data.erase(first, last);
+    std::size_t remove_if(Predicate predicate) {
+        std::size_t count_removed{0};
+        for (auto it = m_manager_data.begin(); it != m_manager_data.end();) {
+            auto current = it++;
+            if (predicate(*current->entry)) {
+                erase_entry(current);
+                ++count_removed;
+            }
         }
         return count_removed;
     }
@@ -426,28 +951,23 @@ GenericManager<model::Task>::UpdateStatus GenericManager<model::Task>::add_or_up
 
     auto it = find_entry(entry.get_uuid());
     if (m_manager_data.end() != it) {
-        if (it->get_parent_uuid() != entry.get_parent_uuid()) {
+        if (it->entry->get_parent_uuid() != entry.get_parent_uuid()) {
             THROW(exceptions::InvalidUuid, "model",
                   "Parent UUID cannot be updated. Entry = '" + entry.get_uuid() + "', parent changed from "
-                  + it->get_parent_uuid() + " to " + entry.get_parent_uuid());
-        }
-        const auto& db_hash = model::utils::Hash::from_resource(*it);
-        const auto& entry_hash = model::utils::Hash::from_resource(entry);
-
-        if (db_hash.status != entry_hash.status) {
-            res = UpdateStatus::StatusChanged;
+                  + it->entry->get_parent_uuid() + " to " + entry.get_parent_uuid());
         }
-        else if (db_hash.resource_without_status != entry_hash.resource_without_status) {
-            res = UpdateStatus::Updated;
-        }
-
-        (*it) = std::forward<U>(entry);
-        if (UpdateStatus::NoUpdate != res && entry.get_end_time().has_value()) {
-            it->call_completion_notifiers();
+        res = get_update_status(*it->entry, entry);
+        const bool has_ended = entry.get_end_time().has_value();
+        replace_entry(it, std::move(entry));
+        if (UpdateStatus::NoUpdate != res) {
+            bump_modification_epoch();
+            if (has_ended) {
+                it->entry->call_completion_notifiers();
+            }
         }
     }
     else {
-        m_manager_data.emplace_back(std::move(entry));
+        append_entry(std::move(entry));
         res = UpdateStatus::Added;
     }
     return res;
@@ -27,6 +27,7 @@
 #include "agent-framework/generic/singleton.hpp"
 #include "agent-framework/module/enum/common.hpp"
 #include "table_interface.hpp"
+#include <atomic>
 #include <list>
 
 
@@ -41,8 +42,24 @@ public:
 
     using TableClientFunc = std::function<bool(TableInterface*)>;
     void for_each_table(TableClientFunc func);
+
+    /*!
+     * @brief Enable or disable snapshot reads in all tables, including the ones created later
+     * @param enabled If true, tables serve reads from immutable snapshots
+     */
+    void set_snapshot_reads(bool enabled);
+
+    /*!
+     * @brief Check if snapshot reads are enabled for the tables
+     * @return true if tables should serve reads from snapshots
+     */
+    bool is_snapshot_reads_enabled() const {
+        return snapshot_reads;
+    }
+
 protected:
     std::list<TableInterface*> tables {};
+    std::atomic<bool> snapshot_reads{false};
 };
 
 template <typename T>
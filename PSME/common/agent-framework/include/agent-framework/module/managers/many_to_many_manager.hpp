@@ -71,7 +71,9 @@ public:
      */
     void add_entry(const Uuid& parent, const Uuid& child, const std::string& gami_id = std::string{}) {
         std::lock_guard<std::mutex> lock{m_mutex};
-        m_manager_data.insert(IdPair(parent, child, gami_id));
+        if (m_manager_data.insert(IdPair(parent, child, gami_id)).second) {
+            ++m_modification_epoch;
+        }
     }
 
 
@@ -89,6 +91,7 @@ public:
                                });
         if (it != m_manager_data.end()) {
             m_manager_data.erase(it);
+            ++m_modification_epoch;
         }
     }
 
@@ -132,6 +135,7 @@ public:
      * @return True if UUID pair entry is found in the manager
      */
     bool entry_exists(const Uuid& parent, const Uuid& child) const {
+        ReadTracker::record(m_modification_epoch);
         std::lock_guard<std::mutex> lock{m_mutex};
         return std::any_of(m_manager_data.begin(), m_manager_data.end(),
                            [&parent, &child](const IdPair& entry) {
@@ -148,6 +152,7 @@ public:
      * @return True if UUID parent is present in the manager
      */
     bool parent_exists(const Uuid& parent) const {
+        ReadTracker::record(m_modification_epoch);
         std::lock_guard<std::mutex> lock{m_mutex};
         for (const auto& entry : m_manager_data) {
             if (parent == std::get<0>(entry)) {
@@ -166,6 +171,7 @@ public:
      * @return True if UUID child is present in the manager
      */
     bool child_exists(const Uuid& child) const {
+        ReadTracker::record(m_modification_epoch);
         std::lock_guard<std::mutex> lock{m_mutex};
         for (const auto& entry : m_manager_data) {
             if (child == std::get<1>(entry)) {
@@ -182,6 +188,7 @@ public:
     void clear_entries() {
         std::lock_guard<std::mutex> lock{m_mutex};
         m_manager_data.clear();
+        ++m_modification_epoch;
     }
 
 
@@ -193,6 +200,7 @@ public:
      * @return Vector of all children UUIDs for the provided parent uuid
      */
     std::vector<Uuid> get_children(const Uuid& parent) const {
+        ReadTracker::record(m_modification_epoch);
         std::lock_guard<std::mutex> lock{m_mutex};
         std::vector<Uuid> children{};
         for (const auto& entry : m_manager_data) {
@@ -212,6 +220,7 @@ public:
      * @return Vector of all parents UUIDs for the provided child uuid
      */
     std::vector<Uuid> get_parents(const Uuid& child) const {
+        ReadTracker::record(m_modification_epoch);
         std::lock_guard<std::mutex> lock{m_mutex};
         std::vector<Uuid> parents{};
         for (const auto& entry : m_manager_data) {
@@ -229,6 +238,7 @@ public:
      * @return Vector of unique parents UUIDs
      */
     std::vector<Uuid> get_all_unique_parents() const {
+        ReadTracker::record(m_modification_epoch);
         std::lock_guard<std::mutex> lock{m_mutex};
         std::set<Uuid> parents{};
         for (const auto& entry : m_manager_data) {
@@ -308,6 +318,7 @@ protected:
                 it = m_manager_data.erase(it);
                 std::get<P>(updated_entry) = new_id;
                 m_manager_data.insert(updated_entry);
+                ++m_modification_epoch;
             }
             else {
                 it++;
@@ -320,6 +331,7 @@ protected:
         for (auto it = m_manager_data.begin(); it != m_manager_data.end();) {
             if (predicate(std::get<0>(*it), std::get<1>(*it), std::get<2>(*it))) {
                 it = m_manager_data.erase(it);
+                ++m_modification_epoch;
             }
             else {
                 ++it;
@@ -333,6 +345,8 @@ protected:
 
     mutable std::mutex m_mutex{};
     IdPairCollection m_manager_data{};
+    /*! @brief Changed on every modification, reported to the ReadTracker of the reading thread */
+    ReadTracker::Epoch m_modification_epoch{1};
 };
 
 }
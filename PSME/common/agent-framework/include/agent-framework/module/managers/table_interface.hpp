@@ -56,6 +56,12 @@ public:
      * @return true if entry with given uuid exists, false otherwise
      */
     virtual bool entry_exists(const std::string& uuid) = 0;
+
+    /*!
+     * @brief Enables or disables serving reads from immutable table snapshots
+     * @param enabled If true, readers do not take the table lock
+     */
+    virtual void set_snapshot_reads(bool enabled) = 0;
 };
 
 
@@ -0,0 +1,141 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file health_rollup_index.hpp
+ * @brief Incrementally maintained health rollup of the resource tree
+ * */
+
+#pragma once
+
+#include "agent-framework/generic/singleton.hpp"
+#include "agent-framework/module/enum/common.hpp"
+#include "agent-framework/module/managers/utils/read_tracker.hpp"
+#include "agent-framework/module/utils/optional_field.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace agent_framework {
+namespace module {
+
+/*!
+ * @brief Worst health of the subtree of each resource, per component type of the descendants.
+ *
+ * Resources of all tables form a tree by their parent UUIDs. For each node the index keeps the number
+ * of descendants with each health value, in total and per component. Tables report added, updated and
+ * removed entries, so counters of all ancestors are adjusted in O(depth) and the rollup of any node
+ * is read in O(1), without traversing its subtree.
+ *
+ * Entries may be reported in any order: a child added before its parent is kept under a placeholder
+ * node which is completed when the parent is added.
+ *
+ * The index is disabled by default and has to be enabled before the tables are filled. Reads of the index
+ * are recorded by the ReadTracker as reads of a single table modified whenever any health changes.
+ */
+class HealthRollupIndex final : public generic::Singleton<HealthRollupIndex> {
+public:
+    using Health = OptionalField<model::enums::Health>;
+
+    virtual ~HealthRollupIndex();
+
+    /*!
+     * @brief Enable or disable the index, the index is cleared
+     * @param enabled If true, tables report their entries to the index
+     */
+    void set_enabled(bool enabled);
+
+    /*!
+     * @brief Check if the index is enabled
+     * @return true if tables report their entries
+     */
+    bool is_enabled() const {
+        return m_enabled;
+    }
+
+    /*!
+     * @brief Add or update a resource
+     * @param uuid UUID of the resource
+     * @param parent_uuid UUID of the parent resource
+     * @param component Component of the resource
+     * @param health Health of the resource
+     */
+    void update(const std::string& uuid, const std::string& parent_uuid,
+                model::enums::Component component, const Health& health);
+
+    /*!
+     * @brief Remove a resource, its descendants are kept
+     * @param uuid UUID of the resource
+     */
+    void remove(const std::string& uuid);
+
+    /*!
+     * @brief Get rollup health of a resource
+     *
+     * Rollup health is unknown if the health of the resource is unknown. Otherwise it is the worst
+     * of the health of the resource and known health values of its descendants.
+     *
+     * @param uuid UUID of the resource
+     * @param filter If not None, only the resource and descendants of this component are taken into account
+     * @return Rollup health, empty if it is unknown
+     */
+    Health get(const std::string& uuid, model::enums::Component filter = model::enums::Component::None) const;
+
+private:
+    friend class generic::Singleton<HealthRollupIndex>;
+
+    /*! @brief Number of resources with each health value, indexed by the health value */
+    using Counters = std::array<std::int64_t, 3>;
+
+    /*! @brief Counters per component */
+    using ComponentCounters = std::map<std::uint32_t, Counters>;
+
+    struct Node {
+        bool present{false};
+        std::string parent_uuid{};
+        std::uint32_t component{};
+        Health health{};
+        std::size_t children{};
+        Counters descendants{};
+        ComponentCounters component_descendants{};
+    };
+
+    HealthRollupIndex() = default;
+
+    void add_contribution(const std::string& uuid, const Node& node, std::int64_t sign);
+
+    void attach(const std::string& uuid, Node& node);
+
+    void detach(const std::string& uuid, Node& node);
+
+    void release_placeholder(const std::string& uuid);
+
+    std::atomic<bool> m_enabled{false};
+    ReadTracker::Epoch m_modification_epoch{1};
+    mutable std::mutex m_mutex{};
+    std::unordered_map<std::string, Node> m_nodes{};
+};
+
+}
+}
@@ -0,0 +1,108 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file ordered_index.hpp
+ * @brief Hash index with many values per key, kept in insertion order
+ * */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+namespace agent_framework {
+namespace module {
+
+/*!
+ * @brief Hash index which maps a key to all values stored under it.
+ *
+ * Values stored under one key are ordered by the position given on insertion,
+ * so the first value is always the one inserted first to the owning container.
+ * This allows managers to keep "first matching entry" lookup semantics of
+ * a linear scan while doing the lookup in constant time.
+ *
+ * @tparam Key Type of the index key
+ * @tparam Value Type of the stored values (usually container iterators)
+ * @tparam Hash Hash function for the key
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class OrderedIndex {
+public:
+    using Position = std::uint64_t;
+    using Bucket = std::map<Position, Value>;
+
+    /*!
+     * @brief Add value to the index
+     * @param key Key to store the value under
+     * @param position Position of the value in the owning container
+     * @param value Value to be stored
+     */
+    void insert(const Key& key, Position position, const Value& value) {
+        m_buckets[key].emplace(position, value);
+    }
+
+    /*!
+     * @brief Remove value from the index
+     * @param key Key the value is stored under
+     * @param position Position of the value in the owning container
+     */
+    void erase(const Key& key, Position position) {
+        auto it = m_buckets.find(key);
+        if (m_buckets.end() != it) {
+            it->second.erase(position);
+            if (it->second.empty()) {
+                m_buckets.erase(it);
+            }
+        }
+    }
+
+    /*!
+     * @brief Find all values stored under the key
+     * @param key Key to look for
+     * @return Pointer to the ordered values or nullptr if there are none
+     */
+    const Bucket* find(const Key& key) const {
+        const auto it = m_buckets.find(key);
+        return (m_buckets.cend() != it) ? &it->second : nullptr;
+    }
+
+    /*!
+     * @brief Count values stored under the key
+     * @param key Key to look for
+     * @return Number of values
+     */
+    std::size_t count(const Key& key) const {
+        const auto* bucket = find(key);
+        return (nullptr != bucket) ? bucket->size() : 0;
+    }
+
+    /*! @brief Remove all values from the index */
+    void clear() {
+        m_buckets.clear();
+    }
+
+private:
+    std::unordered_map<Key, Bucket, Hash> m_buckets{};
+};
+
+}
+}
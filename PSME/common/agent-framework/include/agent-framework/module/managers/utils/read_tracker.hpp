@@ -0,0 +1,105 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file read_tracker.hpp
+ * @brief Tracking of the tables read by a thread
+ * */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace agent_framework {
+namespace module {
+
+/*!
+ * @brief Records modification epochs of the tables read by the current thread while the tracker is alive.
+ *
+ * Tables report their reads with ReadTracker::record(). A result computed from the model while the
+ * tracker was alive is up to date as long as none of the recorded modification epochs has changed,
+ * so it can be validated without computing it again.
+ *
+ * Trackers may be nested, dependencies recorded by the inner tracker are dependencies of the outer one too.
+ */
+class ReadTracker final {
+public:
+    using Epoch = std::atomic<std::uint64_t>;
+    /*! @brief Modification epoch of a table and its value at the time of the first read */
+    using Dependency = std::pair<const Epoch*, std::uint64_t>;
+    using Dependencies = std::vector<Dependency>;
+
+    /*! @brief Start tracking reads of the current thread */
+    ReadTracker();
+
+    /*! @brief Stop tracking, dependencies are passed to the enclosing tracker (if any) */
+    ~ReadTracker();
+
+    ReadTracker(const ReadTracker&) = delete;
+    ReadTracker& operator=(const ReadTracker&) = delete;
+
+    /*!
+     * @brief Record read of a table, does nothing if the current thread is not tracked
+     * @param epoch Modification epoch of the table
+     */
+    static void record(const Epoch& epoch);
+
+    /*!
+     * @brief Record that the result depends on data which is not stored in tables (e.g. is fetched from an agent)
+     *
+     * Such results cannot be validated with the dependencies.
+     */
+    static void record_untracked();
+
+    /*!
+     * @brief Check if all reads were recorded
+     * @return false if the result depends on data which is not stored in tables
+     */
+    bool is_tracked() const {
+        return m_tracked;
+    }
+
+    /*!
+     * @brief Get recorded dependencies in order of the first reads
+     * @return Recorded dependencies
+     */
+    const Dependencies& get_dependencies() const {
+        return m_dependencies;
+    }
+
+    /*!
+     * @brief Check if none of the tables was modified since the dependencies were recorded
+     * @param dependencies Recorded dependencies
+     * @return true if all tables still have the recorded modification epochs
+     */
+    static bool is_up_to_date(const Dependencies& dependencies);
+
+private:
+    void add(const Dependency& dependency);
+
+    ReadTracker* m_enclosing{nullptr};
+    Dependencies m_dependencies{};
+    bool m_tracked{true};
+};
+
+}
+}
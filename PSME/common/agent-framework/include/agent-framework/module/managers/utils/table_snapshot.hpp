@@ -0,0 +1,181 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file table_snapshot.hpp
+ * @brief Immutable, versioned view of the GenericManager table
+ * */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace agent_framework {
+namespace module {
+
+/*!
+ * @brief Immutable view of a GenericManager table.
+ *
+ * Snapshot captures the structure of the table (entries, their UUIDs and parents) at its version.
+ * Entries are kept in cells shared by the table and all its snapshots. The table never modifies
+ * a published object, it publishes a new one in the cell instead, so updates of the entries are
+ * visible in the snapshot without rebuilding it. Only adding or removing entries or changing their
+ * keys requires a new snapshot. Therefore snapshot may be read by any number of threads without
+ * any locking.
+ *
+ * @tparam T Type of the model object
+ */
+template <typename T>
+class TableSnapshot {
+public:
+    using EntryPtr = std::shared_ptr<const T>;
+
+    /*! @brief Latest published version of the table entry */
+    class Cell {
+    public:
+        explicit Cell(EntryPtr entry) : m_entry{std::move(entry)} { }
+
+        /*!
+         * @brief Get published entry
+         * @return Entry which is never modified
+         */
+        EntryPtr load() const {
+            return std::atomic_load(&m_entry);
+        }
+
+        /*!
+         * @brief Publish new version of the entry
+         * @param entry Entry which must not be modified after it is published
+         */
+        void store(EntryPtr entry) {
+            std::atomic_store(&m_entry, std::move(entry));
+        }
+
+    private:
+        EntryPtr m_entry;
+    };
+
+    using CellPtr = std::shared_ptr<Cell>;
+    using Entries = std::vector<CellPtr>;
+
+    /*!
+     * @brief Create snapshot and build its lookup indexes
+     * @param version Version (epoch) of the table structure the snapshot was taken at
+     * @param entries Cells of all table entries in table order
+     */
+    TableSnapshot(std::uint64_t version, Entries&& entries) :
+        m_version{version}, m_entries{std::move(entries)} {
+
+        m_uuid_index.reserve(m_entries.size());
+        for (std::size_t i = 0; i < m_entries.size(); ++i) {
+            const auto entry = m_entries[i]->load();
+            // the first entry with the UUID wins, as in the table
+            m_uuid_index.emplace(entry->get_temporary_uuid(), i);
+            if (entry->has_persistent_uuid()) {
+                m_uuid_index.emplace(entry->get_persistent_uuid(), i);
+            }
+            m_children[entry->get_parent_uuid()].push_back(i);
+        }
+    }
+
+    /*!
+     * @brief Get version of the table structure the snapshot was taken at
+     * @return Table epoch
+     */
+    std::uint64_t get_version() const {
+        return m_version;
+    }
+
+    /*!
+     * @brief Get number of entries in the snapshot
+     * @return Number of entries
+     */
+    std::size_t size() const {
+        return m_entries.size();
+    }
+
+    /*!
+     * @brief Find entry by its persistent or temporary UUID
+     * @param uuid UUID of the entry
+     * @return Latest published version of the entry or nullptr if not found
+     */
+    EntryPtr find(const std::string& uuid) const {
+        const auto it = m_uuid_index.find(uuid);
+        return (m_uuid_index.cend() != it) ? m_entries[it->second]->load() : nullptr;
+    }
+
+    /*!
+     * @brief Get cells of all entries
+     * @return Cells in table order
+     */
+    const Entries& get_entries() const {
+        return m_entries;
+    }
+
+    /*!
+     * @brief Call visitor for every entry in the snapshot
+     * @param visitor Function called with const reference to each entry
+     */
+    template <typename Visitor>
+    void for_each(Visitor visitor) const {
+        for (const auto& cell : m_entries) {
+            const auto entry = cell->load();
+            visitor(*entry);
+        }
+    }
+
+    /*!
+     * @brief Call visitor for every child of the parent
+     * @param parent_uuid UUID of the parent
+     * @param visitor Function called with const reference to each child
+     */
+    template <typename Visitor>
+    void for_each_child(const std::string& parent_uuid, Visitor visitor) const {
+        const auto it = m_children.find(parent_uuid);
+        if (m_children.cend() != it) {
+            for (const auto index : it->second) {
+                const auto entry = m_entries[index]->load();
+                visitor(*entry);
+            }
+        }
+    }
+
+    /*!
+     * @brief Count children of the parent
+     * @param parent_uuid UUID of the parent
+     * @return Number of children
+     */
+    std::size_t count_children(const std::string& parent_uuid) const {
+        const auto it = m_children.find(parent_uuid);
+        return (m_children.cend() != it) ? it->second.size() : 0;
+    }
+
+private:
+    std::uint64_t m_version{};
+    Entries m_entries{};
+    std::unordered_map<std::string, std::size_t> m_uuid_index{};
+    std::unordered_map<std::string, std::vector<std::size_t>> m_children{};
+};
+
+}
+}
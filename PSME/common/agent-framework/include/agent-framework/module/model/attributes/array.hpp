@@ -240,6 +240,33 @@ private:
     ArrayObject m_array{};
 };
 
+
+/*!
+ * @brief Compare arrays, arrays are equal if they have equal elements in the same order
+ *
+ * Defined outside of the class, so explicit instantiations of arrays of elements without
+ * the equality operator do not instantiate it.
+ * @param lhs Array to compare
+ * @param rhs Array to compare with
+ * @return True if arrays are equal
+ * */
+template<typename T>
+bool operator==(const Array<T>& lhs, const Array<T>& rhs) {
+    return lhs.get_array() == rhs.get_array();
+}
+
+
+/*!
+ * @brief Compare arrays
+ * @param lhs Array to compare
+ * @param rhs Array to compare with
+ * @return True if arrays differ
+ * */
+template<typename T>
+bool operator!=(const Array<T>& lhs, const Array<T>& rhs) {
+    return !(lhs == rhs);
+}
+
 }
 }
 }
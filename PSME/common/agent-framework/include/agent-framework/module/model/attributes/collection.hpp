@@ -115,6 +115,31 @@ public:
     static Collection from_json(const json::Json& json);
 
 
+    /*!
+     * @brief Compare with other collection
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const Collection& other) const {
+        return m_name == other.m_name &&
+               m_type == other.m_type;
+    }
+
+
+    /*!
+     * @brief Compare with other collection
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const Collection& other) const {
+        return !(*this == other);
+    }
+
+
 private:
 
     std::string m_name{};
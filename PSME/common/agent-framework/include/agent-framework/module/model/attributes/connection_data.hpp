@@ -86,6 +86,14 @@ public:
         return m_port;
     }
 
+    /*!
+     * @brief Gets type of the IPMI interface used to connect to the BMC
+     * @return Interface type, "lan" or "lanplus"
+     * */
+    const std::string& get_interface_type() const {
+        return m_interface_type;
+    }
+
     /*!
      * @brief setter for ip_address attribute
      *
@@ -122,12 +130,22 @@ public:
         m_port = port;
     }
 
+    /*!
+     * @brief setter for interface_type attribute
+     *
+     * @param interface_type of type std::string
+     */
+    void set_interface_type(const std::string& interface_type) {
+        m_interface_type = interface_type;
+    }
+
 
 private:
     std::uint32_t m_port{};
     std::string m_ip_address{};
     std::string m_username{};
     std::string m_password{};
+    std::string m_interface_type{"lan"};
 };
 
 }
@@ -157,6 +157,33 @@ public:
     static FruInfo from_json(const json::Json& json);
 
 
+    /*!
+     * @brief Compare with other FRU info
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const FruInfo& other) const {
+        return m_serial_number == other.m_serial_number &&
+               m_manufacturer == other.m_manufacturer &&
+               m_model_number == other.m_model_number &&
+               m_part_number == other.m_part_number;
+    }
+
+
+    /*!
+     * @brief Compare with other FRU info
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const FruInfo& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     OptionalField<std::string> m_serial_number{};
     OptionalField<std::string> m_manufacturer{};
@@ -125,6 +125,31 @@ public:
     static Identifier from_json(const json::Json& json);
 
 
+    /*!
+     * @brief Compare with other identifier
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const Identifier& other) const {
+        return m_durable_name == other.m_durable_name &&
+               m_durable_name_format == other.m_durable_name_format;
+    }
+
+
+    /*!
+     * @brief Compare with other identifier
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const Identifier& other) const {
+        return !(*this == other);
+    }
+
+
     /*!
      * @brief Helper method for easy access to NQN identifier.
      *
@@ -106,6 +106,31 @@ public:
     ~Location();
 
 
+    /*!
+     * @brief Compare with other location
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const Location& other) const {
+        return m_info == other.m_info &&
+               m_info_format == other.m_info_format;
+    }
+
+
+    /*!
+     * @brief Compare with other location
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const Location& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     std::string m_info{};
     std::string m_info_format{};
@@ -132,6 +132,34 @@ public:
      */
     static MemoryLocation from_json(const json::Json& json);
 
+
+    /*!
+     * @brief Compare with other memory location
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const MemoryLocation& other) const {
+        return m_socket == other.m_socket &&
+               m_controller == other.m_controller &&
+               m_channel == other.m_channel &&
+               m_slot == other.m_slot;
+    }
+
+
+    /*!
+     * @brief Compare with other memory location
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const MemoryLocation& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     OptionalField<std::uint32_t> m_socket{};
     OptionalField<std::uint32_t> m_controller{};
@@ -59,6 +59,24 @@ public:
 	 */
 	static Oem from_json(const json::Json& json);
 
+    /*!
+     * @brief Compare with other oem, oem attribute has no data
+     *
+     * @return Always true
+     */
+    bool operator==(const Oem&) const {
+        return true;
+    }
+
+    /*!
+     * @brief Compare with other oem, oem attribute has no data
+     *
+     * @return Always false
+     */
+    bool operator!=(const Oem&) const {
+        return false;
+    }
+
 };
 
 }
@@ -103,6 +103,32 @@ public:
      */
     static PciDevice from_json(const json::Json& json);
 
+
+    /*!
+     * @brief Compare with other PCI device
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const PciDevice& other) const {
+        return m_vendor_id == other.m_vendor_id &&
+               m_device_id == other.m_device_id;
+    }
+
+
+    /*!
+     * @brief Compare with other PCI device
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const PciDevice& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     std::string m_vendor_id{};
     std::string m_device_id{};
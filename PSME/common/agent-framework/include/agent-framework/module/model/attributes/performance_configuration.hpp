@@ -234,6 +234,39 @@ public:
     }
 
 
+    /*!
+     * @brief Compare with other performance configuration
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const PerformanceConfiguration& other) const {
+        return m_configuration_id == other.m_configuration_id &&
+               m_type == other.m_type &&
+               m_tdp == other.m_tdp &&
+               m_max_junction_temp_celsius == other.m_max_junction_temp_celsius &&
+               m_high_priority_core_count == other.m_high_priority_core_count &&
+               m_low_priority_core_count == other.m_low_priority_core_count &&
+               m_high_priority_base_frequency == other.m_high_priority_base_frequency &&
+               m_low_priority_base_frequency == other.m_low_priority_base_frequency &&
+               m_active_cores == other.m_active_cores &&
+               m_base_core_frequency == other.m_base_core_frequency;
+    }
+
+
+    /*!
+     * @brief Compare with other performance configuration
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const PerformanceConfiguration& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     /* common configuration members */
     OptionalField<uint64_t> m_configuration_id{};
@@ -126,6 +126,34 @@ public:
      */
     static PowerManagementPolicy from_json(const json::Json& json);
 
+
+    /*!
+     * @brief Compare with other power management policy
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const PowerManagementPolicy& other) const {
+        return m_policy_enabled == other.m_policy_enabled &&
+               m_max_tdp_milliwatts == other.m_max_tdp_milliwatts &&
+               m_average_power_budget_milliwatts == other.m_average_power_budget_milliwatts &&
+               m_peak_power_budget_milliwatts == other.m_peak_power_budget_milliwatts;
+    }
+
+
+    /*!
+     * @brief Compare with other power management policy
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const PowerManagementPolicy& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     OptionalField<bool> m_policy_enabled{};
     OptionalField<std::uint32_t> m_max_tdp_milliwatts{};
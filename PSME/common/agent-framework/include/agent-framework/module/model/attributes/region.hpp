@@ -133,6 +133,34 @@ public:
      */
     static Region from_json(const json::Json& json);
 
+
+    /*!
+     * @brief Compare with other region
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const Region& other) const {
+        return m_region_id == other.m_region_id &&
+               m_memory_type == other.m_memory_type &&
+               m_offset_mib == other.m_offset_mib &&
+               m_size_mib == other.m_size_mib;
+    }
+
+
+    /*!
+     * @brief Compare with other region
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const Region& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     OptionalField<std::string> m_region_id{};
     OptionalField<enums::MemoryClass> m_memory_type{};
@@ -91,6 +91,32 @@ public:
      */
     static SecurityCapabilities from_json(const json::Json& json);
 
+
+    /*!
+     * @brief Compare with other security capabilities
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const SecurityCapabilities& other) const {
+        return m_passphrase_capable == other.m_passphrase_capable &&
+               m_max_passphrase_count == other.m_max_passphrase_count;
+    }
+
+
+    /*!
+     * @brief Compare with other security capabilities
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const SecurityCapabilities& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     OptionalField<bool> m_passphrase_capable{};
     OptionalField<std::uint32_t> m_max_passphrase_count{};
@@ -117,6 +117,31 @@ public:
     static Status from_json(const json::Json& json);
 
 
+    /*!
+     * @brief Compare with other status
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const Status& other) const {
+        return m_state == other.m_state &&
+               m_health == other.m_health;
+    }
+
+
+    /*!
+     * @brief Compare with other status
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const Status& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     enums::State m_state{enums::State::Disabled};
     OptionalField<enums::Health> m_health{};
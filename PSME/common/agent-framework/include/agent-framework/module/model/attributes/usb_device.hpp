@@ -102,6 +102,32 @@ public:
      */
     static UsbDevice from_json(const json::Json& json);
 
+
+    /*!
+     * @brief Compare with other USB device
+     *
+     * @param other Object to compare with
+     *
+     * @return True if all attributes are equal
+     * */
+    bool operator==(const UsbDevice& other) const {
+        return m_vendor_id == other.m_vendor_id &&
+               m_device_id == other.m_device_id;
+    }
+
+
+    /*!
+     * @brief Compare with other USB device
+     *
+     * @param other Object to compare with
+     *
+     * @return True if any attribute differs
+     * */
+    bool operator!=(const UsbDevice& other) const {
+        return !(*this == other);
+    }
+
+
 private:
     std::string m_vendor_id{};
     std::string m_device_id{};
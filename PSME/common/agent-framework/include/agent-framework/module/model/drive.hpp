@@ -79,6 +79,18 @@ public:
     static Drive from_json(const json::Json& json);
 
 
+    /*!
+     * @brief Compare all attributes but the status with other drive, without serialization to JSON
+     *
+     * Only attributes present in the JSON representation are compared.
+     *
+     * @param other Drive to compare with
+     *
+     * @return True if the attributes are equal
+     */
+    bool attributes_equal(const Drive& other) const;
+
+
     /*!
      * @brief Get collection name
      * @return collection name
@@ -57,6 +57,17 @@ public:
      */
     json::Json to_json() const;
 
+    /*!
+     * @brief Compare all attributes but the status with other memory, without serialization to JSON
+     *
+     * Only attributes present in the JSON representation are compared.
+     *
+     * @param other Memory to compare with
+     *
+     * @return True if the attributes are equal
+     */
+    bool attributes_equal(const Memory& other) const;
+
     /*!
      * @brief Get collection name
      * @return collection name
@@ -82,6 +82,18 @@ public:
     json::Json to_json() const;
 
 
+    /*!
+     * @brief Compare all attributes but the status with other system, without serialization to JSON
+     *
+     * Only attributes present in the JSON representation are compared.
+     *
+     * @param other System to compare with
+     *
+     * @return True if the attributes are equal
+     */
+    bool attributes_equal(const System& other) const;
+
+
     /*!
      * @brief Get collection name
      * @return collection name
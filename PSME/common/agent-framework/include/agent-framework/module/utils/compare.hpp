@@ -0,0 +1,121 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file compare.hpp
+ *
+ * @brief Detection of changes between two versions of a model resource
+ * */
+
+#pragma once
+
+#include "json-wrapper/json-wrapper.hpp"
+
+#include <type_traits>
+
+
+
+namespace agent_framework {
+namespace model {
+namespace utils {
+
+/*! @brief Result of comparison of two versions of a resource */
+enum class Difference {
+    None,
+    Status,
+    Attributes
+};
+
+
+/*!
+ * @brief Type_traits-like class to determine if a model class can compare its attributes directly,
+ * i.e. it has attributes_equal(const T&) method.
+ * */
+template <typename T>
+struct has_attributes_equal {
+private:
+
+    /* See is_framework_enum.h for explanation how it works */
+
+    template <typename P>
+    static constexpr bool check(P) {
+        return false;
+    }
+
+    template <typename P, typename V = T>
+    static constexpr auto check(P*)
+            -> decltype(std::declval<const V&>().attributes_equal(std::declval<const V&>()), true) {
+        return true;
+    }
+
+public:
+
+    // required by gcc to compile with no warnings
+    has_attributes_equal() {}
+    ~has_attributes_equal() {}
+
+    /* @brief True if T has attributes_equal method, false otherwise. */
+    static constexpr const bool value = check(static_cast<void*>(nullptr));
+};
+
+
+/*!
+ * @brief Compare JSON representations of two versions of a resource.
+ *
+ * Result is the same as comparing Hash::from_resource() of both versions,
+ * but neither dump to string nor hashing is done.
+ *
+ * @param lhs JSON representation of the first version
+ * @param rhs JSON representation of the second version
+ *
+ * @return Status if statuses differ, Attributes if only other attributes differ, None otherwise
+ * */
+Difference compare_json(const json::Json& lhs, const json::Json& rhs);
+
+
+/*!
+ * @brief Compare two versions of a resource.
+ *
+ * Resources providing attributes_equal() are compared member by member,
+ * all others are compared using their JSON representation.
+ *
+ * @tparam T Resource type
+ * @param lhs First version of the resource
+ * @param rhs Second version of the resource
+ *
+ * @return Status if statuses differ, Attributes if only other attributes differ, None otherwise
+ * */
+template <typename T, typename std::enable_if<has_attributes_equal<T>::value>::type* = nullptr>
+Difference compare_resources(const T& lhs, const T& rhs) {
+    if (lhs.get_status() != rhs.get_status()) {
+        return Difference::Status;
+    }
+    return lhs.attributes_equal(rhs) ? Difference::None : Difference::Attributes;
+}
+
+
+/*! @brief Compare two versions of a resource, see above */
+template <typename T, typename std::enable_if<!has_attributes_equal<T>::value>::type* = nullptr>
+Difference compare_resources(const T& lhs, const T& rhs) {
+    return compare_json(lhs.to_json(), rhs.to_json());
+}
+
+}
+}
+}
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "hash.hpp"
+#include "compare.hpp"
 #include "optional_field.hpp"
 #include "json_converter.hpp"
 #include "time.hpp"
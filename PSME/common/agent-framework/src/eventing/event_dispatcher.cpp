@@ -20,8 +20,10 @@
 */
 #include "agent-framework/eventing/event_dispatcher.hpp"
 #include "agent-framework/eventing/events_queue.hpp"
+#include "agent-framework/eventing/utils.hpp"
 #include "agent-framework/module/service_uuid.hpp"
 #include "agent-framework/module/requests/psme/component_notification.hpp"
+#include "configuration/configuration.hpp"
 
 #include <string>
 
@@ -29,10 +31,25 @@ using namespace agent_framework::generic;
 
 namespace {
 const size_t QUEUE_WAIT_TIME = 1000;
+
+std::chrono::milliseconds read_coalescing_window() {
+    const json::Json& config = configuration::Configuration::get_instance().to_json();
+    const auto& eventing = config.value("eventing", json::Json::object());
+    const auto window = eventing.value("coalescing-window-ms", 0);
+    return std::chrono::milliseconds(window > 0 ? window : 0);
+}
 }
 
 
-EventDispatcher::EventDispatcher() : m_event_sender{new EventSender()} {}
+EventDispatcher::EventDispatcher() : EventDispatcher(read_coalescing_window()) {}
+
+EventDispatcher::EventDispatcher(const std::chrono::milliseconds& coalescing_window) :
+    m_event_sender{new EventSender()}, m_coalescing_window{coalescing_window} {
+
+    if (m_coalescing_window.count() > 0) {
+        log_info("eventing", "Events coalesced within " << m_coalescing_window.count() << "ms window.");
+    }
+}
 
 EventDispatcher::~EventDispatcher() {}
 
@@ -63,8 +80,38 @@ void EventDispatcher::execute() {
                 continue;
             }
 
+            if (m_coalescing_window.count() > 0) {
+                coalesce(*notification);
+                if (notification->get_notifications().empty()) {
+                    log_debug("eventing", "All coalesced events cancelled each other");
+                    continue;
+                }
+            }
+
             m_event_sender->send_notifications(std::move(*notification));
         }
     }
     log_info("eventing", "EventDispatcher thread stopped.");
 }
+
+void EventDispatcher::coalesce(model::requests::ComponentNotification& notification) {
+    using agent_framework::eventing::EventsQueue;
+
+    /* Notifications already queued are gathered until the queue is empty, so nothing waits for more events.
+     * The window limits the time spent on gathering if notifications keep coming. */
+    auto events = notification.get_notifications();
+    const auto deadline = std::chrono::steady_clock::now() + m_coalescing_window;
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto next = EventsQueue::get_instance()->try_pop();
+        if (!next) {
+            break;
+        }
+        const auto& next_events = next->get_notifications();
+        events.insert(events.end(), next_events.cbegin(), next_events.cend());
+    }
+
+    const auto gathered = events.size();
+    notification.set_notifications(agent_framework::eventing::coalesce_events(events));
+    log_debug("eventing", "Coalesced " << gathered << " events into "
+        << notification.get_notifications().size() << ".");
+}
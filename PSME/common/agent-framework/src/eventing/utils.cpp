@@ -23,6 +23,8 @@
 
 #include "agent-framework/eventing/utils.hpp"
 
+#include <unordered_map>
+
 using namespace agent_framework;
 
 void eventing::send_event(const Uuid& uuid,
@@ -37,3 +39,44 @@ void eventing::send_event(const Uuid& uuid,
     edat.set_parent(parent_uuid);
     eventing::EventsQueue::get_instance()->push_back(edat);
 }
+
+model::attribute::EventData::Vector eventing::coalesce_events(const model::attribute::EventData::Vector& events) {
+    using model::enums::Notification;
+
+    std::vector<bool> kept(events.size(), false);
+    /* indexes of kept events for each component, in order */
+    std::unordered_map<Uuid, std::vector<std::size_t>> kept_for_component{};
+
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        auto& component_events = kept_for_component[events[i].get_component()];
+        const auto notification = events[i].get_notification();
+
+        if (!component_events.empty()) {
+            const auto previous = events[component_events.back()].get_notification();
+            if (Notification::Update == notification && Notification::Remove != previous) {
+                /* component is going to be (re)read anyway */
+                continue;
+            }
+            if (Notification::Remove == notification && Notification::Update == previous) {
+                kept[component_events.back()] = false;
+                component_events.pop_back();
+            }
+            else if (Notification::Remove == notification && Notification::Add == previous) {
+                /* component was never reported */
+                kept[component_events.back()] = false;
+                component_events.pop_back();
+                continue;
+            }
+        }
+        kept[i] = true;
+        component_events.push_back(i);
+    }
+
+    model::attribute::EventData::Vector coalesced{};
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        if (kept[i]) {
+            coalesced.push_back(events[i]);
+        }
+    }
+    return coalesced;
+}
@@ -38,5 +38,13 @@ void GenericManagerRegistry::for_each_table(GenericManagerRegistry::TableClientF
     }
 }
 
+void GenericManagerRegistry::set_snapshot_reads(bool enabled) {
+    snapshot_reads = enabled;
+    for_each_table([enabled](TableInterface* table) {
+        table->set_snapshot_reads(enabled);
+        return true;
+    });
+}
+
 }
 }
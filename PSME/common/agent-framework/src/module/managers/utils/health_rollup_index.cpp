@@ -0,0 +1,192 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file health_rollup_index.cpp
+ * @brief Incrementally maintained health rollup of the resource tree
+ * */
+
+#include "agent-framework/module/managers/utils/health_rollup_index.hpp"
+
+#include <algorithm>
+
+using namespace agent_framework::module;
+using agent_framework::model::enums::Component;
+
+namespace {
+
+static_assert(agent_framework::model::enums::Health::OK == 0 &&
+              agent_framework::model::enums::Health::Warning == 1 &&
+              agent_framework::model::enums::Health::Critical == 2,
+              "Health values are used as indexes of the counters");
+
+
+std::uint32_t to_key(Component component) {
+    return static_cast<std::uint32_t>(component);
+}
+
+}
+
+
+HealthRollupIndex::~HealthRollupIndex() { }
+
+
+void HealthRollupIndex::set_enabled(bool enabled) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_nodes.clear();
+    m_enabled = enabled;
+    ++m_modification_epoch;
+}
+
+
+void HealthRollupIndex::update(const std::string& uuid, const std::string& parent_uuid,
+                               Component component, const Health& health) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto& node = m_nodes[uuid];
+    const auto& parent = (parent_uuid == uuid) ? std::string{} : parent_uuid;
+    if (node.present && node.parent_uuid == parent && node.component == to_key(component) && node.health == health) {
+        return;
+    }
+
+    ++m_modification_epoch;
+    if (node.present) {
+        detach(uuid, node);
+    }
+    node.present = true;
+    node.parent_uuid = parent;
+    node.component = to_key(component);
+    node.health = health;
+    attach(uuid, node);
+}
+
+
+void HealthRollupIndex::remove(const std::string& uuid) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    const auto it = m_nodes.find(uuid);
+    if (m_nodes.end() == it || !it->second.present) {
+        return;
+    }
+    ++m_modification_epoch;
+    detach(uuid, it->second);
+    it->second.present = false;
+    it->second.parent_uuid.clear();
+    it->second.health = Health{};
+    // descendants still reported by other tables are kept under a placeholder
+    release_placeholder(uuid);
+}
+
+
+HealthRollupIndex::Health HealthRollupIndex::get(const std::string& uuid, Component filter) const {
+    ReadTracker::record(m_modification_epoch);
+    std::lock_guard<std::mutex> lock{m_mutex};
+    const auto it = m_nodes.find(uuid);
+    if (m_nodes.end() == it || !it->second.present) {
+        return {};
+    }
+
+    const auto& node = it->second;
+    const bool own_health = (Component::None == filter || to_key(filter) == node.component);
+    if (own_health && !node.health.has_value()) {
+        return {};
+    }
+
+    const Counters* counters = &node.descendants;
+    if (Component::None != filter) {
+        const auto component_counters = node.component_descendants.find(to_key(filter));
+        counters = (node.component_descendants.end() == component_counters) ? nullptr : &component_counters->second;
+    }
+
+    Health worst{};
+    for (std::size_t health = (nullptr == counters ? 0 : counters->size()); health > 0; --health) {
+        if ((*counters)[health - 1] > 0) {
+            worst = static_cast<model::enums::Health::base_enum>(health - 1);
+            break;
+        }
+    }
+    return own_health ? std::max(worst, node.health) : worst;
+}
+
+
+void HealthRollupIndex::add_contribution(const std::string& uuid, const Node& node, std::int64_t sign) {
+    Counters counters = node.descendants;
+    ComponentCounters component_counters = node.component_descendants;
+    if (node.health.has_value()) {
+        const auto health = static_cast<std::size_t>(node.health.value());
+        ++counters[health];
+        ++component_counters[node.component][health];
+    }
+
+    // the number of steps is limited, so an invalid (cyclic) tree does not hang the index
+    auto parent_uuid = node.parent_uuid;
+    for (std::size_t steps = 0; !parent_uuid.empty() && parent_uuid != uuid && steps < m_nodes.size(); ++steps) {
+        const auto parent = m_nodes.find(parent_uuid);
+        if (m_nodes.end() == parent) {
+            break;
+        }
+        auto& ancestor = parent->second;
+        for (std::size_t health = 0; health < counters.size(); ++health) {
+            ancestor.descendants[health] += sign * counters[health];
+        }
+        for (const auto& component : component_counters) {
+            auto& ancestor_counters = ancestor.component_descendants[component.first];
+            for (std::size_t health = 0; health < ancestor_counters.size(); ++health) {
+                ancestor_counters[health] += sign * component.second[health];
+            }
+            if (std::all_of(ancestor_counters.begin(), ancestor_counters.end(),
+                            [](std::int64_t count) { return 0 == count; })) {
+                ancestor.component_descendants.erase(component.first);
+            }
+        }
+        if (!ancestor.present) {
+            break;
+        }
+        parent_uuid = ancestor.parent_uuid;
+    }
+}
+
+
+void HealthRollupIndex::attach(const std::string& uuid, Node& node) {
+    if (node.parent_uuid.empty()) {
+        return;
+    }
+    // references to the elements of unordered_map stay valid when a placeholder is inserted
+    ++m_nodes[node.parent_uuid].children;
+    add_contribution(uuid, node, 1);
+}
+
+
+void HealthRollupIndex::detach(const std::string& uuid, Node& node) {
+    if (node.parent_uuid.empty()) {
+        return;
+    }
+    add_contribution(uuid, node, -1);
+    const auto parent = m_nodes.find(node.parent_uuid);
+    if (m_nodes.end() != parent) {
+        --parent->second.children;
+        release_placeholder(node.parent_uuid);
+    }
+}
+
+
+void HealthRollupIndex::release_placeholder(const std::string& uuid) {
+    const auto it = m_nodes.find(uuid);
+    if (m_nodes.end() != it && !it->second.present && 0 == it->second.children) {
+        m_nodes.erase(it);
+    }
+}
@@ -0,0 +1,83 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file read_tracker.cpp
+ * @brief Tracking of the tables read by a thread
+ * */
+
+#include "agent-framework/module/managers/utils/read_tracker.hpp"
+
+#include <algorithm>
+
+using namespace agent_framework::module;
+
+namespace {
+
+thread_local ReadTracker* current_tracker{nullptr};
+
+}
+
+
+ReadTracker::ReadTracker() : m_enclosing{current_tracker} {
+    current_tracker = this;
+}
+
+
+ReadTracker::~ReadTracker() {
+    current_tracker = m_enclosing;
+    if (nullptr != m_enclosing) {
+        for (const auto& dependency : m_dependencies) {
+            m_enclosing->add(dependency);
+        }
+        m_enclosing->m_tracked = m_enclosing->m_tracked && m_tracked;
+    }
+}
+
+
+void ReadTracker::record(const Epoch& epoch) {
+    if (nullptr != current_tracker) {
+        current_tracker->add(Dependency{&epoch, epoch.load(std::memory_order_acquire)});
+    }
+}
+
+
+void ReadTracker::record_untracked() {
+    if (nullptr != current_tracker) {
+        current_tracker->m_tracked = false;
+    }
+}
+
+
+bool ReadTracker::is_up_to_date(const Dependencies& dependencies) {
+    return std::all_of(dependencies.begin(), dependencies.end(), [](const Dependency& dependency) {
+        return dependency.first->load(std::memory_order_acquire) == dependency.second;
+    });
+}
+
+
+void ReadTracker::add(const Dependency& dependency) {
+    // a few tables are read to build a response, so linear search is the fastest
+    const auto it = std::find_if(m_dependencies.begin(), m_dependencies.end(), [&dependency](const Dependency& d) {
+        return d.first == dependency.first;
+    });
+    if (m_dependencies.end() == it) {
+        m_dependencies.push_back(dependency);
+    }
+}
@@ -73,6 +73,38 @@ json::Json Drive::to_json() const {
 }
 
 
+bool Drive::attributes_equal(const Drive& other) const {
+    // keep in sync with to_json()
+    return get_name() == other.get_name() &&
+        get_description() == other.get_description() &&
+        get_interface() == other.get_interface() &&
+        get_type() == other.get_type() &&
+        get_rpm() == other.get_rpm() &&
+        get_firmware_version() == other.get_firmware_version() &&
+        get_latency_tracking_enabled() == other.get_latency_tracking_enabled() &&
+        get_capacity_gb() == other.get_capacity_gb() &&
+        get_fru_info() == other.get_fru_info() &&
+        get_indicator_led() == other.get_indicator_led() &&
+        get_asset_tag() == other.get_asset_tag() &&
+        get_capable_speed_gbs() == other.get_capable_speed_gbs() &&
+        get_negotiated_speed_gbs() == other.get_negotiated_speed_gbs() &&
+        get_locations() == other.get_locations() &&
+        get_status_indicator() == other.get_status_indicator() &&
+        get_revision() == other.get_revision() &&
+        get_failure_predicted() == other.get_failure_predicted() &&
+        get_sku() == other.get_sku() &&
+        get_identifiers() == other.get_identifiers() &&
+        get_hotspare_type() == other.get_hotspare_type() &&
+        get_encryption_ability() == other.get_encryption_ability() &&
+        get_encryption_status() == other.get_encryption_status() &&
+        get_block_size_bytes() == other.get_block_size_bytes() &&
+        get_predicted_media_life_left() == other.get_predicted_media_life_left() &&
+        get_erased() == other.get_erased() &&
+        get_collections() == other.get_collections() &&
+        get_oem() == other.get_oem();
+}
+
+
 Drive Drive::from_json(const json::Json& json) {
     Drive drive{};
 
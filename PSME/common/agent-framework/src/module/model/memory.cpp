@@ -76,6 +76,48 @@ json::Json Memory::to_json() const {
     return result;
 }
 
+
+bool Memory::attributes_equal(const Memory& other) const {
+    // keep in sync with to_json()
+    return get_name() == other.get_name() &&
+        get_description() == other.get_description() &&
+        get_memory_type() == other.get_memory_type() &&
+        get_device_type() == other.get_device_type() &&
+        get_module_type() == other.get_module_type() &&
+        get_memory_media() == other.get_memory_media() &&
+        get_memory_modes() == other.get_memory_modes() &&
+        get_capacity_mib() == other.get_capacity_mib() &&
+        get_data_width_bits() == other.get_data_width_bits() &&
+        get_bus_width_bits() == other.get_bus_width_bits() &&
+        get_fru_info() == other.get_fru_info() &&
+        get_firmware_revision() == other.get_firmware_revision() &&
+        get_firmware_api_version() == other.get_firmware_api_version() &&
+        get_module_manufacturer_id() == other.get_module_manufacturer_id() &&
+        get_module_product_id() == other.get_module_product_id() &&
+        get_memory_subsystem_controller_manufacturer_id() == other.get_memory_subsystem_controller_manufacturer_id() &&
+        get_memory_subsystem_controller_product_id() == other.get_memory_subsystem_controller_product_id() &&
+        get_operating_speed_mhz() == other.get_operating_speed_mhz() &&
+        get_allowed_speeds_mhz() == other.get_allowed_speeds_mhz() &&
+        get_max_tdp_milliwats() == other.get_max_tdp_milliwats() &&
+        get_voltage_volt() == other.get_voltage_volt() &&
+        get_min_voltage_volt() == other.get_min_voltage_volt() &&
+        get_max_voltage_volt() == other.get_max_voltage_volt() &&
+        get_device_locator() == other.get_device_locator() &&
+        get_location() == other.get_location() &&
+        get_rank_count() == other.get_rank_count() &&
+        get_spare_device_count() == other.get_spare_device_count() &&
+        get_logical_size_mib() == other.get_logical_size_mib() &&
+        get_volatile_size_mib() == other.get_volatile_size_mib() &&
+        get_non_volatile_size_mib() == other.get_non_volatile_size_mib() &&
+        get_volatile_region_size_limit_mib() == other.get_volatile_region_size_limit_mib() &&
+        get_persistent_region_size_limit_mib() == other.get_persistent_region_size_limit_mib() &&
+        get_error_correction() == other.get_error_correction() &&
+        get_regions() == other.get_regions() &&
+        get_security_capabilities() == other.get_security_capabilities() &&
+        get_power_management_policy() == other.get_power_management_policy() &&
+        get_oem() == other.get_oem();
+}
+
 Memory Memory::from_json(const json::Json& json) {
     using namespace agent_framework::model::attribute;
     Memory memory{};
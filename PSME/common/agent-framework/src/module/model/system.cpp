@@ -72,6 +72,34 @@ json::Json System::to_json() const {
 }
 
 
+bool System::attributes_equal(const System& other) const {
+    // keep in sync with to_json()
+    return get_system_type() == other.get_system_type() &&
+        get_bios_version() == other.get_bios_version() &&
+        get_boot_override() == other.get_boot_override() &&
+        get_boot_override_mode() == other.get_boot_override_mode() &&
+        get_boot_override_target() == other.get_boot_override_target() &&
+        get_boot_override_supported() == other.get_boot_override_supported() &&
+        get_uefi_target() == other.get_uefi_target() &&
+        get_power_state() == other.get_power_state() &&
+        get_pci_devices() == other.get_pci_devices() &&
+        get_usb_devices() == other.get_usb_devices() &&
+        get_fru_info() == other.get_fru_info() &&
+        get_sku() == other.get_sku() &&
+        get_asset_tag() == other.get_asset_tag() &&
+        get_indicator_led() == other.get_indicator_led() &&
+        get_collections() == other.get_collections() &&
+        get_chassis() == other.get_chassis() &&
+        get_oem() == other.get_oem() &&
+        get_guid() == other.get_guid() &&
+        get_cable_ids() == other.get_cable_ids() &&
+        is_txt_enabled() == other.is_txt_enabled() &&
+        is_user_mode_enabled() == other.is_user_mode_enabled() &&
+        get_current_performance_configuration() == other.get_current_performance_configuration() &&
+        get_performance_configurations() == other.get_performance_configurations();
+}
+
+
 System System::from_json(const json::Json& json) {
     System sys{};
 
@@ -0,0 +1,75 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file compare.cpp
+ *
+ * @brief Detection of changes between two versions of a model resource
+ * */
+
+#include "agent-framework/module/utils/compare.hpp"
+
+
+
+namespace agent_framework {
+namespace model {
+namespace utils {
+
+namespace {
+
+constexpr const char STATUS_KEY[] = "status";
+
+
+bool equal_without_status(const json::Json& lhs, const json::Json& rhs) {
+    if (!lhs.is_object() || !rhs.is_object()) {
+        return lhs == rhs;
+    }
+
+    std::size_t compared{0};
+    for (auto it = lhs.cbegin(); it != lhs.cend(); ++it) {
+        if (it.key() == STATUS_KEY) {
+            continue;
+        }
+        const auto other = rhs.find(it.key());
+        if (other == rhs.cend() || *other != it.value()) {
+            return false;
+        }
+        ++compared;
+    }
+
+    // all attributes of lhs are in rhs, so objects are equal if rhs has no other attributes
+    return compared == rhs.size() - rhs.count(STATUS_KEY);
+}
+
+}
+
+
+Difference compare_json(const json::Json& lhs, const json::Json& rhs) {
+    const bool lhs_has_status = lhs.is_object() && lhs.count(STATUS_KEY) != 0;
+    const bool rhs_has_status = rhs.is_object() && rhs.count(STATUS_KEY) != 0;
+
+    if (lhs_has_status != rhs_has_status || (lhs_has_status && lhs[STATUS_KEY] != rhs[STATUS_KEY])) {
+        return Difference::Status;
+    }
+    return equal_without_status(lhs, rhs) ? Difference::None : Difference::Attributes;
+}
+
+}
+}
+}
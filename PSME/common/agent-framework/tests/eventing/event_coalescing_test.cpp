@@ -0,0 +1,92 @@
+/*!
+ * @brief Event coalescing tests.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file event_coalescing_test.cpp
+ */
+
+#include "agent-framework/eventing/utils.hpp"
+#include "gtest/gtest.h"
+
+using namespace agent_framework;
+using namespace agent_framework::model;
+
+namespace {
+
+attribute::EventData make_event(const Uuid& uuid, enums::Notification notification) {
+    attribute::EventData event{};
+    event.set_component(uuid);
+    event.set_type(enums::Component::System);
+    event.set_notification(notification);
+    event.set_parent("parent");
+    return event;
+}
+
+std::vector<std::string> describe(const attribute::EventData::Vector& events) {
+    std::vector<std::string> description{};
+    for (const auto& event : events) {
+        description.push_back(event.get_component() + ":" + event.get_notification().to_string());
+    }
+    return description;
+}
+
+}
+
+TEST(EventCoalescingTest, RepeatedUpdatesAreDeduplicated) {
+    const auto coalesced = eventing::coalesce_events({
+        make_event("a", enums::Notification::Update),
+        make_event("b", enums::Notification::Update),
+        make_event("a", enums::Notification::Update),
+        make_event("a", enums::Notification::Update)
+    });
+    EXPECT_EQ((std::vector<std::string>{"a:Update", "b:Update"}), describe(coalesced));
+}
+
+TEST(EventCoalescingTest, UpdateAfterAddIsDropped) {
+    const auto coalesced = eventing::coalesce_events({
+        make_event("a", enums::Notification::Add),
+        make_event("a", enums::Notification::Update)
+    });
+    EXPECT_EQ((std::vector<std::string>{"a:Add"}), describe(coalesced));
+}
+
+TEST(EventCoalescingTest, AddFollowedByRemoveCollapses) {
+    const auto coalesced = eventing::coalesce_events({
+        make_event("a", enums::Notification::Add),
+        make_event("b", enums::Notification::Update),
+        make_event("a", enums::Notification::Update),
+        make_event("a", enums::Notification::Remove)
+    });
+    EXPECT_EQ((std::vector<std::string>{"b:Update"}), describe(coalesced));
+}
+
+TEST(EventCoalescingTest, RemoveReplacesUpdate) {
+    const auto coalesced = eventing::coalesce_events({
+        make_event("a", enums::Notification::Update),
+        make_event("b", enums::Notification::Add),
+        make_event("a", enums::Notification::Remove)
+    });
+    EXPECT_EQ((std::vector<std::string>{"b:Add", "a:Remove"}), describe(coalesced));
+}
+
+TEST(EventCoalescingTest, ReaddedComponentIsKept) {
+    const auto coalesced = eventing::coalesce_events({
+        make_event("a", enums::Notification::Remove),
+        make_event("a", enums::Notification::Add),
+        make_event("a", enums::Notification::Update),
+        make_event("a", enums::Notification::Remove),
+        make_event("a", enums::Notification::Add)
+    });
+    EXPECT_EQ((std::vector<std::string>{"a:Remove", "a:Add"}), describe(coalesced));
+}
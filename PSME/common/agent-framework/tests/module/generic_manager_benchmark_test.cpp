@@ -0,0 +1,128 @@
+/*!
+ * @section LICENSE
+ *
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @section GenericManager lookups: entries read per lookup do not depend on the table size
+ * */
+
+#include "agent-framework/module/managers/generic_manager.hpp"
+#include "agent-framework/module/enum/common.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace agent_framework;
+using namespace agent_framework::module;
+using namespace agent_framework::model;
+
+namespace {
+
+/*! Number of reads of the identifiers of the stored entries */
+std::size_t entry_reads{0};
+
+class BenchmarkObject {
+public:
+    BenchmarkObject(const std::string& parent_uuid, const std::string& uuid, std::uint64_t id) :
+        m_uuid(uuid), m_parent_uuid(parent_uuid), m_id(id) { }
+
+    static enums::CollectionName get_collection_name() {
+        return enums::CollectionName::None;
+    }
+
+    static enums::Component get_component() {
+        return enums::Component::Fan;
+    }
+
+    const std::string& get_uuid() const { ++entry_reads; return m_uuid; }
+    const std::string& get_persistent_uuid() const { return m_uuid; }
+    const std::string& get_temporary_uuid() const { return m_uuid; }
+    bool has_persistent_uuid() const { return false; }
+    const std::string& get_parent_uuid() const { ++entry_reads; return m_parent_uuid; }
+    const std::string& get_agent_id() const { return m_agent_id; }
+    std::uint64_t get_id() const { ++entry_reads; return m_id; }
+    void touch(std::uint64_t) { }
+
+    json::Json to_json() const {
+        return json::Json::object();
+    }
+
+private:
+    std::string m_uuid{};
+    std::string m_parent_uuid{};
+    std::string m_agent_id{};
+    std::uint64_t m_id{};
+};
+
+constexpr std::uint64_t CHILDREN_PER_PARENT = 16;
+constexpr std::uint64_t LOOKUPS = 100000;
+
+std::string make_uuid(std::uint64_t i) {
+    return "00000000-0000-0000-0000-" + std::to_string(1000000000000 + i);
+}
+
+std::string make_parent_uuid(std::uint64_t i) {
+    return "parent-" + std::to_string(i / CHILDREN_PER_PARENT);
+}
+
+/*!
+ * @brief Fill the manager and count entries read by all kinds of lookups
+ * @param entries Number of entries in the manager
+ * @return Number of reads of the identifiers of the entries
+ */
+std::size_t count_lookup_reads(std::uint64_t entries) {
+    GenericManager<BenchmarkObject> manager{};
+    for (std::uint64_t i = 0; i < entries; ++i) {
+        manager.add_entry(BenchmarkObject{make_parent_uuid(i), make_uuid(i), i});
+    }
+
+    std::vector<std::string> uuids{};
+    std::vector<std::string> parents{};
+    for (std::uint64_t i = 0; i < LOOKUPS; ++i) {
+        // spread lookups evenly, linear search would have to scan half of the table on average
+        const auto n = (i * 7919) % entries;
+        uuids.emplace_back(make_uuid(n));
+        parents.emplace_back(make_parent_uuid(n));
+    }
+
+    std::size_t found{0};
+    entry_reads = 0;
+    for (std::uint64_t i = 0; i < LOOKUPS; ++i) {
+        const auto n = (i * 7919) % entries;
+        found += std::size_t(manager.entry_exists(uuids[i]));
+        found += std::size_t(manager.rest_id_to_uuid(n) == uuids[i]);
+        found += std::size_t(manager.rest_id_to_uuid(n, parents[i]) == uuids[i]);
+        found += std::size_t(manager.uuid_to_rest_id(uuids[i]) == n);
+        found += std::size_t(manager.get_entry_count(parents[i]) != 0);
+    }
+    const auto reads = entry_reads;
+    EXPECT_EQ(found, 5 * LOOKUPS);
+    return reads;
+}
+
+}
+
+TEST(GenericManagerBenchmark, LookupCostDoesNotDependOnTableSize) {
+    const auto small = count_lookup_reads(10000);
+    const auto large = count_lookup_reads(100000);
+
+    // linear scan would read half of the table per lookup on average, indexes read the found entry at most
+    EXPECT_EQ(small, large);
+    EXPECT_GE(5 * LOOKUPS, large);
+}
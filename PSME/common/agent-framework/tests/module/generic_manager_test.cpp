@@ -29,6 +29,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <string>
+#include <thread>
+#include <atomic>
+#include <functional>
 
 using namespace agent_framework;
 using namespace agent_framework::module;
@@ -66,6 +69,7 @@ public:
     }
 
     const std::string& get_uuid() const { return m_uuid; }
+    void set_uuid(const std::string& uuid) { m_uuid = m_temporary_uuid = m_persistent_uuid = uuid; }
     const std::string& get_persistent_uuid() const { return m_persistent_uuid; }
     const std::string& get_temporary_uuid() const { return m_temporary_uuid; }
     bool has_persistent_uuid() const { return true; }
@@ -114,6 +118,37 @@ private:
     std::string m_data{""};
 };
 
+/*! Test object which calls a hook whenever it is copied or moved, e.g. while the table is updated */
+class ObservedObject : public TestObject {
+public:
+    using TestObject::TestObject;
+
+    ObservedObject(const ObservedObject& other) : TestObject(other) {
+        call_hook();
+    }
+
+    ObservedObject(ObservedObject&& other) : TestObject(std::move(other)) {
+        call_hook();
+    }
+
+    ObservedObject& operator=(const ObservedObject&) = default;
+    ObservedObject& operator=(ObservedObject&&) = default;
+
+    static std::function<void()> hook;
+
+private:
+    static void call_hook() {
+        if (hook) {
+            // the hook may copy objects too
+            auto called = std::move(hook);
+            called();
+            hook = std::move(called);
+        }
+    }
+};
+
+std::function<void()> ObservedObject::hook{};
+
 namespace {
     constexpr static const unsigned num{13};
     const TestObject elems[num] = {
@@ -379,3 +414,311 @@ TEST_F(GenericManagerTest, UUIDsAreCorrectlyTranslatedIntoIDs) {
     // check that nothing has changed in the manager
     EXPECT_TRUE(is_default());
 }
+
+TEST_F(GenericManagerTest, EntriesAreReindexedAfterChangeViaReference) {
+    int index = 3;
+    // move "1-3" from parent "1" to "1-1"
+    gm.get_entry_reference(::elems[index].get_uuid())->set_parent_uuid(::elems[1].get_uuid());
+    EXPECT_EQ(gm.get_entry_count(::elems[0].get_uuid()), 3u);
+    EXPECT_EQ(gm.get_entry_count(::elems[1].get_uuid()), 3u);
+    EXPECT_EQ(gm.rest_id_to_uuid(::elems[index].get_id(), ::elems[1].get_uuid()), ::elems[index].get_uuid());
+    EXPECT_THROW(gm.rest_id_to_uuid(::elems[index].get_id(), ::elems[0].get_uuid()),
+                 ::agent_framework::exceptions::NotFound);
+    // REST id change is visible in the id lookups
+    gm.get_entry_reference(::elems[index].get_uuid())->set_id(999);
+    EXPECT_EQ(gm.rest_id_to_uuid(999), ::elems[index].get_uuid());
+    EXPECT_EQ(gm.uuid_to_rest_id(::elems[index].get_uuid()), 999u);
+    EXPECT_THROW(gm.rest_id_to_uuid(::elems[index].get_id(), ::elems[1].get_uuid()),
+                 ::agent_framework::exceptions::NotFound);
+}
+
+TEST_F(GenericManagerTest, IndexesAreConsistentAfterRemovals) {
+    gm.remove_by_parent(::elems[1].get_uuid());
+    gm.remove_entry(::elems[2].get_uuid());
+    EXPECT_EQ(gm.get_entry_count(), ::num - 3);
+    EXPECT_EQ(gm.get_entry_count(::elems[0].get_uuid()), 3u);
+    EXPECT_EQ(gm.get_entry_count(::elems[1].get_uuid()), 0u);
+    EXPECT_THROW(gm.rest_id_to_uuid(2, ::elems[0].get_uuid()), ::agent_framework::exceptions::NotFound);
+    // both entries with REST id 2 ("1-2" and "1-1-2") are removed
+    EXPECT_THROW(gm.rest_id_to_uuid(2), ::agent_framework::exceptions::NotFound);
+    // re-adding removed entries makes them available again
+    gm.add_entry(::elems[2]);
+    EXPECT_EQ(gm.rest_id_to_uuid(2), ::elems[2].get_uuid());
+    EXPECT_EQ(gm.get_entry_count(::elems[0].get_uuid()), 4u);
+    EXPECT_EQ(gm.get_keys(::elems[0].get_uuid()).back(), ::elems[2].get_uuid());
+}
+
+TEST_F(GenericManagerTest, SnapshotStructureIsNotAffectedByLaterChanges) {
+    const auto snapshot = gm.get_snapshot();
+    ASSERT_EQ(snapshot->size(), ::num);
+    // snapshot is reused as long as entries are not added or removed
+    EXPECT_EQ(snapshot, gm.get_snapshot());
+
+    gm.get_entry_reference(::elems[1].get_uuid())->set_data("CHANGED");
+    gm.add_or_update_entry(TestObject{"A1", "1", "1-2", 2, 0, "UPDATED"});
+    EXPECT_EQ(snapshot, gm.get_snapshot());
+    gm.remove_entry(::elems[3].get_uuid());
+
+    // old snapshot keeps the original entries, with their latest versions
+    EXPECT_EQ(snapshot->size(), ::num);
+    EXPECT_EQ(snapshot->find(::elems[1].get_uuid())->get_data(), "CHANGED");
+    EXPECT_EQ(snapshot->find(::elems[2].get_uuid())->get_data(), "UPDATED");
+    EXPECT_NE(snapshot->find(::elems[3].get_uuid()), nullptr);
+    EXPECT_EQ(snapshot->count_children(::elems[0].get_uuid()), 4u);
+
+    // new snapshot has a newer version and reflects all changes
+    const auto current = gm.get_snapshot();
+    EXPECT_GT(current->get_version(), snapshot->get_version());
+    EXPECT_EQ(current->size(), ::num - 1);
+    EXPECT_EQ(current->find(::elems[1].get_uuid())->get_data(), "CHANGED");
+    EXPECT_EQ(current->find(::elems[2].get_uuid())->get_data(), "UPDATED");
+    EXPECT_EQ(current->find(::elems[3].get_uuid()), nullptr);
+    EXPECT_EQ(current->count_children(::elems[0].get_uuid()), 3u);
+}
+
+TEST_F(GenericManagerTest, SnapshotIsNotRebuiltOnUpdates) {
+    const auto snapshot = gm.get_snapshot();
+    const auto epoch = gm.get_current_epoch();
+
+    // entries touched without any change (e.g. by polling) are visible with their new epoch
+    for (unsigned i = 0; i < ::num; ++i) {
+        EXPECT_EQ(gm.add_or_update_entry(::elems[i]), GenericManager<TestObject>::UpdateStatus::NoUpdate);
+    }
+    EXPECT_EQ(snapshot, gm.get_snapshot());
+    snapshot->for_each([epoch](const TestObject& entry) {
+        EXPECT_TRUE(entry.was_touched_after(epoch));
+    });
+
+    // keys changed through a reference require a new snapshot
+    gm.get_entry_reference(::elems[4].get_uuid())->set_parent_uuid(::elems[1].get_uuid());
+    EXPECT_NE(snapshot, gm.get_snapshot());
+    EXPECT_EQ(gm.get_snapshot()->count_children(::elems[1].get_uuid()), 3u);
+}
+
+TEST_F(GenericManagerTest, SnapshotEntryIsNotModifiedViaReference) {
+    const auto snapshot = gm.get_snapshot();
+    const auto published = snapshot->find(::elems[1].get_uuid());
+    {
+        auto reference = gm.get_entry_reference(::elems[1].get_uuid());
+        reference->set_data("CHANGED");
+        // changes are published when the reference is released
+        EXPECT_EQ(snapshot->find(::elems[1].get_uuid())->get_data(), ::elems[1].get_data());
+        reference->set_data("CHANGED AGAIN");
+    }
+    EXPECT_EQ(published->get_data(), ::elems[1].get_data());
+    EXPECT_EQ(snapshot->find(::elems[1].get_uuid())->get_data(), "CHANGED AGAIN");
+
+    // the entry published on release is not modified by the next reference either
+    const auto released = snapshot->find(::elems[1].get_uuid());
+    gm.get_entry_reference(::elems[1].get_uuid())->set_data("CHANGED ONCE MORE");
+    EXPECT_EQ(released->get_data(), "CHANGED AGAIN");
+    EXPECT_EQ(gm.get_entry(::elems[1].get_uuid()).get_data(), "CHANGED ONCE MORE");
+}
+
+TEST_F(GenericManagerTest, EntryIsRepublishedOnlyAfterChangeViaReference) {
+    auto epoch = gm.get_modification_epoch();
+    const auto current_epoch = gm.get_current_epoch();
+    {
+        auto reference = gm.get_entry_reference(::elems[1].get_uuid());
+        reference->set_data(::elems[1].get_data());
+    }
+    EXPECT_EQ(epoch, gm.get_modification_epoch());
+    EXPECT_EQ(current_epoch, gm.get_current_epoch());
+
+    // entry published when the inner reference is released is not modified through the outer one
+    {
+        auto outer = gm.get_entry_reference(::elems[1].get_uuid());
+        {
+            auto inner = gm.get_entry_reference(::elems[1].get_uuid());
+            inner->set_data("INNER");
+        }
+        EXPECT_LT(epoch, gm.get_modification_epoch());
+        epoch = gm.get_modification_epoch();
+        outer->set_data("OUTER");
+        EXPECT_EQ(gm.get_snapshot()->find(::elems[1].get_uuid())->get_data(), "INNER");
+    }
+    EXPECT_LT(epoch, gm.get_modification_epoch());
+    EXPECT_EQ(gm.get_snapshot()->find(::elems[1].get_uuid())->get_data(), "OUTER");
+}
+
+TEST_F(GenericManagerTest, SnapshotReadsReturnTheSameResults) {
+    gm.set_snapshot_reads(true);
+    EXPECT_TRUE(is_default());
+    EXPECT_EQ(gm.get_entry_count(::elems[0].get_uuid()), 4u);
+    EXPECT_EQ(gm.get_keys(::elems[0].get_uuid()).size(), 4u);
+    EXPECT_EQ(gm.get_ids().size(), ::num);
+    EXPECT_THROW(gm.get_entry("BAD_UUID"), ::agent_framework::exceptions::InvalidUuid);
+
+    // writes are visible to the next read
+    gm.remove_by_parent(::elems[0].get_uuid());
+    EXPECT_EQ(gm.get_entry_count(), ::num - 4);
+    EXPECT_FALSE(gm.entry_exists(::elems[1].get_uuid()));
+    gm.get_entry_reference(::elems[5].get_uuid())->set_data("CHANGED");
+    EXPECT_EQ(gm.get_entry(::elems[5].get_uuid()).get_data(), "CHANGED");
+}
+
+TEST_F(GenericManagerTest, SnapshotReadersRunConcurrentlyWithWriters) {
+    gm.set_snapshot_reads(true);
+    std::atomic<bool> done{false};
+    std::thread writer([this, &done]() {
+        for (unsigned i = 0; i < 1000; ++i) {
+            gm.add_or_update_entry(TestObject{"A1", "1", "1-2", 2, 0, "DATA" + std::to_string(i)});
+        }
+        done = true;
+    });
+    std::size_t reads{0};
+    do {
+        const auto snapshot = gm.get_snapshot();
+        EXPECT_EQ(snapshot->size(), ::num);
+        EXPECT_EQ(snapshot->count_children(::elems[0].get_uuid()), 4u);
+        EXPECT_NE(snapshot->find(::elems[2].get_uuid()), nullptr);
+        ++reads;
+    } while (!done);
+    writer.join();
+    EXPECT_GT(reads, 0u);
+    EXPECT_EQ(gm.get_entry(::elems[2].get_uuid()).get_data(), "DATA999");
+}
+
+TEST_F(GenericManagerTest, EntriesAreVisitedCountedProjectedAndAccumulated) {
+    for (const bool snapshot_reads : {false, true}) {
+        gm.set_snapshot_reads(snapshot_reads);
+
+        std::size_t visited{0};
+        gm.for_each([&visited](const TestObject&) { ++visited; });
+        EXPECT_EQ(visited, ::num);
+
+        std::vector<std::string> children{};
+        gm.for_each(::elems[0].get_uuid(), [&children](const TestObject& entry) {
+            children.emplace_back(entry.get_uuid());
+        });
+        EXPECT_EQ(children, (std::vector<std::string>{"1-1", "1-2", "1-3", "1-4"}));
+
+        auto is_from_a2 = [](const TestObject& entry) { return entry.get_agent_id() == "A2"; };
+        EXPECT_EQ(gm.count_if(is_from_a2), 4u);
+        EXPECT_EQ(gm.count_if(::elems[0].get_uuid(), is_from_a2), 0u);
+        EXPECT_EQ(gm.count_if("BAD_UUID", is_from_a2), 0u);
+
+        auto get_data = [](const TestObject& entry) -> const std::string& { return entry.get_data(); };
+        EXPECT_EQ(gm.project(::elems[1].get_uuid(), get_data), (std::vector<std::string>{"GC1", "GC2"}));
+        EXPECT_EQ(gm.project(get_data).size(), ::num);
+
+        auto sum_ids = [](std::uint64_t sum, const TestObject& entry) { return sum + entry.get_id(); };
+        EXPECT_EQ(gm.accumulate(::elems[0].get_uuid(), std::uint64_t{0}, sum_ids), 10u);
+        EXPECT_EQ(gm.accumulate(std::uint64_t{0}, sum_ids), 25u);
+    }
+}
+
+TEST_F(GenericManagerTest, ModificationEpochChangesOnlyWhenEntriesChange) {
+    auto epoch = gm.get_modification_epoch();
+    EXPECT_EQ(gm.add_or_update_entry(::elems[1]), GenericManager<TestObject>::UpdateStatus::NoUpdate);
+    EXPECT_EQ(epoch, gm.get_modification_epoch());
+    gm.get_entry(::elems[1].get_uuid());
+    gm.get_ids(::elems[0].get_uuid());
+    EXPECT_EQ(epoch, gm.get_modification_epoch());
+
+    TestObject changed = ::elems[1];
+    changed.set_data("changed");
+    EXPECT_EQ(gm.add_or_update_entry(changed), GenericManager<TestObject>::UpdateStatus::Updated);
+    EXPECT_LT(epoch, gm.get_modification_epoch());
+
+    epoch = gm.get_modification_epoch();
+    gm.get_entry_reference(::elems[2].get_uuid())->set_data("changed");
+    EXPECT_LT(epoch, gm.get_modification_epoch());
+
+    epoch = gm.get_modification_epoch();
+    gm.remove_entry(::elems[3].get_uuid());
+    EXPECT_LT(epoch, gm.get_modification_epoch());
+}
+
+TEST_F(GenericManagerTest, ReadsAreRecordedByReadTracker) {
+    managers::ManyToManyManager links{};
+    links.add_entry("1", "1-1");
+
+    ReadTracker outer{};
+    {
+        ReadTracker tracker{};
+        gm.get_entry(::elems[0].get_uuid());
+        links.get_children("1");
+        gm.get_ids(::elems[0].get_uuid());
+        EXPECT_TRUE(tracker.is_tracked());
+        ASSERT_EQ(2u, tracker.get_dependencies().size());
+        EXPECT_EQ(gm.get_modification_epoch(), tracker.get_dependencies().front().second);
+        EXPECT_TRUE(ReadTracker::is_up_to_date(tracker.get_dependencies()));
+
+        gm.add_or_update_entry(::elems[0]);
+        EXPECT_TRUE(ReadTracker::is_up_to_date(tracker.get_dependencies()));
+        links.add_entry("1", "1-2");
+        EXPECT_FALSE(ReadTracker::is_up_to_date(tracker.get_dependencies()));
+    }
+    // dependencies of the inner tracker are passed to the outer one
+    EXPECT_EQ(2u, outer.get_dependencies().size());
+    EXPECT_TRUE(outer.is_tracked());
+    ReadTracker::record_untracked();
+    EXPECT_FALSE(outer.is_tracked());
+}
+
+TEST_F(GenericManagerTest, FirstEntryWithDuplicatedUUIDIsFound) {
+    // "1-2-2" gets UUID of the earlier "1-2", the earlier one is still found
+    gm.get_entry_reference(::elems[8].get_uuid())->set_uuid(::elems[2].get_uuid());
+    EXPECT_EQ(gm.get_entry(::elems[2].get_uuid()).get_data(), ::elems[2].get_data());
+    // "1-3" gets UUID of the later "1-4" and takes its place
+    gm.get_entry_reference(::elems[3].get_uuid())->set_uuid(::elems[4].get_uuid());
+    EXPECT_EQ(gm.get_entry(::elems[4].get_uuid()).get_data(), ::elems[3].get_data());
+    // removal of the found entry makes the next one with the same UUID available
+    gm.remove_entry(::elems[2].get_uuid());
+    EXPECT_EQ(gm.get_entry(::elems[2].get_uuid()).get_data(), ::elems[8].get_data());
+    gm.remove_entry(::elems[2].get_uuid());
+    EXPECT_FALSE(gm.entry_exists(::elems[2].get_uuid()));
+    gm.remove_entry(::elems[4].get_uuid());
+    EXPECT_EQ(gm.get_entry(::elems[4].get_uuid()).get_data(), ::elems[4].get_data());
+    EXPECT_EQ(gm.get_entry_count(), ::num - 3);
+}
+
+TEST(GenericManagerSnapshotReadTest, ReadDuringUpdateIsNotUpToDateWithOldContent) {
+    GenericManager<ObservedObject> manager{};
+    manager.set_snapshot_reads(true);
+    manager.add_entry(ObservedObject{"A1", "0", "1", 1, 0, "OLD"});
+
+    // snapshot reads run whenever the entry is copied by the update, before and after it is published
+    std::vector<std::pair<std::string, ReadTracker::Dependencies>> reads{};
+    ObservedObject::hook = [&manager, &reads]() {
+        ReadTracker tracker{};
+        std::string data{};
+        manager.for_each([&data](const ObservedObject& entry) { data = entry.get_data(); });
+        reads.emplace_back(data, tracker.get_dependencies());
+    };
+    // result of a read which is still up to date after the update must have seen the update
+    auto check_reads = [&reads](const std::string& expected) {
+        EXPECT_FALSE(reads.empty());
+        for (const auto& read : reads) {
+            if (ReadTracker::is_up_to_date(read.second)) {
+                EXPECT_EQ(expected, read.first);
+            }
+        }
+        reads.clear();
+    };
+
+    manager.add_or_update_entry(ObservedObject{"A1", "0", "1", 1, 0, "UPDATED"});
+    check_reads("UPDATED");
+    manager.get_entry_reference("1")->set_data("CHANGED");
+    check_reads("CHANGED");
+    ObservedObject::hook = nullptr;
+}
+
+TEST(GenericManagerReferenceTest, EntryIsCopiedOncePerReference) {
+    for (const bool snapshot_reads : {false, true}) {
+        GenericManager<ObservedObject> manager{};
+        manager.set_snapshot_reads(snapshot_reads);
+        manager.add_entry(ObservedObject{"A1", "0", "1", 1, 0, "OLD"});
+
+        unsigned copies{0};
+        ObservedObject::hook = [&copies]() { ++copies; };
+        manager.get_entry_reference("1")->set_data("CHANGED");
+        manager.get_entry_reference("1")->set_data("CHANGED");
+        ObservedObject::hook = nullptr;
+
+        // the published entry is kept to be compared with the modified private copy
+        EXPECT_EQ(2u, copies);
+        EXPECT_EQ("CHANGED", manager.get_entry("1").get_data());
+    }
+}
@@ -0,0 +1,172 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file health_rollup_index_test.cpp
+ * */
+
+#include "agent-framework/module/managers/utils/health_rollup_index.hpp"
+#include "agent-framework/module/managers/generic_manager.hpp"
+#include "agent-framework/module/model/memory.hpp"
+#include "agent-framework/module/model/system.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace agent_framework::module;
+using namespace agent_framework::model;
+using agent_framework::model::enums::Component;
+using agent_framework::model::enums::Health;
+
+namespace {
+
+class HealthRollupIndexTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        index->set_enabled(true);
+    }
+
+    void TearDown() override {
+        index->set_enabled(false);
+    }
+
+    HealthRollupIndex* index{HealthRollupIndex::get_instance()};
+};
+
+
+template <typename T>
+T make_resource(const std::string& parent_uuid, const std::string& uuid, OptionalField<Health> health) {
+    T resource{parent_uuid};
+    resource.set_uuid(uuid);
+    attribute::Status status{};
+    status.set_health(health);
+    resource.set_status(status);
+    return resource;
+}
+
+}
+
+
+TEST_F(HealthRollupIndexTest, RollupIsWorstHealthOfSubtree) {
+    index->update("system", "manager", Component::System, Health::OK);
+    index->update("memory", "system", Component::Memory, Health::Warning);
+    index->update("processor", "system", Component::Processor, Health::OK);
+    index->update("unknown", "system", Component::Memory, {});
+
+    EXPECT_EQ(Health::Warning, index->get("system"));
+    /* manager is not a resource of the index */
+    EXPECT_FALSE(index->get("manager").has_value());
+    EXPECT_EQ(Health::OK, index->get("processor"));
+    EXPECT_FALSE(index->get("unknown").has_value());
+    EXPECT_FALSE(index->get("not-existing").has_value());
+}
+
+
+TEST_F(HealthRollupIndexTest, UnknownOwnHealthMakesRollupUnknown) {
+    index->update("system", "manager", Component::System, {});
+    index->update("memory", "system", Component::Memory, Health::Critical);
+
+    EXPECT_FALSE(index->get("system").has_value());
+    EXPECT_EQ(Health::Critical, index->get("system", Component::Memory));
+}
+
+
+TEST_F(HealthRollupIndexTest, FilterSkipsOtherComponents) {
+    index->update("system", "manager", Component::System, Health::Critical);
+    index->update("memory1", "system", Component::Memory, Health::Warning);
+    index->update("memory2", "system", Component::Memory, Health::OK);
+    index->update("processor", "system", Component::Processor, Health::Critical);
+
+    EXPECT_EQ(Health::Warning, index->get("system", Component::Memory));
+    EXPECT_EQ(Health::Critical, index->get("system", Component::Processor));
+    EXPECT_EQ(Health::Critical, index->get("system", Component::System));
+    EXPECT_FALSE(index->get("system", Component::Drive).has_value());
+}
+
+
+TEST_F(HealthRollupIndexTest, UpdatesAndRemovalsAreReflected) {
+    index->update("system", "manager", Component::System, Health::OK);
+    index->update("memory", "system", Component::Memory, Health::Critical);
+    EXPECT_EQ(Health::Critical, index->get("system"));
+
+    index->update("memory", "system", Component::Memory, Health::Warning);
+    EXPECT_EQ(Health::Warning, index->get("system"));
+
+    index->update("memory", "other-system", Component::Memory, Health::Warning);
+    EXPECT_EQ(Health::OK, index->get("system"));
+
+    index->update("memory", "system", Component::Memory, Health::Critical);
+    index->remove("memory");
+    EXPECT_EQ(Health::OK, index->get("system"));
+    EXPECT_FALSE(index->get("system", Component::Memory).has_value());
+}
+
+
+TEST_F(HealthRollupIndexTest, ChildrenMayBeAddedBeforeParent) {
+    index->update("dimm", "memory-domain", Component::Memory, Health::Critical);
+    index->update("memory-domain", "system", Component::MemoryDomain, Health::OK);
+    EXPECT_EQ(Health::Critical, index->get("memory-domain"));
+    EXPECT_FALSE(index->get("system").has_value());
+
+    index->update("system", "manager", Component::System, Health::OK);
+    EXPECT_EQ(Health::Critical, index->get("system"));
+    EXPECT_EQ(Health::Critical, index->get("system", Component::Memory));
+
+    /* parent is removed and added again, its children are kept */
+    index->remove("system");
+    index->update("system", "manager", Component::System, Health::Warning);
+    EXPECT_EQ(Health::Critical, index->get("system"));
+}
+
+
+TEST_F(HealthRollupIndexTest, ReadsAreRecordedByReadTracker) {
+    index->update("system", "manager", Component::System, Health::OK);
+
+    ReadTracker tracker{};
+    index->get("system");
+    const auto dependencies = tracker.get_dependencies();
+    EXPECT_TRUE(ReadTracker::is_up_to_date(dependencies));
+
+    index->update("system", "manager", Component::System, Health::OK);
+    EXPECT_TRUE(ReadTracker::is_up_to_date(dependencies));
+
+    index->update("system", "manager", Component::System, Health::Critical);
+    EXPECT_FALSE(ReadTracker::is_up_to_date(dependencies));
+}
+
+
+TEST_F(HealthRollupIndexTest, TablesReportTheirEntries) {
+    GenericManager<System> systems{};
+    GenericManager<Memory> memories{};
+
+    systems.add_entry(make_resource<System>("manager", "system", Health::OK));
+    memories.add_entry(make_resource<Memory>("system", "memory", Health::OK));
+    EXPECT_EQ(Health::OK, index->get("system"));
+
+    memories.get_entry_reference("memory")->set_status(attribute::Status{enums::State::Enabled, Health::Critical});
+    EXPECT_EQ(Health::Critical, index->get("system"));
+
+    memories.add_or_update_entry(make_resource<Memory>("system", "memory", Health::Warning));
+    EXPECT_EQ(Health::Warning, index->get("system"));
+
+    memories.remove_entry("memory");
+    EXPECT_EQ(Health::OK, index->get("system"));
+
+    memories.add_entry(make_resource<Memory>("system", "memory", Health::Critical));
+    memories.clear_entries();
+    EXPECT_EQ(Health::OK, index->get("system"));
+}
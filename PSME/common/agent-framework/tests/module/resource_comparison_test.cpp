@@ -0,0 +1,223 @@
+/*!
+ * @section LICENSE
+ *
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @section Tests of change detection in model resources
+ * */
+
+#include "agent-framework/module/model/drive.hpp"
+#include "agent-framework/module/model/memory.hpp"
+#include "agent-framework/module/model/system.hpp"
+#include "agent-framework/module/utils/compare.hpp"
+#include "agent-framework/module/utils/hash.hpp"
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <vector>
+
+using namespace agent_framework::model;
+using namespace agent_framework::model::utils;
+
+namespace {
+
+/*! Reference implementation, comparison of hashes of JSON representations */
+template <typename T>
+Difference compare_hashes(const T& lhs, const T& rhs) {
+    const auto lhs_hash = Hash::from_resource(lhs);
+    const auto rhs_hash = Hash::from_resource(rhs);
+    if (lhs_hash.status != rhs_hash.status) {
+        return Difference::Status;
+    }
+    return (lhs_hash.resource_without_status != rhs_hash.resource_without_status) ?
+           Difference::Attributes : Difference::None;
+}
+
+
+template <typename T>
+void expect_difference(const T& lhs, const T& rhs, Difference expected) {
+    EXPECT_EQ(static_cast<int>(expected), static_cast<int>(compare_hashes(lhs, rhs)));
+    EXPECT_EQ(static_cast<int>(expected), static_cast<int>(compare_resources(lhs, rhs)));
+}
+
+
+/*! Every change has to be detected, and the result has to be the same as for hashes */
+template <typename T>
+void expect_changes_detected(const T& resource, const std::vector<std::function<void(T&)>>& changes) {
+    for (std::size_t i = 0; i < changes.size(); ++i) {
+        SCOPED_TRACE("change #" + std::to_string(i));
+        T changed{resource};
+        changes[i](changed);
+        expect_difference(resource, changed, Difference::Attributes);
+    }
+}
+
+
+attribute::Status make_status() {
+    return attribute::Status{enums::State::Enabled, enums::Health::OK};
+}
+
+
+Drive make_drive() {
+    Drive drive{"parent"};
+    drive.set_status(make_status());
+    drive.set_name("Drive");
+    drive.set_interface(enums::TransportProtocol::NVMe);
+    drive.set_type(enums::DriveType::SSD);
+    drive.set_capacity_gb(1000.0);
+    drive.set_fru_info(attribute::FruInfo{"serial", "manufacturer", "model", "part"});
+    drive.add_identifier(attribute::Identifier{"naa.5000", enums::IdentifierType::NAA});
+    drive.add_collection(attribute::Collection{"Drives", enums::CollectionType::Drives});
+    return drive;
+}
+
+
+Memory make_memory() {
+    Memory memory{"parent"};
+    memory.set_status(make_status());
+    memory.set_memory_type(enums::MemoryType::DRAM);
+    memory.add_media(enums::Media::DRAM);
+    memory.set_capacity_mib(16384);
+    memory.add_allowed_speed_mhz(2400);
+    memory.set_location(attribute::MemoryLocation{0, 0, 1, 2});
+    memory.add_region(attribute::Region{"1", enums::MemoryClass::Volatile, 0, 16384});
+    return memory;
+}
+
+
+System make_system() {
+    System system{"parent"};
+    system.set_status(make_status());
+    system.set_bios_version("1.0");
+    system.set_power_state(enums::PowerState::On);
+    system.add_pci_device(attribute::PciDevice{"8086", "1234"});
+    system.add_cable_id("cable");
+    system.set_fru_info(attribute::FruInfo{"serial", "manufacturer", "model", "part"});
+    return system;
+}
+
+}
+
+
+TEST(ResourceComparisonTest, EqualResourcesAreNotUpdated) {
+    expect_difference(make_drive(), make_drive(), Difference::None);
+    expect_difference(make_memory(), make_memory(), Difference::None);
+    expect_difference(make_system(), make_system(), Difference::None);
+}
+
+
+TEST(ResourceComparisonTest, StatusChangeHasPriority) {
+    auto drive = make_drive();
+    drive.set_status(attribute::Status{enums::State::Enabled, enums::Health::Critical});
+    drive.set_capacity_gb(2000.0);
+    expect_difference(make_drive(), drive, Difference::Status);
+
+    auto memory = make_memory();
+    memory.set_status(attribute::Status{enums::State::Absent, enums::Health::OK});
+    expect_difference(make_memory(), memory, Difference::Status);
+}
+
+
+TEST(ResourceComparisonTest, AttributesNotPresentInJsonAreIgnored) {
+    auto drive = make_drive();
+    drive.set_is_being_discovered(true);
+    drive.add_dsp_port_uuid("port");
+    expect_difference(make_drive(), drive, Difference::None);
+
+    auto system = make_system();
+    system.set_rackscale_mode_enabled(true);
+    expect_difference(make_system(), system, Difference::None);
+}
+
+
+TEST(ResourceComparisonTest, DriveChangesAreDetected) {
+    expect_changes_detected<Drive>(make_drive(), {
+        [](Drive& d) { d.set_name("Other"); },
+        [](Drive& d) { d.set_description("Description"); },
+        [](Drive& d) { d.set_interface(enums::TransportProtocol::SATA); },
+        [](Drive& d) { d.set_interface({}); },
+        [](Drive& d) { d.set_capacity_gb(2000.0); },
+        [](Drive& d) { d.set_rpm(7200); },
+        [](Drive& d) { d.set_fru_info(attribute::FruInfo{"other", "manufacturer", "model", "part"}); },
+        [](Drive& d) { d.add_identifier(attribute::Identifier{"uuid", enums::IdentifierType::UUID}); },
+        [](Drive& d) { d.set_identifiers({attribute::Identifier{"naa.5000", enums::IdentifierType::EUI}}); },
+        [](Drive& d) { d.add_location(attribute::Location{}); },
+        [](Drive& d) { d.add_collection(attribute::Collection{"Volumes", enums::CollectionType::Volumes}); },
+        [](Drive& d) { d.set_erased(true); },
+        [](Drive& d) { d.set_block_size_bytes(512); }
+    });
+}
+
+
+TEST(ResourceComparisonTest, MemoryChangesAreDetected) {
+    expect_changes_detected<Memory>(make_memory(), {
+        [](Memory& m) { m.set_name("Other"); },
+        [](Memory& m) { m.set_memory_type(enums::MemoryType::NVDIMM_N); },
+        [](Memory& m) { m.add_media(enums::Media::NAND); },
+        [](Memory& m) { m.set_capacity_mib(32768); },
+        [](Memory& m) { m.add_allowed_speed_mhz(2666); },
+        [](Memory& m) { m.add_max_tdp_milliwatts(12000); },
+        [](Memory& m) { m.set_voltage_volt(1.2); },
+        [](Memory& m) { m.set_location(attribute::MemoryLocation{0, 0, 1, 3}); },
+        [](Memory& m) { m.set_regions({attribute::Region{"1", enums::MemoryClass::Volatile, 0, 8192}}); },
+        [](Memory& m) { m.set_device_locator("DIMM_A1"); }
+    });
+}
+
+
+TEST(ResourceComparisonTest, SystemChangesAreDetected) {
+    expect_changes_detected<System>(make_system(), {
+        [](System& s) { s.set_bios_version("2.0"); },
+        [](System& s) { s.set_power_state(enums::PowerState::Off); },
+        [](System& s) { s.add_pci_device(attribute::PciDevice{"8086", "5678"}); },
+        [](System& s) { s.set_pci_devices({attribute::PciDevice{"8086", "4321"}}); },
+        [](System& s) { s.add_cable_id("other"); },
+        [](System& s) { s.set_fru_info(attribute::FruInfo{"serial", "manufacturer", "model", "other"}); },
+        [](System& s) { s.set_chassis("chassis"); },
+        [](System& s) { s.set_txt_enabled(true); },
+        [](System& s) { s.add_performance_configuration(attribute::PerformanceConfiguration{}); },
+        [](System& s) { s.set_current_performance_configuration(1); }
+    });
+}
+
+
+TEST(ResourceComparisonTest, JsonRepresentationsAreCompared) {
+    json::Json resource = json::Json::object();
+    resource["status"] = json::Json::object();
+    resource["status"]["state"] = "Enabled";
+    resource["name"] = "name";
+
+    json::Json other_status = resource;
+    other_status["status"]["state"] = "Absent";
+    json::Json other_name = resource;
+    other_name["name"] = "other";
+    json::Json more_attributes = resource;
+    more_attributes["description"] = nullptr;
+    json::Json without_status = resource;
+    without_status.erase("status");
+
+    EXPECT_EQ(Difference::None, compare_json(resource, resource));
+    EXPECT_EQ(Difference::Status, compare_json(resource, other_status));
+    EXPECT_EQ(Difference::Attributes, compare_json(resource, other_name));
+    EXPECT_EQ(Difference::Attributes, compare_json(resource, more_attributes));
+    EXPECT_EQ(Difference::Attributes, compare_json(more_attributes, resource));
+    EXPECT_EQ(Difference::Status, compare_json(resource, without_status));
+    EXPECT_EQ(Difference::None, compare_json(json::Json("data"), json::Json("data")));
+    EXPECT_EQ(Difference::Attributes, compare_json(json::Json("data"), json::Json("other")));
+}
@@ -60,6 +60,12 @@ public:
         OUTDATED //!< File has sticky bit cleared and status was changed before interval
     };
 
+    /*! @brief Storage used by created databases */
+    enum class Backend {
+        FILE, //!< Each entry is kept in a separate file
+        LOG   //!< All entries are kept in a single append-only log file
+    };
+
     /*!
      * @brief Set default resource "location" for the database
      *
@@ -70,10 +76,27 @@ public:
      */
     static void set_default_location(const std::string& location);
 
+    /*!
+     * @brief Set storage backend for databases created later on
+     *
+     * All databases in the location should be created with the same backend,
+     * otherwise retention policy doesn't see all entries.
+     *
+     * @param backend backend to be used.
+     */
+    static void set_default_backend(Backend backend);
+
+    /*!
+     * @brief Set storage backend by its configuration name
+     * @param backend "file" or "log"
+     * @return true if backend name is known and backend was set
+     */
+    static bool set_default_backend(const std::string& backend);
+
     /*!
      * @brief database factory method
      *
-     * Creates database. Appropriate type is created, based on location.
+     * Creates database. Appropriate type is created, based on default backend.
      * All databases are kept and tracked statically by the name.
      * (It is allowed to have only one database under the name created)
      * All databases with name starting with '*' are related to all data
@@ -260,6 +283,9 @@ private:
 
     /*! @brief Default path to the databases. */
     static std::string default_location;
+
+    /*! @brief Backend of created databases. */
+    static Backend default_backend;
 };
 
 /*!
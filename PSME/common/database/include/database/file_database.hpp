@@ -33,6 +33,7 @@ namespace database {
 class FileDatabase : public Database {
 
     friend class DatabaseTester;
+    friend class LogDatabase;
 
 public:
     /*!
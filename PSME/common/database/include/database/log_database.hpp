@@ -0,0 +1,128 @@
+/*!
+ * @brief Database implementation
+ *
+ * All database entries (of all databases in the location) are kept in a single,
+ * append-only log file. Each change is appended as a checksummed record, current
+ * state of the entries is kept in an in-memory index which is rebuilt from the log
+ * when the location is opened.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file log_database.hpp
+ */
+
+#pragma once
+
+#include <functional>
+
+#include "database/database.hpp"
+
+namespace database {
+
+/*! @brief Log file with the index, shared by all databases in the same location */
+class LogStore;
+
+/*!
+ * @brief Database storing key/value pairs in a single append-only log file.
+ *
+ * Entries are named in the same way as in the FileDatabase ("database.key"), so
+ * databases with empty name (i.e. "*retention") handle entries of all databases
+ * kept in the location. Validity of the entries and time of their last change
+ * are stored in the log, so retention policy works in the same way as for files.
+ */
+class LogDatabase : public Database {
+
+    friend class DatabaseTester;
+
+public:
+    /*! @brief Name of the log file in the database location */
+    static const std::string FILE_NAME;
+
+    /*!
+     * @brief Create "log file" database
+     * @param name Name of the database
+     * @param with_policy if retention policy attributes should be set for all entries
+     * @param location directory where the log file is kept
+     */
+    LogDatabase(const std::string& name, bool with_policy, const std::string& location);
+
+    virtual ~LogDatabase();
+
+    bool start() override;
+    bool next(Serializable& key, Serializable& value) override;
+    void end() override;
+
+    bool get(const Serializable& key, Serializable& value) override;
+    bool put(const Serializable& key, const Serializable& value) override;
+    bool remove(const Serializable& key) override;
+
+    EntityValidity get_validity(const Serializable& key, std::chrono::seconds interval = NEVER) override;
+    bool invalidate(const Serializable& key) override;
+
+    unsigned cleanup(Serializable& key, std::chrono::seconds interval = NEVER) override;
+    unsigned wipe_outdated(Serializable& key, std::chrono::seconds interval) override;
+    unsigned drop(Serializable& key) override;
+
+private:
+    LogDatabase& operator=(const LogDatabase&) = delete;
+    LogDatabase(const LogDatabase&) = delete;
+    LogDatabase() = delete;
+
+    /*! @brief Database entries handled by retention policy */
+    bool m_with_policy{};
+
+    /*! @brief Log file shared with other databases in the location */
+    std::shared_ptr<LogStore> m_store;
+
+    /*! @brief Function to be called on each found name */
+    using ForeachFunction = std::function<bool(const std::string& stripped_name)>;
+
+    /*!
+     * @brief Iterate over all entries of the database
+     * @param key to iterate over
+     * @param function to be executed on each matching name, store is locked
+     * @return number of entries the function returned true for
+     */
+    unsigned foreach(Serializable& key, ForeachFunction function);
+
+    /*!
+     * @brief Return entry name in the log for given (serialized) key
+     * @param stripped_name Deserialized key
+     * @return full name of the entry or empty string if key is not allowed
+     */
+    std::string full_name(const std::string& stripped_name) const;
+
+    /*!
+     * @brief Strip db name from the entry name
+     * @param entry_name entry name from the log
+     * @return stripped name or empty string if entry belongs to other database
+     */
+    std::string strip_name(const std::string& entry_name) const;
+
+    /*! @brief Current state of iterating process */
+    enum class IteratingState {
+        NOT_STARTED, //!< Iterating not in progress
+        STARTED, //!< Iterating was just started, but no next() was called
+        ITERATE, //!< Iterating
+        NO_MORE_DATA //!< No more data was found
+    };
+    IteratingState m_iterating_state{IteratingState::NOT_STARTED};
+
+    /*! @brief List of found names to be used during iterating */
+    using IteratedNames = std::vector<std::string>;
+    IteratedNames m_iterated_names{};
+    /*! Iterator to current name */
+    IteratedNames::iterator m_current_name{};
+};
+
+} // @i{database}
@@ -17,6 +17,7 @@
  */
 
 #include "database/file_database.hpp"
+#include "database/log_database.hpp"
 
 #include "generic/assertions.hpp"
 #include "logger/logger.hpp"
@@ -34,10 +35,31 @@ const std::string Database::EMPTY{""};
 
 std::string Database::default_location = "/var/opt/psme";
 
+Database::Backend Database::default_backend = Database::Backend::FILE;
+
 void Database::set_default_location(const std::string& location) {
     default_location = location;
 }
 
+void Database::set_default_backend(Backend backend) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    default_backend = backend;
+}
+
+bool Database::set_default_backend(const std::string& backend) {
+    if ("file" == backend) {
+        set_default_backend(Backend::FILE);
+    }
+    else if ("log" == backend) {
+        set_default_backend(Backend::LOG);
+    }
+    else {
+        log_error("db", "Unknown database backend " << backend);
+        return false;
+    }
+    return true;
+}
+
 Database::SPtr Database::create(const std::string& name, bool with_policy, const std::string& location) {
     std::lock_guard<std::recursive_mutex> lock(mutex);
 
@@ -50,9 +72,19 @@ Database::SPtr Database::create(const std::string& name, bool with_policy, const
         }
     }
 
-    /* proper database type is to be created here.. Currently only FileDatabase is handled */
+    /* proper database type is to be created here */
     const std::string n = (name.substr(0, 1) == "*") ? "" : name;
-    SPtr added{new FileDatabase(n, with_policy, location.empty() ? default_location : location)};
+    const std::string& path = location.empty() ? default_location : location;
+    SPtr added{};
+    switch (default_backend) {
+        case Backend::LOG:
+            added.reset(new LogDatabase(n, with_policy, path));
+            break;
+        case Backend::FILE:
+        default:
+            added.reset(new FileDatabase(n, with_policy, path));
+            break;
+    }
 
     databases.push_back(added);
     return added;
@@ -0,0 +1,697 @@
+/*!
+ * @brief Log file database implementation
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file log_database.cpp
+ */
+
+#include "database/log_database.hpp"
+#include "database/file_database.hpp"
+
+#include "crc/crc32.hpp"
+
+#include "generic/assertions.hpp"
+#include "logger/logger.hpp"
+#include "logger/logger_factory.hpp"
+
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <mutex>
+
+extern "C" {
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+
+using namespace generic;
+using namespace database;
+
+namespace {
+
+/*!
+ * Record layout (host byte order):
+ *   magic (4), crc32 (4), type (1), flags (1), reserved (2),
+ *   name length (4), value length (4), time of change (8), name, value.
+ * Checksum covers everything behind the checksum field.
+ */
+constexpr std::uint32_t RECORD_MAGIC = 0x42445350; // "PSDB"
+constexpr std::size_t CRC_OFFSET = 4;
+constexpr std::size_t CHECKED_OFFSET = 8;
+constexpr std::size_t HEADER_SIZE = 28;
+
+/*! @brief Record types */
+constexpr std::uint8_t RECORD_STORE = 1;
+constexpr std::uint8_t RECORD_ERASE = 2;
+
+/*! @brief Record flags */
+constexpr std::uint8_t FLAG_VALID = 0x01;
+constexpr std::uint8_t FLAG_POLICY = 0x02;
+
+/*! @brief Maximal length of the entry name, longer records are treated as damaged */
+constexpr std::uint32_t NAME_LENGTH = 4096;
+
+/*! @brief Maximal value size, same as for the FileDatabase */
+constexpr std::uint32_t VALUE_LENGTH = 65536;
+
+/*! @brief Log is not compacted until it reaches this size */
+constexpr std::uint64_t COMPACTION_MIN_SIZE = 1024 * 1024;
+
+template <typename T>
+void put_field(std::string& buffer, T field) {
+    buffer.append(reinterpret_cast<const char*>(&field), sizeof(field));
+}
+
+template <typename T>
+T get_field(const std::string& buffer, std::size_t offset) {
+    T field{};
+    std::memcpy(&field, buffer.data() + offset, sizeof(field));
+    return field;
+}
+
+std::uint32_t checksum(const char* data, std::size_t size) {
+    return crc::Crc32(reinterpret_cast<const std::uint8_t*>(data), size);
+}
+
+bool write_all(int fd, const std::string& data) {
+    std::size_t written = 0;
+    while (written < data.size()) {
+        errno = 0;
+        const ssize_t bytes = ::write(fd, data.data() + written, data.size() - written);
+        if (bytes < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<std::size_t>(bytes);
+    }
+    return true;
+}
+
+std::int64_t now() {
+    return static_cast<std::int64_t>(time(nullptr));
+}
+
+}
+
+namespace database {
+
+class LogStore final {
+public:
+    /*! @brief Current state of an entry */
+    struct Entry {
+        std::string value{};
+        bool valid{};
+        bool with_policy{};
+        std::int64_t changed{};
+    };
+
+    /*! @brief Entries by their full names, ordered to iterate in a stable order */
+    using Entries = std::map<std::string, Entry>;
+
+    /*!
+     * @brief Get log store for the location, store is opened if not used yet
+     * @param path Checked directory of the database
+     * @return log store
+     */
+    static std::shared_ptr<LogStore> open(const std::string& path) {
+        std::lock_guard<std::mutex> lock(stores_mutex);
+        auto store = stores[path].lock();
+        if (!store) {
+            store = std::make_shared<LogStore>(path + "/" + LogDatabase::FILE_NAME);
+            stores[path] = store;
+        }
+        return store;
+    }
+
+    explicit LogStore(const std::string& file_name) : m_file_name(file_name) {
+        replay();
+        if (needs_compaction()) {
+            compact();
+        }
+    }
+
+    ~LogStore() {
+        close_file();
+    }
+
+    /*! @brief Lock the store, lock might be taken multiple times by the thread */
+    std::unique_lock<std::recursive_mutex> lock() {
+        return std::unique_lock<std::recursive_mutex>(m_mutex);
+    }
+
+    const Entries& get_entries() const {
+        return m_entries;
+    }
+
+    const Entry* find(const std::string& name) const {
+        const auto it = m_entries.find(name);
+        return (m_entries.cend() != it) ? &it->second : nullptr;
+    }
+
+    /*!
+     * @brief Append new state of the entry to the log
+     * @param name Full entry name
+     * @param entry Entry state
+     * @return true if entry was stored
+     */
+    bool store(const std::string& name, Entry&& entry) {
+        const std::string record = encode(RECORD_STORE, name, entry);
+        if (!append(record)) {
+            return false;
+        }
+        const auto it = m_entries.find(name);
+        if (m_entries.end() != it) {
+            m_live_size -= record_size(name, it->second);
+            it->second = std::move(entry);
+        }
+        else {
+            m_entries.emplace(name, std::move(entry));
+        }
+        m_live_size += record.size();
+        compact_if_needed();
+        return true;
+    }
+
+    /*!
+     * @brief Append removal of the entry to the log
+     * @param name Full entry name
+     * @return true if entry was removed
+     */
+    bool erase(const std::string& name) {
+        const auto it = m_entries.find(name);
+        if (m_entries.end() == it) {
+            return false;
+        }
+        if (!append(encode(RECORD_ERASE, name, Entry{}))) {
+            return false;
+        }
+        m_live_size -= record_size(name, it->second);
+        m_entries.erase(it);
+        compact_if_needed();
+        return true;
+    }
+
+private:
+    LogStore(const LogStore&) = delete;
+    LogStore& operator=(const LogStore&) = delete;
+
+    static std::uint64_t record_size(const std::string& name, const Entry& entry) {
+        return HEADER_SIZE + name.size() + entry.value.size();
+    }
+
+    static std::string encode(std::uint8_t type, const std::string& name, const Entry& entry) {
+        std::string record{};
+        record.reserve(HEADER_SIZE + name.size() + entry.value.size());
+        put_field(record, RECORD_MAGIC);
+        put_field(record, std::uint32_t{0});
+        put_field(record, type);
+        put_field(record, static_cast<std::uint8_t>((entry.valid ? FLAG_VALID : 0) | (entry.with_policy ? FLAG_POLICY : 0)));
+        put_field(record, std::uint16_t{0});
+        put_field(record, static_cast<std::uint32_t>(name.size()));
+        put_field(record, static_cast<std::uint32_t>(entry.value.size()));
+        put_field(record, entry.changed);
+        record.append(name);
+        record.append(entry.value);
+
+        const std::uint32_t crc = checksum(record.data() + CHECKED_OFFSET, record.size() - CHECKED_OFFSET);
+        std::memcpy(&record[CRC_OFFSET], &crc, sizeof(crc));
+        return record;
+    }
+
+    /*!
+     * @brief Rebuild index from the log
+     *
+     * Records are applied up to the first damaged one. Log is truncated there,
+     * damaged tail is an effect of a write interrupted by a crash.
+     */
+    void replay() {
+        errno = 0;
+        m_fd = ::open(m_file_name.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (m_fd < 0) {
+            log_error("db", "Cannot open database log " << m_file_name << ":: " << strerror(errno));
+            assert(FAIL("Cannot open database log"));
+            return;
+        }
+
+        std::string data{};
+        char buffer[VALUE_LENGTH];
+        while (true) {
+            errno = 0;
+            const ssize_t bytes = ::read(m_fd, buffer, sizeof(buffer));
+            if (bytes < 0 && EINTR == errno) {
+                continue;
+            }
+            if (bytes < 0) {
+                log_error("db", "Cannot read database log " << m_file_name << ":: " << strerror(errno));
+                close_file();
+                return;
+            }
+            if (0 == bytes) {
+                break;
+            }
+            data.append(buffer, static_cast<std::size_t>(bytes));
+        }
+
+        std::size_t offset = 0;
+        while (offset + HEADER_SIZE <= data.size()) {
+            if (RECORD_MAGIC != get_field<std::uint32_t>(data, offset)) {
+                break;
+            }
+            const auto type = get_field<std::uint8_t>(data, offset + 8);
+            const auto flags = get_field<std::uint8_t>(data, offset + 9);
+            const auto name_length = get_field<std::uint32_t>(data, offset + 12);
+            const auto value_length = get_field<std::uint32_t>(data, offset + 16);
+            if ((0 == name_length) || (name_length > NAME_LENGTH) || (value_length >= VALUE_LENGTH)) {
+                break;
+            }
+            const std::size_t size = HEADER_SIZE + name_length + value_length;
+            if (offset + size > data.size()) {
+                break;
+            }
+            if (get_field<std::uint32_t>(data, offset + CRC_OFFSET) !=
+                checksum(data.data() + offset + CHECKED_OFFSET, size - CHECKED_OFFSET)) {
+                break;
+            }
+
+            std::string name = data.substr(offset + HEADER_SIZE, name_length);
+            if (RECORD_STORE == type) {
+                Entry& entry = m_entries[name];
+                entry.value = data.substr(offset + HEADER_SIZE + name_length, value_length);
+                entry.valid = (FLAG_VALID == (flags & FLAG_VALID));
+                entry.with_policy = (FLAG_POLICY == (flags & FLAG_POLICY));
+                entry.changed = get_field<std::int64_t>(data, offset + 20);
+            }
+            else if (RECORD_ERASE == type) {
+                m_entries.erase(name);
+            }
+            else {
+                break;
+            }
+            offset += size;
+        }
+
+        if (offset != data.size()) {
+            log_warning("db", "Damaged record in database log " << m_file_name << ", "
+                              << (data.size() - offset) << " bytes dropped");
+            if (0 != ::ftruncate(m_fd, static_cast<off_t>(offset))) {
+                log_error("db", "Cannot truncate database log " << m_file_name << ":: " << strerror(errno));
+            }
+        }
+        m_file_size = offset;
+
+        m_live_size = 0;
+        for (const auto& entry : m_entries) {
+            m_live_size += record_size(entry.first, entry.second);
+        }
+    }
+
+    /*!
+     * @brief Append record to the log, record is synced to the disk
+     * @param record Encoded record
+     * @return true if record is stored
+     */
+    bool append(const std::string& record) {
+        if (m_fd < 0) {
+            log_error("db", "Database log " << m_file_name << " not opened");
+            return false;
+        }
+        if (!write_all(m_fd, record) || (0 != ::fdatasync(m_fd))) {
+            log_error("db", "Cannot write database log " << m_file_name << ":: " << strerror(errno));
+            /* don't leave partial record, all records behind it would be lost on replay */
+            if (0 != ::ftruncate(m_fd, static_cast<off_t>(m_file_size))) {
+                log_error("db", "Cannot truncate database log " << m_file_name << ":: " << strerror(errno));
+            }
+            return false;
+        }
+        m_file_size += record.size();
+        return true;
+    }
+
+    bool needs_compaction() const {
+        return (m_fd >= 0) && (m_file_size > COMPACTION_MIN_SIZE) && (m_file_size > 2 * m_live_size);
+    }
+
+    void compact_if_needed() {
+        if (needs_compaction()) {
+            compact();
+        }
+    }
+
+    /*!
+     * @brief Replace the log with the one containing current state of entries only
+     *
+     * New log is written aside and renamed over the old one, so any crash leaves
+     * either the old or the new log.
+     */
+    void compact() {
+        const std::string compacted_name = m_file_name + ".compact";
+        std::string data{};
+        data.reserve(m_live_size);
+        for (const auto& entry : m_entries) {
+            data.append(encode(RECORD_STORE, entry.first, entry.second));
+        }
+
+        errno = 0;
+        int fd = ::open(compacted_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            log_error("db", "Cannot create " << compacted_name << ":: " << strerror(errno));
+            return;
+        }
+        if (!write_all(fd, data) || (0 != ::fdatasync(fd))) {
+            log_error("db", "Cannot write " << compacted_name << ":: " << strerror(errno));
+            ::close(fd);
+            ::unlink(compacted_name.c_str());
+            return;
+        }
+        ::close(fd);
+
+        if (0 != ::rename(compacted_name.c_str(), m_file_name.c_str())) {
+            log_error("db", "Cannot replace " << m_file_name << ":: " << strerror(errno));
+            ::unlink(compacted_name.c_str());
+            return;
+        }
+        sync_directory();
+
+        close_file();
+        m_fd = ::open(m_file_name.c_str(), O_RDWR | O_APPEND | O_CLOEXEC);
+        if (m_fd < 0) {
+            log_error("db", "Cannot reopen database log " << m_file_name << ":: " << strerror(errno));
+            return;
+        }
+        log_debug("db", "Database log " << m_file_name << " compacted from " << m_file_size
+                        << " to " << data.size() << " bytes");
+        m_file_size = data.size();
+    }
+
+    void sync_directory() const {
+        const std::string directory = m_file_name.substr(0, m_file_name.rfind('/'));
+        int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+    }
+
+    void close_file() {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    std::string m_file_name;
+    int m_fd{-1};
+    Entries m_entries{};
+    /*! @brief Size of all records in the log */
+    std::uint64_t m_file_size{0};
+    /*! @brief Size of records describing current state of the entries */
+    std::uint64_t m_live_size{0};
+    std::recursive_mutex m_mutex{};
+
+    static std::mutex stores_mutex;
+    static std::map<std::string, std::weak_ptr<LogStore>> stores;
+};
+
+std::mutex LogStore::stores_mutex{};
+
+std::map<std::string, std::weak_ptr<LogStore>> LogStore::stores{};
+
+}
+
+namespace {
+
+Database::EntityValidity entry_validity(const LogStore::Entry* entry, std::chrono::seconds interval,
+                                        bool with_policy) {
+    if (nullptr == entry) {
+        return Database::EntityValidity::ERROR;
+    }
+
+    /* entries stored by databases without retention policy are not touched by policed ones */
+    if (with_policy && !entry->with_policy) {
+        return Database::EntityValidity::NOENTRY;
+    }
+
+    if (entry->valid) {
+        return Database::EntityValidity::VALID;
+    }
+
+    if (now() - entry->changed >= interval.count()) {
+        return Database::EntityValidity::OUTDATED;
+    }
+    return Database::EntityValidity::INVALID;
+}
+
+bool invalidate_entry(LogStore& store, const std::string& name) {
+    const auto* entry = store.find(name);
+    if ((nullptr == entry) || !entry->valid) {
+        return false;
+    }
+    LogStore::Entry invalid{*entry};
+    invalid.valid = false;
+    invalid.changed = now();
+    return store.store(name, std::move(invalid));
+}
+
+}
+
+const std::string LogDatabase::FILE_NAME{"database.log"};
+
+LogDatabase::LogDatabase(const std::string& _name, bool with_policy, const std::string& location) :
+    Database(_name), m_with_policy(with_policy),
+    m_store(LogStore::open(FileDatabase::check_directory(location))) { }
+
+LogDatabase::~LogDatabase() {
+    if (m_iterating_state != IteratingState::NOT_STARTED) {
+        LogDatabase::end();
+    }
+}
+
+bool LogDatabase::start() {
+    auto lock = m_store->lock();
+
+    if (m_iterating_state != IteratingState::NOT_STARTED) {
+        log_error("db", "Iterating in progress");
+        assert(FAIL("In progress"));
+        return false;
+    }
+    m_iterating_state = IteratingState::STARTED;
+    return true;
+}
+
+bool LogDatabase::next(Serializable& key, Serializable& value) {
+    auto lock = m_store->lock();
+
+    switch (m_iterating_state) {
+        case IteratingState::NOT_STARTED:
+            log_error("db", "Iterating not started");
+            assert(FAIL("Not iterating"));
+            return false;
+        case IteratingState::STARTED:
+            m_iterated_names.clear();
+            foreach(key, [this](const std::string& stripped_name) -> bool {
+                m_iterated_names.push_back(stripped_name);
+                return true;
+            });
+            m_current_name = m_iterated_names.begin();
+            m_iterating_state = IteratingState::ITERATE;
+            break;
+        case IteratingState::ITERATE:
+            break;
+        case IteratingState::NO_MORE_DATA:
+            return false;
+        default:
+            assert(FAIL("Unreachable code"));
+            return false;
+    }
+
+    while (m_iterated_names.end() != m_current_name) {
+        const std::string& stripped_name = *m_current_name;
+        m_current_name++;
+
+        /* entry might be removed in the meantime */
+        const auto* entry = m_store->find(full_name(stripped_name));
+        if (nullptr == entry) {
+            continue;
+        }
+
+        key.unserialize(stripped_name);
+        if (!value.unserialize(entry->value)) {
+            log_error("db", "Incorrect data for " << stripped_name << ":: " << entry->value);
+            continue;
+        }
+        return true;
+    }
+    m_iterating_state = IteratingState::NO_MORE_DATA;
+    return false;
+}
+
+void LogDatabase::end() {
+    auto lock = m_store->lock();
+
+    switch (m_iterating_state) {
+        case IteratingState::NOT_STARTED:
+            log_error("db", "Not iterating");
+            assert(FAIL("Not iterating"));
+            return;
+        case IteratingState::STARTED:
+            log_error("db", "Iterating started but not proceeded");
+            assert(FAIL("Not iterating"));
+            break;
+        case IteratingState::ITERATE:
+            log_warning("db", "Not all entries were checked while iterating");
+            break;
+        case IteratingState::NO_MORE_DATA:
+            break;
+
+        default:
+            assert(FAIL("Unreachable code"));
+            return;
+    }
+    m_iterating_state = IteratingState::NOT_STARTED;
+}
+
+bool LogDatabase::get(const Serializable& key, Serializable& value) {
+    auto lock = m_store->lock();
+    const auto* entry = m_store->find(full_name(key.serialize()));
+    if (nullptr == entry) {
+        return false;
+    }
+    return value.unserialize(entry->value);
+}
+
+bool LogDatabase::put(const Serializable& key, const Serializable& value) {
+    const std::string entry_name = full_name(key.serialize());
+    if (entry_name.empty()) {
+        log_error("db", "Incorrect key given");
+        return false;
+    }
+    LogStore::Entry entry{value.serialize(), true, m_with_policy, now()};
+    if (entry.value.size() >= VALUE_LENGTH) {
+        log_error("db", "Value for " << entry_name << " is longer than allowed");
+        return false;
+    }
+
+    auto lock = m_store->lock();
+    return m_store->store(entry_name, std::move(entry));
+}
+
+bool LogDatabase::remove(const Serializable& key) {
+    auto lock = m_store->lock();
+    return m_store->erase(full_name(key.serialize()));
+}
+
+bool LogDatabase::invalidate(const Serializable& key) {
+    auto lock = m_store->lock();
+    return invalidate_entry(*m_store, full_name(key.serialize()));
+}
+
+Database::EntityValidity LogDatabase::get_validity(const Serializable& key, std::chrono::seconds interval) {
+    auto lock = m_store->lock();
+    return entry_validity(m_store->find(full_name(key.serialize())), interval, m_with_policy);
+}
+
+unsigned LogDatabase::cleanup(Serializable& key, std::chrono::seconds interval) {
+    return foreach(key, [this, interval](const std::string& stripped_name) -> bool {
+        const std::string entry_name = full_name(stripped_name);
+        switch (entry_validity(m_store->find(entry_name), interval, m_with_policy)) {
+            case EntityValidity::ERROR:
+            case EntityValidity::NOENTRY:
+            case EntityValidity::INVALID:
+                return false;
+            case EntityValidity::VALID:
+                return invalidate_entry(*m_store, entry_name);
+            case EntityValidity::OUTDATED:
+                return m_store->erase(entry_name);
+            default:
+                assert(FAIL("Unreachable code"));
+                return false;
+        }
+    });
+}
+
+unsigned LogDatabase::wipe_outdated(Serializable& key, std::chrono::seconds interval) {
+    return foreach(key, [this, interval](const std::string& stripped_name) -> bool {
+        const std::string entry_name = full_name(stripped_name);
+        switch (entry_validity(m_store->find(entry_name), interval, m_with_policy)) {
+            case EntityValidity::ERROR:
+            case EntityValidity::NOENTRY:
+            case EntityValidity::VALID:
+            case EntityValidity::INVALID:
+                return false;
+            case EntityValidity::OUTDATED:
+                return m_store->erase(entry_name);
+            default:
+                assert(FAIL("Unreachable code"));
+                return false;
+        }
+    });
+}
+
+unsigned LogDatabase::drop(Serializable& key) {
+    return foreach(key, [this](const std::string& stripped_name) -> bool {
+        return m_store->erase(full_name(stripped_name));
+    });
+}
+
+unsigned LogDatabase::foreach(Serializable& key, ForeachFunction function) {
+    auto lock = m_store->lock();
+
+    /* appoint all names to be processed, function might remove entries */
+    IteratedNames names{};
+    for (const auto& entry : m_store->get_entries()) {
+        std::string stripped_name = strip_name(entry.first);
+        if (stripped_name.empty() || !key.unserialize(stripped_name)) {
+            continue;
+        }
+        names.push_back(std::move(stripped_name));
+    }
+
+    unsigned num = 0;
+    for (const auto& stripped_name : names) {
+        if (function(stripped_name)) {
+            num++;
+        }
+    }
+    return num;
+}
+
+std::string LogDatabase::full_name(const std::string& stripped_name) const {
+    if (stripped_name.empty()) {
+        return EMPTY;
+    }
+    /* same keys as for the FileDatabase are allowed, databases might be switched */
+    if (stripped_name.find_first_of("/:") != std::string::npos) {
+        return EMPTY;
+    }
+    if (get_name().empty()) {
+        return stripped_name;
+    }
+    return get_name() + "." + stripped_name;
+}
+
+std::string LogDatabase::strip_name(const std::string& entry_name) const {
+    if (get_name().empty()) {
+        return entry_name;
+    }
+    if ((entry_name.size() <= get_name().size() + 1) ||
+        (entry_name.compare(0, get_name().size(), get_name()) != 0) ||
+        (entry_name[get_name().size()] != '.')) {
+        return EMPTY;
+    }
+    return entry_name.substr(get_name().size() + 1);
+}
@@ -0,0 +1,271 @@
+/*!
+ * @brief Log file database test
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file log_database_test.cpp
+ */
+
+#include "database/log_database.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace database;
+
+namespace {
+
+/*! @brief Database removed from the pool when goes out of scope */
+class ScopedDatabase final {
+public:
+    ScopedDatabase(const std::string& name, const std::string& location, bool with_policy = true) :
+        m_db{Database::create(name, with_policy, location)} { }
+
+    ~ScopedDatabase() {
+        m_db->remove();
+    }
+
+    Database* operator->() {
+        return m_db.get();
+    }
+
+private:
+    Database::SPtr m_db;
+};
+
+}
+
+class LogDatabaseTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char directory[] = "/tmp/log_database_XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(directory)) << strerror(errno);
+        m_location = directory;
+        Database::set_default_backend(Database::Backend::LOG);
+    }
+
+    void TearDown() override {
+        Database::set_default_backend(Database::Backend::FILE);
+        ::unlink(get_file().c_str());
+        ::rmdir(m_location.c_str());
+    }
+
+    std::string get_file() const {
+        return m_location + "/" + LogDatabase::FILE_NAME;
+    }
+
+    off_t get_file_size() const {
+        struct stat stats{};
+        return (0 == stat(get_file().c_str(), &stats)) ? stats.st_size : -1;
+    }
+
+    std::string m_location{};
+};
+
+TEST_F(LogDatabaseTest, BackendIsSelectedByName) {
+    ASSERT_TRUE(Database::set_default_backend("log"));
+    {
+        ScopedDatabase db{"backend", m_location};
+        EXPECT_NE(nullptr, dynamic_cast<LogDatabase*>(db.operator->()));
+    }
+    ASSERT_FALSE(Database::set_default_backend("sql"));
+    ASSERT_TRUE(Database::set_default_backend("file"));
+}
+
+TEST_F(LogDatabaseTest, PutEntity) {
+    ScopedDatabase db{"simple_key", m_location};
+
+    String key{"1"};
+    String value{"2"};
+    String read{};
+
+    ASSERT_TRUE(db->put(key, value));
+    ASSERT_TRUE(db->get(key, read));
+    ASSERT_EQ("2", read.get());
+
+    ASSERT_TRUE(db->put(key, String{"3"}));
+    ASSERT_TRUE(db->get(key, read));
+    ASSERT_EQ("3", read.get());
+
+    ASSERT_FALSE(db->put(String{"wrong/key"}, value)) << "Keys have to be valid for both backends";
+
+    ASSERT_TRUE(db->remove(key));
+    ASSERT_FALSE(db->get(key, read)) << "Removed entity still exists";
+    ASSERT_FALSE(db->remove(key)) << "Entity removed twice";
+}
+
+TEST_F(LogDatabaseTest, Iterate) {
+    ScopedDatabase db{"db", m_location};
+    ScopedDatabase other{"other", m_location};
+
+    String key{"first_key"};
+    String value{"0"};
+    String tkey{};
+    String tval{};
+
+    ASSERT_TRUE(db->put(key, value));
+    ASSERT_TRUE(other->put(key, String{"other"}));
+    ASSERT_TRUE(db->start());
+
+    /* exactly one key is in the database */
+    ASSERT_TRUE(db->next(tkey, tval));
+    ASSERT_EQ("first_key", tkey.get());
+    ASSERT_EQ("0", tval.get());
+
+    /* keys added while iterating are not reported */
+    ASSERT_TRUE(db->put(String{"second_key"}, value));
+    ASSERT_FALSE(db->next(tkey, tval));
+    db->end();
+
+    AlwaysMatchKey all{};
+    ASSERT_EQ(2, db->drop(all));
+    ASSERT_TRUE(other->get(key, tval)) << "Entry of other database dropped";
+}
+
+TEST_F(LogDatabaseTest, NonRetentionPolicy) {
+    ScopedDatabase persistent{"persistent", m_location, false};
+
+    String key{"KEY"};
+    String value{"test value"};
+    ASSERT_TRUE(persistent->put(key, value));
+    ASSERT_EQ(Database::EntityValidity::VALID, persistent->get_validity(key, std::chrono::seconds(0)));
+
+    ASSERT_TRUE(persistent->invalidate(key));
+    ASSERT_EQ(Database::EntityValidity::INVALID, persistent->get_validity(key, std::chrono::seconds(1)));
+    ASSERT_EQ(Database::EntityValidity::OUTDATED, persistent->get_validity(key, std::chrono::seconds(0)));
+    ASSERT_EQ(Database::EntityValidity::INVALID, persistent->get_validity(key));
+    ASSERT_EQ(Database::EntityValidity::ERROR, persistent->get_validity(String{"none"}));
+
+    ASSERT_FALSE(persistent->invalidate(key)) << "entry already invalid";
+    ASSERT_TRUE(persistent->get(key, value)) << "invalid entry removed";
+
+    ScopedDatabase retention{"*retention", m_location};
+    AlwaysMatchKey all{};
+    ASSERT_EQ(Database::EntityValidity::NOENTRY, retention->get_validity(String{"persistent.KEY"}));
+    ASSERT_EQ(0, retention->cleanup(all, std::chrono::seconds(0)));
+    ASSERT_EQ(0, retention->wipe_outdated(all, std::chrono::seconds(0)));
+
+    ASSERT_TRUE(persistent->get(key, value)) << "non-policed entry removed";
+    ASSERT_EQ(1, persistent->drop(key));
+}
+
+TEST_F(LogDatabaseTest, RetentionPolicy) {
+    ScopedDatabase persistent{"persistent", m_location};
+
+    String key{"KEY"};
+    String value{"test value"};
+    ASSERT_TRUE(persistent->put(key, value));
+
+    ScopedDatabase retention{"*retention", m_location};
+    AlwaysMatchKey all{};
+    ASSERT_EQ(1, retention->cleanup(all, std::chrono::seconds(10))) << "entry not invalidated";
+    ASSERT_EQ(0, retention->cleanup(all, std::chrono::seconds(10))) << "just invalidated entry cleaned up";
+    ASSERT_EQ(1, retention->wipe_outdated(all, std::chrono::seconds(0))) << "outdated entry not wiped";
+
+    ASSERT_FALSE(persistent->get(key, value)) << "outdated entry not removed";
+}
+
+TEST_F(LogDatabaseTest, EntriesAreReplayed) {
+    {
+        ScopedDatabase db{"replay", m_location};
+        ASSERT_TRUE(db->put(String{"valid"}, String{"1"}));
+        ASSERT_TRUE(db->put(String{"invalid"}, String{"2"}));
+        ASSERT_TRUE(db->put(String{"removed"}, String{"3"}));
+        ASSERT_TRUE(db->put(String{"valid"}, String{"4"}));
+        ASSERT_TRUE(db->invalidate(String{"invalid"}));
+        ASSERT_TRUE(db->remove(String{"removed"}));
+    }
+
+    ScopedDatabase db{"replay", m_location};
+    String value{};
+    ASSERT_TRUE(db->get(String{"valid"}, value));
+    ASSERT_EQ("4", value.get());
+    ASSERT_EQ(Database::EntityValidity::VALID, db->get_validity(String{"valid"}));
+    ASSERT_TRUE(db->get(String{"invalid"}, value));
+    ASSERT_EQ("2", value.get());
+    ASSERT_EQ(Database::EntityValidity::INVALID, db->get_validity(String{"invalid"}, std::chrono::seconds(10)));
+    ASSERT_FALSE(db->get(String{"removed"}, value));
+}
+
+TEST_F(LogDatabaseTest, TornRecordIsDropped) {
+    off_t complete_size{};
+    {
+        ScopedDatabase db{"torn", m_location};
+        ASSERT_TRUE(db->put(String{"first"}, String{"1"}));
+        complete_size = get_file_size();
+        ASSERT_TRUE(db->put(String{"second"}, String{"2"}));
+    }
+
+    /* interrupted write of the last record */
+    ASSERT_EQ(0, truncate(get_file().c_str(), get_file_size() - 1));
+
+    {
+        ScopedDatabase db{"torn", m_location};
+        String value{};
+        ASSERT_TRUE(db->get(String{"first"}, value));
+        ASSERT_FALSE(db->get(String{"second"}, value));
+        ASSERT_EQ(complete_size, get_file_size()) << "damaged tail not truncated";
+
+        ASSERT_TRUE(db->put(String{"third"}, String{"3"}));
+    }
+
+    ScopedDatabase db{"torn", m_location};
+    String value{};
+    ASSERT_TRUE(db->get(String{"third"}, value)) << "record behind the damaged one lost";
+    ASSERT_EQ("3", value.get());
+}
+
+TEST_F(LogDatabaseTest, CorruptedRecordIsDropped) {
+    {
+        ScopedDatabase db{"corrupted", m_location};
+        ASSERT_TRUE(db->put(String{"first"}, String{"1"}));
+        ASSERT_TRUE(db->put(String{"second"}, String{"2"}));
+    }
+
+    /* flip the value of the last record */
+    int fd = open(get_file().c_str(), O_WRONLY);
+    ASSERT_LE(0, fd);
+    ASSERT_EQ(1, pwrite(fd, "X", 1, get_file_size() - 1));
+    close(fd);
+
+    ScopedDatabase db{"corrupted", m_location};
+    String value{};
+    ASSERT_TRUE(db->get(String{"first"}, value));
+    ASSERT_FALSE(db->get(String{"second"}, value)) << "record with wrong checksum applied";
+}
+
+TEST_F(LogDatabaseTest, LogIsCompacted) {
+    const std::string large(32 * 1024, 'x');
+    {
+        ScopedDatabase db{"compacted", m_location};
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(db->put(String{"key"}, String{large + std::to_string(i)}));
+        }
+        ASSERT_TRUE(db->put(String{"small"}, String{"value"}));
+        /* single entry is live, log would be larger than 3MB without compaction */
+        EXPECT_GT(2 * 1024 * 1024, get_file_size());
+    }
+
+    ScopedDatabase db{"compacted", m_location};
+    String value{};
+    ASSERT_TRUE(db->get(String{"key"}, value));
+    ASSERT_EQ(large + "99", value.get());
+    ASSERT_TRUE(db->get(String{"small"}, value));
+    ASSERT_EQ("value", value.get());
+}
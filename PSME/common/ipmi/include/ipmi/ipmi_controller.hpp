@@ -29,6 +29,9 @@
 #include "ipmi/connection_data.hpp"
 #include "ipmi/ipmi_interface.hpp"
 
+#include <exception>
+#include <vector>
+
 namespace testing {
 
 class IpmiInterface_Factory_Test;
@@ -44,6 +47,17 @@ class IpmiController {
 public:
     using Ptr = std::shared_ptr<IpmiController>;
 
+    /*!
+     * @brief Request and response of a batch
+     */
+    struct Exchange {
+        const Request& request;
+        Response& response;
+        /*! Set if the exchange failed, response is not valid then */
+        std::exception_ptr error;
+    };
+    using Exchanges = std::vector<Exchange>;
+
     IpmiController(ConnectionData::Ptr connection_data);
 
     IpmiController() = delete;
@@ -75,6 +89,17 @@ public:
      */
     virtual void send(const Request& request, Response& response);
 
+    /*!
+     * @brief Send all messages using the same bridge info.
+     *
+     * Requests are overlapped if the interface allows it, otherwise they are sent one by one
+     * without releasing the interface. Errors are reported for each exchange separately.
+     *
+     * @param[in,out] exchanges requests to be sent and responses to be filled in
+     * @param via information about bridges
+     */
+    virtual void send_batch(Exchanges& exchanges, const BridgeInfo& via);
+
     /*!
      * @brief Release IPMI interface used by the controller
      *
@@ -25,6 +25,7 @@
 #include "ipmi/bridge_info.hpp"
 
 #include <cstdint>
+#include <exception>
 #include <memory>
 #include <vector>
 
@@ -54,6 +55,20 @@ public:
     using Ptr = std::shared_ptr<IpmiInterface>;
     using ConstPtr = std::shared_ptr<const IpmiInterface>;
 
+    /*!
+     * @brief Message of a batch
+     */
+    struct BatchEntry {
+        NetFn netfn{};
+        Cmd command{};
+        Lun lun{};
+        ByteBuffer request{};
+        ByteBuffer response{};
+        /*! Set if the message failed, response is not valid then */
+        std::exception_ptr error{};
+    };
+    using Batch = std::vector<BatchEntry>;
+
 protected:
     IpmiInterface();
     virtual ~IpmiInterface();
@@ -107,6 +122,17 @@ protected:
      */
     virtual void unlock() = 0;
 
+    /*!
+     * @brief Sends all messages of the batch and waits for all responses
+     *
+     * Default implementation sends messages one by one under the lock. Interfaces able to keep
+     * several requests outstanding overlap them. Failed message doesn't stop the batch.
+     *
+     * @param bridge bridging information, same for all messages
+     * @param[in,out] batch messages to be sent, responses (or errors) are filled in
+     */
+    virtual void send_batch(const BridgeInfo& bridge, Batch& batch);
+
     /*!
      * @brief Check if IPMI interface matches given connection data
      * @param connection_data configuration to be checked.
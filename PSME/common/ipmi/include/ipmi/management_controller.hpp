@@ -41,7 +41,21 @@ public:
 
     ManagementController(const std::string& ip, std::uint32_t port, const std::string& username,
                          const std::string& password) :
-        ipmi::IpmiController(std::make_shared<ipmi::manager::ipmitool::LanConnectionData>()) {
+        ManagementController(ipmi::manager::ipmitool::LanConnectionData::INTF_TYPE, ip, port, username, password) {}
+
+
+    /*!
+     * @brief Constructor of the controller connected through given LAN interface
+     * @param interface_type "lan" for ipmitool, "lanplus" for the native RMCP+ transport
+     * @param ip IP address of the controller
+     * @param port UDP port number
+     * @param username user name
+     * @param password password
+     * @throws std::invalid_argument if the interface type is not a LAN interface
+     */
+    ManagementController(const std::string& interface_type, const std::string& ip, std::uint32_t port,
+                         const std::string& username, const std::string& password) :
+        ipmi::IpmiController(make_connection_data(interface_type)) {
 
         data_to_modify().set_ip(ip);
         data_to_modify().set_port(port);
@@ -136,6 +150,9 @@ public:
 
 
 private:
+    static ConnectionData::Ptr make_connection_data(const std::string& interface_type);
+
+
     const ipmi::manager::ipmitool::LanConnectionData& data() const {
         return dynamic_cast<const ipmi::manager::ipmitool::LanConnectionData&>(*ipmi::IpmiController::data());
     }
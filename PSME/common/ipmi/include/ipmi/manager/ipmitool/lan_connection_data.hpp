@@ -139,6 +139,10 @@ public:
 
     std::string get_info() const override;
 
+protected:
+    LanConnectionData(const std::string& _interface_type, const std::string& ip, std::uint32_t port,
+                      const std::string& username, const std::string& password);
+
 private:
     std::string m_ip{};
     std::uint32_t m_port{623};
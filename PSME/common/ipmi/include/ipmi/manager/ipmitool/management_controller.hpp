@@ -46,6 +46,11 @@ public:
         ipmi::ManagementController(ip, port, username, password) {}
 
 
+    ManagementController(const std::string& interface_type, const std::string& ip, std::uint32_t port,
+                         const std::string& username, const std::string& password) :
+        ipmi::ManagementController(interface_type, ip, port, username, password) {}
+
+
     ManagementController() = default;
 
 
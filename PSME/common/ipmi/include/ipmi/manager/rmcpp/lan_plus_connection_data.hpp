@@ -0,0 +1,93 @@
+/*!
+ * @brief "Lanplus" ManagementController configuration data.
+ *
+ * Connection data of the native RMCP+ session engine. Besides the "lan" settings it defines
+ * how many requests may be outstanding in the session and how lost requests are retried.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp/lan_plus_connection_data.hpp
+ */
+
+#pragma once
+
+#include "ipmi/manager/ipmitool/lan_connection_data.hpp"
+
+#include <chrono>
+
+namespace ipmi {
+namespace manager {
+namespace rmcpp {
+
+class LanPlusConnectionData : public ipmi::manager::ipmitool::LanConnectionData {
+public:
+    constexpr static const char* INTF_TYPE = "lanplus";
+
+    LanPlusConnectionData(const std::string& ip, std::uint32_t port, const std::string& username,
+                          const std::string& password);
+
+    LanPlusConnectionData();
+    LanPlusConnectionData(const LanPlusConnectionData&) = default;
+    LanPlusConnectionData(LanPlusConnectionData&&) = default;
+    virtual ~LanPlusConnectionData();
+
+    /*!
+     * @brief Set maximal number of requests sent to the BMC without waiting for their responses
+     * @param window_size number of outstanding requests, limited to 63 by IPMI sequence numbers
+     */
+    void set_window_size(std::uint8_t window_size) {
+        m_window_size = window_size;
+    }
+
+
+    std::uint8_t get_window_size() const {
+        return m_window_size;
+    }
+
+
+    /*!
+     * @brief Set time to wait for the response before the request is sent again
+     * @param timeout time of a single attempt
+     */
+    void set_request_timeout(std::chrono::milliseconds timeout) {
+        m_request_timeout = timeout;
+    }
+
+
+    std::chrono::milliseconds get_request_timeout() const {
+        return m_request_timeout;
+    }
+
+
+    /*!
+     * @brief Set number of retransmissions of a request without response
+     * @param retries number of retries
+     */
+    void set_retries(std::uint8_t retries) {
+        m_retries = retries;
+    }
+
+
+    std::uint8_t get_retries() const {
+        return m_retries;
+    }
+
+private:
+    std::uint8_t m_window_size{8};
+    std::chrono::milliseconds m_request_timeout{1000};
+    std::uint8_t m_retries{3};
+};
+
+}
+}
+}
@@ -0,0 +1,131 @@
+/*!
+ * @brief Session implementation for "lanplus" communication interface.
+ *
+ * Native RMCP+ interface. Messages are sent by the shared session engine, so requests of
+ * concurrent callers are pipelined in one session instead of being serialized on the interface.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp/lan_plus_ipmi_interface.hpp
+ */
+
+#pragma once
+
+#include "ipmi/ipmi_interface.hpp"
+#include "ipmi/manager/rmcpp/lan_plus_connection_data.hpp"
+#include "ipmi/manager/rmcpp/session_engine.hpp"
+
+#include <future>
+#include <shared_mutex>
+
+namespace ipmi {
+namespace manager {
+namespace rmcpp {
+
+class LanPlusIpmiInterface : public ipmi::IpmiInterface {
+public:
+    LanPlusIpmiInterface(ConnectionData::ConstPtr connection_data);
+
+    virtual ~LanPlusIpmiInterface();
+
+    /*!
+     * @brief Queue a message without waiting for the response
+     *
+     * Any number of messages may be queued, at most window size of them is outstanding on the BMC.
+     *
+     * @param netfn network function
+     * @param command command
+     * @param lun logical unit number
+     * @param bridge bridging information
+     * @param request bytes to be sent
+     * @return future of received bytes, starting with completion code
+     */
+    std::future<ByteBuffer> send_async(NetFn netfn, Cmd command, Lun lun, const BridgeInfo& bridge,
+                                       const ByteBuffer& request);
+
+protected:
+    /*!
+     * @brief Send a message
+     *
+     * Messages of concurrent callers are outstanding together. Waits only for bundles sent
+     * between lock() and unlock().
+     *
+     * @param netfn network function
+     * @param command command
+     * @param lun logical unit number
+     * @param bridge bridging information
+     * @param request bytes to be sent
+     * @param[out] response received bytes
+     */
+    void send(NetFn netfn, Cmd command, Lun lun, const BridgeInfo& bridge,
+              const ByteBuffer& request, ByteBuffer& response) override;
+
+    /*!
+     * @brief Send a message of a bundle, interface has to be locked
+     * @param netfn network function
+     * @param command command
+     * @param lun logical unit number
+     * @param bridge bridging information
+     * @param request bytes to be sent
+     * @param[out] response received bytes
+     */
+    void send_unlocked(NetFn netfn, Cmd command, Lun lun, const BridgeInfo& bridge,
+                       const ByteBuffer& request, ByteBuffer& response) override;
+
+    /*!
+     * @brief Locks the IPMI interface instance, exclusively to other senders.
+     */
+    void lock() override;
+
+    /*!
+     * @brief Unlocks the IPMI interface instance.
+     */
+    void unlock() override;
+
+    /*!
+     * @brief Sends all messages of the batch at once
+     *
+     * Messages are queued together, so at most window size of them is outstanding on the BMC.
+     *
+     * @param bridge bridging information, same for all messages
+     * @param[in,out] batch messages to be sent, responses (or errors) are filled in
+     */
+    void send_batch(const BridgeInfo& bridge, Batch& batch) override;
+
+    /*!
+     * @brief Check if IPMI interface matches current connection data
+     * @param connection_data configuration to be checked.
+     * @return true if interface "equals" given configuration
+     */
+    bool matches(ConnectionData::ConstPtr connection_data) const override;
+
+    /*!
+     * @brief Check if IPMI interface configuration matches given connection data
+     * @param connection_data configuration to be checked.
+     * @return true if interface uses same configuration.
+     */
+    bool config_equals(ConnectionData::ConstPtr connection_data) const override;
+
+private:
+    /*! Connection data to be used by matches()/config_equals() */
+    const LanPlusConnectionData data;
+
+    const SessionEngine::SessionPtr session;
+
+    /*! Shared by single messages, exclusive for bundles */
+    std::shared_timed_mutex mutex{};
+};
+
+}
+}
+}
@@ -0,0 +1,213 @@
+/*!
+ * @brief RMCP+ protocol: packet format, IPMI message framing and RAKP authentication.
+ *
+ * Implements cipher suite 3 of IPMI v2.0: RAKP-HMAC-SHA1 authentication, HMAC-SHA1-96 integrity
+ * and AES-CBC-128 confidentiality. Used by the session engine and by the BMC simulator in tests.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp/protocol.hpp
+ */
+
+#pragma once
+
+#include "ipmi/ipmi_interface.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace ipmi {
+namespace manager {
+namespace rmcpp {
+namespace protocol {
+
+using ByteBuffer = ipmi::IpmiInterface::ByteBuffer;
+
+/*! Slave address of the BMC */
+constexpr std::uint8_t BMC_ADDRESS = 0x20;
+/*! Software ID of the remote console */
+constexpr std::uint8_t REMOTE_CONSOLE_ADDRESS = 0x81;
+
+/*! Number of IPMI request sequence numbers */
+constexpr std::uint8_t SEQUENCE_NUMBERS = 64;
+
+constexpr std::size_t RANDOM_NUMBER_SIZE = 16;
+constexpr std::size_t GUID_SIZE = 16;
+constexpr std::size_t HMAC_SHA1_SIZE = 20;
+constexpr std::size_t HMAC_SHA1_96_SIZE = 12;
+constexpr std::size_t AES_CBC_128_BLOCK_SIZE = 16;
+constexpr std::size_t MAX_USERNAME_SIZE = 16;
+constexpr std::size_t MAX_PASSWORD_SIZE = 20;
+
+constexpr std::uint8_t PRIVILEGE_ADMINISTRATOR = 0x04;
+/*! Requested role flag: user is looked up by the name only */
+constexpr std::uint8_t NAME_ONLY_LOOKUP = 0x10;
+
+constexpr std::uint8_t NETFN_APP = 0x06;
+constexpr std::uint8_t CMD_SEND_MESSAGE = 0x34;
+constexpr std::uint8_t CMD_SET_SESSION_PRIVILEGE_LEVEL = 0x3B;
+constexpr std::uint8_t CMD_CLOSE_SESSION = 0x3C;
+
+/*! Send Message channel flag: BMC tracks the request and forwards the response */
+constexpr std::uint8_t TRACK_REQUEST = 0x40;
+
+/*! RMCP+ payload types */
+enum class PayloadType : std::uint8_t {
+    IPMI = 0x00,
+    OPEN_SESSION_REQUEST = 0x10,
+    OPEN_SESSION_RESPONSE = 0x11,
+    RAKP_1 = 0x12,
+    RAKP_2 = 0x13,
+    RAKP_3 = 0x14,
+    RAKP_4 = 0x15
+};
+
+/*!
+ * @brief Keys protecting session packets, derived from the Session Integrity Key
+ */
+struct SessionKeys {
+    /*! K1, key of the HMAC-SHA1-96 integrity algorithm */
+    ByteBuffer integrity_key{};
+    /*! First 16 bytes of K2, key of the AES-CBC-128 confidentiality algorithm */
+    ByteBuffer confidentiality_key{};
+};
+
+/*!
+ * @brief RMCP+ session packet
+ */
+struct SessionPacket {
+    PayloadType type{PayloadType::IPMI};
+    /*! Payload is encrypted with the confidentiality key */
+    bool encrypted{false};
+    /*! Packet is signed with the integrity key */
+    bool authenticated{false};
+    std::uint32_t session_id{0};
+    std::uint32_t sequence{0};
+    ByteBuffer payload{};
+};
+
+/*!
+ * @brief IPMI message exchanged over LAN or bridged to another controller
+ */
+struct IpmiMessage {
+    /*! Address of the responder */
+    std::uint8_t rs_address{BMC_ADDRESS};
+    /*! Address of the requester */
+    std::uint8_t rq_address{REMOTE_CONSOLE_ADDRESS};
+    /*! Network function, odd for responses */
+    std::uint8_t netfn{0};
+    std::uint8_t lun{0};
+    /*! Request sequence number, copied to the response */
+    std::uint8_t sequence{0};
+    std::uint8_t command{0};
+    /*! Request data, or completion code followed by response data */
+    ByteBuffer data{};
+};
+
+/*!
+ * @brief Data of a RAKP-HMAC-SHA1 authentication
+ */
+struct Rakp {
+    std::uint32_t console_session_id{0};
+    std::uint32_t bmc_session_id{0};
+    ByteBuffer console_random{};
+    ByteBuffer bmc_random{};
+    ByteBuffer bmc_guid{};
+    /*! Requested maximum privilege with lookup flags */
+    std::uint8_t role{0};
+    std::string username{};
+    std::string password{};
+
+    /*! @return key exchange authentication code of RAKP message 2 */
+    ByteBuffer get_rakp2_auth_code() const;
+
+    /*! @return key exchange authentication code of RAKP message 3 */
+    ByteBuffer get_rakp3_auth_code() const;
+
+    /*! @return Session Integrity Key */
+    ByteBuffer get_session_integrity_key() const;
+
+    /*! @return integrity check value of RAKP message 4 */
+    ByteBuffer get_rakp4_integrity_check_value() const;
+
+    /*! @return keys protecting session packets */
+    SessionKeys get_session_keys() const;
+};
+
+/*!
+ * @brief Calculate HMAC-SHA1
+ * @param key HMAC key
+ * @param data authenticated data
+ * @return 20 bytes of HMAC
+ */
+ByteBuffer hmac_sha1(const ByteBuffer& key, const ByteBuffer& data);
+
+/*!
+ * @brief Generate random bytes
+ * @param size number of bytes
+ * @return random bytes
+ */
+ByteBuffer get_random_bytes(std::size_t size);
+
+/*!
+ * @brief Encode RMCP+ session packet
+ * @param packet packet to be encoded
+ * @param keys session keys, required for encrypted or authenticated packets
+ * @return datagram to be sent
+ */
+ByteBuffer encode_packet(const SessionPacket& packet, const SessionKeys* keys);
+
+/*!
+ * @brief Decode RMCP+ session packet, integrity of authenticated packets is verified
+ * @param data received datagram
+ * @param size size of the datagram
+ * @param keys session keys, required for encrypted or authenticated packets
+ * @param[out] packet decoded packet
+ * @return false if the datagram is not a valid RMCP+ packet
+ */
+bool decode_packet(const std::uint8_t* data, std::size_t size, const SessionKeys* keys, SessionPacket& packet);
+
+/*!
+ * @brief Encode IPMI request
+ * @param message request to be encoded
+ * @return IPMI message with checksums
+ */
+ByteBuffer encode_request(const IpmiMessage& message);
+
+/*!
+ * @brief Encode IPMI response
+ * @param message response to be encoded, data starts with completion code
+ * @return IPMI message with checksums
+ */
+ByteBuffer encode_response(const IpmiMessage& message);
+
+/*!
+ * @brief Decode IPMI request
+ * @param data encoded request
+ * @param[out] message decoded request
+ * @return false if checksums are invalid or the message is too short
+ */
+bool decode_request(const ByteBuffer& data, IpmiMessage& message);
+
+/*!
+ * @brief Decode IPMI response
+ * @param data encoded response
+ * @param[out] message decoded response, data starts with completion code
+ * @return false if checksums are invalid or the message is too short
+ */
+bool decode_response(const ByteBuffer& data, IpmiMessage& message);
+
+}
+}
+}
+}
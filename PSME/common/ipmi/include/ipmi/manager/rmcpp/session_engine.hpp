@@ -0,0 +1,147 @@
+/*!
+ * @brief Event driven engine of RMCP+ sessions.
+ *
+ * Single thread drives sessions to all BMCs with one epoll loop. Requests of a session are
+ * demultiplexed by IPMI sequence numbers, so up to the window size of them is outstanding at once.
+ * Each request has its own timeout and is retransmitted until the number of retries is exhausted.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp/session_engine.hpp
+ */
+
+#pragma once
+
+#include "ipmi/ipmi_interface.hpp"
+#include "ipmi/manager/rmcpp/lan_plus_connection_data.hpp"
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ipmi {
+namespace manager {
+namespace rmcpp {
+
+class SessionEngine final {
+public:
+    class Session;
+    using SessionPtr = std::shared_ptr<Session>;
+
+    /*!
+     * @brief Counters of the engine
+     */
+    struct Statistics {
+        std::uint64_t requests{0};
+        std::uint64_t responses{0};
+        std::uint64_t retransmissions{0};
+        std::uint64_t timeouts{0};
+        /*! Number of established sessions, including reestablished ones */
+        std::uint64_t sessions{0};
+    };
+
+    /*!
+     * @brief Get engine shared by all "lanplus" interfaces
+     * @return engine instance
+     */
+    static SessionEngine& get_instance();
+
+    SessionEngine();
+    ~SessionEngine();
+
+    SessionEngine(const SessionEngine&) = delete;
+    SessionEngine& operator=(const SessionEngine&) = delete;
+
+    /*!
+     * @brief Create session to the BMC. Session is established with the first request.
+     * @param data connection data of the BMC
+     * @return session handle
+     */
+    SessionPtr create_session(const LanPlusConnectionData& data);
+
+    /*!
+     * @brief Queue request in the session
+     * @param session session handle
+     * @param netfn network function
+     * @param command command
+     * @param lun logical unit number
+     * @param bridge bridging information, dual bridging is not supported
+     * @param request request data
+     * @return future of the completion code followed by response data
+     */
+    std::future<IpmiInterface::ByteBuffer> submit(const SessionPtr& session, IpmiInterface::NetFn netfn,
+                                                  IpmiInterface::Cmd command, IpmiInterface::Lun lun,
+                                                  const BridgeInfo& bridge, const IpmiInterface::ByteBuffer& request);
+
+    /*!
+     * @brief Close the session, all its pending requests fail
+     * @param session session handle
+     */
+    void close_session(const SessionPtr& session);
+
+    /*!
+     * @brief Get snapshot of the counters
+     * @return counters
+     */
+    Statistics get_statistics() const;
+
+private:
+    using Command = std::function<void()>;
+
+    void run();
+    void execute(Command command);
+    void process_commands();
+    void receive(Session& session);
+    void process_deadlines();
+    int get_wait_time() const;
+
+    void dispatch(Session& session);
+    void start_handshake(Session& session);
+    void send_handshake(Session& session);
+    void handle_packet(Session& session, const std::uint8_t* data, std::size_t size);
+    void handle_open_session_response(Session& session, const IpmiInterface::ByteBuffer& payload);
+    void handle_rakp2(Session& session, const IpmiInterface::ByteBuffer& payload);
+    void handle_rakp4(Session& session, const IpmiInterface::ByteBuffer& payload);
+    void handle_response(Session& session, const IpmiInterface::ByteBuffer& payload);
+    void send_request(Session& session, std::uint8_t sequence);
+    void send_ipmi(Session& session, const IpmiInterface::ByteBuffer& message);
+    void fail_session(Session& session, const std::string& reason);
+    void release(Session& session);
+
+    int m_epoll{-1};
+    int m_event{-1};
+    std::atomic<bool> m_running{true};
+
+    mutable std::mutex m_mutex{};
+    std::vector<Command> m_commands{};
+
+    /*! Sessions by their socket, accessed by the loop thread only */
+    std::map<int, SessionPtr> m_sessions{};
+
+    std::atomic<std::uint64_t> m_requests{0};
+    std::atomic<std::uint64_t> m_responses{0};
+    std::atomic<std::uint64_t> m_retransmissions{0};
+    std::atomic<std::uint64_t> m_timeouts{0};
+    std::atomic<std::uint64_t> m_established{0};
+
+    std::thread m_thread{};
+};
+
+}
+}
+}
@@ -48,7 +48,8 @@ public:
      * @brief Read all records from SEL
      *
      * It tries to records from the last one read. If reservation is canceled, awaiting
-     * records are to be read in next cycle.
+     * records are to be read in next cycle. If the last read record doesn't exist anymore
+     * (or it was replaced), or some records were deleted, all records are read from the scratch.
      *
      * @return true if event "database" has changed
      */
@@ -95,6 +96,16 @@ public:
      */
     SelRecord::Ptr get_record(ipmi::command::generic::SelEntryId id) const;
 
+    /*!
+     * @brief Get number of times records were read from the scratch
+     *
+     * Records already returned are still valid as long as the generation is not changed,
+     * only new records are appended (and rolled-out removed) in the meantime.
+     *
+     * @return generation of the records
+     */
+    std::uint32_t get_generation() const { return generation; }
+
 private:
     /*!
      * @brief Special record ID to find very first record in the SEL
@@ -114,6 +125,18 @@ private:
      */
     ipmi::command::generic::SelReservationId get_reservation() const;
 
+    /*!
+     * @brief Read records following the last read one
+     * @param reservation reservation ID to be used
+     * @return false if the last read record is not in the SEL anymore
+     */
+    bool read_records(ipmi::command::generic::SelReservationId reservation);
+
+    /*!
+     * @brief Drop all records, next read starts from the very first record
+     */
+    void restart();
+
     IpmiController& controller;
 
     ipmi::command::generic::SelTimestamp sel_time{};
@@ -125,6 +148,8 @@ private:
     bool reserve_supported{};
 
     ipmi::command::generic::SelEntryId last_read_record{FIRST_ENTRY};
+    ipmi::IpmiInterface::ByteBuffer last_read_entry{};
+    std::uint32_t generation{0};
     RecordVect records{};
 
     /*!
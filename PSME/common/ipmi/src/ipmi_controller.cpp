@@ -44,6 +44,44 @@ void IpmiController::send(const Request& request, const BridgeInfo& via, Respons
     do_send(request, via, response);
 }
 
+void IpmiController::send_batch(Exchanges& exchanges, const BridgeInfo& via) {
+    check_interface_refresh();
+    IpmiInterface::Batch batch{};
+    batch.reserve(exchanges.size());
+    for (auto& exchange : exchanges) {
+        IpmiInterface::BatchEntry entry{};
+        entry.netfn = exchange.request.get_network_function();
+        entry.command = exchange.request.get_command();
+        entry.lun = exchange.request.get_lun();
+        entry.request = exchange.request.do_pack();
+        batch.push_back(std::move(entry));
+    }
+
+    try {
+        interface->send_batch(via, batch);
+    }
+    catch (...) {
+        check_interface = true;
+        throw;
+    }
+
+    for (std::size_t i = 0; i < exchanges.size(); ++i) {
+        exchanges[i].error = batch[i].error;
+        if (!exchanges[i].error) {
+            try {
+                exchanges[i].response.do_unpack(batch[i].response);
+            }
+            catch (...) {
+                exchanges[i].error = std::current_exception();
+            }
+        }
+        /* as for single messages, interface is rechecked after any failure */
+        if (exchanges[i].error) {
+            check_interface = true;
+        }
+    }
+}
+
 void IpmiController::send_unlocked(const Request& request, Response& response) {
     static const BridgeInfo default_bridge{};
     send_unlocked(request, default_bridge, response);
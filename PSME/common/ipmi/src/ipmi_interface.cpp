@@ -26,3 +26,16 @@ using namespace ipmi;
 IpmiInterface::IpmiInterface() { }
 
 IpmiInterface::~IpmiInterface() { }
+
+void IpmiInterface::send_batch(const BridgeInfo& bridge, Batch& batch) {
+    lock();
+    for (auto& entry : batch) {
+        try {
+            send_unlocked(entry.netfn, entry.command, entry.lun, bridge, entry.request, entry.response);
+        }
+        catch (...) {
+            entry.error = std::current_exception();
+        }
+    }
+    unlock();
+}
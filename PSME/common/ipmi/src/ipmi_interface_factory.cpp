@@ -22,6 +22,7 @@
 
 #include "ipmi/manager/ipmitool/lan_ipmi_interface.hpp"
 #include "ipmi/manager/ipmitool/serial_ipmi_interface.hpp"
+#include "ipmi/manager/rmcpp/lan_plus_ipmi_interface.hpp"
 
 namespace {
 
@@ -33,6 +34,7 @@ public:
     IpmitoolInterfaceFactory() {
         add_builder<ipmi::manager::ipmitool::LanIpmiInterface>(ipmi::manager::ipmitool::LanConnectionData::INTF_TYPE);
         add_builder<ipmi::manager::ipmitool::SerialIpmiInterface>(ipmi::manager::ipmitool::SerialConnectionData::INTF_TYPE);
+        add_builder<ipmi::manager::rmcpp::LanPlusIpmiInterface>(ipmi::manager::rmcpp::LanPlusConnectionData::INTF_TYPE);
     }
 };
 
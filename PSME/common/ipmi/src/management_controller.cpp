@@ -20,7 +20,21 @@
  */
 
 #include "ipmi/management_controller.hpp"
+#include "ipmi/manager/rmcpp/lan_plus_connection_data.hpp"
+
+#include <stdexcept>
 
 
 
 ipmi::ManagementController::~ManagementController() {}
+
+
+ipmi::ConnectionData::Ptr ipmi::ManagementController::make_connection_data(const std::string& interface_type) {
+    if (interface_type == ipmi::manager::ipmitool::LanConnectionData::INTF_TYPE) {
+        return std::make_shared<ipmi::manager::ipmitool::LanConnectionData>();
+    }
+    if (interface_type == ipmi::manager::rmcpp::LanPlusConnectionData::INTF_TYPE) {
+        return std::make_shared<ipmi::manager::rmcpp::LanPlusConnectionData>();
+    }
+    throw std::invalid_argument("Unsupported IPMI LAN interface type: " + interface_type);
+}
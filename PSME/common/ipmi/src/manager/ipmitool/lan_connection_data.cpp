@@ -29,6 +29,11 @@ LanConnectionData::LanConnectionData(const std::string& ip, std::uint32_t port,
     ipmi::ConnectionData(LanConnectionData::INTF_TYPE),
     m_ip(ip), m_port(port), m_username(username), m_password(password) { }
 
+LanConnectionData::LanConnectionData(const std::string& _interface_type, const std::string& ip, std::uint32_t port,
+                                     const std::string& username, const std::string& password):
+    ipmi::ConnectionData(_interface_type),
+    m_ip(ip), m_port(port), m_username(username), m_password(password) { }
+
 LanConnectionData::~LanConnectionData() { }
 
 
@@ -0,0 +1,30 @@
+/*!
+ * @brief "Lanplus" ManagementController configuration data.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp/lan_plus_connection_data.cpp
+ */
+
+#include "ipmi/manager/rmcpp/lan_plus_connection_data.hpp"
+
+using namespace ipmi::manager::rmcpp;
+
+LanPlusConnectionData::LanPlusConnectionData() :
+    ipmi::manager::ipmitool::LanConnectionData(LanPlusConnectionData::INTF_TYPE, {}, 623, {}, {}) { }
+
+LanPlusConnectionData::LanPlusConnectionData(const std::string& ip, std::uint32_t port,
+                                             const std::string& username, const std::string& password):
+    ipmi::manager::ipmitool::LanConnectionData(LanPlusConnectionData::INTF_TYPE, ip, port, username, password) { }
+
+LanPlusConnectionData::~LanPlusConnectionData() { }
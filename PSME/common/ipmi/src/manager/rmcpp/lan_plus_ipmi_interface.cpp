@@ -0,0 +1,110 @@
+/*!
+ * @brief Session implementation for "lanplus" communication interface.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp/lan_plus_ipmi_interface.cpp
+ */
+
+#include "ipmi/manager/rmcpp/lan_plus_ipmi_interface.hpp"
+
+using namespace ipmi::manager::rmcpp;
+
+LanPlusIpmiInterface::LanPlusIpmiInterface(ipmi::ConnectionData::ConstPtr connection_data) :
+    data(dynamic_cast<const LanPlusConnectionData&>(*connection_data)),
+    session(SessionEngine::get_instance().create_session(data)) { }
+
+LanPlusIpmiInterface::~LanPlusIpmiInterface() {
+    SessionEngine::get_instance().close_session(session);
+}
+
+bool LanPlusIpmiInterface::matches(ipmi::ConnectionData::ConstPtr connection_data) const {
+
+    if (connection_data->get_interface_type() != LanPlusConnectionData::INTF_TYPE) {
+        return false;
+    }
+    const LanPlusConnectionData& other = dynamic_cast<const LanPlusConnectionData&>(*connection_data);
+    return (other.get_ip() == data.get_ip()) &&
+           (other.get_port() == data.get_port()) &&
+           (other.get_username() == data.get_username());
+}
+
+bool LanPlusIpmiInterface::config_equals(ConnectionData::ConstPtr connection_data) const {
+
+    /* both matches.. but it is necessary to check if "additional" setting match as well */
+    const LanPlusConnectionData& other = dynamic_cast<const LanPlusConnectionData&>(*connection_data);
+    return (other.get_password() == data.get_password()) &&
+           (other.get_window_size() == data.get_window_size()) &&
+           (other.get_request_timeout() == data.get_request_timeout()) &&
+           (other.get_retries() == data.get_retries());
+}
+
+std::future<ipmi::IpmiInterface::ByteBuffer> LanPlusIpmiInterface::send_async(NetFn netfn, Cmd command, Lun lun,
+                                                                              const BridgeInfo& bridge,
+                                                                              const ByteBuffer& request) {
+    return SessionEngine::get_instance().submit(session, netfn, command, lun, bridge, request);
+}
+
+void LanPlusIpmiInterface::send(NetFn netfn, Cmd command, Lun lun, const BridgeInfo& bridge,
+                                const ByteBuffer& request, ByteBuffer& response) {
+
+    std::shared_lock<std::shared_timed_mutex> lock{mutex};
+    response = send_async(netfn, command, lun, bridge, request).get();
+}
+
+void LanPlusIpmiInterface::send_unlocked(NetFn netfn, Cmd command, Lun lun, const BridgeInfo& bridge,
+                                         const ByteBuffer& request, ByteBuffer& response) {
+
+    response = send_async(netfn, command, lun, bridge, request).get();
+}
+
+void LanPlusIpmiInterface::send_batch(const BridgeInfo& bridge, Batch& batch) {
+
+    std::shared_lock<std::shared_timed_mutex> lock{mutex};
+    std::vector<std::future<ByteBuffer>> responses{};
+    responses.reserve(batch.size());
+    for (auto& entry : batch) {
+        try {
+            responses.emplace_back(send_async(entry.netfn, entry.command, entry.lun, bridge, entry.request));
+        }
+        catch (...) {
+            entry.error = std::current_exception();
+            responses.emplace_back();
+        }
+    }
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        if (!responses[i].valid()) {
+            continue;
+        }
+        try {
+            batch[i].response = responses[i].get();
+        }
+        catch (...) {
+            batch[i].error = std::current_exception();
+        }
+    }
+}
+
+/*!
+ * @brief Locks the IPMI interface instance.
+ */
+void LanPlusIpmiInterface::lock() {
+    mutex.lock();
+}
+
+/*!
+ * @brief Unlocks the IPMI interface instance.
+ */
+void LanPlusIpmiInterface::unlock() {
+    mutex.unlock();
+}
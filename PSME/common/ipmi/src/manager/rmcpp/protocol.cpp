@@ -0,0 +1,362 @@
+/*!
+ * @brief RMCP+ protocol implementation.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp/protocol.cpp
+ */
+
+#include "ipmi/manager/rmcpp/protocol.hpp"
+
+#include <gcrypt.h>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+using namespace ipmi::manager::rmcpp::protocol;
+
+namespace {
+
+constexpr std::uint8_t RMCP_VERSION = 0x06;
+constexpr std::uint8_t RMCP_SEQUENCE_NO_ACK = 0xFF;
+constexpr std::uint8_t RMCP_CLASS_IPMI = 0x07;
+constexpr std::uint8_t AUTH_TYPE_RMCPP = 0x06;
+
+constexpr std::uint8_t PAYLOAD_ENCRYPTED = 0x80;
+constexpr std::uint8_t PAYLOAD_AUTHENTICATED = 0x40;
+constexpr std::uint8_t PAYLOAD_TYPE_MASK = 0x3F;
+
+constexpr std::size_t RMCP_HEADER_SIZE = 4;
+/*! Auth type, payload type, session id, session sequence and payload length */
+constexpr std::size_t SESSION_HEADER_SIZE = 12;
+constexpr std::size_t INTEGRITY_ALIGNMENT = 4;
+constexpr std::uint8_t NEXT_HEADER = 0x07;
+constexpr std::uint8_t INTEGRITY_PAD = 0xFF;
+
+/*! IPMI header, sequence and command bytes and both checksums */
+constexpr std::size_t IPMI_MESSAGE_OVERHEAD = 7;
+
+
+void initialize_gcrypt() {
+    static std::once_flag initialized{};
+    std::call_once(initialized, []() {
+        if (!gcry_control(GCRYCTL_INITIALIZATION_FINISHED_P)) {
+            gcry_check_version(nullptr);
+            gcry_control(GCRYCTL_INITIALIZATION_FINISHED, 0);
+        }
+    });
+}
+
+
+void push_u32(ByteBuffer& buffer, std::uint32_t value) {
+    for (unsigned i = 0; i < sizeof(value); ++i) {
+        buffer.push_back(std::uint8_t(value >> (8 * i)));
+    }
+}
+
+
+std::uint32_t read_u32(const std::uint8_t* data) {
+    return std::uint32_t(data[0]) | (std::uint32_t(data[1]) << 8) |
+           (std::uint32_t(data[2]) << 16) | (std::uint32_t(data[3]) << 24);
+}
+
+
+std::uint8_t checksum(ByteBuffer::const_iterator begin, ByteBuffer::const_iterator end) {
+    std::uint8_t sum = 0;
+    for (auto it = begin; it != end; ++it) {
+        sum = std::uint8_t(sum + *it);
+    }
+    return std::uint8_t(-sum);
+}
+
+
+bool is_checksum_valid(ByteBuffer::const_iterator begin, ByteBuffer::const_iterator end) {
+    std::uint8_t sum = 0;
+    for (auto it = begin; it != end; ++it) {
+        sum = std::uint8_t(sum + *it);
+    }
+    return 0 == sum;
+}
+
+
+ByteBuffer aes_cbc_128(const ByteBuffer& key, const std::uint8_t* iv, const std::uint8_t* data, std::size_t size,
+                       bool encrypt) {
+    initialize_gcrypt();
+    gcry_cipher_hd_t handle{};
+    if (gcry_cipher_open(&handle, GCRY_CIPHER_AES128, GCRY_CIPHER_MODE_CBC, 0)) {
+        throw std::runtime_error("Cannot initialize AES-CBC-128 cipher.");
+    }
+    ByteBuffer output(size);
+    gcry_error_t error = gcry_cipher_setkey(handle, key.data(), AES_CBC_128_BLOCK_SIZE);
+    if (!error) {
+        error = gcry_cipher_setiv(handle, iv, AES_CBC_128_BLOCK_SIZE);
+    }
+    if (!error) {
+        error = encrypt ? gcry_cipher_encrypt(handle, output.data(), size, data, size)
+                        : gcry_cipher_decrypt(handle, output.data(), size, data, size);
+    }
+    gcry_cipher_close(handle);
+    if (error) {
+        throw std::runtime_error("AES-CBC-128 failed: " + std::string(gcry_strerror(error)));
+    }
+    return output;
+}
+
+
+ByteBuffer get_user_key(const std::string& password) {
+    ByteBuffer key(MAX_PASSWORD_SIZE, 0);
+    std::copy_n(password.begin(), std::min(password.size(), MAX_PASSWORD_SIZE), key.begin());
+    return key;
+}
+
+
+void push_user(ByteBuffer& buffer, std::uint8_t role, const std::string& username) {
+    buffer.push_back(role);
+    buffer.push_back(std::uint8_t(username.size()));
+    buffer.insert(buffer.end(), username.begin(), username.end());
+}
+
+
+ByteBuffer encode_message(const IpmiMessage& message, std::uint8_t first_address, std::uint8_t second_address,
+                          std::uint8_t netfn_lun, std::uint8_t sequence_lun) {
+    ByteBuffer data{first_address, std::uint8_t((message.netfn << 2) | netfn_lun)};
+    data.push_back(checksum(data.begin(), data.end()));
+    data.push_back(second_address);
+    data.push_back(std::uint8_t((message.sequence << 2) | sequence_lun));
+    data.push_back(message.command);
+    data.insert(data.end(), message.data.begin(), message.data.end());
+    data.push_back(checksum(data.begin() + 3, data.end()));
+    return data;
+}
+
+
+bool decode_message(const ByteBuffer& data, std::uint8_t& first_address, std::uint8_t& second_address,
+                    IpmiMessage& message, std::uint8_t& netfn_lun, std::uint8_t& sequence_lun) {
+    if (data.size() < IPMI_MESSAGE_OVERHEAD || !is_checksum_valid(data.begin(), data.begin() + 3)
+        || !is_checksum_valid(data.begin() + 3, data.end())) {
+        return false;
+    }
+    first_address = data[0];
+    message.netfn = std::uint8_t(data[1] >> 2);
+    netfn_lun = std::uint8_t(data[1] & 0x03);
+    second_address = data[3];
+    message.sequence = std::uint8_t(data[4] >> 2);
+    sequence_lun = std::uint8_t(data[4] & 0x03);
+    message.command = data[5];
+    message.data.assign(data.begin() + 6, data.end() - 1);
+    return true;
+}
+
+}
+
+
+ByteBuffer ipmi::manager::rmcpp::protocol::hmac_sha1(const ByteBuffer& key, const ByteBuffer& data) {
+    initialize_gcrypt();
+    gcry_md_hd_t handle{};
+    if (gcry_md_open(&handle, GCRY_MD_SHA1, GCRY_MD_FLAG_HMAC)) {
+        throw std::runtime_error("Cannot initialize HMAC-SHA1.");
+    }
+    if (gcry_md_setkey(handle, key.data(), key.size())) {
+        gcry_md_close(handle);
+        throw std::runtime_error("Cannot set HMAC-SHA1 key.");
+    }
+    gcry_md_write(handle, data.data(), data.size());
+    const auto* digest = gcry_md_read(handle, GCRY_MD_SHA1);
+    ByteBuffer result(digest, digest + HMAC_SHA1_SIZE);
+    gcry_md_close(handle);
+    return result;
+}
+
+
+ByteBuffer ipmi::manager::rmcpp::protocol::get_random_bytes(std::size_t size) {
+    initialize_gcrypt();
+    ByteBuffer data(size);
+    gcry_create_nonce(data.data(), data.size());
+    return data;
+}
+
+
+ByteBuffer Rakp::get_rakp2_auth_code() const {
+    ByteBuffer data{};
+    push_u32(data, console_session_id);
+    push_u32(data, bmc_session_id);
+    data.insert(data.end(), console_random.begin(), console_random.end());
+    data.insert(data.end(), bmc_random.begin(), bmc_random.end());
+    data.insert(data.end(), bmc_guid.begin(), bmc_guid.end());
+    push_user(data, role, username);
+    return hmac_sha1(get_user_key(password), data);
+}
+
+
+ByteBuffer Rakp::get_rakp3_auth_code() const {
+    ByteBuffer data{bmc_random};
+    push_u32(data, console_session_id);
+    push_user(data, role, username);
+    return hmac_sha1(get_user_key(password), data);
+}
+
+
+ByteBuffer Rakp::get_session_integrity_key() const {
+    ByteBuffer data{console_random};
+    data.insert(data.end(), bmc_random.begin(), bmc_random.end());
+    push_user(data, role, username);
+    return hmac_sha1(get_user_key(password), data);
+}
+
+
+ByteBuffer Rakp::get_rakp4_integrity_check_value() const {
+    ByteBuffer data{console_random};
+    push_u32(data, bmc_session_id);
+    data.insert(data.end(), bmc_guid.begin(), bmc_guid.end());
+    auto icv = hmac_sha1(get_session_integrity_key(), data);
+    icv.resize(HMAC_SHA1_96_SIZE);
+    return icv;
+}
+
+
+SessionKeys Rakp::get_session_keys() const {
+    const auto sik = get_session_integrity_key();
+    SessionKeys keys{};
+    keys.integrity_key = hmac_sha1(sik, ByteBuffer(HMAC_SHA1_SIZE, 0x01));
+    keys.confidentiality_key = hmac_sha1(sik, ByteBuffer(HMAC_SHA1_SIZE, 0x02));
+    keys.confidentiality_key.resize(AES_CBC_128_BLOCK_SIZE);
+    return keys;
+}
+
+
+ByteBuffer ipmi::manager::rmcpp::protocol::encode_packet(const SessionPacket& packet, const SessionKeys* keys) {
+    if ((packet.encrypted || packet.authenticated) && nullptr == keys) {
+        throw std::logic_error("Session keys are required to protect RMCP+ packet.");
+    }
+
+    ByteBuffer payload{};
+    if (packet.encrypted) {
+        /* confidentiality trailer: pad bytes 1, 2, ... N followed by N */
+        ByteBuffer plain{packet.payload};
+        const auto pad = (AES_CBC_128_BLOCK_SIZE - (plain.size() + 1) % AES_CBC_128_BLOCK_SIZE)
+                         % AES_CBC_128_BLOCK_SIZE;
+        for (std::size_t i = 1; i <= pad; ++i) {
+            plain.push_back(std::uint8_t(i));
+        }
+        plain.push_back(std::uint8_t(pad));
+        payload = get_random_bytes(AES_CBC_128_BLOCK_SIZE);
+        const auto encrypted = aes_cbc_128(keys->confidentiality_key, payload.data(), plain.data(), plain.size(),
+                                           true);
+        payload.insert(payload.end(), encrypted.begin(), encrypted.end());
+    }
+    else {
+        payload = packet.payload;
+    }
+
+    ByteBuffer data{RMCP_VERSION, 0x00, RMCP_SEQUENCE_NO_ACK, RMCP_CLASS_IPMI, AUTH_TYPE_RMCPP};
+    data.push_back(std::uint8_t(std::uint8_t(packet.type) | (packet.encrypted ? PAYLOAD_ENCRYPTED : 0)
+                                | (packet.authenticated ? PAYLOAD_AUTHENTICATED : 0)));
+    push_u32(data, packet.session_id);
+    push_u32(data, packet.sequence);
+    data.push_back(std::uint8_t(payload.size()));
+    data.push_back(std::uint8_t(payload.size() >> 8));
+    data.insert(data.end(), payload.begin(), payload.end());
+
+    if (packet.authenticated) {
+        /* integrity pad aligns the authenticated data including pad length and next header */
+        const auto pad = (INTEGRITY_ALIGNMENT - (data.size() - RMCP_HEADER_SIZE + 2) % INTEGRITY_ALIGNMENT)
+                         % INTEGRITY_ALIGNMENT;
+        data.insert(data.end(), pad, INTEGRITY_PAD);
+        data.push_back(std::uint8_t(pad));
+        data.push_back(NEXT_HEADER);
+        auto auth_code = hmac_sha1(keys->integrity_key, ByteBuffer(data.begin() + RMCP_HEADER_SIZE, data.end()));
+        data.insert(data.end(), auth_code.begin(), auth_code.begin() + HMAC_SHA1_96_SIZE);
+    }
+    return data;
+}
+
+
+bool ipmi::manager::rmcpp::protocol::decode_packet(const std::uint8_t* data, std::size_t size,
+                                                   const SessionKeys* keys, SessionPacket& packet) {
+    constexpr std::size_t HEADERS_SIZE = RMCP_HEADER_SIZE + SESSION_HEADER_SIZE;
+    if (size < HEADERS_SIZE || RMCP_CLASS_IPMI != data[3] || AUTH_TYPE_RMCPP != data[4]) {
+        return false;
+    }
+    packet.type = PayloadType(data[5] & PAYLOAD_TYPE_MASK);
+    packet.encrypted = (0 != (data[5] & PAYLOAD_ENCRYPTED));
+    packet.authenticated = (0 != (data[5] & PAYLOAD_AUTHENTICATED));
+    packet.session_id = read_u32(data + 6);
+    packet.sequence = read_u32(data + 10);
+    const std::size_t payload_size = std::size_t(data[14]) | (std::size_t(data[15]) << 8);
+    if (size < HEADERS_SIZE + payload_size) {
+        return false;
+    }
+    if ((packet.encrypted || packet.authenticated) && nullptr == keys) {
+        return false;
+    }
+
+    if (packet.authenticated) {
+        if (size < HEADERS_SIZE + payload_size + 2 + HMAC_SHA1_96_SIZE) {
+            return false;
+        }
+        const std::size_t auth_code_offset = size - HMAC_SHA1_96_SIZE;
+        const auto pad = data[auth_code_offset - 2];
+        if (HEADERS_SIZE + payload_size + pad + 2 != auth_code_offset) {
+            return false;
+        }
+        auto auth_code = hmac_sha1(keys->integrity_key, ByteBuffer(data + RMCP_HEADER_SIZE, data + auth_code_offset));
+        if (!std::equal(data + auth_code_offset, data + size, auth_code.begin())) {
+            return false;
+        }
+    }
+
+    const std::uint8_t* payload = data + HEADERS_SIZE;
+    if (packet.encrypted) {
+        if (payload_size < 2 * AES_CBC_128_BLOCK_SIZE || 0 != payload_size % AES_CBC_128_BLOCK_SIZE) {
+            return false;
+        }
+        packet.payload = aes_cbc_128(keys->confidentiality_key, payload, payload + AES_CBC_128_BLOCK_SIZE,
+                                     payload_size - AES_CBC_128_BLOCK_SIZE, false);
+        const std::size_t pad = packet.payload.back();
+        if (pad + 1 > packet.payload.size()) {
+            return false;
+        }
+        packet.payload.resize(packet.payload.size() - pad - 1);
+    }
+    else {
+        packet.payload.assign(payload, payload + payload_size);
+    }
+    return true;
+}
+
+
+ByteBuffer ipmi::manager::rmcpp::protocol::encode_request(const IpmiMessage& message) {
+    return encode_message(message, message.rs_address, message.rq_address, message.lun, 0);
+}
+
+
+ByteBuffer ipmi::manager::rmcpp::protocol::encode_response(const IpmiMessage& message) {
+    return encode_message(message, message.rq_address, message.rs_address, 0, message.lun);
+}
+
+
+bool ipmi::manager::rmcpp::protocol::decode_request(const ByteBuffer& data, IpmiMessage& message) {
+    std::uint8_t rq_lun{};
+    return decode_message(data, message.rs_address, message.rq_address, message, message.lun, rq_lun);
+}
+
+
+bool ipmi::manager::rmcpp::protocol::decode_response(const ByteBuffer& data, IpmiMessage& message) {
+    std::uint8_t rq_lun{};
+    if (!decode_message(data, message.rq_address, message.rs_address, message, rq_lun, message.lun)) {
+        return false;
+    }
+    /* response always contains completion code */
+    return !message.data.empty();
+}
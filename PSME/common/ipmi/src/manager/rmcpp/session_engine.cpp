@@ -0,0 +1,789 @@
+/*!
+ * @brief Event driven engine of RMCP+ sessions.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp/session_engine.cpp
+ */
+
+#include "ipmi/manager/rmcpp/session_engine.hpp"
+#include "ipmi/manager/rmcpp/protocol.hpp"
+
+#include "logger/logger_factory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace ipmi::manager::rmcpp;
+using namespace ipmi::manager::rmcpp::protocol;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t MAX_EVENTS = 32;
+constexpr std::size_t MAX_DATAGRAM_SIZE = 1024;
+
+/*! Sequence number 0 is reserved for session setup and close requests */
+constexpr std::uint8_t FIRST_SEQUENCE = 1;
+constexpr std::uint8_t MAX_WINDOW_SIZE = SEQUENCE_NUMBERS - FIRST_SEQUENCE;
+
+/*! Algorithms of cipher suite 3: RAKP-HMAC-SHA1, HMAC-SHA1-96 and AES-CBC-128 */
+constexpr std::uint8_t AUTHENTICATION_PAYLOAD = 0x00;
+constexpr std::uint8_t INTEGRITY_PAYLOAD = 0x01;
+constexpr std::uint8_t CONFIDENTIALITY_PAYLOAD = 0x02;
+constexpr std::uint8_t ALGORITHM_PAYLOAD_LENGTH = 0x08;
+constexpr std::uint8_t CIPHER_SUITE_3_ALGORITHM = 0x01;
+
+constexpr std::size_t OPEN_SESSION_RESPONSE_SIZE = 12;
+constexpr std::size_t RAKP_2_SIZE = 8 + RANDOM_NUMBER_SIZE + GUID_SIZE + HMAC_SHA1_SIZE;
+constexpr std::size_t RAKP_4_SIZE = 8 + HMAC_SHA1_96_SIZE;
+
+
+void push_u32(ByteBuffer& buffer, std::uint32_t value) {
+    for (unsigned i = 0; i < sizeof(value); ++i) {
+        buffer.push_back(std::uint8_t(value >> (8 * i)));
+    }
+}
+
+
+std::uint32_t read_u32(const ByteBuffer& buffer, std::size_t offset) {
+    return std::uint32_t(buffer[offset]) | (std::uint32_t(buffer[offset + 1]) << 8) |
+           (std::uint32_t(buffer[offset + 2]) << 16) | (std::uint32_t(buffer[offset + 3]) << 24);
+}
+
+
+void push_algorithm(ByteBuffer& buffer, std::uint8_t payload) {
+    buffer.insert(buffer.end(), {payload, 0x00, 0x00, ALGORITHM_PAYLOAD_LENGTH, CIPHER_SUITE_3_ALGORITHM,
+                                 0x00, 0x00, 0x00});
+}
+
+
+std::uint32_t get_console_session_id() {
+    std::uint32_t id = 0;
+    while (0 == id) {
+        id = read_u32(get_random_bytes(sizeof(id)), 0);
+    }
+    return id;
+}
+
+
+std::exception_ptr make_error(const std::string& reason) {
+    return std::make_exception_ptr(std::runtime_error(reason));
+}
+
+}
+
+
+class SessionEngine::Session final {
+public:
+    enum class State {
+        IDLE,
+        OPEN_SESSION,
+        RAKP_1,
+        RAKP_3,
+        PRIVILEGE,
+        ACTIVE,
+        CLOSED
+    };
+
+    struct Request {
+        IpmiInterface::NetFn netfn{};
+        IpmiInterface::Cmd command{};
+        IpmiInterface::Lun lun{};
+        ByteBuffer data{};
+        /*! Request is sent in Send Message to the target controller */
+        bool bridged{false};
+        std::uint8_t channel{};
+        std::uint8_t target_address{};
+        std::promise<ByteBuffer> promise{};
+        Clock::time_point deadline{};
+        unsigned attempts{0};
+    };
+    using RequestPtr = std::unique_ptr<Request>;
+
+    Session(int _fd, const LanPlusConnectionData& data) :
+        fd(_fd), info(data.get_info()), username(data.get_username()), password(data.get_password()),
+        window_size(std::max<std::uint8_t>(1, std::min(data.get_window_size(), MAX_WINDOW_SIZE))),
+        request_timeout(data.get_request_timeout()), retries(data.get_retries()),
+        session_timeout(data.get_session_timeout()) { }
+
+    bool is_handshaking() const {
+        return State::OPEN_SESSION == state || State::RAKP_1 == state || State::RAKP_3 == state
+               || State::PRIVILEGE == state;
+    }
+
+    const int fd;
+    const std::string info;
+    const std::string username;
+    const std::string password;
+    const std::uint8_t window_size;
+    const std::chrono::milliseconds request_timeout;
+    const unsigned retries;
+    const std::chrono::milliseconds session_timeout;
+
+    State state{State::IDLE};
+    Rakp rakp{};
+    SessionKeys keys{};
+    /*! Session sequence number of the last sent packet */
+    std::uint32_t sequence{0};
+    /*! Session has to be reestablished before next request */
+    bool reset{false};
+    Clock::time_point last_activity{};
+
+    PayloadType handshake_type{PayloadType::OPEN_SESSION_REQUEST};
+    ByteBuffer handshake_payload{};
+    Clock::time_point handshake_deadline{};
+    unsigned handshake_attempts{0};
+
+    std::deque<RequestPtr> waiting{};
+    /*! Outstanding requests indexed by their IPMI sequence numbers */
+    std::array<RequestPtr, SEQUENCE_NUMBERS> in_flight{};
+    std::size_t outstanding{0};
+    std::uint8_t next_sequence{FIRST_SEQUENCE};
+};
+
+
+SessionEngine& SessionEngine::get_instance() {
+    static SessionEngine engine{};
+    return engine;
+}
+
+
+SessionEngine::SessionEngine() {
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    m_event = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_epoll < 0 || m_event < 0) {
+        throw std::system_error(errno, std::system_category(), "Cannot initialize RMCP+ session engine");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = m_event;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_event, &event);
+    m_thread = std::thread(&SessionEngine::run, this);
+}
+
+
+SessionEngine::~SessionEngine() {
+    m_running = false;
+    std::uint64_t wakeup = 1;
+    if (sizeof(wakeup) != ::write(m_event, &wakeup, sizeof(wakeup))) {
+        log_error("ipmi", "Cannot wake up RMCP+ session engine.");
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    /* pending requests are abandoned, their futures report broken promise */
+    for (const auto& entry : m_sessions) {
+        ::close(entry.first);
+    }
+    m_sessions.clear();
+    ::close(m_event);
+    ::close(m_epoll);
+}
+
+
+SessionEngine::SessionPtr SessionEngine::create_session(const LanPlusConnectionData& data) {
+    if (data.get_username().size() > MAX_USERNAME_SIZE || data.get_password().size() > MAX_PASSWORD_SIZE) {
+        throw std::invalid_argument("RMCP+ username or password is too long.");
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* addresses = nullptr;
+    const auto port = std::to_string(data.get_port());
+    if (0 != getaddrinfo(data.get_ip().c_str(), port.c_str(), &hints, &addresses)) {
+        throw std::runtime_error("Cannot resolve BMC address " + data.get_ip());
+    }
+
+    int fd = -1;
+    for (auto* address = addresses; address != nullptr; address = address->ai_next) {
+        fd = ::socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && 0 == ::connect(fd, address->ai_addr, address->ai_addrlen)) {
+            break;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot connect to BMC " + data.get_ip());
+    }
+
+    auto session = std::make_shared<Session>(fd, data);
+    execute([this, session]() {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = session->fd;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, session->fd, &event);
+        m_sessions[session->fd] = session;
+    });
+    return session;
+}
+
+
+std::future<ipmi::IpmiInterface::ByteBuffer> SessionEngine::submit(const SessionPtr& session,
+                                                                   IpmiInterface::NetFn netfn,
+                                                                   IpmiInterface::Cmd command,
+                                                                   IpmiInterface::Lun lun,
+                                                                   const BridgeInfo& bridge,
+                                                                   const IpmiInterface::ByteBuffer& request) {
+    if (BridgeInfo::Level::DUAL_BRIDGE == bridge.get_level()) {
+        throw std::runtime_error("Dual bridging is not supported by RMCP+ session engine.");
+    }
+
+    std::shared_ptr<Session::Request> entry = std::make_shared<Session::Request>();
+    entry->netfn = netfn;
+    entry->command = command;
+    entry->lun = lun;
+    entry->data = request;
+    BridgeInfo::Address address{};
+    BridgeInfo::Channel channel{};
+    if (bridge.get_target(address, channel)) {
+        entry->bridged = true;
+        entry->channel = channel;
+        entry->target_address = std::uint8_t(address);
+    }
+    auto future = entry->promise.get_future();
+    ++m_requests;
+
+    execute([this, session, entry]() {
+        if (Session::State::CLOSED == session->state) {
+            entry->promise.set_exception(make_error("RMCP+ session is closed."));
+            return;
+        }
+        session->waiting.emplace_back(new Session::Request(std::move(*entry)));
+        dispatch(*session);
+    });
+    return future;
+}
+
+
+void SessionEngine::close_session(const SessionPtr& session) {
+    execute([this, session]() {
+        release(*session);
+    });
+}
+
+
+SessionEngine::Statistics SessionEngine::get_statistics() const {
+    Statistics statistics{};
+    statistics.requests = m_requests;
+    statistics.responses = m_responses;
+    statistics.retransmissions = m_retransmissions;
+    statistics.timeouts = m_timeouts;
+    statistics.sessions = m_established;
+    return statistics;
+}
+
+
+void SessionEngine::execute(Command command) {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_commands.emplace_back(std::move(command));
+    }
+    std::uint64_t wakeup = 1;
+    if (sizeof(wakeup) != ::write(m_event, &wakeup, sizeof(wakeup))) {
+        log_error("ipmi", "Cannot wake up RMCP+ session engine.");
+    }
+}
+
+
+void SessionEngine::process_commands() {
+    std::uint64_t counter{};
+    while (::read(m_event, &counter, sizeof(counter)) > 0) { }
+
+    std::vector<Command> commands{};
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        commands.swap(m_commands);
+    }
+    for (auto& command : commands) {
+        command();
+    }
+}
+
+
+void SessionEngine::run() {
+    std::array<epoll_event, MAX_EVENTS> events{};
+    while (m_running) {
+        const int count = epoll_wait(m_epoll, events.data(), int(events.size()), get_wait_time());
+        for (int i = 0; i < count; ++i) {
+            const int fd = events[std::size_t(i)].data.fd;
+            try {
+                if (fd == m_event) {
+                    process_commands();
+                    continue;
+                }
+                auto it = m_sessions.find(fd);
+                if (it != m_sessions.end()) {
+                    receive(*it->second);
+                }
+            }
+            catch (const std::exception& e) {
+                log_error("ipmi", "RMCP+ session engine error: " << e.what());
+            }
+        }
+        process_deadlines();
+    }
+}
+
+
+int SessionEngine::get_wait_time() const {
+    bool any = false;
+    Clock::time_point nearest = Clock::time_point::max();
+    for (const auto& entry : m_sessions) {
+        const auto& session = *entry.second;
+        if (session.is_handshaking()) {
+            nearest = std::min(nearest, session.handshake_deadline);
+            any = true;
+        }
+        if (0 == session.outstanding) {
+            continue;
+        }
+        for (const auto& request : session.in_flight) {
+            if (request) {
+                nearest = std::min(nearest, request->deadline);
+                any = true;
+            }
+        }
+    }
+    if (!any) {
+        return -1;
+    }
+    const auto now = Clock::now();
+    if (nearest <= now) {
+        return 0;
+    }
+    /* round up, the loop would spin until the deadline otherwise */
+    return int(std::chrono::duration_cast<std::chrono::milliseconds>(nearest - now).count()) + 1;
+}
+
+
+void SessionEngine::process_deadlines() {
+    const auto now = Clock::now();
+    for (const auto& entry : m_sessions) {
+        auto& session = *entry.second;
+        if (session.is_handshaking() && session.handshake_deadline <= now) {
+            if (session.handshake_attempts <= session.retries) {
+                ++m_retransmissions;
+                send_handshake(session);
+            }
+            else {
+                fail_session(session, "Cannot establish RMCP+ session with " + session.info + ": timeout.");
+            }
+            continue;
+        }
+        if (0 == session.outstanding) {
+            continue;
+        }
+        for (std::uint8_t sequence = FIRST_SEQUENCE; sequence < SEQUENCE_NUMBERS; ++sequence) {
+            auto& request = session.in_flight[sequence];
+            if (!request || request->deadline > now) {
+                continue;
+            }
+            if (request->attempts <= session.retries) {
+                ++m_retransmissions;
+                send_request(session, sequence);
+            }
+            else {
+                ++m_timeouts;
+                request->promise.set_exception(make_error("IPMI request to " + session.info + " timed out."));
+                request.reset();
+                --session.outstanding;
+                /* BMC may have dropped the session, it is reestablished before next requests */
+                session.reset = true;
+            }
+        }
+        dispatch(session);
+    }
+}
+
+
+void SessionEngine::dispatch(Session& session) {
+    if (Session::State::ACTIVE == session.state && 0 == session.outstanding) {
+        if (session.reset || (Clock::now() - session.last_activity > session.session_timeout)) {
+            session.state = Session::State::IDLE;
+        }
+    }
+    if (Session::State::IDLE == session.state) {
+        if (!session.waiting.empty()) {
+            start_handshake(session);
+        }
+        return;
+    }
+    if (Session::State::ACTIVE != session.state) {
+        return;
+    }
+
+    while (!session.waiting.empty() && session.outstanding < session.window_size) {
+        /* sequence numbers are rotated, so late responses do not match newer requests */
+        std::uint8_t sequence = session.next_sequence;
+        while (session.in_flight[sequence]) {
+            sequence = std::uint8_t(sequence % MAX_WINDOW_SIZE + FIRST_SEQUENCE);
+        }
+        session.next_sequence = std::uint8_t(sequence % MAX_WINDOW_SIZE + FIRST_SEQUENCE);
+
+        session.in_flight[sequence] = std::move(session.waiting.front());
+        session.waiting.pop_front();
+        ++session.outstanding;
+        send_request(session, sequence);
+    }
+}
+
+
+void SessionEngine::start_handshake(Session& session) {
+    session.reset = false;
+    session.keys = {};
+    session.sequence = 0;
+    session.rakp = {};
+    session.rakp.console_session_id = get_console_session_id();
+    session.rakp.role = PRIVILEGE_ADMINISTRATOR | NAME_ONLY_LOOKUP;
+    session.rakp.username = session.username;
+    session.rakp.password = session.password;
+
+    ByteBuffer payload{0x00, PRIVILEGE_ADMINISTRATOR, 0x00, 0x00};
+    push_u32(payload, session.rakp.console_session_id);
+    push_algorithm(payload, AUTHENTICATION_PAYLOAD);
+    push_algorithm(payload, INTEGRITY_PAYLOAD);
+    push_algorithm(payload, CONFIDENTIALITY_PAYLOAD);
+
+    session.state = Session::State::OPEN_SESSION;
+    session.handshake_type = PayloadType::OPEN_SESSION_REQUEST;
+    session.handshake_payload = std::move(payload);
+    session.handshake_attempts = 0;
+    send_handshake(session);
+}
+
+
+void SessionEngine::send_handshake(Session& session) {
+    SessionPacket packet{};
+    packet.type = session.handshake_type;
+    packet.payload = session.handshake_payload;
+    const SessionKeys* keys = nullptr;
+    if (Session::State::PRIVILEGE == session.state) {
+        packet.encrypted = true;
+        packet.authenticated = true;
+        packet.session_id = session.rakp.bmc_session_id;
+        packet.sequence = ++session.sequence;
+        keys = &session.keys;
+    }
+    const auto datagram = encode_packet(packet, keys);
+    if (::send(session.fd, datagram.data(), datagram.size(), 0) < 0) {
+        log_debug("ipmi", "Cannot send RMCP+ packet to " << session.info << ": " << strerror(errno));
+    }
+    session.handshake_deadline = Clock::now() + session.request_timeout;
+    ++session.handshake_attempts;
+}
+
+
+void SessionEngine::send_request(Session& session, std::uint8_t sequence) {
+    auto& request = *session.in_flight[sequence];
+
+    IpmiMessage message{};
+    message.netfn = request.netfn;
+    message.lun = request.lun;
+    message.sequence = sequence;
+    message.command = request.command;
+    message.data = request.data;
+    if (request.bridged) {
+        /* inner request has the same sequence number, so both responses match the same slot */
+        message.rs_address = request.target_address;
+        message.rq_address = BMC_ADDRESS;
+        IpmiMessage outer{};
+        outer.netfn = NETFN_APP;
+        outer.sequence = sequence;
+        outer.command = CMD_SEND_MESSAGE;
+        outer.data.push_back(std::uint8_t(request.channel | TRACK_REQUEST));
+        const auto inner = encode_request(message);
+        outer.data.insert(outer.data.end(), inner.begin(), inner.end());
+        message = std::move(outer);
+    }
+    send_ipmi(session, encode_request(message));
+    request.deadline = Clock::now() + session.request_timeout;
+    ++request.attempts;
+}
+
+
+void SessionEngine::send_ipmi(Session& session, const IpmiInterface::ByteBuffer& message) {
+    SessionPacket packet{};
+    packet.type = PayloadType::IPMI;
+    packet.encrypted = true;
+    packet.authenticated = true;
+    packet.session_id = session.rakp.bmc_session_id;
+    packet.sequence = ++session.sequence;
+    packet.payload = message;
+    const auto datagram = encode_packet(packet, &session.keys);
+    if (::send(session.fd, datagram.data(), datagram.size(), 0) < 0) {
+        log_debug("ipmi", "Cannot send RMCP+ packet to " << session.info << ": " << strerror(errno));
+    }
+    session.last_activity = Clock::now();
+}
+
+
+void SessionEngine::receive(Session& session) {
+    std::array<std::uint8_t, MAX_DATAGRAM_SIZE> buffer{};
+    while (true) {
+        const auto received = ::recv(session.fd, buffer.data(), buffer.size(), 0);
+        if (received < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            break;
+        }
+        handle_packet(session, buffer.data(), std::size_t(received));
+    }
+}
+
+
+void SessionEngine::handle_packet(Session& session, const std::uint8_t* data, std::size_t size) {
+    const bool protected_session = (Session::State::PRIVILEGE == session.state)
+                                   || (Session::State::ACTIVE == session.state);
+    SessionPacket packet{};
+    if (!decode_packet(data, size, protected_session ? &session.keys : nullptr, packet)) {
+        log_debug("ipmi", "Invalid RMCP+ packet from " << session.info);
+        return;
+    }
+    switch (packet.type) {
+        case PayloadType::OPEN_SESSION_RESPONSE:
+            handle_open_session_response(session, packet.payload);
+            break;
+        case PayloadType::RAKP_2:
+            handle_rakp2(session, packet.payload);
+            break;
+        case PayloadType::RAKP_4:
+            handle_rakp4(session, packet.payload);
+            break;
+        case PayloadType::IPMI:
+            if (protected_session && packet.authenticated && packet.encrypted
+                && packet.session_id == session.rakp.console_session_id) {
+                handle_response(session, packet.payload);
+            }
+            break;
+        case PayloadType::OPEN_SESSION_REQUEST:
+        case PayloadType::RAKP_1:
+        case PayloadType::RAKP_3:
+        default:
+            break;
+    }
+}
+
+
+void SessionEngine::handle_open_session_response(Session& session, const IpmiInterface::ByteBuffer& payload) {
+    if (Session::State::OPEN_SESSION != session.state || payload.size() < OPEN_SESSION_RESPONSE_SIZE
+        || read_u32(payload, 4) != session.rakp.console_session_id) {
+        return;
+    }
+    if (0 != payload[1]) {
+        fail_session(session, "BMC " + session.info + " rejected RMCP+ session with status "
+                              + std::to_string(unsigned(payload[1])) + ".");
+        return;
+    }
+    session.rakp.bmc_session_id = read_u32(payload, 8);
+    session.rakp.console_random = get_random_bytes(RANDOM_NUMBER_SIZE);
+
+    ByteBuffer rakp1{0x00, 0x00, 0x00, 0x00};
+    push_u32(rakp1, session.rakp.bmc_session_id);
+    rakp1.insert(rakp1.end(), session.rakp.console_random.begin(), session.rakp.console_random.end());
+    rakp1.insert(rakp1.end(), {session.rakp.role, 0x00, 0x00, std::uint8_t(session.username.size())});
+    rakp1.insert(rakp1.end(), session.username.begin(), session.username.end());
+
+    session.state = Session::State::RAKP_1;
+    session.handshake_type = PayloadType::RAKP_1;
+    session.handshake_payload = std::move(rakp1);
+    session.handshake_attempts = 0;
+    send_handshake(session);
+}
+
+
+void SessionEngine::handle_rakp2(Session& session, const IpmiInterface::ByteBuffer& payload) {
+    if (Session::State::RAKP_1 != session.state || payload.size() < 8
+        || read_u32(payload, 4) != session.rakp.console_session_id) {
+        return;
+    }
+    if (0 != payload[1] || payload.size() < RAKP_2_SIZE) {
+        fail_session(session, "BMC " + session.info + " rejected RAKP 1 with status "
+                              + std::to_string(unsigned(payload[1])) + ".");
+        return;
+    }
+    auto it = payload.begin() + 8;
+    session.rakp.bmc_random.assign(it, it + RANDOM_NUMBER_SIZE);
+    it += RANDOM_NUMBER_SIZE;
+    session.rakp.bmc_guid.assign(it, it + GUID_SIZE);
+    it += GUID_SIZE;
+    if (!std::equal(it, it + HMAC_SHA1_SIZE, session.rakp.get_rakp2_auth_code().begin())) {
+        fail_session(session, "RMCP+ authentication of " + session.info + " failed: invalid credentials.");
+        return;
+    }
+
+    ByteBuffer rakp3{0x00, 0x00, 0x00, 0x00};
+    push_u32(rakp3, session.rakp.bmc_session_id);
+    const auto auth_code = session.rakp.get_rakp3_auth_code();
+    rakp3.insert(rakp3.end(), auth_code.begin(), auth_code.end());
+
+    session.state = Session::State::RAKP_3;
+    session.handshake_type = PayloadType::RAKP_3;
+    session.handshake_payload = std::move(rakp3);
+    session.handshake_attempts = 0;
+    send_handshake(session);
+}
+
+
+void SessionEngine::handle_rakp4(Session& session, const IpmiInterface::ByteBuffer& payload) {
+    if (Session::State::RAKP_3 != session.state || payload.size() < 8
+        || read_u32(payload, 4) != session.rakp.console_session_id) {
+        return;
+    }
+    if (0 != payload[1] || payload.size() < RAKP_4_SIZE) {
+        fail_session(session, "BMC " + session.info + " rejected RAKP 3 with status "
+                              + std::to_string(unsigned(payload[1])) + ".");
+        return;
+    }
+    const auto icv = session.rakp.get_rakp4_integrity_check_value();
+    if (!std::equal(icv.begin(), icv.end(), payload.begin() + 8)) {
+        fail_session(session, "RMCP+ authentication of " + session.info + " failed: invalid BMC signature.");
+        return;
+    }
+
+    IpmiMessage privilege{};
+    privilege.netfn = NETFN_APP;
+    privilege.command = CMD_SET_SESSION_PRIVILEGE_LEVEL;
+    privilege.data = {PRIVILEGE_ADMINISTRATOR};
+
+    session.keys = session.rakp.get_session_keys();
+    session.state = Session::State::PRIVILEGE;
+    session.handshake_type = PayloadType::IPMI;
+    session.handshake_payload = encode_request(privilege);
+    session.handshake_attempts = 0;
+    send_handshake(session);
+}
+
+
+void SessionEngine::handle_response(Session& session, const IpmiInterface::ByteBuffer& payload) {
+    IpmiMessage response{};
+    if (!decode_response(payload, response)) {
+        return;
+    }
+    session.last_activity = Clock::now();
+
+    if (Session::State::PRIVILEGE == session.state) {
+        if (0 != response.sequence || CMD_SET_SESSION_PRIVILEGE_LEVEL != response.command) {
+            return;
+        }
+        if (0 != response.data[0]) {
+            fail_session(session, "Cannot set RMCP+ session privilege on " + session.info + ".");
+            return;
+        }
+        ++m_established;
+        session.state = Session::State::ACTIVE;
+        log_debug("ipmi", "RMCP+ session with " << session.info << " established.");
+        dispatch(session);
+        return;
+    }
+
+    if (response.sequence < FIRST_SEQUENCE || response.sequence >= SEQUENCE_NUMBERS) {
+        return;
+    }
+    auto& request = session.in_flight[response.sequence];
+    if (!request) {
+        /* late response of a request which already timed out */
+        return;
+    }
+
+    ByteBuffer result{};
+    if (request->bridged && CMD_SEND_MESSAGE == response.command && (NETFN_APP | 1) == response.netfn) {
+        IpmiMessage inner{};
+        if (0 != response.data[0]) {
+            result = {response.data[0]};
+        }
+        else if (response.data.size() > 1
+                 && decode_response(ByteBuffer(response.data.begin() + 1, response.data.end()), inner)) {
+            result = std::move(inner.data);
+        }
+        else {
+            /* response of the target controller follows */
+            return;
+        }
+    }
+    else if (request->command == response.command && (request->netfn | 1) == response.netfn) {
+        result = std::move(response.data);
+    }
+    else {
+        return;
+    }
+
+    ++m_responses;
+    request->promise.set_value(std::move(result));
+    request.reset();
+    --session.outstanding;
+    dispatch(session);
+}
+
+
+void SessionEngine::fail_session(Session& session, const std::string& reason) {
+    if (Session::State::CLOSED != session.state) {
+        session.state = Session::State::IDLE;
+    }
+    log_warning("ipmi", reason);
+    const auto error = make_error(reason);
+    for (auto& request : session.in_flight) {
+        if (request) {
+            request->promise.set_exception(error);
+            request.reset();
+        }
+    }
+    session.outstanding = 0;
+    for (auto& request : session.waiting) {
+        request->promise.set_exception(error);
+    }
+    session.waiting.clear();
+}
+
+
+void SessionEngine::release(Session& session) {
+    if (Session::State::CLOSED == session.state) {
+        return;
+    }
+    if (Session::State::ACTIVE == session.state) {
+        /* best effort, BMC drops the session after its timeout anyway */
+        IpmiMessage close{};
+        close.netfn = NETFN_APP;
+        close.command = CMD_CLOSE_SESSION;
+        push_u32(close.data, session.rakp.bmc_session_id);
+        send_ipmi(session, encode_request(close));
+    }
+    session.state = Session::State::CLOSED;
+    if (0 != session.outstanding || !session.waiting.empty()) {
+        fail_session(session, "RMCP+ session with " + session.info + " closed.");
+    }
+    const int fd = session.fd;
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    /* session may be destroyed here */
+    m_sessions.erase(fd);
+}
@@ -64,23 +64,76 @@ bool ipmi::Sel::process_records() {
     last_erase = sel_info_resp.get_last_erase_timestamp();
     SelReservationId reservation = get_reservation();
 
-    unsigned read_records = 0;
+    if (!read_records(reservation)) {
+        /* SEL content was cleared, all records are to be read from the scratch */
+        restart();
+        read_records(reservation);
+    }
+
+    /* remove all rolled-out records */
+    if ((!previous_failed) && (!records.empty())) {
+        /* read very first record in the SEL */
+        SelEntryId record_id{};
+        try {
+            request::GetSelEntry get_sel_entry_req{FIRST_ENTRY, reservation};
+            response::GetSelEntry get_sel_entry_resp{};
+
+            controller.send(get_sel_entry_req, get_sel_entry_resp);
+            record_id = ipmi::SelRecord::get_id(get_sel_entry_resp.get_entry());
+        }
+        catch (const ResponseError&) {
+            record_id = records.front()->get_id();
+        }
+
+        /* look for very first one, and remove all records before it */
+        RecordVect::iterator record_it;
+        for (record_it = records.begin(); record_it != records.end(); record_it++) {
+            if ((*record_it)->get_id() == record_id) {
+                if (record_it != records.begin()) {
+                    log_debug("telemetry", (record_it - records.begin()) << " records rolled out from SEL");
+                    records.erase(records.begin(), record_it);
+                }
+                break;
+            }
+        }
+
+        /*
+         * It is possible to detect removed records only when records are read from the scratch.
+         * More records than reported by the SEL means that some of them were deleted.
+         */
+        if (records.size() > sel_info_resp.get_entries_count()) {
+            log_debug("telemetry", "Records removed from SEL, " << records.size() << " records kept, "
+                                   << sel_info_resp.get_entries_count() << " in SEL");
+            restart();
+            read_records(reservation);
+        }
+    }
+
+    return true;
+}
+
+
+bool ipmi::Sel::read_records(SelReservationId reservation) {
+    unsigned read_count = 0;
     SelEntryId record_id = last_read_record;
     for (;;) {
         /* read whole records, all records are 16 bytes and fit into single message */
         request::GetSelEntry get_sel_entry_req{record_id, reservation};
         response::GetSelEntry get_sel_entry_resp{};
 
+        const bool cursor_record = (record_id == last_read_record) && (last_read_record != FIRST_ENTRY);
         try {
             controller.send(get_sel_entry_req, get_sel_entry_resp);
-            read_records++;
         }
         catch (const RequestedRecordNotPresentError&) {
-            /* SEL content was cleared, last record does not exist */
-            log_debug("telemetry", "Last record was removed: SEL cleared?");
-            last_read_record = FIRST_ENTRY;
-            records.clear();
-            return true;
+            if (cursor_record) {
+                /* SEL content was cleared, last record does not exist */
+                log_debug("telemetry", "Last record was removed: SEL cleared?");
+                return false;
+            }
+            /* SEL is empty or the record was removed while reading, continue in next cycle */
+            previous_failed = (record_id != FIRST_ENTRY);
+            break;
         }
         catch (const ResponseError& e) {
             /* All read data should be processed, it should continue from the last read one */
@@ -89,13 +142,24 @@ bool ipmi::Sel::process_records() {
             break;
         }
 
-        if (record_id == FIRST_ENTRY) {
-            record_id = ipmi::SelRecord::get_id(get_sel_entry_resp.get_entry());
-            log_debug("telemetry", "First record in SEL " << std::hex << record_id);
+        if (cursor_record) {
+            /* last record is read again only to get appropriate next record id.. */
+            if (get_sel_entry_resp.get_entry() != last_read_entry) {
+                log_debug("telemetry", "Last record was replaced: SEL cleared?");
+                return false;
+            }
+        }
+        else {
+            if (record_id == FIRST_ENTRY) {
+                record_id = ipmi::SelRecord::get_id(get_sel_entry_resp.get_entry());
+                log_debug("telemetry", "First record in SEL " << std::hex << record_id);
+            }
+            records.emplace_back(build(get_sel_entry_resp.get_entry()));
+            read_count++;
         }
-        records.emplace_back(build(get_sel_entry_resp.get_entry()));
         /* in next loop last record must be read to get appropriate next record id.. */
         last_read_record = record_id;
+        last_read_entry = get_sel_entry_resp.get_entry();
 
         /* get next entry if there are some. Next will be read on SEL changed */
         if (get_sel_entry_resp.is_last_record()) {
@@ -105,38 +169,16 @@ bool ipmi::Sel::process_records() {
         record_id = get_sel_entry_resp.get_next_entry_id();
     }
     log_debug("telemetry", "Last record read from SEL " << std::hex << record_id
-                                    << ", " << std::dec << read_records << " records read");
-
-    /* remove all rolled-out records */
-    if ((!previous_failed) && (!records.empty())) {
-        /* read very first record in the SEL */
-        try {
-            request::GetSelEntry get_sel_entry_req{FIRST_ENTRY, reservation};
-            response::GetSelEntry get_sel_entry_resp{};
-
-            controller.send(get_sel_entry_req, get_sel_entry_resp);
-            record_id = ipmi::SelRecord::get_id(get_sel_entry_resp.get_entry());
-        }
-        catch (const ResponseError&) {
-            record_id = records.front()->get_id();
-        }
-
-        /* look for very first one, and remove all records before it */
-        RecordVect::iterator record_it;
-        for (record_it = records.begin(); record_it != records.end(); record_it++) {
-            if ((*record_it)->get_id() == record_id) {
-                if (record_it != records.begin()) {
-                    log_debug("telemetry", (record_it - records.begin()) << " records rolled out from SEL");
-                    records.erase(records.begin(), record_it);
-                }
-                break;
-            }
-        }
-    }
+                                    << ", " << std::dec << read_count << " records read");
+    return true;
+}
 
-    /* It is possible to detect removed records only when records are read from the scratch.. */
 
-    return true;
+void ipmi::Sel::restart() {
+    records.clear();
+    last_read_record = FIRST_ENTRY;
+    last_read_entry.clear();
+    generation++;
 }
 
 ipmi::Sel::RecordVect ipmi::Sel::get_records(ipmi::Sel::RecordFilter filter) const {
@@ -0,0 +1,238 @@
+/*!
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sel_test.cpp
+ */
+
+#include "ipmi/sel.hpp"
+#include "ipmi/command/generic/enums.hpp"
+#include "ipmi/manager/ipmitool/lan_connection_data.hpp"
+#include <gtest/gtest.h>
+
+using namespace ipmi::command::generic;
+
+namespace {
+
+constexpr std::uint16_t LAST_RECORD = 0xffff;
+constexpr std::uint8_t SENSOR_SPECIFIC = 0x6f;
+
+/*! BMC with SEL, records are given consecutive IDs, the oldest ones are overwritten when SEL is full */
+class FakeSelBmc : public ipmi::IpmiController {
+public:
+    using Entry = ipmi::IpmiInterface::ByteBuffer;
+
+    FakeSelBmc(std::size_t _capacity) :
+        ipmi::IpmiController(std::make_shared<ipmi::manager::ipmitool::LanConnectionData>("10.0.0.1", 623, "u", "p")),
+        capacity(_capacity) {}
+
+    void send(const ipmi::Request& request, ipmi::Response& response) override {
+        ++requests;
+        response.do_unpack(process(request));
+    }
+
+    void send(const ipmi::Request& request, const ipmi::BridgeInfo&, ipmi::Response& response) override {
+        send(request, response);
+    }
+
+    void add(unsigned count) {
+        for (unsigned i = 0; i < count; ++i) {
+            ++add_timestamp;
+            const auto id = next_id++;
+            entries.push_back({std::uint8_t(id & 0xff), std::uint8_t(id >> 8), 0x02,
+                               std::uint8_t(add_timestamp), std::uint8_t(add_timestamp >> 8),
+                               std::uint8_t(add_timestamp >> 16), std::uint8_t(add_timestamp >> 24),
+                               0x20, 0x00, 0x04, 0x07, std::uint8_t(id), SENSOR_SPECIFIC, 0x01, 0xff, 0xff});
+            if (entries.size() > capacity) {
+                entries.erase(entries.begin());
+            }
+        }
+    }
+
+    void clear() {
+        entries.clear();
+        next_id = 1;
+        ++erase_timestamp;
+    }
+
+    void remove(std::uint16_t id) {
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (ipmi::SelRecord::get_id(*it) == id) {
+                entries.erase(it);
+                ++erase_timestamp;
+                return;
+            }
+        }
+    }
+
+    std::vector<std::uint16_t> get_ids() const {
+        std::vector<std::uint16_t> ids{};
+        for (const auto& entry : entries) {
+            ids.push_back(ipmi::SelRecord::get_id(entry));
+        }
+        return ids;
+    }
+
+    unsigned requests{0};
+
+private:
+    ipmi::IpmiInterface::ByteBuffer process(const ipmi::Request& request) {
+        const auto data = request.do_pack();
+        switch (request.get_command()) {
+            case Cmd::GET_SEL_TIME:
+                return {0x00, 0x00, 0x00, 0x00, 0x5c};
+            case Cmd::GET_SEL_INFO:
+                return {0x00, 0x51, std::uint8_t(entries.size()), std::uint8_t(entries.size() >> 8), 0x00, 0x10,
+                        std::uint8_t(add_timestamp), std::uint8_t(add_timestamp >> 8),
+                        std::uint8_t(add_timestamp >> 16), std::uint8_t(add_timestamp >> 24),
+                        std::uint8_t(erase_timestamp), std::uint8_t(erase_timestamp >> 8),
+                        std::uint8_t(erase_timestamp >> 16), std::uint8_t(erase_timestamp >> 24), 0x0a};
+            case Cmd::RESERVE_SEL:
+                return {0x00, 0x01, 0x00};
+            case Cmd::GET_SEL_ENTRY: {
+                const auto id = std::uint16_t(data[2] | data[3] << 8);
+                for (std::size_t pos = 0; pos < entries.size(); ++pos) {
+                    if ((id == 0) || (ipmi::SelRecord::get_id(entries[pos]) == id)) {
+                        const auto next = (pos + 1 < entries.size())
+                                          ? ipmi::SelRecord::get_id(entries[pos + 1]) : LAST_RECORD;
+                        ipmi::IpmiInterface::ByteBuffer response{0x00, std::uint8_t(next & 0xff),
+                                                                 std::uint8_t(next >> 8)};
+                        response.insert(response.end(), entries[pos].begin(), entries[pos].end());
+                        return response;
+                    }
+                }
+                return {0xcb};
+            }
+            default:
+                return {0xc1};
+        }
+    }
+
+    const std::size_t capacity;
+    std::uint16_t next_id{1};
+    std::uint32_t add_timestamp{0x5c000000};
+    std::uint32_t erase_timestamp{0x5c000000};
+    std::vector<Entry> entries{};
+};
+
+
+std::vector<std::uint16_t> get_ids(const ipmi::Sel& sel) {
+    std::vector<std::uint16_t> ids{};
+    for (const auto& record : sel.get_records()) {
+        ids.push_back(record->get_id());
+    }
+    return ids;
+}
+
+}
+
+TEST(SelTest, ReadIncrementally) {
+    FakeSelBmc bmc{100};
+    bmc.add(10);
+
+    ipmi::Sel sel{bmc};
+    ASSERT_TRUE(sel.process_records());
+    ASSERT_EQ(bmc.get_ids(), get_ids(sel));
+    const auto generation = sel.get_generation();
+
+    /* nothing changed: time and SEL info only */
+    bmc.requests = 0;
+    ASSERT_FALSE(sel.process_records());
+    ASSERT_EQ(2, bmc.requests);
+
+    /* time, info, reservation, last read record, new records and the very first one */
+    bmc.requests = 0;
+    bmc.add(3);
+    ASSERT_TRUE(sel.process_records());
+    ASSERT_EQ(bmc.get_ids(), get_ids(sel));
+    ASSERT_EQ(8, bmc.requests);
+    ASSERT_EQ(generation, sel.get_generation());
+}
+
+TEST(SelTest, Cleared) {
+    FakeSelBmc bmc{100};
+    bmc.add(10);
+
+    ipmi::Sel sel{bmc};
+    sel.process_records();
+    const auto generation = sel.get_generation();
+
+    /* last read record does not exist */
+    bmc.clear();
+    bmc.add(3);
+    ASSERT_TRUE(sel.process_records());
+    ASSERT_EQ(bmc.get_ids(), get_ids(sel));
+    ASSERT_NE(generation, sel.get_generation());
+
+    /* last read record ID is reused by another record */
+    bmc.clear();
+    bmc.add(5);
+    ASSERT_TRUE(sel.process_records());
+    ASSERT_EQ(bmc.get_ids(), get_ids(sel));
+
+    bmc.clear();
+    ASSERT_TRUE(sel.process_records());
+    ASSERT_TRUE(sel.get_records().empty());
+
+    bmc.add(1);
+    ASSERT_TRUE(sel.process_records());
+    ASSERT_EQ(bmc.get_ids(), get_ids(sel));
+}
+
+TEST(SelTest, RolledOutAndRemoved) {
+    FakeSelBmc bmc{10};
+    bmc.add(10);
+
+    ipmi::Sel sel{bmc};
+    sel.process_records();
+    const auto generation = sel.get_generation();
+
+    bmc.add(4);
+    ASSERT_TRUE(sel.process_records());
+    ASSERT_EQ(bmc.get_ids(), get_ids(sel));
+    ASSERT_EQ(generation, sel.get_generation());
+
+    bmc.remove(8);
+    ASSERT_TRUE(sel.process_records());
+    ASSERT_EQ(bmc.get_ids(), get_ids(sel));
+}
+
+/*!
+ * @brief IPMI transactions per SEL change, reading whole SEL vs reading from the last read record
+ */
+TEST(SelTest, TransactionsPerChangeBenchmark) {
+    constexpr unsigned CHANGES = 20;
+    FakeSelBmc full_bmc{512};
+    FakeSelBmc incremental_bmc{512};
+    full_bmc.add(500);
+    incremental_bmc.add(500);
+
+    ipmi::Sel incremental{incremental_bmc};
+    incremental.process_records();
+
+    full_bmc.requests = 0;
+    incremental_bmc.requests = 0;
+    for (unsigned i = 0; i < CHANGES; ++i) {
+        full_bmc.add(1);
+        ipmi::Sel full{full_bmc};
+        full.process_records();
+        ASSERT_EQ(full_bmc.get_ids(), get_ids(full));
+
+        incremental_bmc.add(1);
+        incremental.process_records();
+        ASSERT_EQ(incremental_bmc.get_ids(), get_ids(incremental));
+    }
+
+    /* whole SEL is read for each change, incremental read costs the same regardless of SEL size */
+    EXPECT_LT(500 * CHANGES, full_bmc.requests);
+    EXPECT_GE(8 * CHANGES, incremental_bmc.requests);
+}
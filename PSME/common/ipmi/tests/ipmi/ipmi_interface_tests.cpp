@@ -156,6 +156,40 @@ TEST(IpmiInterface, EmptyResponse) {
     ASSERT_EQ(1, resp.get_size());
 }
 
+/*!
+ * @brief Test batch of requests sent under the interface lock
+ */
+TEST(IpmiInterface, Batch) {
+    TestManagementController::initialize_factory();
+
+    testing::TestManagementController ctrl("batch");
+
+    testing::TestRequest req{};
+    std::vector<testing::TestResponse> resps(3);
+    ipmi::IpmiController::Exchanges exchanges{};
+    for (auto& resp : resps) {
+        exchanges.push_back({req, resp, nullptr});
+    }
+
+    ctrl.send_batch(exchanges, {});
+    for (std::size_t i = 0; i < resps.size(); ++i) {
+        ASSERT_FALSE(exchanges[i].error);
+        ASSERT_EQ("batch", resps[i].get_descr());
+        ASSERT_EQ(i + 1, resps[i].get_serial());
+    }
+
+    /* bridged requests are rejected by the test interface, each exchange fails separately */
+    ctrl.send_batch(exchanges, {1, 2});
+    for (const auto& exchange : exchanges) {
+        ASSERT_THROW(std::rethrow_exception(exchange.error), ipmi::ResponseError);
+    }
+
+    /* all requests of both batches reached the interface */
+    testing::TestResponse resp{};
+    ctrl.send(req, resp);
+    ASSERT_EQ(7, resp.get_serial());
+}
+
 static void scoped_loop() {
     testing::TestRequest req{};
     testing::TestResponse resp{};
@@ -0,0 +1,312 @@
+/*!
+ * @brief BMC simulator serving RMCP+ sessions on a local UDP port.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp_bmc_simulator.cpp
+ */
+
+#include "rmcpp_bmc_simulator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace testing;
+using namespace ipmi::manager::rmcpp::protocol;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::uint8_t CMD_GET_DEVICE_ID = 0x01;
+constexpr std::uint8_t TEST_NETFN = 0x30;
+constexpr std::uint8_t TEST_CMD = 0xff;
+
+constexpr std::uint8_t STATUS_UNAUTHORIZED_NAME = 0x0D;
+constexpr std::uint8_t STATUS_INVALID_INTEGRITY_CHECK_VALUE = 0x0F;
+constexpr std::uint8_t INVALID_COMMAND = 0xC1;
+
+void push_u32(ByteBuffer& buffer, std::uint32_t value) {
+    for (unsigned i = 0; i < sizeof(value); ++i) {
+        buffer.push_back(std::uint8_t(value >> (8 * i)));
+    }
+}
+
+std::uint32_t read_u32(const std::uint8_t* data) {
+    return std::uint32_t(data[0]) | (std::uint32_t(data[1]) << 8) |
+           (std::uint32_t(data[2]) << 16) | (std::uint32_t(data[3]) << 24);
+}
+
+}
+
+
+RmcppBmcSimulator::RmcppBmcSimulator(const std::string& username, const std::string& password) :
+    m_username(username), m_password(password) {
+
+    m_socket = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (m_socket < 0 || 0 != ::bind(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address))
+        || 0 != ::getsockname(m_socket, reinterpret_cast<sockaddr*>(&address), &length)) {
+        throw std::runtime_error("Cannot start BMC simulator");
+    }
+    m_port = ntohs(address.sin_port);
+    m_thread = std::thread(&RmcppBmcSimulator::run, this);
+}
+
+
+RmcppBmcSimulator::~RmcppBmcSimulator() {
+    m_running = false;
+    m_thread.join();
+    ::close(m_socket);
+}
+
+
+void RmcppBmcSimulator::run() {
+    std::array<std::uint8_t, 1024> buffer{};
+    while (m_running) {
+        /* short timeout, so the simulator notices it is stopped */
+        int timeout = 10;
+        const auto now = Clock::now();
+        for (const auto& pending : m_pending) {
+            const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(pending.due - now).count();
+            timeout = std::max(0, std::min(timeout, int(wait)));
+        }
+
+        pollfd fd{m_socket, POLLIN, 0};
+        if (::poll(&fd, 1, timeout) > 0) {
+            sockaddr_in address{};
+            socklen_t length = sizeof(address);
+            const auto received = ::recvfrom(m_socket, buffer.data(), buffer.size(), 0,
+                                             reinterpret_cast<sockaddr*>(&address), &length);
+            if (received > 0) {
+                handle(address, buffer.data(), std::size_t(received));
+            }
+        }
+
+        /* pending responses are kept in order of arrival, each of them is due independently */
+        const auto current = Clock::now();
+        auto due = std::stable_partition(m_pending.begin(), m_pending.end(),
+                                         [current](const Pending& pending) { return pending.due <= current; });
+        for (auto it = m_pending.begin(); it != due; ++it) {
+            send(it->address, it->datagram);
+        }
+        m_pending.erase(m_pending.begin(), due);
+    }
+}
+
+
+void RmcppBmcSimulator::send(const sockaddr_in& address, const ByteBuffer& datagram) {
+    ::sendto(m_socket, datagram.data(), datagram.size(), 0, reinterpret_cast<const sockaddr*>(&address),
+             sizeof(address));
+}
+
+
+void RmcppBmcSimulator::handle(const sockaddr_in& address, const std::uint8_t* data, std::size_t size) {
+    constexpr std::size_t HEADERS_SIZE = 16;
+    if (size < HEADERS_SIZE) {
+        return;
+    }
+    const auto type = PayloadType(data[5] & 0x3F);
+    SessionPacket packet{};
+    if (PayloadType::IPMI == type) {
+        auto it = m_sessions.find(read_u32(data + 6));
+        if (it == m_sessions.end() || !it->second.active || !decode_packet(data, size, &it->second.keys, packet)
+            || !packet.authenticated || !packet.encrypted) {
+            return;
+        }
+        handle_request(address, it->second, packet.payload);
+        return;
+    }
+    if (!decode_packet(data, size, nullptr, packet)) {
+        return;
+    }
+    switch (type) {
+        case PayloadType::OPEN_SESSION_REQUEST:
+            handle_open_session(address, packet.payload);
+            break;
+        case PayloadType::RAKP_1:
+            handle_rakp1(address, packet.payload);
+            break;
+        case PayloadType::RAKP_3:
+            handle_rakp3(address, packet.payload);
+            break;
+        case PayloadType::IPMI:
+        case PayloadType::OPEN_SESSION_RESPONSE:
+        case PayloadType::RAKP_2:
+        case PayloadType::RAKP_4:
+        default:
+            break;
+    }
+}
+
+
+void RmcppBmcSimulator::handle_open_session(const sockaddr_in& address, const ByteBuffer& payload) {
+    if (payload.size() < 32) {
+        return;
+    }
+    const auto bmc_session_id = m_next_session_id++;
+    auto& session = m_sessions[bmc_session_id];
+    session.rakp.console_session_id = read_u32(payload.data() + 4);
+    session.rakp.bmc_session_id = bmc_session_id;
+
+    SessionPacket response{};
+    response.type = PayloadType::OPEN_SESSION_RESPONSE;
+    response.payload = {payload[0], 0x00, PRIVILEGE_ADMINISTRATOR, 0x00};
+    push_u32(response.payload, session.rakp.console_session_id);
+    push_u32(response.payload, bmc_session_id);
+    response.payload.insert(response.payload.end(), payload.begin() + 8, payload.begin() + 32);
+    send(address, encode_packet(response, nullptr));
+}
+
+
+void RmcppBmcSimulator::handle_rakp1(const sockaddr_in& address, const ByteBuffer& payload) {
+    if (payload.size() < 28 || payload.size() < 28u + payload[27]) {
+        return;
+    }
+    auto it = m_sessions.find(read_u32(payload.data() + 4));
+    if (it == m_sessions.end()) {
+        return;
+    }
+    auto& rakp = it->second.rakp;
+    rakp.console_random.assign(payload.begin() + 8, payload.begin() + 24);
+    rakp.role = payload[24];
+    rakp.username.assign(payload.begin() + 28, payload.begin() + 28 + payload[27]);
+    rakp.password = m_password;
+    rakp.bmc_random = get_random_bytes(RANDOM_NUMBER_SIZE);
+    rakp.bmc_guid = ByteBuffer(GUID_SIZE, 0xA5);
+
+    SessionPacket response{};
+    response.type = PayloadType::RAKP_2;
+    response.payload = {payload[0], 0x00, 0x00, 0x00};
+    push_u32(response.payload, rakp.console_session_id);
+    if (rakp.username != m_username) {
+        response.payload[1] = STATUS_UNAUTHORIZED_NAME;
+        send(address, encode_packet(response, nullptr));
+        return;
+    }
+    response.payload.insert(response.payload.end(), rakp.bmc_random.begin(), rakp.bmc_random.end());
+    response.payload.insert(response.payload.end(), rakp.bmc_guid.begin(), rakp.bmc_guid.end());
+    const auto auth_code = rakp.get_rakp2_auth_code();
+    response.payload.insert(response.payload.end(), auth_code.begin(), auth_code.end());
+    send(address, encode_packet(response, nullptr));
+}
+
+
+void RmcppBmcSimulator::handle_rakp3(const sockaddr_in& address, const ByteBuffer& payload) {
+    if (payload.size() < 8 + HMAC_SHA1_SIZE) {
+        return;
+    }
+    auto it = m_sessions.find(read_u32(payload.data() + 4));
+    if (it == m_sessions.end()) {
+        return;
+    }
+    auto& session = it->second;
+
+    SessionPacket response{};
+    response.type = PayloadType::RAKP_4;
+    response.payload = {payload[0], 0x00, 0x00, 0x00};
+    push_u32(response.payload, session.rakp.console_session_id);
+    const auto auth_code = session.rakp.get_rakp3_auth_code();
+    if (!std::equal(auth_code.begin(), auth_code.end(), payload.begin() + 8)) {
+        response.payload[1] = STATUS_INVALID_INTEGRITY_CHECK_VALUE;
+        send(address, encode_packet(response, nullptr));
+        return;
+    }
+    if (!session.active) {
+        session.active = true;
+        session.keys = session.rakp.get_session_keys();
+        ++m_activated;
+    }
+    const auto icv = session.rakp.get_rakp4_integrity_check_value();
+    response.payload.insert(response.payload.end(), icv.begin(), icv.end());
+    send(address, encode_packet(response, nullptr));
+}
+
+
+void RmcppBmcSimulator::handle_request(const sockaddr_in& address, Session& session, const ByteBuffer& payload) {
+    IpmiMessage request{};
+    if (!decode_request(payload, request)) {
+        return;
+    }
+    ++m_requests;
+    if (m_drop > 0) {
+        --m_drop;
+        return;
+    }
+
+    if (NETFN_APP == request.netfn && CMD_SET_SESSION_PRIVILEGE_LEVEL == request.command) {
+        respond(address, session, request, {0x00, request.data.empty() ? PRIVILEGE_ADMINISTRATOR : request.data[0]});
+    }
+    else if (NETFN_APP == request.netfn && CMD_CLOSE_SESSION == request.command) {
+        session.active = false;
+    }
+    else if (NETFN_APP == request.netfn && CMD_GET_DEVICE_ID == request.command) {
+        respond(address, session, request, {0x00, 0x20, 0x81, 0x01, 0x02, 0x02, 0xBF,
+                                            0x57, 0x01, 0x00, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00});
+    }
+    else if (ECHO_NETFN == request.netfn && ECHO_CMD == request.command) {
+        ByteBuffer data{0x00};
+        data.insert(data.end(), request.data.begin(), request.data.end());
+        respond(address, session, request, data);
+    }
+    else if (TEST_NETFN == request.netfn && TEST_CMD == request.command) {
+        respond(address, session, request, {0x00, ++m_serial, 'b', 'm', 'c'});
+    }
+    else if (NETFN_APP == request.netfn && CMD_SEND_MESSAGE == request.command && request.data.size() > 1) {
+        IpmiMessage inner{};
+        if (!decode_request(ByteBuffer(request.data.begin() + 1, request.data.end()), inner)) {
+            respond(address, session, request, {INVALID_COMMAND});
+            return;
+        }
+        /* tracked request: Send Message is acknowledged, response of the target follows */
+        respond(address, session, request, {0x00});
+        inner.rs_address = BMC_ADDRESS;
+        inner.rq_address = REMOTE_CONSOLE_ADDRESS;
+        respond(address, session, inner, {0x00, std::uint8_t(request.data[0] & 0x0F), request.data[1]});
+    }
+    else {
+        respond(address, session, request, {INVALID_COMMAND});
+    }
+}
+
+
+void RmcppBmcSimulator::respond(const sockaddr_in& address, Session& session, const IpmiMessage& request,
+                                const ByteBuffer& data) {
+    IpmiMessage response{request};
+    response.netfn = std::uint8_t(request.netfn | 1);
+    response.data = data;
+
+    SessionPacket packet{};
+    packet.type = PayloadType::IPMI;
+    packet.encrypted = true;
+    packet.authenticated = true;
+    packet.session_id = session.rakp.console_session_id;
+    packet.sequence = ++session.sequence;
+    packet.payload = encode_response(response);
+
+    Pending pending{};
+    pending.due = Clock::now() + m_delay.load();
+    pending.address = address;
+    pending.datagram = encode_packet(packet, &session.keys);
+    m_pending.emplace_back(std::move(pending));
+    m_max_outstanding = std::max(m_max_outstanding.load(), unsigned(m_pending.size()));
+}
@@ -0,0 +1,133 @@
+/*!
+ * @brief BMC simulator serving RMCP+ sessions on a local UDP port.
+ *
+ * Implements BMC side of cipher suite 3 sessions. Requests are processed concurrently with
+ * configurable delay, so pipelining of the session engine is observable.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp_bmc_simulator.hpp
+ */
+
+#pragma once
+
+#include "ipmi/manager/rmcpp/protocol.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+
+namespace testing {
+
+class RmcppBmcSimulator final {
+public:
+    using ByteBuffer = ipmi::manager::rmcpp::protocol::ByteBuffer;
+
+    /*! Echo command: response contains request data */
+    constexpr static std::uint8_t ECHO_NETFN = 0x30;
+    constexpr static std::uint8_t ECHO_CMD = 0xfe;
+
+    RmcppBmcSimulator(const std::string& username, const std::string& password);
+    ~RmcppBmcSimulator();
+
+    RmcppBmcSimulator(const RmcppBmcSimulator&) = delete;
+    RmcppBmcSimulator& operator=(const RmcppBmcSimulator&) = delete;
+
+    std::uint16_t get_port() const {
+        return m_port;
+    }
+
+    /*!
+     * @brief Set time of processing of each IPMI request
+     * @param delay processing time
+     */
+    void set_processing_delay(std::chrono::milliseconds delay) {
+        m_delay = delay;
+    }
+
+    /*!
+     * @brief Ignore next IPMI requests
+     * @param count number of requests to be dropped
+     */
+    void drop_requests(unsigned count) {
+        m_drop = count;
+    }
+
+    /*! @return maximal number of requests processed at once */
+    unsigned get_max_outstanding() const {
+        return m_max_outstanding;
+    }
+
+    /*! @return number of IPMI requests received, including dropped ones */
+    unsigned get_requests() const {
+        return m_requests;
+    }
+
+    /*! @return number of sessions activated by RAKP 3 */
+    unsigned get_sessions() const {
+        return m_activated;
+    }
+
+private:
+    struct Session {
+        ipmi::manager::rmcpp::protocol::Rakp rakp{};
+        ipmi::manager::rmcpp::protocol::SessionKeys keys{};
+        bool active{false};
+        std::uint32_t sequence{0};
+    };
+
+    struct Pending {
+        std::chrono::steady_clock::time_point due{};
+        sockaddr_in address{};
+        ByteBuffer datagram{};
+    };
+
+    void run();
+    void handle(const sockaddr_in& address, const std::uint8_t* data, std::size_t size);
+    void handle_open_session(const sockaddr_in& address, const ByteBuffer& payload);
+    void handle_rakp1(const sockaddr_in& address, const ByteBuffer& payload);
+    void handle_rakp3(const sockaddr_in& address, const ByteBuffer& payload);
+    void handle_request(const sockaddr_in& address, Session& session, const ByteBuffer& payload);
+    void respond(const sockaddr_in& address, Session& session,
+                 const ipmi::manager::rmcpp::protocol::IpmiMessage& request, const ByteBuffer& data);
+    void send(const sockaddr_in& address, const ByteBuffer& datagram);
+
+    const std::string m_username;
+    const std::string m_password;
+
+    int m_socket{-1};
+    std::uint16_t m_port{0};
+    std::atomic<bool> m_running{true};
+    std::atomic<std::chrono::milliseconds> m_delay{std::chrono::milliseconds{0}};
+    std::atomic<unsigned> m_drop{0};
+    std::atomic<unsigned> m_max_outstanding{0};
+    std::atomic<unsigned> m_requests{0};
+    std::atomic<unsigned> m_activated{0};
+
+    /*! Sessions by BMC session ID, accessed by the simulator thread only */
+    std::map<std::uint32_t, Session> m_sessions{};
+    std::uint32_t m_next_session_id{0x1000};
+    std::uint8_t m_serial{0};
+    std::vector<Pending> m_pending{};
+
+    std::thread m_thread{};
+};
+
+}
@@ -0,0 +1,318 @@
+/*!
+ * @brief Tests of native RMCP+ communication.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file rmcpp_tests.cpp
+ */
+
+#include "ipmi/ipmi_controller.hpp"
+#include "ipmi/manager/ipmitool/management_controller.hpp"
+#include "ipmi/manager/rmcpp/lan_plus_ipmi_interface.hpp"
+#include "ipmi/manager/rmcpp/protocol.hpp"
+
+#include "rmcpp_bmc_simulator.hpp"
+#include "test_message.hpp"
+
+#include <memory>
+#include <set>
+#include "gtest/gtest.h"
+
+using namespace ipmi::manager::rmcpp;
+using namespace ipmi::manager::rmcpp::protocol;
+
+namespace testing {
+
+namespace {
+
+constexpr const char USERNAME[] = "admin";
+constexpr const char PASSWORD[] = "secret";
+constexpr std::uint8_t CMD_GET_DEVICE_ID = 0x01;
+
+std::shared_ptr<LanPlusConnectionData> make_connection_data(const RmcppBmcSimulator& bmc,
+                                                            const std::string& password = PASSWORD) {
+    auto data = std::make_shared<LanPlusConnectionData>("127.0.0.1", bmc.get_port(), USERNAME, password);
+    data->set_request_timeout(std::chrono::milliseconds{200});
+    return data;
+}
+
+ByteBuffer echo(LanPlusIpmiInterface& intf, const ByteBuffer& data) {
+    return intf.send_async(RmcppBmcSimulator::ECHO_NETFN, RmcppBmcSimulator::ECHO_CMD, 0, {}, data).get();
+}
+
+}
+
+/*!
+ * @brief Protected packets are decoded back, tampered ones are rejected
+ */
+TEST(RmcppProtocol, PacketIntegrity) {
+    Rakp rakp{};
+    rakp.console_session_id = 0x11223344;
+    rakp.bmc_session_id = 0x55667788;
+    rakp.console_random = ByteBuffer(RANDOM_NUMBER_SIZE, 0x01);
+    rakp.bmc_random = ByteBuffer(RANDOM_NUMBER_SIZE, 0x02);
+    rakp.bmc_guid = ByteBuffer(GUID_SIZE, 0x03);
+    rakp.role = PRIVILEGE_ADMINISTRATOR | NAME_ONLY_LOOKUP;
+    rakp.username = USERNAME;
+    rakp.password = PASSWORD;
+    const auto keys = rakp.get_session_keys();
+    ASSERT_EQ(HMAC_SHA1_SIZE, keys.integrity_key.size());
+    ASSERT_EQ(AES_CBC_128_BLOCK_SIZE, keys.confidentiality_key.size());
+
+    for (std::size_t size = 0; size < 40; ++size) {
+        SessionPacket packet{};
+        packet.encrypted = true;
+        packet.authenticated = true;
+        packet.session_id = rakp.bmc_session_id;
+        packet.sequence = std::uint32_t(size + 1);
+        for (std::size_t i = 0; i < size; ++i) {
+            packet.payload.push_back(std::uint8_t(i * 7));
+        }
+
+        auto datagram = encode_packet(packet, &keys);
+        /* authenticated part of the packet is aligned to 4 bytes */
+        ASSERT_EQ(0, (datagram.size() - 4 - HMAC_SHA1_96_SIZE) % 4);
+
+        SessionPacket decoded{};
+        ASSERT_TRUE(decode_packet(datagram.data(), datagram.size(), &keys, decoded));
+        ASSERT_EQ(packet.payload, decoded.payload);
+        ASSERT_EQ(packet.session_id, decoded.session_id);
+        ASSERT_EQ(packet.sequence, decoded.sequence);
+
+        datagram[20] ^= 0x01;
+        ASSERT_FALSE(decode_packet(datagram.data(), datagram.size(), &keys, decoded));
+    }
+}
+
+/*!
+ * @brief IPMI messages are framed with valid checksums
+ */
+TEST(RmcppProtocol, MessageFraming) {
+    IpmiMessage request{};
+    request.netfn = NETFN_APP;
+    request.sequence = 17;
+    request.command = CMD_GET_DEVICE_ID;
+    request.data = {0x01, 0x02};
+
+    auto encoded = encode_request(request);
+    ASSERT_EQ(ByteBuffer({0x20, 0x18, 0xC8, 0x81, 0x44, 0x01, 0x01, 0x02, 0x37}), encoded);
+
+    IpmiMessage decoded{};
+    ASSERT_TRUE(decode_request(encoded, decoded));
+    ASSERT_EQ(request.sequence, decoded.sequence);
+    ASSERT_EQ(request.data, decoded.data);
+
+    encoded[6] = 0x7F;
+    ASSERT_FALSE(decode_request(encoded, decoded));
+}
+
+/*!
+ * @brief Session is established with the first request
+ */
+TEST(RmcppSession, GetDeviceId) {
+    RmcppBmcSimulator bmc{USERNAME, PASSWORD};
+    LanPlusIpmiInterface intf{make_connection_data(bmc)};
+
+    const auto response = intf.send_async(NETFN_APP, CMD_GET_DEVICE_ID, 0, {}, {}).get();
+    ASSERT_EQ(16, response.size());
+    ASSERT_EQ(0x00, response[0]);
+    ASSERT_EQ(0x20, response[1]);
+    ASSERT_EQ(1, bmc.get_sessions());
+
+    ASSERT_EQ(ByteBuffer({0x00, 0x42}), echo(intf, {0x42}));
+    ASSERT_EQ(1, bmc.get_sessions());
+}
+
+/*!
+ * @brief "lanplus" interface is built by the factory and used by the controller
+ */
+TEST(RmcppSession, Controller) {
+    RmcppBmcSimulator bmc{USERNAME, PASSWORD};
+    ipmi::IpmiController controller{make_connection_data(bmc)};
+
+    testing::TestRequest request{};
+    testing::TestResponse response{};
+    controller.send(request, response);
+    ASSERT_EQ("bmc", response.get_descr());
+    ASSERT_EQ(1, response.get_serial());
+
+    controller.send(request, response);
+    ASSERT_EQ(2, response.get_serial());
+}
+
+/*!
+ * @brief Management controller of a BMC configured with "lanplus" interface type uses the RMCP+ session
+ */
+TEST(RmcppSession, ManagementControllerInterfaceType) {
+    RmcppBmcSimulator bmc{USERNAME, PASSWORD};
+    ipmi::manager::ipmitool::ManagementController controller{LanPlusConnectionData::INTF_TYPE, "127.0.0.1",
+                                                            bmc.get_port(), USERNAME, PASSWORD};
+    ASSERT_EQ(bmc.get_port(), controller.get_port());
+
+    testing::TestRequest request{};
+    testing::TestResponse response{};
+    controller.send(request, response);
+    ASSERT_EQ("bmc", response.get_descr());
+    ASSERT_EQ(1, bmc.get_sessions());
+
+    ASSERT_THROW((ipmi::manager::ipmitool::ManagementController{"serial", "127.0.0.1", bmc.get_port(),
+                                                                USERNAME, PASSWORD}), std::invalid_argument);
+}
+
+/*!
+ * @brief Concurrent requests are outstanding together and matched by sequence numbers
+ */
+TEST(RmcppSession, PipelinedRequests) {
+    RmcppBmcSimulator bmc{USERNAME, PASSWORD};
+    bmc.set_processing_delay(std::chrono::milliseconds{10});
+    auto data = make_connection_data(bmc);
+    data->set_window_size(8);
+    LanPlusIpmiInterface intf{data};
+
+    std::vector<std::future<ByteBuffer>> futures{};
+    for (std::uint8_t i = 0; i < 100; ++i) {
+        futures.emplace_back(intf.send_async(RmcppBmcSimulator::ECHO_NETFN, RmcppBmcSimulator::ECHO_CMD, 0, {},
+                                             {i, std::uint8_t(i * 3)}));
+    }
+    for (std::uint8_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(ByteBuffer({0x00, i, std::uint8_t(i * 3)}), futures[i].get());
+    }
+    ASSERT_EQ(8, bmc.get_max_outstanding());
+    ASSERT_EQ(1, bmc.get_sessions());
+}
+
+/*!
+ * @brief Batch of the controller is pipelined, each exchange gets its own response
+ */
+TEST(RmcppSession, ControllerBatch) {
+    RmcppBmcSimulator bmc{USERNAME, PASSWORD};
+    bmc.set_processing_delay(std::chrono::milliseconds{10});
+    auto data = make_connection_data(bmc);
+    data->set_window_size(4);
+    ipmi::IpmiController controller{data};
+
+    testing::TestRequest request{};
+    std::vector<testing::TestResponse> responses(12);
+    ipmi::IpmiController::Exchanges exchanges{};
+    for (auto& response : responses) {
+        exchanges.push_back({request, response, nullptr});
+    }
+    controller.send_batch(exchanges, {});
+
+    std::set<unsigned> serials{};
+    for (std::size_t i = 0; i < responses.size(); ++i) {
+        ASSERT_FALSE(exchanges[i].error);
+        ASSERT_EQ("bmc", responses[i].get_descr());
+        serials.insert(responses[i].get_serial());
+    }
+    ASSERT_EQ(responses.size(), serials.size());
+    ASSERT_EQ(4, bmc.get_max_outstanding());
+}
+
+/*!
+ * @brief Lost requests are retransmitted, requests without response fail after retries
+ */
+TEST(RmcppSession, Retransmission) {
+    RmcppBmcSimulator bmc{USERNAME, PASSWORD};
+    auto data = make_connection_data(bmc);
+    data->set_request_timeout(std::chrono::milliseconds{30});
+    data->set_retries(2);
+    LanPlusIpmiInterface intf{data};
+    ASSERT_EQ(ByteBuffer({0x00, 0x01}), echo(intf, {0x01}));
+
+    const auto before = SessionEngine::get_instance().get_statistics();
+    bmc.drop_requests(2);
+    ASSERT_EQ(ByteBuffer({0x00, 0x02}), echo(intf, {0x02}));
+    const auto after = SessionEngine::get_instance().get_statistics();
+    ASSERT_LE(before.retransmissions + 2, after.retransmissions);
+
+    bmc.drop_requests(3);
+    ASSERT_THROW(echo(intf, {0x03}), std::runtime_error);
+
+    /* session is reestablished after the timeout */
+    ASSERT_EQ(ByteBuffer({0x00, 0x04}), echo(intf, {0x04}));
+    ASSERT_EQ(2, bmc.get_sessions());
+}
+
+/*!
+ * @brief Single bridged request is sent in Send Message
+ */
+TEST(RmcppSession, Bridging) {
+    RmcppBmcSimulator bmc{USERNAME, PASSWORD};
+    LanPlusIpmiInterface intf{make_connection_data(bmc)};
+
+    const auto response = intf.send_async(RmcppBmcSimulator::ECHO_NETFN, RmcppBmcSimulator::ECHO_CMD, 0,
+                                          {0x24, 0x06}, {0x01}).get();
+    ASSERT_EQ(ByteBuffer({0x00, 0x06, 0x24}), response);
+
+    ASSERT_THROW(intf.send_async(NETFN_APP, CMD_GET_DEVICE_ID, 0, {0x24, 0x06, 0x28, 0x07}, {}),
+                 std::runtime_error);
+}
+
+/*!
+ * @brief Requests fail if the BMC cannot be authenticated
+ */
+TEST(RmcppSession, InvalidPassword) {
+    RmcppBmcSimulator bmc{USERNAME, PASSWORD};
+    LanPlusIpmiInterface intf{make_connection_data(bmc, "invalid")};
+
+    ASSERT_THROW(echo(intf, {0x01}), std::runtime_error);
+    ASSERT_EQ(0, bmc.get_sessions());
+}
+
+/*!
+ * @brief Requests to several BMCs, serialized and pipelined within the window of each session
+ */
+TEST(RmcppSession, PipeliningBenchmark) {
+    constexpr unsigned BMCS = 4;
+    constexpr unsigned REQUESTS = 16;
+    constexpr unsigned WINDOW = 8;
+
+    std::vector<std::unique_ptr<RmcppBmcSimulator>> bmcs{};
+    std::vector<std::unique_ptr<LanPlusIpmiInterface>> interfaces{};
+    for (unsigned i = 0; i < BMCS; ++i) {
+        bmcs.emplace_back(new RmcppBmcSimulator{USERNAME, PASSWORD});
+        bmcs.back()->set_processing_delay(std::chrono::milliseconds{10});
+        auto data = make_connection_data(*bmcs.back());
+        data->set_window_size(WINDOW);
+        interfaces.emplace_back(new LanPlusIpmiInterface{data});
+    }
+
+    for (unsigned request = 0; request < REQUESTS; ++request) {
+        for (auto& intf : interfaces) {
+            ASSERT_EQ(ByteBuffer({0x00, std::uint8_t(request)}), echo(*intf, {std::uint8_t(request)}));
+        }
+    }
+    /* each BMC processes a single request at a time */
+    for (const auto& bmc : bmcs) {
+        ASSERT_EQ(1, bmc->get_max_outstanding());
+    }
+
+    std::vector<std::future<ByteBuffer>> futures{};
+    for (unsigned request = 0; request < REQUESTS; ++request) {
+        for (auto& intf : interfaces) {
+            futures.emplace_back(intf->send_async(RmcppBmcSimulator::ECHO_NETFN, RmcppBmcSimulator::ECHO_CMD, 0,
+                                                  {}, {std::uint8_t(request)}));
+        }
+    }
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        ASSERT_EQ(ByteBuffer({0x00, std::uint8_t(i / BMCS)}), futures[i].get());
+    }
+    /* whole window of each session is filled, but never exceeded */
+    for (const auto& bmc : bmcs) {
+        ASSERT_EQ(WINDOW, bmc->get_max_outstanding());
+        ASSERT_EQ(1, bmc->get_sessions());
+    }
+}
+
+}
@@ -28,10 +28,19 @@
 #include "json-rpc/connectors/abstract_client_connector.hpp"
 #include <curl/curl.h>
 
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
 namespace json_rpc {
 
 /*!
  * @brief Implementation of the AbstractClientConnector based on the HTTP
+ *
+ * Connector may be used by many threads at once, each request is sent using one of the pooled curl handles.
+ * Up to max_connections requests are sent concurrently, the others wait for a free handle.
+ * Each pooled handle keeps its own kept-alive connection, handles of all connectors share only the DNS cache.
  */
 class HttpClientConnector : public AbstractClientConnector {
 public:
@@ -39,12 +48,29 @@ public:
     /*! Default timeout (ms) time used by the constructor */
     static constexpr long DEFAULT_TIMEOUT_MS = 10000;
 
+    /*! Default number of concurrent requests to the url */
+    static constexpr std::size_t DEFAULT_MAX_CONNECTIONS = 1;
+
+    /*! @brief Connector usage counters */
+    struct Statistics {
+        /*! @brief Number of performed requests */
+        std::uint64_t requests{};
+        /*! @brief Number of requests which had to open a new connection */
+        std::uint64_t connections_opened{};
+        /*! @brief Number of requests sent over already opened connection */
+        std::uint64_t connections_reused{};
+        /*! @brief Number of requests which waited for a free handle */
+        std::uint64_t throttled{};
+    };
+
     /*!
      * @brief Constructs a http connector
      * @param url Target url
      * @param timeout_ms Timeout (ms) for connection
+     * @param max_connections Maximal number of requests sent concurrently
      */
-    HttpClientConnector(const std::string& url, long timeout_ms = DEFAULT_TIMEOUT_MS);
+    HttpClientConnector(const std::string& url, long timeout_ms = DEFAULT_TIMEOUT_MS,
+                        std::size_t max_connections = DEFAULT_MAX_CONNECTIONS);
 
     virtual ~HttpClientConnector();
 
@@ -60,16 +86,38 @@ public:
      * @param url New URL
      */
     void set_url(const std::string& url) {
+        std::lock_guard<std::mutex> lock{m_mutex};
         m_url = url;
     }
 
+    /*!
+     * @brief Gets usage counters
+     * @return Current counters
+     */
+    Statistics get_statistics() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_statistics;
+    }
+
 private:
 
+    using CurlPtr = std::unique_ptr<CURL, void(*)(CURL*)>;
+    using HeadersPtr = std::unique_ptr<curl_slist, void(*)(curl_slist*)>;
+
+    CurlPtr acquire_handle(std::string& url);
+
+    void release_handle(CurlPtr handle, CURLcode result, long new_connections);
+
     std::string m_url{};
     long m_timeout_ms{};
+    std::size_t m_max_connections{};
+    HeadersPtr m_headers;
 
-    using CurlPtr = std::unique_ptr<CURL, void(*)(CURL*)>;
-    CurlPtr m_curl;
+    mutable std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+    std::vector<CurlPtr> m_idle_handles{};
+    std::size_t m_handle_count{};
+    Statistics m_statistics{};
 
 };
 
@@ -0,0 +1,90 @@
+/*!
+ * @copyright Copyright (c) 2019 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file connectors/persistent_unix_domain_socket_client_connector.hpp
+ */
+
+#pragma once
+
+
+
+#include "json-rpc/connectors/abstract_client_connector.hpp"
+#include "json-rpc/common.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+
+namespace json_rpc {
+
+/*!
+ * @brief Implementation of the AbstractClientConnector keeping connections to the Unix domain socket open
+ *
+ * Requests are newline delimited and pipelined: they are written to the connection as soon as they are
+ * sent, without waiting for responses to the previous ones. Ids of the requests are replaced with ids
+ * unique for the connector, responses are matched with requests by these ids, so they may come in any order.
+ * Broken connection is dropped (pending requests fail) and reestablished by the next request.
+ */
+class PersistentUnixDomainSocketClientConnector : public AbstractClientConnector {
+
+public:
+
+    /*!
+     * @brief Constructs a valid Socket connector
+     * @param path default server address
+     * @param connections number of connections kept open
+     */
+    PersistentUnixDomainSocketClientConnector(const std::string& path, std::size_t connections = 1);
+
+
+    virtual ~PersistentUnixDomainSocketClientConnector();
+
+    /*!
+     * @brief Sends client request
+     * @param message Message to be send
+     * @return Obtained response, empty for notifications
+     */
+    virtual std::string send_request(const std::string& message) override;
+
+
+private:
+
+    class Socket;
+    using SocketPtr = std::shared_ptr<Socket>;
+
+    /*! @brief Pool entry, socket is replaced when the connection is broken */
+    struct Connection {
+        std::mutex mutex{};
+        std::condition_variable cv{};
+        SocketPtr socket{};
+    };
+
+    Connection& select_connection();
+
+    SocketPtr get_socket(Connection& connection);
+
+    json::Json wait_for_response(Connection& connection, const SocketPtr& socket, std::uint64_t id);
+
+    void drop_socket(Connection& connection, const SocketPtr& socket, const std::string& error);
+
+    std::string m_path{};
+    std::vector<std::unique_ptr<Connection>> m_connections{};
+    std::atomic<std::uint64_t> m_last_id{0};
+
+};
+
+}
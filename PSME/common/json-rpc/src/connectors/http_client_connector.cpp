@@ -27,6 +27,7 @@
 
 #include "json-rpc/common.hpp"
 
+#include <algorithm>
 
 
 using namespace json_rpc;
@@ -38,6 +39,15 @@ class CurlInitializer {
 public:
     CurlInitializer() {
         curl_global_init(CURL_GLOBAL_ALL);
+
+        m_share = curl_share_init();
+        if (nullptr != m_share) {
+            curl_share_setopt(m_share, CURLSHOPT_LOCKFUNC, &CurlInitializer::lock);
+            curl_share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, &CurlInitializer::unlock);
+            curl_share_setopt(m_share, CURLSHOPT_USERDATA, this);
+            // connection cache must not be shared by handles used concurrently, see CURLSHOPT_SHARE
+            curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        }
     }
 
     CurlInitializer(const CurlInitializer&) = delete;
@@ -47,8 +57,28 @@ public:
     CurlInitializer& operator=(CurlInitializer&&) = delete;
 
     ~CurlInitializer() {
+        if (nullptr != m_share) {
+            curl_share_cleanup(m_share);
+        }
         curl_global_cleanup();
     }
+
+    /*! @brief Share handle with DNS cache used by all connectors */
+    CURLSH* get_share() const {
+        return m_share;
+    }
+
+private:
+    static void lock(CURL*, curl_lock_data data, curl_lock_access, void* user) {
+        static_cast<CurlInitializer*>(user)->m_mutexes[data % CURL_LOCK_DATA_LAST].lock();
+    }
+
+    static void unlock(CURL*, curl_lock_data data, void* user) {
+        static_cast<CurlInitializer*>(user)->m_mutexes[data % CURL_LOCK_DATA_LAST].unlock();
+    }
+
+    CURLSH* m_share{nullptr};
+    std::mutex m_mutexes[CURL_LOCK_DATA_LAST]{};
 };
 
 // See here: http://curl.haxx.se/libcurl/c/curl_global_init.html
@@ -71,44 +101,108 @@ static size_t curl_write_function(void* ptr, size_t size, size_t nmemb, std::str
     return chunk_length;
 }
 
+void free_headers(curl_slist* headers) {
+    curl_slist_free_all(headers);
 }
 
-HttpClientConnector::HttpClientConnector(const std::string& url, long timeout_ms):
-        m_url(url), m_timeout_ms(timeout_ms), m_curl{curl_easy_init(), &curl_easy_cleanup} {
-    if (nullptr == m_curl) {
+}
+
+HttpClientConnector::HttpClientConnector(const std::string& url, long timeout_ms, std::size_t max_connections):
+        m_url(url), m_timeout_ms(timeout_ms), m_max_connections(std::max<std::size_t>(max_connections, 1)),
+        m_headers{nullptr, &free_headers} {
+
+    curl_slist* headers = curl_slist_append(nullptr, "Content-Type: application/json");
+    if (nullptr != headers) {
+        m_headers.reset(headers);
+        headers = curl_slist_append(headers, "charsets: utf-8");
+    }
+    if (nullptr == headers) {
         throw JsonRpcException(ERROR_CLIENT_CONNECTOR, "Unable to initialize HTTP client connector");
     }
+
+    /* first handle is created upfront, so broken curl is reported by the constructor */
+    std::string first_url{};
+    release_handle(acquire_handle(first_url), CURLE_FAILED_INIT, 0);
 }
 
 HttpClientConnector::~HttpClientConnector() {
 }
 
-std::string HttpClientConnector::send_request(const std::string& message) {
+HttpClientConnector::CurlPtr HttpClientConnector::acquire_handle(std::string& url) {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (m_idle_handles.empty() && m_handle_count >= m_max_connections) {
+        ++m_statistics.throttled;
+        m_cv.wait(lock, [this] { return !m_idle_handles.empty(); });
+    }
+    url = m_url;
 
-    if (nullptr == m_curl) {
-        throw JsonRpcException(ERROR_CLIENT_CONNECTOR, "HTTP client connector not initialized");
+    if (!m_idle_handles.empty()) {
+        auto handle = std::move(m_idle_handles.back());
+        m_idle_handles.pop_back();
+        return handle;
     }
 
-    curl_easy_setopt(m_curl.get(), CURLOPT_URL, m_url.c_str());
-    curl_easy_setopt(m_curl.get(), CURLOPT_TIMEOUT_MS, m_timeout_ms);
-    curl_easy_setopt(m_curl.get(), CURLOPT_WRITEFUNCTION, ::curl_write_function);
-    curl_easy_setopt(m_curl.get(), CURLOPT_POSTFIELDS, message.c_str());
+    CurlPtr handle{curl_easy_init(), &curl_easy_cleanup};
+    if (nullptr == handle) {
+        throw JsonRpcException(ERROR_CLIENT_CONNECTOR, "Unable to initialize HTTP client connector");
+    }
+    ++m_handle_count;
+
+    /* options which do not change between requests */
+    if (nullptr != curl_init.get_share()) {
+        curl_easy_setopt(handle.get(), CURLOPT_SHARE, curl_init.get_share());
+    }
+    curl_easy_setopt(handle.get(), CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle.get(), CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle.get(), CURLOPT_TIMEOUT_MS, m_timeout_ms);
+    curl_easy_setopt(handle.get(), CURLOPT_WRITEFUNCTION, ::curl_write_function);
+    curl_easy_setopt(handle.get(), CURLOPT_HTTPHEADER, m_headers.get());
+    return handle;
+}
+
+void HttpClientConnector::release_handle(CurlPtr handle, CURLcode result, long new_connections) {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (CURLE_OK == result) {
+            ++m_statistics.requests;
+            if (new_connections > 0) {
+                ++m_statistics.connections_opened;
+            }
+            else {
+                ++m_statistics.connections_reused;
+            }
+        }
+        else if (CURLE_FAILED_INIT != result) {
+            ++m_statistics.requests;
+        }
+        m_idle_handles.push_back(std::move(handle));
+    }
+    m_cv.notify_one();
+}
 
-    struct curl_slist* headers = NULL;
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "charsets: utf-8");
-    curl_easy_setopt(m_curl.get(), CURLOPT_HTTPHEADER, headers);
+std::string HttpClientConnector::send_request(const std::string& message) {
+
+    std::string url{};
+    auto handle = acquire_handle(url);
 
     std::string data{};
-    curl_easy_setopt(m_curl.get(), CURLOPT_WRITEDATA, &data);
+    curl_easy_setopt(handle.get(), CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle.get(), CURLOPT_POSTFIELDS, message.c_str());
+    curl_easy_setopt(handle.get(), CURLOPT_POSTFIELDSIZE, static_cast<long>(message.size()));
+    curl_easy_setopt(handle.get(), CURLOPT_WRITEDATA, &data);
 
-    CURLcode result = curl_easy_perform(m_curl.get());
-    curl_slist_free_all(headers);
+    CURLcode result = curl_easy_perform(handle.get());
+
+    long http_code = 0;
+    long new_connections = 0;
+    curl_easy_getinfo(handle.get(), CURLINFO_RESPONSE_CODE, &http_code);
+    curl_easy_getinfo(handle.get(), CURLINFO_NUM_CONNECTS, &new_connections);
+    release_handle(std::move(handle), result, new_connections);
 
     if (result != CURLE_OK)
     {
         if (CURLE_COULDNT_CONNECT == result) {
-            throw JsonRpcException(ERROR_CLIENT_CONNECTOR, "Curl error: could not connect to: " + m_url);
+            throw JsonRpcException(ERROR_CLIENT_CONNECTOR, "Curl error: could not connect to: " + url);
         }
         else if (CURLE_OPERATION_TIMEDOUT == result) {
             throw JsonRpcException(ERROR_CLIENT_CONNECTOR, "Curl error: operation timed out");
@@ -116,9 +210,6 @@ std::string HttpClientConnector::send_request(const std::string& message) {
         throw JsonRpcException(ERROR_CLIENT_CONNECTOR, std::string{"Curl error: code "} + std::to_string(int(result)));
     }
 
-    long http_code = 0;
-    curl_easy_getinfo(m_curl.get(), CURLINFO_RESPONSE_CODE, &http_code);
-
     constexpr long HTTP_OK_STATUS = 200;
     if (http_code != HTTP_OK_STATUS) {
         throw JsonRpcException(ERROR_CLIENT_INVALID_RESPONSE,
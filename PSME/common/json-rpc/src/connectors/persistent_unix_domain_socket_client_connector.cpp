@@ -0,0 +1,346 @@
+/*!
+ * @copyright Copyright (c) 2019 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file connectors/persistent_unix_domain_socket_client_connector.cpp
+ */
+
+
+#include "json-rpc/connectors/persistent_unix_domain_socket_client_connector.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <safe-string/safe_lib.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+
+
+
+namespace {
+
+constexpr const char DEFAULT_DELIMITER_CHAR = char(0x0A);
+constexpr const std::size_t INITIAL_BUFFER_SIZE = 16 * 1024;
+constexpr const std::size_t MIN_READ_SIZE = 4 * 1024;
+constexpr const int MAX_PATH_SIZE = 107;
+
+}
+
+namespace json_rpc {
+
+/*!
+ * @brief Connected socket with its read buffer and requests waiting for responses.
+ *
+ * Socket is closed when the last request using it is finished.
+ * Except the descriptor and the buffer, all fields are guarded by the mutex of the connection.
+ */
+class PersistentUnixDomainSocketClientConnector::Socket {
+public:
+    explicit Socket(int fd) : m_fd(fd) { }
+
+    ~Socket() {
+        close(m_fd);
+    }
+
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+
+    /*!
+     * @brief Writes whole request, concurrent writes are serialized
+     * @param request Delimited request
+     * @return false if the socket is broken
+     */
+    bool write_request(const std::string& request) {
+        std::lock_guard<std::mutex> lock{m_write_mutex};
+        std::size_t written = 0;
+        while (written < request.size()) {
+            ssize_t bytes_written = send(m_fd, request.data() + written, request.size() - written, MSG_NOSIGNAL);
+            if (bytes_written < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                return false;
+            }
+            written += static_cast<std::size_t>(bytes_written);
+        }
+        return true;
+    }
+
+    /*!
+     * @brief Reads available data (blocks until any comes) and extracts complete responses.
+     *
+     * Only newly read bytes are searched for the delimiter, the buffer grows when a response
+     * does not fit in it.
+     *
+     * @param[out] lines Received responses
+     * @return false if the socket is broken
+     */
+    bool read_responses(std::vector<std::string>& lines) {
+        if (m_begin == m_end) {
+            m_begin = m_scanned = m_end = 0;
+        }
+        if (m_buffer.size() - m_end < MIN_READ_SIZE) {
+            if (m_begin > 0) {
+                std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+                m_scanned -= m_begin;
+                m_end -= m_begin;
+                m_begin = 0;
+            }
+            if (m_buffer.size() - m_end < MIN_READ_SIZE) {
+                m_buffer.resize(std::max(2 * m_buffer.size(), INITIAL_BUFFER_SIZE));
+            }
+        }
+
+        ssize_t bytes_read{};
+        do {
+            bytes_read = recv(m_fd, m_buffer.data() + m_end, m_buffer.size() - m_end, 0);
+        }
+        while (bytes_read < 0 && EINTR == errno);
+        if (bytes_read <= 0) {
+            return false;
+        }
+        m_end += static_cast<std::size_t>(bytes_read);
+
+        const char* delimiter{};
+        while (nullptr != (delimiter = static_cast<const char*>(
+            std::memchr(m_buffer.data() + m_scanned, DEFAULT_DELIMITER_CHAR, m_end - m_scanned)))) {
+
+            const char* begin = m_buffer.data() + m_begin;
+            lines.emplace_back(begin, delimiter);
+            m_begin = m_scanned = static_cast<std::size_t>(delimiter - m_buffer.data()) + 1;
+        }
+        m_scanned = m_end;
+        return true;
+    }
+
+    /*! @brief Wakes up blocked reader and writers */
+    void shutdown() {
+        ::shutdown(m_fd, SHUT_RDWR);
+    }
+
+    /*! @brief Response slot of a sent request */
+    struct Pending {
+        bool done{false};
+        json::Json response{};
+    };
+
+    std::map<std::uint64_t, Pending> pending{};
+    /*! @brief One of the requesters reads responses for all of them */
+    bool reading{false};
+    bool broken{false};
+    std::string error{};
+
+private:
+    int m_fd;
+    std::mutex m_write_mutex{};
+    std::vector<char> m_buffer{};
+    std::size_t m_begin{};
+    std::size_t m_scanned{};
+    std::size_t m_end{};
+};
+
+
+PersistentUnixDomainSocketClientConnector::PersistentUnixDomainSocketClientConnector(const std::string& path,
+                                                                                     std::size_t connections)
+    : m_path(path) {
+    for (std::size_t i = 0; i < std::max<std::size_t>(connections, 1); ++i) {
+        m_connections.emplace_back(new Connection{});
+    }
+}
+
+
+PersistentUnixDomainSocketClientConnector::~PersistentUnixDomainSocketClientConnector() {
+}
+
+
+std::string PersistentUnixDomainSocketClientConnector::send_request(const std::string& message) {
+    json::Json request{};
+    try {
+        request = json::Json::parse(message);
+    }
+    catch (const std::exception& e) {
+        throw JsonRpcException(common::ERROR_RPC_JSON_PARSE_ERROR, e.what());
+    }
+
+    const bool is_notification = !request.is_object() || !request.count(common::KEY_ID);
+    json::Json original_id{};
+    std::uint64_t id{};
+    if (!is_notification) {
+        original_id = request[common::KEY_ID];
+        id = ++m_last_id;
+        request[common::KEY_ID] = id;
+    }
+    const std::string to_send = request.dump() + DEFAULT_DELIMITER_CHAR;
+
+    /* request failed to be written to a stale connection is sent again using a new one */
+    for (int attempt = 0; ; ++attempt) {
+        auto& connection = select_connection();
+        auto socket = get_socket(connection);
+        if (!is_notification) {
+            std::lock_guard<std::mutex> lock{connection.mutex};
+            socket->pending[id];
+        }
+
+        if (!socket->write_request(to_send)) {
+            std::lock_guard<std::mutex> lock{connection.mutex};
+            socket->pending.erase(id);
+            drop_socket(connection, socket, "Could not write request");
+            if (attempt > 0) {
+                throw JsonRpcException(json_rpc::common::ERROR_CLIENT_CONNECTOR, "Could not write request");
+            }
+            continue;
+        }
+
+        if (is_notification) {
+            return {};
+        }
+
+        json::Json response = wait_for_response(connection, socket, id);
+        if (response.is_object() && response.count(common::KEY_ID)) {
+            response[common::KEY_ID] = original_id;
+        }
+        return response.dump();
+    }
+}
+
+
+PersistentUnixDomainSocketClientConnector::Connection& PersistentUnixDomainSocketClientConnector::select_connection() {
+    Connection* selected{};
+    std::size_t selected_load{};
+    for (auto& connection : m_connections) {
+        std::lock_guard<std::mutex> lock{connection->mutex};
+        const std::size_t load = connection->socket ? connection->socket->pending.size() : 0;
+        if (!selected || load < selected_load) {
+            selected = connection.get();
+            selected_load = load;
+        }
+    }
+    return *selected;
+}
+
+
+PersistentUnixDomainSocketClientConnector::SocketPtr
+PersistentUnixDomainSocketClientConnector::get_socket(Connection& connection) {
+    std::lock_guard<std::mutex> lock{connection.mutex};
+    if (connection.socket) {
+        return connection.socket;
+    }
+
+    int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_fd < 0) {
+        throw JsonRpcException(json_rpc::common::ERROR_CLIENT_CONNECTOR,
+                               "Unable to initialize socket client connector");
+    }
+    auto socket = std::make_shared<Socket>(socket_fd);
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy_s(address.sun_path, MAX_PATH_SIZE, this->m_path.c_str(), MAX_PATH_SIZE);
+    if (connect(socket_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(sockaddr_un)) != 0) {
+        throw JsonRpcException(json_rpc::common::ERROR_CLIENT_CONNECTOR,
+                               "Could not connect to: " + this->m_path);
+    }
+
+    connection.socket = socket;
+    return socket;
+}
+
+
+json::Json PersistentUnixDomainSocketClientConnector::wait_for_response(Connection& connection,
+                                                                         const SocketPtr& socket,
+                                                                         std::uint64_t id) {
+    std::unique_lock<std::mutex> lock{connection.mutex};
+    while (true) {
+        auto it = socket->pending.find(id);
+        if (socket->pending.end() == it) {
+            throw JsonRpcException(json_rpc::common::ERROR_CLIENT_CONNECTOR, socket->error);
+        }
+        if (it->second.done) {
+            json::Json response = std::move(it->second.response);
+            socket->pending.erase(it);
+            return response;
+        }
+        if (socket->reading) {
+            connection.cv.wait(lock);
+            continue;
+        }
+
+        socket->reading = true;
+        lock.unlock();
+        std::vector<std::string> lines{};
+        const bool read = socket->read_responses(lines);
+        std::vector<json::Json> responses{};
+        std::string error{};
+        for (const auto& line : lines) {
+            try {
+                responses.push_back(json::Json::parse(line));
+            }
+            catch (const std::exception& e) {
+                error = std::string{"Could not parse response: "} + e.what();
+            }
+        }
+        lock.lock();
+        socket->reading = false;
+
+        for (auto& response : responses) {
+            const auto& response_id = response.is_object() ? response.value(common::KEY_ID, json::Json{}) : json::Json{};
+            auto pending = response_id.is_number_unsigned() ?
+                           socket->pending.find(response_id.get<std::uint64_t>()) : socket->pending.end();
+            if (socket->pending.end() == pending && 1 == socket->pending.size()) {
+                /* error without id (i.e. request not parsed) */
+                pending = socket->pending.begin();
+            }
+            if (socket->pending.end() == pending) {
+                error = "Could not match response with request: " + response.dump();
+                continue;
+            }
+            pending->second.done = true;
+            pending->second.response = std::move(response);
+        }
+
+        if (!read) {
+            error = "Could not read response";
+        }
+        if (!error.empty()) {
+            drop_socket(connection, socket, error);
+        }
+        connection.cv.notify_all();
+    }
+}
+
+
+void PersistentUnixDomainSocketClientConnector::drop_socket(Connection& connection,
+                                                            const SocketPtr& socket,
+                                                            const std::string& error) {
+    if (!socket->broken) {
+        socket->broken = true;
+        socket->error = error;
+        socket->shutdown();
+    }
+    /* requests waiting for responses fail */
+    for (auto it = socket->pending.begin(); it != socket->pending.end();) {
+        if (it->second.done) {
+            ++it;
+        }
+        else {
+            it = socket->pending.erase(it);
+        }
+    }
+    if (connection.socket == socket) {
+        connection.socket.reset();
+    }
+    connection.cv.notify_all();
+}
+
+}
@@ -32,6 +32,8 @@
 #include <unistd.h>
 #include <safe-string/safe_lib.hpp>
 
+#include <cstring>
+
 
 
 namespace {
@@ -74,7 +76,8 @@ bool read_response(std::string& target, int fd, char delimiter) {
             target.append(buffer, static_cast<size_t>(bytes_read));
         }
     }
-    while (target.find(delimiter) == std::string::npos && bytes_read > 0);
+    /* only the newly read chunk may contain the delimiter */
+    while (bytes_read > 0 && nullptr == memchr(buffer, delimiter, static_cast<size_t>(bytes_read)));
 
     target.pop_back();
     return true;
@@ -0,0 +1,216 @@
+/*!
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file tests/http_client_connector.cpp
+ */
+
+#include "json-rpc/connectors/http_client_connector.hpp"
+#include "json-rpc/common.hpp"
+
+#include "gtest/gtest.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace json_rpc;
+
+namespace {
+
+/*! Keep-alive HTTP/1.1 server echoing bodies of POST requests after a delay */
+class EchoHttpServer {
+public:
+    explicit EchoHttpServer(std::chrono::milliseconds delay = std::chrono::milliseconds{0}) : m_delay(delay) {
+        m_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        EXPECT_EQ(0, bind(m_listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+        socklen_t length = sizeof(address);
+        EXPECT_EQ(0, getsockname(m_listen_fd, reinterpret_cast<sockaddr*>(&address), &length));
+        m_port = ntohs(address.sin_port);
+        EXPECT_EQ(0, listen(m_listen_fd, 16));
+        m_acceptor = std::thread(&EchoHttpServer::accept_connections, this);
+    }
+
+    ~EchoHttpServer() {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_stopped = true;
+            for (auto fd : m_client_fds) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        shutdown(m_listen_fd, SHUT_RDWR);
+        m_acceptor.join();
+        for (auto& handler : m_handlers) {
+            handler.join();
+        }
+        close(m_listen_fd);
+    }
+
+    std::string get_url() const {
+        return "http://127.0.0.1:" + std::to_string(m_port);
+    }
+
+    std::size_t get_accepted() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_accepted;
+    }
+
+    std::size_t get_max_in_progress() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_max_in_progress;
+    }
+
+private:
+    void accept_connections() {
+        while (true) {
+            int fd = accept(m_listen_fd, nullptr, nullptr);
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (fd < 0 || m_stopped) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+                return;
+            }
+            ++m_accepted;
+            m_client_fds.push_back(fd);
+            m_handlers.emplace_back(&EchoHttpServer::handle_connection, this, fd);
+        }
+    }
+
+    void handle_connection(int fd) {
+        std::string buffer{};
+        char chunk[4096];
+        while (true) {
+            std::size_t headers_end{};
+            while (std::string::npos == (headers_end = buffer.find("\r\n\r\n"))) {
+                ssize_t bytes_read = read(fd, chunk, sizeof(chunk));
+                if (bytes_read <= 0) {
+                    close(fd);
+                    return;
+                }
+                buffer.append(chunk, static_cast<std::size_t>(bytes_read));
+            }
+            const auto length_header = buffer.find("Content-Length: ");
+            const auto body_length = std::stoul(buffer.substr(length_header + 16));
+            while (buffer.size() < headers_end + 4 + body_length) {
+                ssize_t bytes_read = read(fd, chunk, sizeof(chunk));
+                if (bytes_read <= 0) {
+                    close(fd);
+                    return;
+                }
+                buffer.append(chunk, static_cast<std::size_t>(bytes_read));
+            }
+            const auto body = buffer.substr(headers_end + 4, body_length);
+            buffer.erase(0, headers_end + 4 + body_length);
+
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_max_in_progress = std::max(m_max_in_progress, ++m_in_progress);
+            }
+            std::this_thread::sleep_for(m_delay);
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                --m_in_progress;
+            }
+
+            const std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: "
+                + std::to_string(body.size()) + "\r\n\r\n" + body;
+            EXPECT_EQ(static_cast<ssize_t>(response.size()), write(fd, response.data(), response.size()));
+        }
+    }
+
+    std::chrono::milliseconds m_delay;
+    int m_listen_fd{-1};
+    std::uint16_t m_port{};
+    std::thread m_acceptor{};
+    std::vector<std::thread> m_handlers{};
+
+    std::mutex m_mutex{};
+    bool m_stopped{false};
+    std::vector<int> m_client_fds{};
+    std::size_t m_accepted{};
+    std::size_t m_in_progress{};
+    std::size_t m_max_in_progress{};
+};
+
+}
+
+TEST(HttpClientConnectorTest, ConnectionIsKeptAlive) {
+    EchoHttpServer server{};
+    HttpClientConnector connector{server.get_url()};
+
+    for (int i = 0; i < 5; ++i) {
+        const auto message = "{\"request\":" + std::to_string(i) + "}";
+        EXPECT_EQ(message, connector.send_request(message));
+    }
+
+    const auto statistics = connector.get_statistics();
+    EXPECT_EQ(5, statistics.requests);
+    EXPECT_EQ(1, statistics.connections_opened);
+    EXPECT_EQ(4, statistics.connections_reused);
+    EXPECT_EQ(1, server.get_accepted());
+}
+
+TEST(HttpClientConnectorTest, ConcurrentRequestsAreLimited) {
+    constexpr std::size_t MAX_CONNECTIONS = 2;
+    constexpr std::size_t REQUESTS = 6;
+    EchoHttpServer server{std::chrono::milliseconds{50}};
+    HttpClientConnector connector{server.get_url(), HttpClientConnector::DEFAULT_TIMEOUT_MS, MAX_CONNECTIONS};
+
+    std::vector<std::string> responses(REQUESTS);
+    std::vector<std::thread> clients{};
+    for (std::size_t i = 0; i < REQUESTS; ++i) {
+        clients.emplace_back([&connector, &responses, i] {
+            responses[i] = connector.send_request(std::to_string(i));
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    for (std::size_t i = 0; i < REQUESTS; ++i) {
+        EXPECT_EQ(std::to_string(i), responses[i]);
+    }
+    EXPECT_EQ(MAX_CONNECTIONS, server.get_max_in_progress());
+    EXPECT_GE(MAX_CONNECTIONS, server.get_accepted());
+
+    const auto statistics = connector.get_statistics();
+    EXPECT_EQ(REQUESTS, statistics.requests);
+    EXPECT_EQ(REQUESTS, statistics.connections_opened + statistics.connections_reused);
+    EXPECT_LT(0, statistics.throttled);
+}
+
+TEST(HttpClientConnectorTest, UnreachableUrlThrowsConnectorError) {
+    std::uint16_t port{};
+    {
+        /* port which was just free */
+        EchoHttpServer server{};
+        port = static_cast<std::uint16_t>(std::stoi(server.get_url().substr(server.get_url().rfind(':') + 1)));
+    }
+    HttpClientConnector connector{"http://127.0.0.1:" + std::to_string(port)};
+    try {
+        connector.send_request("{}");
+        FAIL() << "Exception not thrown";
+    }
+    catch (const JsonRpcException& e) {
+        EXPECT_EQ(common::ERROR_CLIENT_CONNECTOR, e.get_code());
+    }
+    EXPECT_EQ(1, connector.get_statistics().requests);
+}
@@ -0,0 +1,279 @@
+/*!
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file tests/persistent_unix_domain_socket_client_connector.cpp
+ */
+
+#include "json-rpc/connectors/persistent_unix_domain_socket_client_connector.hpp"
+#include "json-rpc/handlers/json_rpc_request_invoker.hpp"
+
+#include "gtest/gtest.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <thread>
+
+using namespace json_rpc;
+
+namespace {
+
+constexpr std::chrono::seconds TIMEOUT{5};
+
+/*!
+ * Newline delimited JSON-RPC server echoing params of the requests.
+ * Requests may be answered in batches (in reverse order) and connections closed after each response.
+ */
+class EchoServer {
+public:
+    EchoServer(std::size_t batch_size = 1, bool close_after_response = false) :
+        m_batch_size(batch_size), m_close_after_response(close_after_response) {
+
+        char directory[] = "/tmp/json_rpc_socket_XXXXXX";
+        EXPECT_NE(nullptr, mkdtemp(directory));
+        m_directory = directory;
+        m_path = m_directory + "/server.sock";
+
+        m_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+        EXPECT_EQ(0, bind(m_listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+        EXPECT_EQ(0, listen(m_listen_fd, 8));
+        m_acceptor = std::thread(&EchoServer::accept_connections, this);
+    }
+
+    ~EchoServer() {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_stopped = true;
+            for (auto fd : m_client_fds) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        shutdown(m_listen_fd, SHUT_RDWR);
+        m_acceptor.join();
+        for (auto& handler : m_handlers) {
+            handler.join();
+        }
+        close(m_listen_fd);
+        unlink(m_path.c_str());
+        rmdir(m_directory.c_str());
+    }
+
+    const std::string& get_path() const {
+        return m_path;
+    }
+
+    std::size_t get_accepted() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_accepted;
+    }
+
+    std::vector<json::Json> get_requests() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_requests;
+    }
+
+    bool wait_for_closed(std::size_t closed) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_cv.wait_for(lock, TIMEOUT, [this, closed] { return m_closed >= closed; });
+    }
+
+    bool wait_for_requests(std::size_t requests) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_cv.wait_for(lock, TIMEOUT, [this, requests] { return m_requests.size() >= requests; });
+    }
+
+private:
+    void accept_connections() {
+        while (true) {
+            int fd = accept(m_listen_fd, nullptr, nullptr);
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (fd < 0 || m_stopped) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+                return;
+            }
+            ++m_accepted;
+            m_client_fds.push_back(fd);
+            m_handlers.emplace_back(&EchoServer::handle_connection, this, fd);
+        }
+    }
+
+    void handle_connection(int fd) {
+        std::string buffer{};
+        std::vector<json::Json> batch{};
+        char chunk[4096];
+        bool open = true;
+        while (open) {
+            ssize_t bytes_read = read(fd, chunk, sizeof(chunk));
+            if (bytes_read <= 0) {
+                break;
+            }
+            buffer.append(chunk, static_cast<std::size_t>(bytes_read));
+            std::size_t position{};
+            while (std::string::npos != (position = buffer.find('\n'))) {
+                const auto request = json::Json::parse(buffer.substr(0, position));
+                buffer.erase(0, position + 1);
+                {
+                    std::lock_guard<std::mutex> lock{m_mutex};
+                    m_requests.push_back(request);
+                    m_cv.notify_all();
+                }
+                if (!request.count("id")) {
+                    continue;
+                }
+                batch.push_back(request);
+                if (batch.size() < m_batch_size) {
+                    continue;
+                }
+                std::string responses{};
+                for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+                    json::Json response = json::Json::object();
+                    response["jsonrpc"] = "2.0";
+                    response["id"] = (*it)["id"];
+                    response["result"] = (*it)["params"];
+                    responses += response.dump() + "\n";
+                }
+                batch.clear();
+                EXPECT_EQ(static_cast<ssize_t>(responses.size()), write(fd, responses.data(), responses.size()));
+                if (m_close_after_response) {
+                    open = false;
+                    break;
+                }
+            }
+        }
+        close(fd);
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_client_fds.erase(std::remove(m_client_fds.begin(), m_client_fds.end(), fd), m_client_fds.end());
+        ++m_closed;
+        m_cv.notify_all();
+    }
+
+    std::size_t m_batch_size;
+    bool m_close_after_response;
+    std::string m_directory{};
+    std::string m_path{};
+    int m_listen_fd{-1};
+    std::thread m_acceptor{};
+    std::vector<std::thread> m_handlers{};
+
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+    bool m_stopped{false};
+    std::vector<int> m_client_fds{};
+    std::size_t m_accepted{};
+    std::size_t m_closed{};
+    std::vector<json::Json> m_requests{};
+};
+
+std::string make_request(const json::Json& id, const json::Json& params) {
+    json::Json request = json::Json::object();
+    request["jsonrpc"] = "2.0";
+    request["method"] = "echo";
+    request["id"] = id;
+    request["params"] = params;
+    return request.dump();
+}
+
+}
+
+TEST(PersistentUnixDomainSocketClientConnectorTest, ConnectionIsReusedByInvoker) {
+    EchoServer server{};
+    auto connector = std::make_shared<PersistentUnixDomainSocketClientConnector>(server.get_path());
+    JsonRpcRequestInvoker invoker{};
+
+    for (int i = 0; i < 3; ++i) {
+        json::Json params = json::Json::object();
+        params["value"] = i;
+        invoker.prepare_method("echo", params);
+        ASSERT_NO_THROW(invoker.call(connector));
+        EXPECT_EQ(params, invoker.get_result());
+    }
+    EXPECT_EQ(1, server.get_accepted());
+
+    /* ids on the wire are unique, even if the invoker repeats them */
+    std::set<std::uint64_t> wire_ids{};
+    for (const auto& request : server.get_requests()) {
+        wire_ids.insert(request["id"].get<std::uint64_t>());
+    }
+    EXPECT_EQ(3, wire_ids.size());
+}
+
+TEST(PersistentUnixDomainSocketClientConnectorTest, PipelinedResponsesAreDemultiplexed) {
+    constexpr std::size_t REQUESTS = 4;
+    /* server answers only when all requests are sent, in reverse order */
+    EchoServer server{REQUESTS};
+    PersistentUnixDomainSocketClientConnector connector{server.get_path()};
+
+    std::vector<std::string> responses(REQUESTS);
+    std::vector<std::thread> clients{};
+    for (std::size_t i = 0; i < REQUESTS; ++i) {
+        clients.emplace_back([&connector, &responses, i] {
+            responses[i] = connector.send_request(make_request("request-" + std::to_string(i), i));
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    for (std::size_t i = 0; i < REQUESTS; ++i) {
+        const auto response = json::Json::parse(responses[i]);
+        EXPECT_EQ("request-" + std::to_string(i), response["id"].get<std::string>());
+        EXPECT_EQ(i, response["result"].get<std::size_t>());
+    }
+    EXPECT_EQ(1, server.get_accepted());
+}
+
+TEST(PersistentUnixDomainSocketClientConnectorTest, LargeResponseIsReceived) {
+    EchoServer server{};
+    PersistentUnixDomainSocketClientConnector connector{server.get_path()};
+
+    const std::string large(8 * 1024 * 1024, 'x');
+    const auto response = json::Json::parse(connector.send_request(make_request(1, large)));
+    EXPECT_EQ(large, response["result"].get<std::string>());
+}
+
+TEST(PersistentUnixDomainSocketClientConnectorTest, ReconnectsWhenConnectionIsClosed) {
+    EchoServer server{1, true};
+    PersistentUnixDomainSocketClientConnector connector{server.get_path()};
+
+    EXPECT_EQ(1, json::Json::parse(connector.send_request(make_request(1, 1)))["result"].get<int>());
+    ASSERT_TRUE(server.wait_for_closed(1));
+    EXPECT_EQ(2, json::Json::parse(connector.send_request(make_request(2, 2)))["result"].get<int>());
+    EXPECT_EQ(2, server.get_accepted());
+}
+
+TEST(PersistentUnixDomainSocketClientConnectorTest, NotificationDoesNotWaitForResponse) {
+    EchoServer server{};
+    PersistentUnixDomainSocketClientConnector connector{server.get_path()};
+
+    json::Json notification = json::Json::object();
+    notification["jsonrpc"] = "2.0";
+    notification["method"] = "notify";
+    EXPECT_TRUE(connector.send_request(notification.dump()).empty());
+    ASSERT_TRUE(server.wait_for_requests(1));
+    EXPECT_EQ("notify", server.get_requests().front()["method"].get<std::string>());
+}
+
+TEST(PersistentUnixDomainSocketClientConnectorTest, ThrowsWhenServerIsNotAvailable) {
+    PersistentUnixDomainSocketClientConnector connector{"/tmp/json_rpc_socket_not_existing.sock"};
+    EXPECT_THROW(connector.send_request(make_request(1, 1)), JsonRpcException);
+}
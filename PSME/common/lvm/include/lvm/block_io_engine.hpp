@@ -0,0 +1,129 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @file block_io_engine.hpp
+ * @brief Block device copy and erase engine
+ * */
+
+#pragma once
+
+
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+
+
+namespace storage {
+namespace lvm {
+
+/*!
+ * @brief Progress callback of block I/O operations
+ * @param processed_bytes Number of bytes already processed
+ * @param total_bytes Number of bytes to be processed
+ * */
+using ProgressCallback = std::function<void(std::uint64_t processed_bytes, std::uint64_t total_bytes)>;
+
+
+/*! @brief Options of block I/O operations */
+struct BlockIoOptions {
+    /*! Size of a single read or write request, must be a multiple of 4 KiB */
+    std::uint32_t request_size{4 * 1024 * 1024};
+
+    /*! Number of requests in flight */
+    unsigned queue_depth{4};
+
+    /*! Bypass the page cache if the device supports it */
+    bool direct_io{true};
+
+    /*! Offload writing of zeroes to the device if it supports it */
+    bool zeroes_offload{true};
+};
+
+
+/*!
+ * @brief Engine copying and erasing data of block devices.
+ *
+ * Data is processed in requests handled by queue_depth workers, each using its own aligned buffer.
+ * Ranges of zeroes are written with the write zeroes offload of the device (BLKZEROOUT for block devices,
+ * zero range allocation for regular files) when it is supported, so zeroed regions of a clone source are not
+ * transferred. Operations writing to the same device are serialized, operations on different devices run
+ * concurrently.
+ * */
+class BlockIoEngine {
+public:
+    /*! @brief Erase patterns */
+    enum class ErasePattern {
+        ZEROES,
+        RANDOM
+    };
+
+    /*! @brief Statistics of an operation */
+    struct Statistics {
+        /*! Number of bytes processed */
+        std::uint64_t processed_bytes{0};
+        /*! Number of bytes written by the write requests */
+        std::uint64_t written_bytes{0};
+        /*! Number of bytes zeroed by the device offload */
+        std::uint64_t offloaded_bytes{0};
+    };
+
+    /*!
+     * @brief Constructor
+     * @param options I/O options
+     * @param progress_callback Callback called after each processed request, may be called from any worker
+     * */
+    explicit BlockIoEngine(const BlockIoOptions& options = {}, const ProgressCallback& progress_callback = {});
+
+
+    /*!
+     * @brief Copies whole data of the source device to the destination device
+     * @param source Path to the source device
+     * @param destination Path to the destination device
+     * @return Statistics of the copy operation
+     * */
+    Statistics copy(const std::string& source, const std::string& destination) const;
+
+
+    /*!
+     * @brief Overwrites data of the device
+     * @param destination Path to the device
+     * @param size Number of bytes to be erased from the start of the device
+     * @param pattern Data written to the device
+     * @return Statistics of the erase operation
+     * */
+    Statistics erase(const std::string& destination, std::uint64_t size, ErasePattern pattern) const;
+
+
+    /*!
+     * @brief Returns size of the device
+     * @param path Path to the device or regular file
+     * @return Size in bytes
+     * */
+    static std::uint64_t get_device_size(const std::string& path);
+
+private:
+    BlockIoOptions m_options{};
+    ProgressCallback m_progress_callback{};
+};
+
+}
+}
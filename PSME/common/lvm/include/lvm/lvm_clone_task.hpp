@@ -27,6 +27,7 @@
 
 
 #include "model/creation_data.hpp"
+#include "block_io_engine.hpp"
 
 
 
@@ -39,8 +40,9 @@ public:
     /*!
      * @brief Constructor
      * @param[in] creation_data Data to clone
+     * @param[in] progress_callback Callback notified about copied data
      * */
-    explicit LvmCloneTask(const model::CreationData& creation_data);
+    explicit LvmCloneTask(const model::CreationData& creation_data, const ProgressCallback& progress_callback = {});
 
 
     /*! @brief Starts cloning */
@@ -49,6 +51,7 @@ public:
 
 private:
     model::CreationData m_creation_data{};
+    ProgressCallback m_progress_callback{};
 
 
     std::string get_source() const;
@@ -26,6 +26,8 @@
 
 
 
+#include "block_io_engine.hpp"
+
 #include <string>
 
 
@@ -42,8 +44,10 @@ public:
      * @param path Path to the device.
      * @param size Capacity in bytes of the device to be cleared.
      * @param fast True if erase method should be fast, false to replace data with random noise.
+     * @param progress_callback Callback notified about erased data.
      */
-    explicit LvmEraseTask(const std::string& path, std::uint64_t size, bool fast);
+    explicit LvmEraseTask(const std::string& path, std::uint64_t size, bool fast,
+                          const ProgressCallback& progress_callback = {});
 
 
     /*! @brief Starts erasing */
@@ -53,6 +57,7 @@ private:
     std::string m_destination_path{};
     std::uint64_t m_size{};
     bool m_fast{false};
+    ProgressCallback m_progress_callback{};
 };
 
 }
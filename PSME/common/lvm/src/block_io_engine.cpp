@@ -0,0 +1,416 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file block_io_engine.cpp
+ * @brief Block device copy and erase engine implementation
+ * */
+
+#include "lvm/block_io_engine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+
+using namespace storage::lvm;
+
+namespace {
+
+/*! Alignment of buffers, offsets and sizes required by direct I/O */
+constexpr std::uint32_t ALIGNMENT = 4096;
+
+/*! Alignment of ranges accepted by BLKZEROOUT */
+constexpr std::uint64_t SECTOR_SIZE = 512;
+
+
+std::string get_error_message(const std::string& message, const std::string& path) {
+    return message + " " + path + ": " + std::strerror(errno);
+}
+
+
+bool is_unsupported_error(int error) {
+    return EOPNOTSUPP == error || ENOTTY == error || EINVAL == error || ENOSYS == error;
+}
+
+
+bool is_zeroed(const std::uint8_t* data, std::size_t size) {
+    return 0 == size || (0 == data[0] && 0 == std::memcmp(data, data + 1, size - 1));
+}
+
+
+/*! @brief Device opened for block I/O, direct I/O is used only if the device supports it */
+class DeviceFile {
+public:
+    DeviceFile(const std::string& path, int flags, bool direct_io) : m_path(path) {
+        if (direct_io) {
+            m_fd = ::open(path.c_str(), flags | O_DIRECT | O_CLOEXEC);
+        }
+        if (m_fd < 0) {
+            m_fd = ::open(path.c_str(), flags | O_CLOEXEC);
+        }
+        if (m_fd < 0) {
+            throw std::runtime_error(get_error_message("Unable to open device", path));
+        }
+        struct stat file_stat{};
+        if (0 != ::fstat(m_fd, &file_stat)) {
+            ::close(m_fd);
+            throw std::runtime_error(get_error_message("Unable to stat device", path));
+        }
+        m_is_block_device = S_ISBLK(file_stat.st_mode);
+        m_size = std::uint64_t(file_stat.st_size);
+        if (m_is_block_device && 0 != ::ioctl(m_fd, BLKGETSIZE64, &m_size)) {
+            ::close(m_fd);
+            throw std::runtime_error(get_error_message("Unable to read size of device", path));
+        }
+    }
+
+    DeviceFile(const DeviceFile&) = delete;
+    DeviceFile& operator=(const DeviceFile&) = delete;
+
+    ~DeviceFile() {
+        ::close(m_fd);
+    }
+
+    bool is_block_device() const {
+        return m_is_block_device;
+    }
+
+    std::uint64_t get_size() const {
+        return m_size;
+    }
+
+    void read(std::uint8_t* data, std::size_t size, std::uint64_t offset) const {
+        while (size > 0) {
+            auto result = ::pread(m_fd, data, size, off_t(offset));
+            if (result < 0 && EINTR == errno) {
+                continue;
+            }
+            if (result < 0) {
+                throw std::runtime_error(get_error_message("Unable to read data from device", m_path));
+            }
+            if (0 == result) {
+                throw std::runtime_error("Unexpected end of device " + m_path);
+            }
+            data += result;
+            size -= std::size_t(result);
+            offset += std::uint64_t(result);
+        }
+    }
+
+    void write(const std::uint8_t* data, std::size_t size, std::uint64_t offset) const {
+        while (size > 0) {
+            auto result = ::pwrite(m_fd, data, size, off_t(offset));
+            if (result < 0 && EINTR == errno) {
+                continue;
+            }
+            if (result <= 0) {
+                throw std::runtime_error(get_error_message("Unable to write data to device", m_path));
+            }
+            data += result;
+            size -= std::size_t(result);
+            offset += std::uint64_t(result);
+        }
+    }
+
+    /*! Zeroes the range using the device offload, returns false if the device does not support it */
+    bool zero_range(std::uint64_t offset, std::uint64_t size) const {
+        int result{};
+        if (m_is_block_device) {
+            if (0 != offset % SECTOR_SIZE || 0 != size % SECTOR_SIZE) {
+                return false;
+            }
+            std::uint64_t range[2] = {offset, size};
+            result = ::ioctl(m_fd, BLKZEROOUT, range);
+        }
+        else {
+            result = ::fallocate(m_fd, FALLOC_FL_ZERO_RANGE, off_t(offset), off_t(size));
+        }
+        if (0 == result) {
+            return true;
+        }
+        if (is_unsupported_error(errno)) {
+            return false;
+        }
+        throw std::runtime_error(get_error_message("Unable to zero data of device", m_path));
+    }
+
+    void sync() const {
+        if (0 != ::fdatasync(m_fd)) {
+            throw std::runtime_error(get_error_message("Unable to flush data to device", m_path));
+        }
+    }
+
+private:
+    std::string m_path{};
+    int m_fd{-1};
+    bool m_is_block_device{false};
+    std::uint64_t m_size{0};
+};
+
+
+/*! @brief Serializes operations writing to the same device */
+class DeviceLock {
+public:
+    explicit DeviceLock(const std::string& path) : m_key(get_canonical_path(path)) {
+        std::unique_lock<std::mutex> lock{get_mutex()};
+        get_released().wait(lock, [this]() { return 0 == get_locked().count(m_key); });
+        get_locked().insert(m_key);
+    }
+
+    DeviceLock(const DeviceLock&) = delete;
+    DeviceLock& operator=(const DeviceLock&) = delete;
+
+    ~DeviceLock() {
+        {
+            std::lock_guard<std::mutex> lock{get_mutex()};
+            get_locked().erase(m_key);
+        }
+        get_released().notify_all();
+    }
+
+private:
+    static std::string get_canonical_path(const std::string& path) {
+        std::unique_ptr<char, decltype(&std::free)> resolved{::realpath(path.c_str(), nullptr), &std::free};
+        return resolved ? std::string{resolved.get()} : path;
+    }
+
+    static std::mutex& get_mutex() {
+        static std::mutex mutex{};
+        return mutex;
+    }
+
+    static std::condition_variable& get_released() {
+        static std::condition_variable released{};
+        return released;
+    }
+
+    static std::set<std::string>& get_locked() {
+        static std::set<std::string> locked{};
+        return locked;
+    }
+
+    std::string m_key{};
+};
+
+
+using Buffer = std::unique_ptr<std::uint8_t, decltype(&std::free)>;
+
+
+Buffer allocate_buffer(std::size_t size) {
+    void* data{nullptr};
+    if (0 != ::posix_memalign(&data, ALIGNMENT, size)) {
+        throw std::bad_alloc();
+    }
+    std::memset(data, 0, size);
+    return Buffer{static_cast<std::uint8_t*>(data), &std::free};
+}
+
+
+/*! @brief State of an operation shared by its workers */
+class Operation {
+public:
+    using BufferInitializer = std::function<void(std::uint8_t* buffer, std::size_t size, unsigned worker)>;
+    using RequestHandler = std::function<void(std::uint8_t* buffer, std::uint64_t offset, std::size_t size)>;
+
+    Operation(std::uint64_t size, const BlockIoOptions& options, const ProgressCallback& progress_callback) :
+        m_size(size), m_options(options), m_progress_callback(progress_callback) {}
+
+    /*! Handles all requests of the operation, rethrows the first error of the workers */
+    void run(const BufferInitializer& initializer, const RequestHandler& handler) {
+        const auto requests = (m_size + m_options.request_size - 1) / m_options.request_size;
+        const auto workers = unsigned(std::min<std::uint64_t>(m_options.queue_depth, requests));
+
+        std::vector<std::thread> threads{};
+        threads.reserve(workers);
+        for (unsigned worker = 0; worker < workers; ++worker) {
+            threads.emplace_back(&Operation::work, this, worker, std::cref(initializer), std::cref(handler));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+private:
+    void work(unsigned worker, const BufferInitializer& initializer, const RequestHandler& handler) {
+        try {
+            auto buffer = allocate_buffer(m_options.request_size);
+            if (initializer) {
+                initializer(buffer.get(), m_options.request_size, worker);
+            }
+            while (!m_is_stopped) {
+                const auto offset = m_next_offset.fetch_add(m_options.request_size);
+                if (offset >= m_size) {
+                    break;
+                }
+                const auto size = std::size_t(std::min<std::uint64_t>(m_options.request_size, m_size - offset));
+                handler(buffer.get(), offset, size);
+                report_progress(size);
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (!m_error) {
+                m_error = std::current_exception();
+            }
+            m_is_stopped = true;
+        }
+    }
+
+    void report_progress(std::size_t size) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_processed += size;
+        if (m_progress_callback) {
+            m_progress_callback(m_processed, m_size);
+        }
+    }
+
+    const std::uint64_t m_size;
+    const BlockIoOptions& m_options;
+    const ProgressCallback& m_progress_callback;
+    std::atomic<std::uint64_t> m_next_offset{0};
+    std::atomic<bool> m_is_stopped{false};
+    std::mutex m_mutex{};
+    std::uint64_t m_processed{0};
+    std::exception_ptr m_error{};
+};
+
+
+/*! @brief Statistics updated concurrently by workers */
+struct AtomicStatistics {
+    std::atomic<std::uint64_t> written_bytes{0};
+    std::atomic<std::uint64_t> offloaded_bytes{0};
+    bool is_offload_enabled{true};
+
+    BlockIoEngine::Statistics get(std::uint64_t processed_bytes) const {
+        BlockIoEngine::Statistics statistics{};
+        statistics.processed_bytes = processed_bytes;
+        statistics.written_bytes = written_bytes;
+        statistics.offloaded_bytes = offloaded_bytes;
+        return statistics;
+    }
+
+    /*! Zeroes the range using the device offload, returns false if the range has to be written */
+    bool try_zero_range(const DeviceFile& file, std::uint64_t offset, std::size_t size) {
+        if (is_offload_enabled && file.zero_range(offset, size)) {
+            offloaded_bytes += size;
+            return true;
+        }
+        return false;
+    }
+
+    void write(const DeviceFile& file, const std::uint8_t* data, std::size_t size, std::uint64_t offset) {
+        file.write(data, size, offset);
+        written_bytes += size;
+    }
+};
+
+}
+
+
+BlockIoEngine::BlockIoEngine(const BlockIoOptions& options, const ProgressCallback& progress_callback) :
+    m_options(options), m_progress_callback(progress_callback) {
+
+    if (0 == m_options.request_size || 0 != m_options.request_size % ALIGNMENT) {
+        throw std::invalid_argument("Block I/O request size must be a multiple of " + std::to_string(ALIGNMENT));
+    }
+    if (0 == m_options.queue_depth) {
+        throw std::invalid_argument("Block I/O queue depth must be positive");
+    }
+}
+
+
+BlockIoEngine::Statistics BlockIoEngine::copy(const std::string& source, const std::string& destination) const {
+    DeviceLock lock{destination};
+    const auto size = get_device_size(source);
+    const bool direct_io = m_options.direct_io && 0 == size % ALIGNMENT;
+    DeviceFile input{source, O_RDONLY, direct_io};
+    DeviceFile output{destination, O_WRONLY, direct_io};
+    if (output.is_block_device() && output.get_size() < size) {
+        throw std::runtime_error("Device " + destination + " is smaller than " + source);
+    }
+
+    AtomicStatistics statistics{};
+    statistics.is_offload_enabled = m_options.zeroes_offload;
+    Operation{size, m_options, m_progress_callback}.run({},
+        [&](std::uint8_t* buffer, std::uint64_t offset, std::size_t request_size) {
+            input.read(buffer, request_size, offset);
+            if (!is_zeroed(buffer, request_size) || !statistics.try_zero_range(output, offset, request_size)) {
+                statistics.write(output, buffer, request_size, offset);
+            }
+        });
+    output.sync();
+    return statistics.get(size);
+}
+
+
+BlockIoEngine::Statistics BlockIoEngine::erase(const std::string& destination, std::uint64_t size,
+                                               ErasePattern pattern) const {
+    DeviceLock lock{destination};
+    DeviceFile output{destination, O_WRONLY, m_options.direct_io && 0 == size % ALIGNMENT};
+
+    AtomicStatistics statistics{};
+    statistics.is_offload_enabled = m_options.zeroes_offload && ErasePattern::ZEROES == pattern;
+    Operation::BufferInitializer initializer{};
+    if (ErasePattern::RANDOM == pattern) {
+        const auto seed = std::uint64_t(std::chrono::system_clock::now().time_since_epoch().count())
+                          ^ std::random_device{}();
+        initializer = [seed](std::uint8_t* buffer, std::size_t buffer_size, unsigned worker) {
+            std::mt19937_64 generator{seed + worker};
+            for (std::size_t offset = 0; offset < buffer_size; offset += sizeof(std::uint64_t)) {
+                const auto value = generator();
+                std::memcpy(buffer + offset, &value, sizeof(value));
+            }
+        };
+    }
+
+    Operation{size, m_options, m_progress_callback}.run(initializer,
+        [&](std::uint8_t* buffer, std::uint64_t offset, std::size_t request_size) {
+            if (!statistics.try_zero_range(output, offset, request_size)) {
+                statistics.write(output, buffer, request_size, offset);
+            }
+        });
+    output.sync();
+    return statistics.get(size);
+}
+
+
+std::uint64_t BlockIoEngine::get_device_size(const std::string& path) {
+    return DeviceFile{path, O_RDONLY, false}.get_size();
+}
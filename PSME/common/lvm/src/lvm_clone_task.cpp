@@ -24,34 +24,22 @@
 #include "lvm/lvm_clone_task.hpp"
 #include "logger/logger.hpp"
 
-#include <fstream>
-
 
 
 using namespace storage::lvm;
 
 
-LvmCloneTask::LvmCloneTask(const model::CreationData& creation_data) :
-    m_creation_data{creation_data} {}
+LvmCloneTask::LvmCloneTask(const model::CreationData& creation_data, const ProgressCallback& progress_callback) :
+    m_creation_data{creation_data}, m_progress_callback{progress_callback} {}
 
 
 void LvmCloneTask::operator()() {
     log_info("lvm", "Clone task started [Src: " << get_source() << ", Dest: " << get_destination() << "]");
 
     try {
-        std::ifstream source(get_source(), std::ios::binary);
-        std::ofstream destination(get_destination(), std::ios::binary);
-        static constexpr int BUFFER_SIZE = 1024 * 1024;
-        char buffer[BUFFER_SIZE];
-
-        do {
-            source.read(buffer, BUFFER_SIZE);
-            destination.write(buffer, source.gcount());
-        }
-        while (!source.eof());
-
-        source.close();
-        destination.close();
+        auto statistics = BlockIoEngine{BlockIoOptions{}, m_progress_callback}.copy(get_source(), get_destination());
+        log_debug("lvm", "Cloned " << statistics.processed_bytes << " bytes, " << statistics.offloaded_bytes
+                                   << " bytes zeroed by device offload.");
     }
     catch (const std::exception& error) {
         throw std::runtime_error(std::string{"Could not copy data to clone: "} + error.what());
@@ -0,0 +1,261 @@
+/*!
+ * @copyright
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * @copyright
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * @copyright
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @copyright
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file block_io_engine.cpp
+ * @brief Block I/O engine tests
+ * */
+
+#include "lvm/block_io_engine.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+
+
+using namespace storage::lvm;
+
+namespace {
+
+constexpr std::size_t MiB = 1024 * 1024;
+
+
+class BlockIoEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char directory[] = "/tmp/block_io_engine_XXXXXX";
+        ASSERT_NE(nullptr, ::mkdtemp(directory));
+        m_directory = directory;
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(0, std::system(("rm -rf " + m_directory).c_str()));
+    }
+
+    std::string get_path(const std::string& name) const {
+        return m_directory + "/" + name;
+    }
+
+    /*! Creates device with chunks of zeroes and data, every zeroed_chunks_period chunk is zeroed */
+    std::string create_device(const std::string& name, std::size_t size, std::size_t zeroed_chunks_period,
+                              std::size_t chunk_size = MiB) const {
+        std::vector<char> data(size, 0);
+        for (std::size_t i = 0; i < size; ++i) {
+            if (0 != (i / chunk_size) % zeroed_chunks_period) {
+                data[i] = char(i * 7 + 1);
+            }
+        }
+        return write_device(name, data);
+    }
+
+    std::string write_device(const std::string& name, const std::vector<char>& data) const {
+        std::ofstream file(get_path(name), std::ios::binary);
+        file.write(data.data(), std::streamsize(data.size()));
+        return get_path(name);
+    }
+
+    static std::vector<char> read_device(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+private:
+    std::string m_directory{};
+};
+
+}
+
+
+TEST_F(BlockIoEngineTest, CopyOfAlignedDevice) {
+    const auto source = create_device("source", 9 * MiB, 3);
+    const auto destination = write_device("destination", std::vector<char>(9 * MiB, char(0xff)));
+
+    BlockIoOptions options{};
+    options.request_size = MiB;
+    auto statistics = BlockIoEngine{options}.copy(source, destination);
+
+    EXPECT_EQ(read_device(source), read_device(destination));
+    EXPECT_EQ(9 * MiB, statistics.processed_bytes);
+    EXPECT_EQ(9 * MiB, statistics.written_bytes + statistics.offloaded_bytes);
+    EXPECT_GE(6 * MiB, statistics.written_bytes);
+}
+
+
+TEST_F(BlockIoEngineTest, CopyOfUnalignedDeviceWithoutOffload) {
+    const auto source = create_device("source", 5 * MiB + 123, 2);
+    const auto destination = write_device("destination", {});
+
+    BlockIoOptions options{};
+    options.request_size = MiB;
+    options.zeroes_offload = false;
+    auto statistics = BlockIoEngine{options}.copy(source, destination);
+
+    EXPECT_EQ(read_device(source), read_device(destination));
+    EXPECT_EQ(5 * MiB + 123, statistics.written_bytes);
+    EXPECT_EQ(0, statistics.offloaded_bytes);
+}
+
+
+TEST_F(BlockIoEngineTest, CopyReportsProgress) {
+    const auto source = create_device("source", 4 * MiB + 4096, 2);
+    const auto destination = write_device("destination", {});
+
+    std::vector<std::uint64_t> progress{};
+    BlockIoOptions options{};
+    options.request_size = MiB;
+    BlockIoEngine{options, [&progress](std::uint64_t processed_bytes, std::uint64_t total_bytes) {
+        EXPECT_EQ(4 * MiB + 4096, total_bytes);
+        progress.push_back(processed_bytes);
+    }}.copy(source, destination);
+
+    ASSERT_EQ(5, progress.size());
+    EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+    EXPECT_EQ(4 * MiB + 4096, progress.back());
+}
+
+
+TEST_F(BlockIoEngineTest, CopyOfMissingDeviceThrows) {
+    const auto destination = write_device("destination", {});
+    EXPECT_THROW(BlockIoEngine{}.copy(get_path("missing"), destination), std::runtime_error);
+}
+
+
+TEST_F(BlockIoEngineTest, EraseWithZeroes) {
+    const auto device = write_device("device", std::vector<char>(3 * MiB, char(0xff)));
+
+    BlockIoOptions options{};
+    options.request_size = MiB;
+    BlockIoEngine{options}.erase(device, 2 * MiB + 4096, BlockIoEngine::ErasePattern::ZEROES);
+
+    auto data = read_device(device);
+    ASSERT_EQ(3 * MiB, data.size());
+    EXPECT_TRUE(std::all_of(data.begin(), data.begin() + 2 * MiB + 4096, [](char c) { return 0 == c; }));
+    EXPECT_TRUE(std::all_of(data.begin() + 2 * MiB + 4096, data.end(), [](char c) { return char(0xff) == c; }));
+}
+
+
+TEST_F(BlockIoEngineTest, EraseWithRandomData) {
+    const auto device = write_device("device", std::vector<char>(2 * MiB, 0));
+
+    BlockIoOptions options{};
+    options.request_size = 64 * 1024;
+    auto statistics = BlockIoEngine{options}.erase(device, 2 * MiB, BlockIoEngine::ErasePattern::RANDOM);
+
+    auto data = read_device(device);
+    EXPECT_EQ(2 * MiB, statistics.written_bytes);
+    EXPECT_EQ(0, statistics.offloaded_bytes);
+    EXPECT_LT(std::count(data.begin(), data.end(), 0), std::ptrdiff_t(2 * MiB / 128));
+}
+
+
+TEST_F(BlockIoEngineTest, ConcurrentErasesOfDifferentDevices) {
+    const std::vector<std::string> devices{write_device("first", std::vector<char>(2 * MiB, char(0xff))),
+                                           write_device("second", std::vector<char>(2 * MiB, char(0xff)))};
+
+    /* each erase waits in its first progress report until the other one reports progress too */
+    std::mutex mutex{};
+    std::condition_variable started{};
+    unsigned started_erases{0};
+    std::vector<bool> overlapped(devices.size(), false);
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < devices.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            bool is_first_report{true};
+            BlockIoOptions options{};
+            options.request_size = 256 * 1024;
+            BlockIoEngine{options, [&](std::uint64_t, std::uint64_t) {
+                if (is_first_report) {
+                    is_first_report = false;
+                    std::unique_lock<std::mutex> lock{mutex};
+                    ++started_erases;
+                    started.notify_all();
+                    overlapped[i] = started.wait_for(lock, std::chrono::seconds(10),
+                                                     [&]() { return started_erases == devices.size(); });
+                }
+            }}.erase(devices[i], 2 * MiB, BlockIoEngine::ErasePattern::ZEROES);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(std::vector<bool>(devices.size(), true), overlapped);
+    for (const auto& device : devices) {
+        EXPECT_EQ(std::vector<char>(2 * MiB, 0), read_device(device));
+    }
+}
+
+
+TEST_F(BlockIoEngineTest, InvalidOptionsThrow) {
+    BlockIoOptions options{};
+    options.request_size = 1000;
+    EXPECT_THROW(BlockIoEngine{options}, std::invalid_argument);
+
+    options = BlockIoOptions{};
+    options.queue_depth = 0;
+    EXPECT_THROW(BlockIoEngine{options}, std::invalid_argument);
+}
+
+
+TEST_F(BlockIoEngineTest, ZeroedChunksOfThinVolumeAreNotTransferred) {
+    static constexpr std::size_t SIZE = 8 * MiB;
+    /* thinly provisioned volume, a half of data is written */
+    const auto source = create_device("source", SIZE, 2);
+    const auto destination = write_device("destination", {});
+
+    unsigned requests{0};
+    BlockIoOptions options{};
+    options.request_size = MiB;
+    auto statistics = BlockIoEngine{options, [&requests](std::uint64_t, std::uint64_t) { ++requests; }}
+        .copy(source, destination);
+
+    EXPECT_EQ(read_device(source), read_device(destination));
+    EXPECT_EQ(SIZE / MiB, requests);
+    EXPECT_EQ(SIZE, statistics.processed_bytes);
+    EXPECT_EQ(SIZE, statistics.written_bytes + statistics.offloaded_bytes);
+    /* zeroed chunks are written only if the file system does not support the offload */
+    EXPECT_TRUE(SIZE / 2 == statistics.written_bytes || SIZE == statistics.written_bytes);
+}
+
+
+TEST_F(BlockIoEngineTest, FastEraseWritesNoDataIfOffloadIsSupported) {
+    static constexpr std::size_t SIZE = 4 * MiB;
+    const auto device = create_device("device", SIZE, 2);
+
+    unsigned requests{0};
+    BlockIoOptions options{};
+    options.request_size = MiB;
+    auto statistics = BlockIoEngine{options, [&requests](std::uint64_t, std::uint64_t) { ++requests; }}
+        .erase(device, SIZE, BlockIoEngine::ErasePattern::ZEROES);
+
+    EXPECT_EQ(std::vector<char>(SIZE, 0), read_device(device));
+    EXPECT_EQ(SIZE / MiB, requests);
+    EXPECT_EQ(SIZE, statistics.written_bytes + statistics.offloaded_bytes);
+    EXPECT_TRUE(SIZE == statistics.offloaded_bytes || 0 == statistics.offloaded_bytes);
+}
@@ -0,0 +1,144 @@
+/*!
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sysfs/pci_topology.hpp
+ */
+
+#pragma once
+
+#include "sysfs/abstract_sysfs_interface.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sysfs {
+
+/*! Represents a PCI function in the sysfs */
+struct PciFunction final {
+    /*! Address of the function in the format dddd:bb:dd.f (lowercase) */
+    std::string address{};
+    /*! Path to the link in the PCI bus directory */
+    Path link{};
+    /*! Canonized path to the function */
+    Path path{};
+};
+
+/*! Represents a block device in the sysfs with its position in the PCI topology */
+struct PciBlockDevice final {
+    /*! Name of the block device, e.g. nvme0n1 */
+    std::string name{};
+    /*! Canonized path to the block device */
+    Path path{};
+    /*! Addresses of all PCI functions on the path to the device, from the root port down to the endpoint */
+    std::vector<std::string> pci_addresses{};
+    /*! Name of the namespace (e.g. nvme0n1 in .../nvme/nvme0/nvme0n1), empty if the device is not a namespace */
+    std::string namespace_name{};
+};
+
+/*!
+ * @brief Index of block devices attached to PCI functions.
+ *
+ * The PCI bus and block device directories are read and all of their links are resolved once, on construction.
+ * All queries are then served from memory, so the index is a snapshot of the topology: a new one has to be built
+ * to see devices added or removed later.
+ */
+class PciTopology final {
+public:
+
+    /*!
+     * @brief Reads the PCI and block devices and builds the index
+     * @param sysfs_interface Interface used to access the sysfs
+     * @param pci_devices_path Path to the directory with links to all PCI functions
+     * @param block_devices_path Path to the directory with links to all block devices
+     * @throws std::runtime_error if the PCI bus directory cannot be read. If only the block devices directory
+     * cannot be read, the index holds PCI functions without block devices.
+     */
+    PciTopology(const AbstractSysfsInterface& sysfs_interface,
+                const Path& pci_devices_path = "/sys/bus/pci/devices",
+                const Path& block_devices_path = "/sys/block");
+
+    ~PciTopology();
+
+    PciTopology(const PciTopology&) = default;
+    PciTopology& operator=(const PciTopology&) = default;
+
+    PciTopology(PciTopology&&) = default;
+    PciTopology& operator=(PciTopology&&) = default;
+
+    /*!
+     * @brief Returns all PCI functions
+     * @return List of PCI functions in the order of the PCI bus directory
+     */
+    const std::vector<PciFunction>& get_pci_functions() const {
+        return m_pci_functions;
+    }
+
+    /*!
+     * @brief Returns all block devices attached to PCI functions
+     * @return List of block devices in the order of the block devices directory
+     */
+    const std::vector<PciBlockDevice>& get_block_devices() const {
+        return m_block_devices;
+    }
+
+    /*!
+     * @brief Returns names of all block devices below a PCI function, on any depth
+     * @param pci_address Address of the function in the format dddd:bb:dd.f (case insensitive)
+     * @return Names of the block devices
+     */
+    std::vector<std::string> get_block_device_names(const std::string& pci_address) const;
+
+    /*!
+     * @brief Returns names of all namespaces below a PCI function, on any depth
+     * @param pci_address Address of the function in the format dddd:bb:dd.f (case insensitive)
+     * @return Names of the namespaces
+     */
+    std::vector<std::string> get_namespace_names(const std::string& pci_address) const;
+
+    /*!
+     * @brief Returns links which could not be resolved while the index was built
+     * @return List of links skipped by the index
+     */
+    const std::vector<Path>& get_unresolved_links() const {
+        return m_unresolved_links;
+    }
+
+    /*!
+     * @brief Checks if the block devices directory was read
+     * @return False if the index holds no block devices because the directory could not be read
+     */
+    bool are_block_devices_read() const {
+        return m_block_devices_read;
+    }
+
+    /*!
+     * @brief Checks if a string is a PCI function address
+     * @param str String to be checked
+     * @return True if the string is in the format dddd:bb:dd.f
+     */
+    static bool is_pci_address(const std::string& str);
+
+private:
+
+    const std::vector<std::size_t>& get_children(const std::string& pci_address) const;
+
+    std::vector<PciFunction> m_pci_functions{};
+    std::vector<PciBlockDevice> m_block_devices{};
+    /* indexes of the block devices below each of the PCI functions */
+    std::unordered_map<std::string, std::vector<std::size_t>> m_children{};
+    std::vector<Path> m_unresolved_links{};
+    bool m_block_devices_read{false};
+};
+
+}
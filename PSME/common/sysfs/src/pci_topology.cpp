@@ -0,0 +1,170 @@
+/*!
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file pci_topology.cpp
+ */
+
+#include "sysfs/pci_topology.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace sysfs;
+
+namespace {
+
+/* Length of the dddd:bb:dd.f address */
+constexpr std::size_t PCI_ADDRESS_LENGTH = 12;
+
+
+std::string to_lower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(),
+                   [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    return str;
+}
+
+
+std::vector<std::string> split(const std::string& path) {
+    std::vector<std::string> components{};
+    std::size_t begin = 0;
+    while (begin < path.size()) {
+        auto end = path.find('/', begin);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        if (end > begin) {
+            components.emplace_back(path, begin, end - begin);
+        }
+        begin = end + 1;
+    }
+    return components;
+}
+
+
+bool starts_with(const std::string& str, const std::string& prefix) {
+    return str.size() >= prefix.size() && 0 == str.compare(0, prefix.size(), prefix);
+}
+
+
+/* Fills PCI addresses and namespace name from the canonized path of the block device */
+void update_block_device(PciBlockDevice& device) {
+    const auto components = split(device.path.to_string());
+    auto it = std::find_if(components.begin(), components.end(), PciTopology::is_pci_address);
+    for (; it != components.end() && PciTopology::is_pci_address(*it); ++it) {
+        device.pci_addresses.push_back(to_lower(*it));
+    }
+
+    // namespaces are in the class/controller/namespace subdirectory of the endpoint, e.g. nvme/nvme0/nvme0n1
+    static constexpr std::ptrdiff_t NAMESPACE_DEPTH = 3;
+    if (!device.pci_addresses.empty() && NAMESPACE_DEPTH == std::distance(it, components.end())
+        && starts_with(*(it + 1), *it) && starts_with(*(it + 2), *(it + 1))) {
+        device.namespace_name = *(it + 2);
+    }
+}
+
+}
+
+
+PciTopology::PciTopology(const AbstractSysfsInterface& sysfs_interface, const Path& pci_devices_path,
+                         const Path& block_devices_path) {
+
+    for (const auto& link : sysfs_interface.get_dir(pci_devices_path).links) {
+        PciFunction function{};
+        function.address = to_lower(link.basename());
+        function.link = link;
+        try {
+            function.path = sysfs_interface.get_absolute_path(link);
+        }
+        catch (const std::exception&) {
+            m_unresolved_links.push_back(link);
+            continue;
+        }
+        m_pci_functions.push_back(std::move(function));
+    }
+
+    SysfsDir block_devices{};
+    try {
+        block_devices = sysfs_interface.get_dir(block_devices_path);
+    }
+    catch (const std::exception&) {
+        // PCI functions are still valid, they are reported without block devices
+        return;
+    }
+    m_block_devices_read = true;
+
+    for (const auto& link : block_devices.links) {
+        PciBlockDevice device{};
+        device.name = link.basename();
+        try {
+            device.path = sysfs_interface.get_absolute_path(link);
+        }
+        catch (const std::exception&) {
+            m_unresolved_links.push_back(link);
+            continue;
+        }
+        update_block_device(device);
+        if (device.pci_addresses.empty()) {
+            // virtual devices, e.g. loop or ram disks
+            continue;
+        }
+        for (const auto& address : device.pci_addresses) {
+            m_children[address].push_back(m_block_devices.size());
+        }
+        m_block_devices.push_back(std::move(device));
+    }
+}
+
+
+PciTopology::~PciTopology() {}
+
+
+std::vector<std::string> PciTopology::get_block_device_names(const std::string& pci_address) const {
+    std::vector<std::string> names{};
+    for (const auto index : get_children(pci_address)) {
+        names.push_back(m_block_devices[index].name);
+    }
+    return names;
+}
+
+
+std::vector<std::string> PciTopology::get_namespace_names(const std::string& pci_address) const {
+    std::vector<std::string> names{};
+    for (const auto index : get_children(pci_address)) {
+        if (!m_block_devices[index].namespace_name.empty()) {
+            names.push_back(m_block_devices[index].namespace_name);
+        }
+    }
+    return names;
+}
+
+
+bool PciTopology::is_pci_address(const std::string& str) {
+    if (PCI_ADDRESS_LENGTH != str.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < PCI_ADDRESS_LENGTH; ++i) {
+        const bool is_separator = (4 == i || 7 == i || 10 == i);
+        if (is_separator ? (str[i] != (10 == i ? '.' : ':'))
+                         : !std::isxdigit(static_cast<unsigned char>(str[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+const std::vector<std::size_t>& PciTopology::get_children(const std::string& pci_address) const {
+    static const std::vector<std::size_t> NO_CHILDREN{};
+    const auto it = m_children.find(to_lower(pci_address));
+    return it != m_children.end() ? it->second : NO_CHILDREN;
+}
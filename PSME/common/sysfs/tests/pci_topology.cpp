@@ -0,0 +1,300 @@
+/*!
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file tests/pci_topology.cpp
+ */
+
+#include "sysfs/pci_topology.hpp"
+#include "sysfs/sysfs_interface.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+
+using namespace sysfs;
+
+namespace {
+
+std::string execute(const std::string& cmd) {
+    static const unsigned SIZE = 100;
+    char buffer[SIZE]{};
+    FILE* fp = popen(cmd.c_str(), "r");
+    std::string ret{};
+    while (fgets(buffer, sizeof(buffer), fp)) {
+        ret += buffer;
+    }
+    pclose(fp);
+    if (!ret.empty() && ret.back() == '\n') {
+        ret.pop_back();
+    }
+    return ret;
+}
+
+
+/* RAII class for test directory creation/removal, the sysfs tree is created with a single shell script */
+class TestSysfs final {
+public:
+    TestSysfs() {
+        m_name = execute("mktemp -d");
+        if (m_name.empty()) {
+            throw std::runtime_error("Unable to prepare testing directory");
+        }
+        m_path = Path(m_name);
+    }
+
+    ~TestSysfs() {
+        if (!m_name.empty()) {
+            execute("rm -R " + m_name + "/");
+        }
+    }
+
+    /* adds a device directory, path is relative to the devices directory */
+    TestSysfs& add_device(const std::string& path) {
+        m_script << "mkdir -p " << devices() << "/" << path << "\n";
+        return *this;
+    }
+
+    /* adds a link to the device directory, path of the link is relative to the test directory */
+    TestSysfs& add_link(const std::string& link, const std::string& device_path) {
+        m_script << "mkdir -p " << m_name << "/" << Path(link).dirname().to_string() << " && ln -s "
+                 << devices() << "/" << device_path << " " << m_name << "/" << link << "\n";
+        return *this;
+    }
+
+    /* adds a PCI function and its link in the bus directory */
+    TestSysfs& add_pci_function(const std::string& path) {
+        return add_device(path).add_link("bus/pci/devices/" + Path(path).basename(), path);
+    }
+
+    /* adds a block device and its link in the block directory */
+    TestSysfs& add_block_device(const std::string& path) {
+        return add_device(path).add_link("block/" + Path(path).basename(), path);
+    }
+
+    void create() {
+        execute(m_script.str());
+        m_script.str({});
+    }
+
+    std::string devices() const { return m_name + "/devices"; }
+    Path pci_devices() const { return m_path / "bus/pci/devices"; }
+    Path block_devices() const { return m_path / "block"; }
+
+private:
+    std::string m_name{};
+    Path m_path{};
+    std::stringstream m_script{};
+};
+
+
+std::vector<std::string> sorted(std::vector<std::string> names) {
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+
+class PciTopologyTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        sysfs.add_pci_function("pci0000:00/0000:00:01.0")
+            .add_pci_function("pci0000:00/0000:00:01.0/0000:01:00.0")
+            .add_pci_function("pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:00.0")
+            .add_pci_function("pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:01.0")
+            .add_pci_function("pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:00.0/0000:03:00.0")
+            .add_pci_function("pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:01.0/0000:04:00.0")
+            .add_pci_function("pci0000:00/0000:00:1f.2")
+            .add_block_device("pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:00.0/0000:03:00.0/nvme/nvme0/nvme0n1")
+            .add_block_device("pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:00.0/0000:03:00.0/nvme/nvme0/nvme0n2")
+            .add_block_device("pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:01.0/0000:04:00.0/nvme/nvme1/nvme1n1")
+            .add_block_device("pci0000:00/0000:00:1f.2/ata1/host0/target0:0:0/0:0:0:0/block/sda")
+            .add_block_device("virtual/block/loop0")
+            .add_link("bus/pci/devices/0000:05:00.0", "pci0000:00/0000:05:00.0")
+            .create();
+    }
+
+    TestSysfs sysfs{};
+    SysfsInterface iface{};
+};
+
+}
+
+
+TEST_F(PciTopologyTest, BlockDevicesAreAssignedToAllFunctionsOnTheirPath) {
+    PciTopology topology{iface, sysfs.pci_devices(), sysfs.block_devices()};
+
+    EXPECT_EQ(sorted({"nvme0n1", "nvme0n2"}), sorted(topology.get_block_device_names("0000:03:00.0")));
+    EXPECT_EQ(sorted({"nvme0n1", "nvme0n2"}), sorted(topology.get_block_device_names("0000:02:00.0")));
+    EXPECT_EQ(std::vector<std::string>{"nvme1n1"}, topology.get_block_device_names("0000:04:00.0"));
+    EXPECT_EQ(3u, topology.get_block_device_names("0000:01:00.0").size());
+    EXPECT_EQ(3u, topology.get_block_device_names("0000:00:01.0").size());
+    EXPECT_EQ(std::vector<std::string>{"sda"}, topology.get_block_device_names("0000:00:1F.2"));
+    EXPECT_TRUE(topology.get_block_device_names("0000:06:00.0").empty());
+}
+
+
+TEST_F(PciTopologyTest, NamespacesAreRecognizedByPath) {
+    PciTopology topology{iface, sysfs.pci_devices(), sysfs.block_devices()};
+
+    EXPECT_EQ(sorted({"nvme0n1", "nvme0n2", "nvme1n1"}), sorted(topology.get_namespace_names("0000:01:00.0")));
+    EXPECT_TRUE(topology.get_namespace_names("0000:00:1f.2").empty());
+
+    const auto& devices = topology.get_block_devices();
+    const auto it = std::find_if(devices.begin(), devices.end(),
+                                 [](const PciBlockDevice& device) { return device.name == "nvme1n1"; });
+    ASSERT_TRUE(devices.end() != it);
+    EXPECT_EQ((std::vector<std::string>{"0000:00:01.0", "0000:01:00.0", "0000:02:01.0", "0000:04:00.0"}),
+              it->pci_addresses);
+    EXPECT_EQ("nvme1n1", it->namespace_name);
+}
+
+
+TEST_F(PciTopologyTest, VirtualDevicesAndUnresolvedLinksAreSkipped) {
+    PciTopology topology{iface, sysfs.pci_devices(), sysfs.block_devices()};
+
+    EXPECT_EQ(4u, topology.get_block_devices().size());
+    EXPECT_EQ(7u, topology.get_pci_functions().size());
+    ASSERT_EQ(1u, topology.get_unresolved_links().size());
+    EXPECT_EQ("0000:05:00.0", topology.get_unresolved_links().front().basename());
+
+    for (const auto& function : topology.get_pci_functions()) {
+        EXPECT_EQ(function.address, function.path.basename());
+        EXPECT_EQ(function.address, function.link.basename());
+    }
+}
+
+
+TEST_F(PciTopologyTest, MissingPciDirectoryThrows) {
+    EXPECT_THROW(PciTopology(iface, sysfs.pci_devices() / "missing", sysfs.block_devices()), std::runtime_error);
+}
+
+
+TEST_F(PciTopologyTest, PciFunctionsAreKeptWithoutBlockDevicesDirectory) {
+    PciTopology topology{iface, sysfs.pci_devices(), sysfs.block_devices() / "missing"};
+
+    EXPECT_FALSE(topology.are_block_devices_read());
+    EXPECT_EQ(7u, topology.get_pci_functions().size());
+    EXPECT_TRUE(topology.get_block_devices().empty());
+    EXPECT_TRUE(topology.get_block_device_names("0000:03:00.0").empty());
+}
+
+
+TEST(PciTopologyAddressTest, PciAddressesAreRecognized) {
+    EXPECT_TRUE(PciTopology::is_pci_address("0000:00:01.0"));
+    EXPECT_TRUE(PciTopology::is_pci_address("ABCD:EF:1f.7"));
+    EXPECT_FALSE(PciTopology::is_pci_address("pci0000:00"));
+    EXPECT_FALSE(PciTopology::is_pci_address("0000:00:01:0"));
+    EXPECT_FALSE(PciTopology::is_pci_address("0000:0g:01.0"));
+    EXPECT_FALSE(PciTopology::is_pci_address("0000:00:01.0 "));
+}
+
+
+namespace {
+
+constexpr unsigned DOWNSTREAM_PORTS = 16;
+constexpr unsigned NAMESPACES = 4;
+
+
+/* Sysfs interface counting directory reads and resolved links */
+class CountingSysfsInterface final : public SysfsInterface {
+public:
+    SysfsDir get_dir(const Path& path) const override {
+        ++dir_reads;
+        return SysfsInterface::get_dir(path);
+    }
+
+    Path get_absolute_path(const Path& input) const override {
+        ++resolved_links;
+        return SysfsInterface::get_absolute_path(input);
+    }
+
+    mutable std::size_t dir_reads{0};
+    mutable std::size_t resolved_links{0};
+};
+
+
+/*
+ * Reference implementation reading the drives of a single device, as done before the topology index:
+ * block directory is read, all links are resolved and a regular expression is compiled for each of them.
+ */
+std::vector<std::string> read_drives_per_device(const SysfsInterface& iface, const TestSysfs& sysfs,
+                                                const std::string& address, std::size_t& regex_matches) {
+    std::vector<std::string> drives{};
+    const std::string regex_str = sysfs.devices() + "/pci....:../(?:....:..:..\\../)*" + address + "/(.*)";
+    for (const auto& link_path : iface.get_dir(sysfs.block_devices()).links) {
+        std::smatch matches{};
+        const auto absolute_path_str = iface.get_absolute_path(link_path).to_string();
+        ++regex_matches;
+        std::regex_match(absolute_path_str, matches, std::regex(regex_str, std::regex_constants::icase));
+        if (2 == matches.size()) {
+            drives.push_back(link_path.basename());
+        }
+    }
+    return drives;
+}
+
+}
+
+
+TEST(PciTopologyBenchmark, SingleScanComparedToScanPerDevice) {
+    TestSysfs sysfs{};
+
+    /* switch with an NVMe drive with several namespaces behind each downstream port */
+    const std::string upstream = "pci0000:00/0000:00:01.0/0000:01:00.0";
+    sysfs.add_pci_function("pci0000:00/0000:00:01.0").add_pci_function(upstream);
+    for (unsigned port = 0; port < DOWNSTREAM_PORTS; ++port) {
+        std::stringstream downstream{};
+        downstream << upstream << "/0000:02:" << std::hex << std::setw(2) << std::setfill('0') << port << ".0";
+        std::stringstream endpoint{};
+        endpoint << downstream.str() << "/0000:" << std::hex << std::setw(2) << std::setfill('0') << port + 3
+                 << ":00.0";
+        sysfs.add_pci_function(downstream.str()).add_pci_function(endpoint.str());
+        const auto controller = endpoint.str() + "/nvme/nvme" + std::to_string(port);
+        for (unsigned ns = 1; ns <= NAMESPACES; ++ns) {
+            sysfs.add_block_device(controller + "/" + Path(controller).basename() + "n" + std::to_string(ns));
+        }
+    }
+    sysfs.create();
+    const std::size_t functions = 2 + 2 * DOWNSTREAM_PORTS;
+    const std::size_t block_devices = DOWNSTREAM_PORTS * NAMESPACES;
+
+    CountingSysfsInterface per_device_iface{};
+    std::size_t per_device_checksum{0};
+    std::size_t regex_matches{0};
+    for (const auto& link : per_device_iface.get_dir(sysfs.pci_devices()).links) {
+        per_device_checksum += read_drives_per_device(per_device_iface, sysfs, link.basename(), regex_matches).size();
+    }
+
+    CountingSysfsInterface index_iface{};
+    std::size_t index_checksum{0};
+    PciTopology topology{index_iface, sysfs.pci_devices(), sysfs.block_devices()};
+    for (const auto& function : topology.get_pci_functions()) {
+        index_checksum += topology.get_block_device_names(function.address).size();
+    }
+
+    /* each drive is below the root port, the upstream port, its downstream port and its endpoint */
+    EXPECT_EQ(4u * DOWNSTREAM_PORTS * NAMESPACES, index_checksum);
+    EXPECT_EQ(per_device_checksum, index_checksum);
+
+    /* block directory is read and all of its links are resolved and matched for each of the functions */
+    EXPECT_EQ(1 + functions, per_device_iface.dir_reads);
+    EXPECT_EQ(functions * block_devices, per_device_iface.resolved_links);
+    EXPECT_EQ(functions * block_devices, regex_matches);
+
+    /* both directories are read and each link is resolved once */
+    EXPECT_EQ(2u, index_iface.dir_reads);
+    EXPECT_EQ(functions + block_devices, index_iface.resolved_links);
+}
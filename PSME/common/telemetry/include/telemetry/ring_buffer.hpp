@@ -0,0 +1,173 @@
+/*!
+ * @brief RingBuffer
+ *
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file ring_buffer.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace telemetry {
+
+/*!
+ * FIFO container with contiguous storage of fixed capacity.
+ *
+ * Elements are appended at the back and removed from the front without moving other elements.
+ * Capacity is reserved upfront, it is doubled only if the container is full.
+ */
+template<typename T>
+class RingBuffer {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    /*! Iterator over elements, from the oldest one */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        const_iterator(const RingBuffer* buffer, size_type position) : m_buffer{buffer}, m_position{position} {}
+
+        reference operator*() const {
+            return (*m_buffer)[m_position];
+        }
+
+        pointer operator->() const {
+            return &(*m_buffer)[m_position];
+        }
+
+        const_iterator& operator++() {
+            ++m_position;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto it = *this;
+            ++m_position;
+            return it;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return m_buffer == other.m_buffer && m_position == other.m_position;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const RingBuffer* m_buffer{nullptr};
+        size_type m_position{0};
+    };
+
+    using iterator = const_iterator;
+
+    /*!
+     * Reserves storage for given number of elements
+     * @param capacity Number of elements to be stored without reallocation
+     */
+    void reserve(size_type capacity) {
+        if (capacity <= m_data.size()) {
+            return;
+        }
+        std::vector<T> data(capacity);
+        for (size_type i = 0; i < m_size; ++i) {
+            data[i] = std::move(m_data[index(i)]);
+        }
+        m_data.swap(data);
+        m_head = 0;
+    }
+
+    /*! Appends new element, the storage is extended if the buffer is full */
+    template<typename... Args>
+    void emplace_back(Args&&... args) {
+        if (m_size == m_data.size()) {
+            reserve(m_data.empty() ? MIN_CAPACITY : 2 * m_data.size());
+        }
+        m_data[index(m_size)] = T(std::forward<Args>(args)...);
+        ++m_size;
+    }
+
+    /*! Appends new element */
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    /*! Removes the oldest element */
+    void pop_front() {
+        m_head = index(1);
+        --m_size;
+    }
+
+    /*! Removes all elements, the storage is kept */
+    void clear() {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    size_type size() const { return m_size; }
+
+    size_type capacity() const { return m_data.size(); }
+
+    bool empty() const { return 0 == m_size; }
+
+    /*!
+     * Element access
+     * @param position Position of the element, 0 is the oldest one
+     * @return Element at given position
+     */
+    const_reference operator[](size_type position) const {
+        return m_data[index(position)];
+    }
+
+    const_reference front() const { return (*this)[0]; }
+
+    const_reference back() const { return (*this)[m_size - 1]; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    const_iterator end() const { return const_iterator(this, m_size); }
+
+    const_iterator cbegin() const { return begin(); }
+
+    const_iterator cend() const { return end(); }
+
+private:
+    static constexpr size_type MIN_CAPACITY = 8;
+
+    size_type index(size_type position) const {
+        const auto i = m_head + position;
+        return i < m_data.size() ? i : i - m_data.size();
+    }
+
+    std::vector<T> m_data{};
+    size_type m_head{0};
+    size_type m_size{0};
+};
+
+}
@@ -19,7 +19,10 @@
 
 #pragma once
 
+#include "telemetry/ring_buffer.hpp"
+
 #include <algorithm>
+#include <chrono>
 #include <vector>
 
 namespace telemetry {
@@ -56,10 +59,10 @@ bool sample_by_time_comp(const Sample& a, const Sample& b) {
     return a.m_timepoint < b.m_timepoint;
 }
 
-/*! Sample container */
+/*! Sample container, samples are stored in order of timepoints */
 template<typename T = double,
          typename C = std::chrono::steady_clock>
-using Samples = std::vector<Sample<T, C>>;
+using Samples = RingBuffer<Sample<T, C>>;
 
 /*! Removes "old" samples before given timepoint.
  *  We assume samples are ordered by timepoint
@@ -74,4 +77,12 @@ void remove_samples_before_timepoint(Samples& samples, typename Samples::value_t
                   }));
 }
 
+/*! Removes "old" samples before given timepoint from the front of the ring buffer. */
+template<typename Sample>
+void remove_samples_before_timepoint(RingBuffer<Sample>& samples, typename Sample::TimePoint time_point) {
+    while (!samples.empty() && samples.front().m_timepoint < time_point) {
+        samples.pop_front();
+    }
+}
+
 }
@@ -0,0 +1,180 @@
+/*!
+ * @brief SampleWindow
+ *
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sample_window.hpp
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <type_traits>
+#include <utility>
+
+namespace telemetry {
+
+/*!
+ * Aggregates of numeric samples in the sliding window, updated on each appended and removed sample.
+ *
+ * The trapezoid integral of the samples is kept as a running sum, minimum and maximum are kept
+ * as fronts of monotonic queues. Each sample is added to and removed from the queues once,
+ * so all aggregates are maintained in amortized O(1) time.
+ *
+ * The integral is recalculated from the samples after as many removals as the window size,
+ * so rounding errors of subtractions do not accumulate (still amortized O(1)).
+ *
+ * Aggregates are calculated for numeric samples only, the window of other samples does nothing.
+ */
+template<typename Samples,
+         bool NUMERIC = std::is_arithmetic<typename Samples::value_type::ValueType>::value>
+class SampleWindow {
+public:
+    using Sample = typename Samples::value_type;
+    using ValueType = typename Sample::ValueType;
+
+    /*! Aggregates are available */
+    static constexpr bool is_enabled() noexcept { return true; }
+
+    /*!
+     * Appends new sample to the window
+     * @param samples Samples of the window, the new sample is already appended
+     */
+    void on_sample_added(const Samples& samples) {
+        const auto& sample = samples.back();
+        if (samples.size() > 1) {
+            m_area += trapezoid(samples[samples.size() - 2], sample);
+        }
+        while (!m_minimum.empty() && !(m_minimum.back().second < sample.m_value)) {
+            m_minimum.pop_back();
+        }
+        m_minimum.emplace_back(m_added, sample.m_value);
+        while (!m_maximum.empty() && !(sample.m_value < m_maximum.back().second)) {
+            m_maximum.pop_back();
+        }
+        m_maximum.emplace_back(m_added, sample.m_value);
+        ++m_added;
+    }
+
+    /*!
+     * Removes the oldest sample from the window
+     * @param removed The removed sample
+     * @param samples Samples of the window, the sample is already removed
+     */
+    void on_sample_removed(const Sample& removed, const Samples& samples) {
+        if (!m_minimum.empty() && m_minimum.front().first == m_removed) {
+            m_minimum.pop_front();
+        }
+        if (!m_maximum.empty() && m_maximum.front().first == m_removed) {
+            m_maximum.pop_front();
+        }
+        ++m_removed;
+
+        if (samples.size() < 2) {
+            m_area = 0.0;
+            m_removed_since_sum = 0;
+        }
+        else if (++m_removed_since_sum >= samples.size()) {
+            m_area = sum_area(samples);
+            m_removed_since_sum = 0;
+        }
+        else {
+            m_area -= trapezoid(removed, samples.front());
+        }
+    }
+
+    /*! Removes all samples */
+    void clear() {
+        m_area = 0.0;
+        m_removed_since_sum = 0;
+        m_added = m_removed = 0;
+        m_minimum.clear();
+        m_maximum.clear();
+    }
+
+    /*!
+     * Time weighted average of the samples, samples are linearly interpolated
+     * @param samples Samples of the window, at least two samples are expected
+     * @return Integral of the samples divided by the window duration
+     */
+    double get_average(const Samples& samples) const {
+        using namespace std::chrono;
+        return m_area / duration_cast<duration<double>>(
+            samples.back().m_timepoint - samples.front().m_timepoint).count();
+    }
+
+    /*! Minimal value in the window, at least one sample is expected */
+    ValueType get_minimum() const {
+        return m_minimum.front().second;
+    }
+
+    /*! Maximal value in the window, at least one sample is expected */
+    ValueType get_maximum() const {
+        return m_maximum.front().second;
+    }
+
+private:
+    /* Samples are identified by the order number of insertion */
+    using Candidates = std::deque<std::pair<std::uint64_t, ValueType>>;
+
+    static double trapezoid(const Sample& first, const Sample& second) {
+        using namespace std::chrono;
+        return (double(first.m_value) + double(second.m_value)) / 2.0
+               * duration_cast<duration<double>>(second.m_timepoint - first.m_timepoint).count();
+    }
+
+    static double sum_area(const Samples& samples) {
+        double area = 0.0;
+        for (typename Samples::size_type i = 1; i < samples.size(); ++i) {
+            area += trapezoid(samples[i - 1], samples[i]);
+        }
+        return area;
+    }
+
+    double m_area{0.0};
+    typename Samples::size_type m_removed_since_sum{0};
+    std::uint64_t m_added{0};
+    std::uint64_t m_removed{0};
+    /* Ascending values of samples which may become the minimum, the oldest first */
+    Candidates m_minimum{};
+    /* Descending values of samples which may become the maximum, the oldest first */
+    Candidates m_maximum{};
+};
+
+
+/*! Window of non-numeric samples, no aggregates are calculated */
+template<typename Samples>
+class SampleWindow<Samples, false> {
+public:
+    using Sample = typename Samples::value_type;
+    using ValueType = typename Sample::ValueType;
+
+    static constexpr bool is_enabled() noexcept { return false; }
+
+    void on_sample_added(const Samples&) {}
+
+    void on_sample_removed(const Sample&, const Samples&) {}
+
+    void clear() {}
+
+    double get_average(const Samples&) const { return 0.0; }
+
+    ValueType get_minimum() const { return ValueType(); }
+
+    ValueType get_maximum() const { return ValueType(); }
+};
+
+}
@@ -25,6 +25,7 @@
 #include <vector>
 #include <string>
 #include "sample.hpp"
+#include "sample_window.hpp"
 #include "agent-framework/module/enum/common.hpp"
 #include "json-wrapper/json-wrapper.hpp"
 
@@ -75,6 +76,24 @@ json::Json maximum_during_interval(const Samples& samples) {
     return json::Json(it->m_value);
 }
 
+/*! Calculation algorithm selector */
+template<typename T>
+CalculationAlgorithm<T> select_algorithm(agent_framework::model::enums::MetricAlgorithm metric_algorithm) {
+    switch (metric_algorithm) {
+    case agent_framework::model::enums::MetricAlgorithm::AverageOverInterval:
+        return average_over_interval<T>;
+    case agent_framework::model::enums::MetricAlgorithm::MaximumDuringInterval:
+        return maximum_during_interval<T>;
+    case agent_framework::model::enums::MetricAlgorithm::MinimumDuringInterval:
+        return minimum_during_interval<T>;
+    default:
+        break;
+    };
+    return [](const T& samples) {
+        return samples.empty() ? json::Json() : json::Json(samples.back().m_value);
+    };
+}
+
 template<typename T>
 struct SampleTraits {
     static constexpr bool accepts_null() noexcept { return false; }
@@ -89,6 +108,11 @@ struct SampleTraits<json::Json> {
 
 /*!
  * Processes samples according to given calculation parameters
+ *
+ * Samples are kept in a FIFO container (RingBuffer by default). If the processor is built for one of
+ * the metric algorithms and samples are numeric, values are calculated from streaming aggregates
+ * of the SampleWindow in amortized O(1) time. Otherwise the calculation algorithm is executed
+ * on all samples of the window.
  */
 template<typename T = Samples<>,
          bool CLEAR_ON_NULL = true>
@@ -100,6 +124,7 @@ public:
     using ValueType = typename Sample::ValueType;
     using Clock = typename Sample::Clock;
     using TimePoint = typename Sample::TimePoint;
+    using Window = SampleWindow<Samples>;
 
     /*!
      * Constructor
@@ -117,6 +142,21 @@ public:
         }
     }
 
+    /*!
+     * Constructor of processor calculating the metric algorithm from streaming aggregates
+     * @param calculation_interval Samples calculation interval
+     * @param sensing_interval Samples sensing interval
+     * @param metric_algorithm Metric calculation algorithm
+     */
+    SamplesProcessor(typename TimePoint::duration calculation_interval,
+                     typename TimePoint::duration sensing_interval,
+                     agent_framework::model::enums::MetricAlgorithm metric_algorithm)
+        : SamplesProcessor(calculation_interval, sensing_interval, select_algorithm<Samples>(metric_algorithm)) {
+
+        m_streaming_algorithm = Window::is_enabled();
+        m_metric_algorithm = metric_algorithm;
+    }
+
     /*!
      * Appends new sample to sample collection and calculates new value over samples.
      * If necessary trims sample collection to fit calculation interval window.
@@ -129,46 +169,63 @@ public:
         const auto is_null = value.is_null();
         if (CLEAR_ON_NULL && is_null) {
             m_samples.clear();
+            m_window.clear();
         }
         else {
-            remove_samples_before_timepoint<Samples>(m_samples, now - m_calculation_interval);
+            remove_samples_before(now - m_calculation_interval);
             if (!is_null) {
-                m_samples.emplace_back(value.get<ValueType>(), now);
+                add_sample(value.get<ValueType>(), now);
             }
             else {
                 if (STraits::accepts_null()) {
-                    m_samples.emplace_back(STraits::null(), now);
+                    add_sample(STraits::null(), now);
                 }
                 else {
                     log_debug("samples_processor", "skipping null");
                 }
             }
         }
-        return m_algorithm(m_samples);
+        return m_streaming_algorithm ? calculate_from_window() : m_algorithm(m_samples);
     }
 
 private:
+    void add_sample(ValueType value, TimePoint now) {
+        m_samples.emplace_back(value, now);
+        m_window.on_sample_added(m_samples);
+    }
+
+    void remove_samples_before(TimePoint time_point) {
+        while (!m_samples.empty() && m_samples.front().m_timepoint < time_point) {
+            const auto removed = m_samples.front();
+            m_samples.pop_front();
+            m_window.on_sample_removed(removed, m_samples);
+        }
+    }
+
+    json::Json calculate_from_window() const {
+        if (m_samples.empty()) {
+            return json::Json();
+        }
+        switch (m_metric_algorithm) {
+        case agent_framework::model::enums::MetricAlgorithm::AverageOverInterval:
+            return (1 == m_samples.size()) ? json::Json(m_samples.back().m_value)
+                                           : json::Json(m_window.get_average(m_samples));
+        case agent_framework::model::enums::MetricAlgorithm::MinimumDuringInterval:
+            return json::Json(m_window.get_minimum());
+        case agent_framework::model::enums::MetricAlgorithm::MaximumDuringInterval:
+            return json::Json(m_window.get_maximum());
+        default:
+            return json::Json(m_samples.back().m_value);
+        }
+    }
+
     typename TimePoint::duration m_calculation_interval;
     CalculationAlgorithm<Samples> m_algorithm;
     Samples m_samples{};
+    Window m_window{};
+    bool m_streaming_algorithm{false};
+    agent_framework::model::enums::MetricAlgorithm m_metric_algorithm{
+        agent_framework::model::enums::MetricAlgorithm::AverageOverInterval};
 };
 
-/*! Calculation algorithm selector */
-template<typename T>
-CalculationAlgorithm<T> select_algorithm(agent_framework::model::enums::MetricAlgorithm metric_algorithm) {
-    switch (metric_algorithm) {
-    case agent_framework::model::enums::MetricAlgorithm::AverageOverInterval:
-        return average_over_interval<T>;
-    case agent_framework::model::enums::MetricAlgorithm::MaximumDuringInterval:
-        return maximum_during_interval<T>;
-    case agent_framework::model::enums::MetricAlgorithm::MinimumDuringInterval:
-        return minimum_during_interval<T>;
-    default:
-        break;
-    };
-    return [](const T& samples) {
-        return samples.empty() ? json::Json() : json::Json(samples.back().m_value);
-    };
-}
-
 }
@@ -0,0 +1,95 @@
+/*!
+ * @brief Cache of SDR repositories read from the BMCs
+ *
+ * Reading whole SDR takes a request per record, so it is done only if the repository
+ * was changed since it was read last time. Changes are detected by last addition/erase
+ * timestamps reported in Get SDR Repository Info. Read repositories are stored in the
+ * database, so they are reused after the agent is restarted.
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sdr_cache.hpp
+ */
+
+#pragma once
+
+#include "ipmi/ipmi_controller.hpp"
+#include "database/database.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace telemetry {
+
+class SdrCache final {
+public:
+    using Record = ipmi::IpmiInterface::ByteBuffer;
+    using Records = std::vector<Record>;
+
+    /*!
+     * @brief Get cache used by all sensor readers, repositories are stored in "sdr" database
+     * @return singleton instance
+     */
+    static SdrCache& get_instance();
+
+    /*!
+     * @brief Create cache
+     * @param _db database to store read repositories in, nullptr if repositories are kept in memory only
+     */
+    explicit SdrCache(database::Database::SPtr _db);
+
+    SdrCache(const SdrCache&) = delete;
+    SdrCache& operator=(const SdrCache&) = delete;
+
+    /*!
+     * @brief Get all records of the SDR repository
+     *
+     * Records are read from the BMC only if there is no valid cached copy. Repositories without
+     * addition/erase timestamps are always read.
+     *
+     * @param ctrl IPMI controller of the BMC
+     * @return all SDR records, with record headers
+     */
+    Records get_records(ipmi::IpmiController& ctrl);
+
+    /*!
+     * @brief Read all records of the SDR repository, without caching
+     * @param ctrl IPMI controller of the BMC
+     * @return all SDR records, with record headers
+     */
+    static Records read_records(ipmi::IpmiController& ctrl);
+
+private:
+    struct Repository {
+        std::uint32_t addition_timestamp{};
+        std::uint32_t erase_timestamp{};
+        Records records{};
+    };
+
+    bool load(const std::string& key, Repository& repository);
+    void store(const std::string& key, const Repository& repository);
+
+    static std::string serialize(const Repository& repository);
+    static bool unserialize(const std::string& str, Repository& repository);
+
+    database::Database::SPtr m_db;
+
+    std::mutex m_mutex{};
+    /*! Repositories by controller info */
+    std::map<std::string, Repository> m_repositories{};
+};
+
+}
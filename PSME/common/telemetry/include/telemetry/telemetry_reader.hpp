@@ -281,7 +281,7 @@ protected:
             && m_metric_definition.get_calculation_time_interval().has_value()) {
             auto calculation_interval = m_metric_definition.get_calculation_period().as<typename SamplesProcessor<>::TimePoint::duration>();
             auto sensing_interval = m_metric_definition.get_sensing_period().as<typename SamplesProcessor<>::TimePoint::duration>();
-            auto algorithm = select_algorithm<typename SamplesProcessor<>::Samples>(*m_metric_definition.get_calculation_algorithm());
+            auto algorithm = *m_metric_definition.get_calculation_algorithm();
             m_samples_processor.reset(new SamplesProcessor<>(calculation_interval, sensing_interval, algorithm));
         }
     }
@@ -0,0 +1,239 @@
+/*!
+ * @brief Implementation of SDR repository cache
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sdr_cache.cpp
+ */
+
+#include "telemetry/sdr_cache.hpp"
+
+#include "ipmi/command/generic/reserve_sdr_repository.hpp"
+#include "ipmi/command/generic/get_sdr_repository_info.hpp"
+#include "ipmi/command/generic/get_sdr.hpp"
+
+#include "logger/logger_factory.hpp"
+
+#include <cctype>
+
+using namespace ipmi::command::generic;
+
+namespace {
+
+/*! Timestamp reported if the repository cannot tell when it was changed */
+constexpr std::uint32_t UNSPECIFIED_TIMESTAMP = 0xFFFFFFFF;
+
+/*! Values stored in the file database are limited to 64kB */
+constexpr std::size_t MAX_STORED_LENGTH = 65535;
+
+constexpr char SEPARATOR = ':';
+constexpr const char HEX_DIGITS[] = "0123456789abcdef";
+
+
+void append_hex(std::string& str, std::uint32_t value) {
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        str.push_back(HEX_DIGITS[(value >> shift) & 0x0F]);
+    }
+}
+
+
+int from_hex(char c) {
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+    if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+
+bool parse_timestamp(const std::string& str, std::size_t& pos, std::uint32_t& value) {
+    value = 0;
+    for (std::size_t i = 0; i < 8; ++i, ++pos) {
+        const int digit = (pos < str.size()) ? from_hex(str[pos]) : -1;
+        if (digit < 0) {
+            return false;
+        }
+        value = (value << 4) | std::uint32_t(digit);
+    }
+    return true;
+}
+
+
+/*! Database keys are used as file names, so all "special" characters are replaced */
+std::string get_key(const ipmi::IpmiController& ctrl) {
+    std::string key = ctrl.get_info();
+    for (auto& c : key) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && (c != '.')) {
+            c = '_';
+        }
+    }
+    return key;
+}
+
+}
+
+
+namespace telemetry {
+
+SdrCache& SdrCache::get_instance() {
+    static SdrCache cache{database::Database::create("sdr")};
+    return cache;
+}
+
+
+SdrCache::SdrCache(database::Database::SPtr _db) : m_db(_db) { }
+
+
+SdrCache::Records SdrCache::get_records(ipmi::IpmiController& ctrl) {
+    response::GetSdrRepositoryInfo info{};
+    ctrl.send(request::GetSdrRepositoryInfo(), info);
+
+    if ((info.get_last_addition_timestamp() == UNSPECIFIED_TIMESTAMP)
+        && (info.get_last_delete_timestamp() == UNSPECIFIED_TIMESTAMP)) {
+        log_debug("telemetry", "SDR changes of " << ctrl.get_info() << " are not tracked, SDR not cached");
+        return read_records(ctrl);
+    }
+
+    const auto key = get_key(ctrl);
+    auto is_valid = [&info](const Repository& repository) {
+        return (repository.addition_timestamp == info.get_last_addition_timestamp())
+               && (repository.erase_timestamp == info.get_last_delete_timestamp())
+               && (repository.records.size() == info.get_record_count());
+    };
+
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        auto it = m_repositories.find(key);
+        if ((it != m_repositories.end()) && is_valid(it->second)) {
+            log_debug("telemetry", "Cached SDR of " << ctrl.get_info() << " used");
+            return it->second.records;
+        }
+
+        Repository stored{};
+        if (load(key, stored) && is_valid(stored)) {
+            log_info("telemetry", "Stored SDR of " << ctrl.get_info() << " used, "
+                                  << stored.records.size() << " records");
+            m_repositories[key] = stored;
+            return stored.records;
+        }
+    }
+
+    Repository repository{};
+    repository.addition_timestamp = info.get_last_addition_timestamp();
+    repository.erase_timestamp = info.get_last_delete_timestamp();
+    repository.records = read_records(ctrl);
+    log_info("telemetry", "SDR of " << ctrl.get_info() << " read, " << repository.records.size() << " records");
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    store(key, repository);
+    m_repositories[key] = repository;
+    return repository.records;
+}
+
+
+SdrCache::Records SdrCache::read_records(ipmi::IpmiController& ctrl) {
+    Records records{};
+
+    response::ReserveSdrRepository reserve_sdr_repo_resp{};
+    ctrl.send(request::ReserveSdrRepository(), reserve_sdr_repo_resp);
+
+    request::GetSdr get_sdr_req{};
+    get_sdr_req.set_record_id(request::GetSdr::SDR_FIRST_RECORD_ID);
+    get_sdr_req.set_reservation_id(reserve_sdr_repo_resp.get_reservation_id());
+    get_sdr_req.set_bytes_to_read(request::GetSdr::GET_SDR_ENTIRE_RECORD);
+    response::GetSdr get_sdr_resp{};
+
+    do {
+        ctrl.send(get_sdr_req, get_sdr_resp);
+        records.push_back(get_sdr_resp.get_record_data());
+        get_sdr_req.set_record_id(get_sdr_resp.get_next_record_id());
+    }
+    while (get_sdr_resp.get_next_record_id() != request::GetSdr::SDR_LAST_RECORD_ID);
+
+    return records;
+}
+
+
+bool SdrCache::load(const std::string& key, Repository& repository) {
+    database::String value{};
+    if (!m_db || !m_db->get(database::String{key}, value)) {
+        return false;
+    }
+    if (!unserialize(value, repository)) {
+        log_warning("telemetry", "Invalid SDR stored for " << key);
+        return false;
+    }
+    return true;
+}
+
+
+void SdrCache::store(const std::string& key, const Repository& repository) {
+    if (!m_db) {
+        return;
+    }
+    const auto value = serialize(repository);
+    if (value.size() > MAX_STORED_LENGTH) {
+        log_debug("telemetry", "SDR of " << key << " too big to be stored");
+        m_db->remove(database::String{key});
+        return;
+    }
+    if (!m_db->put(database::String{key}, database::String{value})) {
+        log_warning("telemetry", "Cannot store SDR of " << key);
+    }
+}
+
+
+std::string SdrCache::serialize(const Repository& repository) {
+    std::string str{};
+    append_hex(str, repository.addition_timestamp);
+    append_hex(str, repository.erase_timestamp);
+    for (const auto& record : repository.records) {
+        str.push_back(SEPARATOR);
+        for (const auto byte : record) {
+            str.push_back(HEX_DIGITS[byte >> 4]);
+            str.push_back(HEX_DIGITS[byte & 0x0F]);
+        }
+    }
+    return str;
+}
+
+
+bool SdrCache::unserialize(const std::string& str, Repository& repository) {
+    std::size_t pos = 0;
+    if (!parse_timestamp(str, pos, repository.addition_timestamp)
+        || !parse_timestamp(str, pos, repository.erase_timestamp)) {
+        return false;
+    }
+    repository.records.clear();
+    while (pos < str.size()) {
+        if (str[pos++] != SEPARATOR) {
+            return false;
+        }
+        Record record{};
+        while ((pos < str.size()) && (str[pos] != SEPARATOR)) {
+            const int high = from_hex(str[pos]);
+            const int low = (pos + 1 < str.size()) ? from_hex(str[pos + 1]) : -1;
+            if ((high < 0) || (low < 0)) {
+                return false;
+            }
+            record.push_back(std::uint8_t((high << 4) | low));
+            pos += 2;
+        }
+        repository.records.push_back(std::move(record));
+    }
+    return true;
+}
+
+}
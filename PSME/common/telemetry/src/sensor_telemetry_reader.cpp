@@ -17,14 +17,15 @@
  */
 
 #include "telemetry/sensor_telemetry_reader.hpp"
+#include "telemetry/sdr_cache.hpp"
 
-#include "ipmi/command/generic/reserve_sdr_repository.hpp"
-#include "ipmi/command/generic/get_sdr_repository_info.hpp"
-#include "ipmi/command/generic/get_sdr.hpp"
 #include "ipmi/command/generic/get_sensor_reading.hpp"
 
 #include "logger/logger_factory.hpp"
 
+#include <chrono>
+#include <map>
+
 extern "C" {
 #include "ipmitool/ipmi_sdr.h"
 #undef GET_SDR_ENTIRE_RECORD
@@ -34,6 +35,11 @@ using namespace ipmi::command::generic;
 
 namespace {
 
+/*! Sensors owned by the BMC are read without bridging */
+constexpr std::uint8_t BMC_SLAVE_ADDRESS = 0x20;
+/*! Owner ID is a system software ID (not IPMB slave address) */
+constexpr std::uint8_t SOFTWARE_ID_MASK = 0x01;
+
 #pragma pack(1)
 struct SdrHeader {
     uint16_t id;    /* record ID */
@@ -124,59 +130,142 @@ public:
         OptionalField<bool> is_linear{};
         std::string name{};
         ConversionFn conversion_fn{[](std::uint8_t reading) { return reading; }};
+        /*! Sensor owner, sensors of other controllers than the BMC are read via IPMB */
+        std::uint8_t owner_id{BMC_SLAVE_ADDRESS};
+        std::uint8_t owner_lun{};
+        std::uint8_t channel{};
     };
     using SensorMap = std::unordered_map<SensorTelemetryReader::SensorNumber, SensorDefinition>;
 
     SensorContext(ipmi::IpmiController& ctrl) :
-        sdr_definitions(read_sdr_definitions(ctrl)) {}
+        m_ctrl(ctrl), sdr_definitions(parse_sdr_definitions(SdrCache::get_instance().get_records(ctrl))) {}
 
     SensorMap& get_sdr_definitions() { return sdr_definitions; }
 
+    /*!
+     * @brief Add valid reader, its sensor is read in the batches
+     * @param reader reader to be processed
+     */
+    void add_reader(const SensorTelemetryReader& reader) {
+        m_readers.push_back(&reader);
+    }
+
+    /*!
+     * @brief Get sensor reading read in the last update
+     * @param sensor_number sensor to be found
+     * @return response of the sensor, nullptr if the sensor was not read
+     */
+    const response::GetSensorReading* get_reading(SensorTelemetryReader::SensorNumber sensor_number) const;
+
 protected:
     /*!
-     * @brief update context, nothing to be done here
+     * @brief Read all sensors to be read, sensors of the same owner are sent in one batch
      * @return true to process all records
      */
     bool update() override;
 
 private:
+    using OwnerKey = std::pair<std::uint8_t, std::uint8_t>;
+
+    struct Reading {
+        request::GetSensorReading request{};
+        response::GetSensorReading response{};
+        std::exception_ptr error{};
+    };
+
+    ipmi::IpmiController& m_ctrl;
     SensorMap sdr_definitions;
+    std::vector<const SensorTelemetryReader*> m_readers{};
+    std::map<SensorTelemetryReader::SensorNumber, Reading> m_readings{};
+
+    static SensorMap parse_sdr_definitions(const SdrCache::Records& records);
 
-    static SensorMap read_sdr_definitions(ipmi::IpmiController& ctrl);
+    static OwnerKey get_owner_key(const SensorDefinition& def);
 };
 
 
-bool SensorContext::update() {
-    return true;
+SensorContext::OwnerKey SensorContext::get_owner_key(const SensorDefinition& def) {
+    /* sensors of the BMC and of the system software are read directly */
+    if ((def.owner_id == BMC_SLAVE_ADDRESS) || (def.owner_id & SOFTWARE_ID_MASK)) {
+        return {BMC_SLAVE_ADDRESS, 0};
+    }
+    return {def.owner_id, def.channel};
 }
 
 
-SensorContext::SensorMap SensorContext::read_sdr_definitions(ipmi::IpmiController& ctrl) {
+bool SensorContext::update() {
+    const auto now = std::chrono::steady_clock::now();
+
+    /* only sensors of readers whose time has passed are read */
+    m_readings.clear();
+    std::map<OwnerKey, std::vector<Reading*>> batches{};
+    for (const auto* reader : m_readers) {
+        const auto& time_to_update = reader->get_time_to_update();
+        if (time_to_update.has_value() && (time_to_update.value() > now)) {
+            continue;
+        }
+        const auto& def = sdr_definitions[reader->get_sensor_number()];
+        Reading& reading = m_readings[reader->get_sensor_number()];
+        reading.request.set_sensor_number(reader->get_sensor_number());
+        reading.request.set_lun(def.owner_lun);
+        batches[get_owner_key(def)].push_back(&reading);
+    }
 
-    SensorContext::SensorMap ret{};
+    for (const auto& batch : batches) {
+        ipmi::IpmiController::Exchanges exchanges{};
+        exchanges.reserve(batch.second.size());
+        for (auto* reading : batch.second) {
+            exchanges.push_back({reading->request, reading->response, nullptr});
+        }
+
+        try {
+            if (batch.first.first == BMC_SLAVE_ADDRESS) {
+                m_ctrl.send_batch(exchanges, {});
+            }
+            else {
+                m_ctrl.send_batch(exchanges, {batch.first.first, batch.first.second});
+            }
+            for (std::size_t i = 0; i < exchanges.size(); ++i) {
+                batch.second[i]->error = exchanges[i].error;
+            }
+        }
+        catch (...) {
+            for (auto* reading : batch.second) {
+                reading->error = std::current_exception();
+            }
+        }
+    }
+    return true;
+}
 
-    /* actual sensors are described by SDR records 1/2 */
-    response::ReserveSdrRepository reserve_sdr_repo_resp{};
-    ctrl.send(request::ReserveSdrRepository(), reserve_sdr_repo_resp);
 
-    request::GetSdr get_sdr_req{};
-    get_sdr_req.set_record_id(request::GetSdr::SDR_FIRST_RECORD_ID);
-    get_sdr_req.set_reservation_id(reserve_sdr_repo_resp.get_reservation_id());
-    get_sdr_req.set_bytes_to_read(request::GetSdr::GET_SDR_ENTIRE_RECORD);
-    response::GetSdr get_sdr_resp{};
+const response::GetSensorReading* SensorContext::get_reading(SensorTelemetryReader::SensorNumber sensor_number) const {
+    const auto it = m_readings.find(sensor_number);
+    if (it == m_readings.end()) {
+        return nullptr;
+    }
+    if (it->second.error) {
+        std::rethrow_exception(it->second.error);
+    }
+    return &it->second.response;
+}
 
-    do {
 
-        ctrl.send(get_sdr_req, get_sdr_resp);
+SensorContext::SensorMap SensorContext::parse_sdr_definitions(const SdrCache::Records& records) {
 
-        const auto& record_data = get_sdr_resp.get_record_data();
+    SensorContext::SensorMap ret{};
+
+    /* actual sensors are described by SDR records 1/2 */
+    for (const auto& record_data : records) {
 
         const auto record = get_record(record_data);
 
+        if (nullptr == record.header) {
+            continue;
+        }
         if (nullptr == record.cmn) {
             log_debug("telemetry",
                 "Skipping record #" << uint(record.header->id) << " type: " << uint(record.header->type));
-            get_sdr_req.set_record_id(get_sdr_resp.get_next_record_id());
             continue;
         }
 
@@ -188,6 +277,9 @@ SensorContext::SensorMap SensorContext::read_sdr_definitions(ipmi::IpmiControlle
             SensorContext::SensorDefinition def{};
             def.entity_id = record.cmn->entity.id;
             def.entity_instance = record.cmn->entity.instance;
+            def.owner_id = record.cmn->keys.owner_id;
+            def.owner_lun = record.cmn->keys.lun;
+            def.channel = record.cmn->keys.channel;
 
             if (record.header->type == SDR_RECORD_TYPE_FULL_SENSOR) {
                 def.has_analog_reading = IS_THRESHOLD_SENSOR(record.cmn) && !UNITS_ARE_DISCRETE(record.cmn);
@@ -217,10 +309,7 @@ SensorContext::SensorMap SensorContext::read_sdr_definitions(ipmi::IpmiControlle
 
             ret[record.cmn->keys.sensor_num] = def;
         }
-
-        get_sdr_req.set_record_id(get_sdr_resp.get_next_record_id());
     }
-    while (get_sdr_resp.get_next_record_id() != request::GetSdr::SDR_LAST_RECORD_ID);
 
     return ret;
 }
@@ -262,6 +351,7 @@ bool SensorTelemetryReader::is_valid(TelemetryReader::Context::Ptr context) cons
     }
     else {
         sensor_def_it->second.entity_id = 0; /* mark as "already defined */
+        static_cast<SensorContext*>(context.get())->add_reader(*this);
         ret = true;
     }
     return ret;
@@ -271,14 +361,18 @@ bool SensorTelemetryReader::is_valid(TelemetryReader::Context::Ptr context) cons
 bool SensorTelemetryReader::read(TelemetryReader::Context::Ptr context, ipmi::IpmiController& ctrl) {
     SensorContext* ctx = static_cast<SensorContext*>(context.get());
 
-    request::GetSensorReading request{};
-    request.set_sensor_number(get_sensor_number());
+    /* sensor is read in the batch, unless it wasn't to be read when the context was updated */
+    const response::GetSensorReading* reading = ctx->get_reading(get_sensor_number());
     response::GetSensorReading response{};
+    if (nullptr == reading) {
+        request::GetSensorReading request{};
+        request.set_sensor_number(get_sensor_number());
+        ctrl.send(request, response);
+        reading = &response;
+    }
 
-    ctrl.send(request, response);
-
-    const auto value = response.is_valid_reading()
-                       ? ctx->get_sdr_definitions()[get_sensor_number()].conversion_fn(response.get_sensor_reading())
+    const auto value = reading->is_valid_reading()
+                       ? ctx->get_sdr_definitions()[get_sensor_number()].conversion_fn(reading->get_sensor_reading())
                        : json::Json();
     return update_value(value);
 }
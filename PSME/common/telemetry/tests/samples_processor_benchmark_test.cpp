@@ -0,0 +1,91 @@
+/*!
+ * @brief SamplesProcessor benchmark
+ *
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file samples_processor_benchmark_test.cpp
+ */
+
+#include "gtest/gtest.h"
+
+#include "telemetry/samples_processor.hpp"
+#include "agent-framework/module/enum/common.hpp"
+
+using namespace telemetry;
+using agent_framework::model::enums::MetricAlgorithm;
+
+namespace {
+
+constexpr std::size_t WINDOW_SAMPLES = 1000;
+constexpr std::size_t PROCESSED_SAMPLES = 2 * WINDOW_SAMPLES;
+constexpr std::chrono::milliseconds SENSING_INTERVAL{100};
+
+/*! Number of samples read from the window */
+std::size_t touched_samples{0};
+
+/*! Samples container counting accesses to its elements */
+class CountingSamples : public Samples<> {
+public:
+    const_reference operator[](size_type position) const {
+        ++touched_samples;
+        return Samples<>::operator[](position);
+    }
+
+    const_reference front() const { return (*this)[0]; }
+
+    const_reference back() const { return (*this)[size() - 1]; }
+};
+
+/*! Feeds the processor with a full window and then with sliding samples */
+template<typename Processor>
+double process_samples(Processor& processor) {
+    auto now = Processor::Clock::now();
+    double checksum{0.0};
+    for (std::size_t i = 0; i < PROCESSED_SAMPLES; ++i) {
+        now += SENSING_INTERVAL;
+        const auto value = processor.add_and_process_samples(double(i % 100) / 10.0, now);
+        checksum += value.template get<double>();
+    }
+    return checksum;
+}
+
+}
+
+TEST(SamplesProcessorBenchmark, StreamingAggregatesTouchConstantNumberOfSamplesPerUpdate) {
+    const auto calculation_interval = SENSING_INTERVAL * (WINDOW_SAMPLES - 1);
+    for (const auto algorithm : {MetricAlgorithm::AverageOverInterval, MetricAlgorithm::MinimumDuringInterval,
+                                 MetricAlgorithm::MaximumDuringInterval}) {
+        /* each run of the algorithm reads all samples of the window */
+        std::size_t rescanned_samples{0};
+        const auto rescan = select_algorithm<SamplesProcessor<>::Samples>(algorithm);
+        SamplesProcessor<> rescanning(calculation_interval, SENSING_INTERVAL,
+            [&rescanned_samples, &rescan](const SamplesProcessor<>::Samples& samples) {
+                rescanned_samples += samples.size();
+                return rescan(samples);
+            });
+        SamplesProcessor<CountingSamples> streaming(calculation_interval, SENSING_INTERVAL,
+                                                    MetricAlgorithm(algorithm));
+
+        touched_samples = 0;
+        const auto rescanning_checksum = process_samples(rescanning);
+        const auto streaming_checksum = process_samples(streaming);
+        EXPECT_NEAR(rescanning_checksum, streaming_checksum, 1e-6 * rescanning_checksum);
+
+        /* window is filling up, then it is full */
+        EXPECT_EQ(WINDOW_SAMPLES * (WINDOW_SAMPLES + 1) / 2 + WINDOW_SAMPLES * (PROCESSED_SAMPLES - WINDOW_SAMPLES),
+                  rescanned_samples);
+        /* new, removed and the first samples, the integral is re-summed once per window of removals */
+        EXPECT_GT(16 * PROCESSED_SAMPLES, touched_samples) << MetricAlgorithm(algorithm).to_string();
+    }
+}
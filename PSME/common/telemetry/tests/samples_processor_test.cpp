@@ -237,3 +237,48 @@ TEST(SamplesProcessorTest, MaximumDuringIntervalCalculationJsonSamples) {
     JsonSamplesProcessor processor(calculation_interval, sensing_interval, select_algorithm<typename JsonSamplesProcessor::Samples>(calculation_algorithm));
     verify_processor(processor, sensing_interval, expected_values, sample_values);
 }
+
+TEST(SamplesProcessorTest, StreamingAggregatesMatchCalculationAlgorithms) {
+    using namespace agent_framework::model::enums;
+    const auto calculation_interval = std::chrono::seconds(13);
+    const auto sensing_interval = std::chrono::seconds(1);
+    for (const auto algorithm : {MetricAlgorithm::AverageOverInterval, MetricAlgorithm::MinimumDuringInterval,
+                                 MetricAlgorithm::MaximumDuringInterval}) {
+        SamplesProcessor<> streaming(calculation_interval, sensing_interval, MetricAlgorithm(algorithm));
+        SamplesProcessor<> rescanning(calculation_interval, sensing_interval,
+                                      select_algorithm<SamplesProcessor<>::Samples>(algorithm));
+        auto now = SamplesProcessor<>::Clock::now();
+        for (int i = 0; i < 200; ++i) {
+            /* irregular sensing periods, nulls clear the window */
+            now += std::chrono::milliseconds(500 + (i * 7919) % 1500);
+            const json::Json value = (i % 97 == 96) ? json::Json() : json::Json(double((i * 31) % 17) - 8.25);
+            const auto expected = rescanning.add_and_process_samples(value, now);
+            const auto calculated = streaming.add_and_process_samples(value, now);
+            if (expected.is_number()) {
+                EXPECT_NEAR(expected.get<double>(), calculated.get<double>(), 1e-9) << " i=" << i;
+            }
+            else {
+                EXPECT_EQ(expected.dump(), calculated.dump()) << " i=" << i;
+            }
+        }
+    }
+}
+
+TEST(SamplesProcessorTest, RingBufferKeepsSamplesInOrder) {
+    RingBuffer<int> buffer{};
+    buffer.reserve(3);
+    for (int i = 0; i < 3; ++i) {
+        buffer.push_back(i);
+    }
+    buffer.pop_front();
+    buffer.push_back(3);
+    EXPECT_EQ(3, buffer.capacity());
+    buffer.push_back(4);
+    EXPECT_EQ(4, buffer.size());
+    EXPECT_LE(4, buffer.capacity());
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4}), std::vector<int>(buffer.cbegin(), buffer.cend()));
+    EXPECT_EQ(1, buffer.front());
+    EXPECT_EQ(4, buffer.back());
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+}
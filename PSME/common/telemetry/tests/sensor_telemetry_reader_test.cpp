@@ -0,0 +1,282 @@
+/*!
+ * @brief SDR cache and sensor reader tests
+ *
+ * @copyright Copyright (c) 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file sensor_telemetry_reader_test.cpp
+ */
+
+#include "gtest/gtest.h"
+
+#include "telemetry/sdr_cache.hpp"
+#include "telemetry/sensor_telemetry_reader.hpp"
+#include "telemetry/metric_processor.hpp"
+#include "telemetry/metric_definition_builder.hpp"
+#include "ipmi/manager/ipmitool/lan_connection_data.hpp"
+#include "ipmi/command/generic/enums.hpp"
+#include "ipmi/command/generic/get_sensor_reading.hpp"
+#include "agent-framework/module/enum/common.hpp"
+
+
+using namespace agent_framework::model;
+using namespace telemetry;
+
+namespace {
+
+constexpr std::uint8_t BMC_ADDRESS = 0x20;
+constexpr std::uint8_t ME_ADDRESS = 0x2c;
+constexpr std::uint8_t ME_CHANNEL = 0x06;
+constexpr std::uint8_t ENTITY_ID = 0x07;
+constexpr std::uint8_t ENTITY_INSTANCE = 0x01;
+constexpr unsigned SENSORS = 100;
+
+/*! BMC with SDR of compact sensor records, sensor reading is equal to the sensor number */
+class FakeBmc : public ipmi::IpmiController {
+public:
+    FakeBmc(const std::string& ip) :
+        ipmi::IpmiController(std::make_shared<ipmi::manager::ipmitool::LanConnectionData>(ip, 623, "user", "pass")) {}
+
+    void add_sensor(std::uint8_t sensor_number, std::uint8_t owner = BMC_ADDRESS, std::uint8_t channel = 0) {
+        /* compact sensor record, with "S<number>" name */
+        const std::string name = "S" + std::to_string(unsigned(sensor_number));
+        SdrCache::Record body(27, 0);
+        body[0] = owner;
+        body[1] = std::uint8_t(channel << 4);
+        body[2] = sensor_number;
+        body[3] = ENTITY_ID;
+        body[4] = ENTITY_INSTANCE;
+        body[26] = std::uint8_t(0xc0 | name.size());
+        body.insert(body.end(), name.begin(), name.end());
+
+        const auto id = std::uint16_t(records.size() + 1);
+        SdrCache::Record record{std::uint8_t(id & 0xff), std::uint8_t(id >> 8), 0x51, 0x02, std::uint8_t(body.size())};
+        record.insert(record.end(), body.begin(), body.end());
+        records.push_back(record);
+        ++addition_timestamp;
+    }
+
+    void send(const ipmi::Request& request, ipmi::Response& response) override {
+        send(request, ipmi::BridgeInfo{}, response);
+    }
+
+    void send(const ipmi::Request& request, const ipmi::BridgeInfo& via, ipmi::Response& response) override {
+        ++requests;
+        response.do_unpack(process(request, via));
+    }
+
+    void send_batch(Exchanges& exchanges, const ipmi::BridgeInfo& via) override {
+        ++batches;
+        for (auto& exchange : exchanges) {
+            ++requests;
+            try {
+                exchange.response.do_unpack(process(exchange.request, via));
+            }
+            catch (...) {
+                exchange.error = std::current_exception();
+            }
+        }
+    }
+
+    std::uint32_t addition_timestamp{0x5c000000};
+    std::uint32_t erase_timestamp{0x5c000000};
+    SdrCache::Records records{};
+
+    unsigned requests{0};
+    unsigned sdr_requests{0};
+    unsigned batches{0};
+    unsigned bridged_readings{0};
+
+private:
+    ipmi::IpmiInterface::ByteBuffer process(const ipmi::Request& request, const ipmi::BridgeInfo& via) {
+        using namespace ipmi::command::generic;
+        const auto data = request.do_pack();
+        if (request.get_network_function() == NetFn::STORAGE) {
+            switch (request.get_command()) {
+                case Cmd::GET_SDR_REPOSITORY_INFO:
+                    return {0x00, 0x51, std::uint8_t(records.size()), std::uint8_t(records.size() >> 8), 0x00, 0x10,
+                            std::uint8_t(addition_timestamp), std::uint8_t(addition_timestamp >> 8),
+                            std::uint8_t(addition_timestamp >> 16), std::uint8_t(addition_timestamp >> 24),
+                            std::uint8_t(erase_timestamp), std::uint8_t(erase_timestamp >> 8),
+                            std::uint8_t(erase_timestamp >> 16), std::uint8_t(erase_timestamp >> 24), 0x02};
+                case Cmd::RESERVE_SDR_REPOSITORY:
+                    return {0x00, 0x01, 0x00};
+                case Cmd::GET_SDR: {
+                    ++sdr_requests;
+                    const std::size_t index = std::size_t(data[2] | data[3] << 8);
+                    const std::size_t position = (index == 0) ? 0 : index - 1;
+                    const std::uint16_t next = (position + 1 < records.size()) ? std::uint16_t(position + 2) : 0xffff;
+                    ipmi::IpmiInterface::ByteBuffer response{0x00, std::uint8_t(next & 0xff), std::uint8_t(next >> 8)};
+                    response.insert(response.end(), records[position].begin(), records[position].end());
+                    return response;
+                }
+                default:
+                    break;
+            }
+        }
+        else if ((request.get_network_function() == NetFn::SENSOR_EVENT)
+                 && (request.get_command() == Cmd::GET_SENSOR_READING)) {
+            if (via.get_level() != ipmi::BridgeInfo::Level::DIRECT) {
+                ++bridged_readings;
+            }
+            return {0x00, data[0], 0xc0};
+        }
+        return {0xc1};
+    }
+};
+
+MetricDefinition make_definition() {
+    return MetricDefinitionBuilder("/TestSensor")
+        .set_metric_type(enums::MetricType::Numeric)
+        .set_sensing_interval("PT10s")
+        .build();
+}
+
+}
+
+namespace testing {
+
+/*!
+ * @brief SDR is read only when the repository is changed
+ */
+TEST(SdrCacheTest, ReadOnChange) {
+    FakeBmc bmc{"10.0.0.1"};
+    for (std::uint8_t sensor = 1; sensor <= 10; ++sensor) {
+        bmc.add_sensor(sensor);
+    }
+    SdrCache cache{nullptr};
+
+    auto records = cache.get_records(bmc);
+    ASSERT_EQ(bmc.records, records);
+    ASSERT_EQ(10, bmc.sdr_requests);
+
+    records = cache.get_records(bmc);
+    ASSERT_EQ(bmc.records, records);
+    ASSERT_EQ(10, bmc.sdr_requests);
+
+    bmc.add_sensor(11);
+    records = cache.get_records(bmc);
+    ASSERT_EQ(11, records.size());
+    ASSERT_EQ(21, bmc.sdr_requests);
+
+    ++bmc.erase_timestamp;
+    cache.get_records(bmc);
+    ASSERT_EQ(32, bmc.sdr_requests);
+
+    /* changes of the repository cannot be tracked */
+    bmc.addition_timestamp = 0xffffffff;
+    bmc.erase_timestamp = 0xffffffff;
+    cache.get_records(bmc);
+    cache.get_records(bmc);
+    ASSERT_EQ(54, bmc.sdr_requests);
+}
+
+/*!
+ * @brief Stored repository is used by next cache instance
+ */
+TEST(SdrCacheTest, Stored) {
+    auto db = database::Database::create("sdr_cache_test", false, "");
+    FakeBmc bmc{"10.0.0.2"};
+    for (std::uint8_t sensor = 1; sensor <= 10; ++sensor) {
+        bmc.add_sensor(sensor);
+    }
+
+    SdrCache{db}.get_records(bmc);
+    ASSERT_EQ(10, bmc.sdr_requests);
+
+    const auto records = SdrCache{db}.get_records(bmc);
+    ASSERT_EQ(bmc.records, records);
+    ASSERT_EQ(10, bmc.sdr_requests);
+
+    /* the same address, but another repository */
+    FakeBmc replaced{"10.0.0.2"};
+    replaced.add_sensor(1);
+    ASSERT_EQ(replaced.records, SdrCache{db}.get_records(replaced));
+    ASSERT_EQ(1, replaced.sdr_requests);
+
+    db->remove();
+}
+
+/*!
+ * @brief Sensors are read in batches, one batch for each sensor owner
+ */
+TEST(SensorTelemetryReaderTest, Batches) {
+    FakeBmc bmc{"10.0.0.3"};
+    auto definition = make_definition();
+    TelemetryReader::PtrVector readers{};
+    for (std::uint8_t sensor = 1; sensor <= 20; ++sensor) {
+        if (sensor <= 15) {
+            bmc.add_sensor(sensor);
+        }
+        else {
+            bmc.add_sensor(sensor, ME_ADDRESS, ME_CHANNEL);
+        }
+        readers.push_back(std::make_shared<SensorTelemetryReader>(
+            ResourceInstance{ResourceInstance::Component::System}, definition, sensor, ENTITY_ID, ENTITY_INSTANCE));
+    }
+    /* sensor not defined in the SDR is not read */
+    readers.push_back(std::make_shared<SensorTelemetryReader>(
+        ResourceInstance{ResourceInstance::Component::System}, definition, 0x50, ENTITY_ID, ENTITY_INSTANCE));
+
+    MetricsProcessor processor{bmc, std::move(readers)};
+    const auto changed = processor.read_all_metrics();
+    ASSERT_EQ(20, changed.size());
+    for (const auto& reader : changed) {
+        const auto& sensor_reader = static_cast<const SensorTelemetryReader&>(*reader);
+        ASSERT_EQ(json::Json(sensor_reader.get_sensor_number()), reader->get_value());
+    }
+    ASSERT_EQ(2, bmc.batches);
+    ASSERT_EQ(5, bmc.bridged_readings);
+}
+
+/*!
+ * @brief IPMI traffic until the first telemetry, without and with SDR cache and batches
+ */
+TEST(SensorTelemetryReaderTest, FirstTelemetryBenchmark) {
+    auto run = [](FakeBmc& bmc, SdrCache& cache, bool batched) {
+        for (std::uint8_t sensor = 1; sensor <= SENSORS; ++sensor) {
+            bmc.add_sensor(sensor);
+        }
+        EXPECT_EQ(SENSORS, cache.get_records(bmc).size());
+
+        std::vector<ipmi::command::generic::request::GetSensorReading> requests(SENSORS);
+        std::vector<ipmi::command::generic::response::GetSensorReading> responses(SENSORS);
+        ipmi::IpmiController::Exchanges exchanges{};
+        for (unsigned i = 0; i < SENSORS; ++i) {
+            requests[i].set_sensor_number(std::uint8_t(i + 1));
+            if (batched) {
+                exchanges.push_back({requests[i], responses[i], nullptr});
+            }
+            else {
+                bmc.send(requests[i], responses[i]);
+            }
+        }
+        if (batched) {
+            bmc.send_batch(exchanges, {});
+        }
+        for (unsigned i = 0; i < SENSORS; ++i) {
+            EXPECT_EQ(i + 1, responses[i].get_sensor_reading());
+        }
+    };
+
+    SdrCache cache{nullptr};
+    FakeBmc uncached{"10.0.0.4"};
+    run(uncached, cache, false);
+    FakeBmc cached{"10.0.0.4"};
+    run(cached, cache, true);
+
+    EXPECT_EQ(SENSORS + 1, cached.requests);
+    EXPECT_EQ(0, cached.sdr_requests);
+    EXPECT_LT(cached.requests, uncached.requests);
+}
+
+}
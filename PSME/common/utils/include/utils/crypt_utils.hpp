@@ -47,6 +47,14 @@ std::string decrypt(const std::string& cipher_text, const std::string& key, cons
  * */
 std::string hash(const std::string& plain_text);
 
+/*!
+ * @brief Calculates keyed message digest (HMAC, by default uses SHA512).
+ * @param plain_text string with the plain text to be hashed.
+ * @param key string with the secret key.
+ * @return message authentication code.
+ * */
+std::string keyed_hash(const std::string& plain_text, const std::string& key);
+
 /*!
  * @brief Generates key/hash with PBKDF2 key derivation function (SHA512 based).
  * @param password string with the plain text password to be hashed.
@@ -160,6 +160,31 @@ std::string hash(const std::string& plain_text) {
     return digest;
 }
 
+std::string keyed_hash(const std::string& plain_text, const std::string& key) {
+    gcry_md_hd_t handle;
+    gcry_error_t error;
+
+    error = gcry_md_open(&handle, PSME_HASH_ALGO, PSME_HASH_FLAG | GCRY_MD_FLAG_HMAC);
+    if (error) {
+        throw std::runtime_error("Error on HMAC initialization: " + std::string(gcry_strerror(error)));
+    }
+
+    error = gcry_md_setkey(handle, key.data(), key.size());
+    if (error) {
+        gcry_md_close(handle);
+        throw std::runtime_error("Error on setting HMAC key: " + std::string(gcry_strerror(error)));
+    }
+
+    gcry_md_write(handle, plain_text.data(), plain_text.size());
+    auto digest_read = gcry_md_read(handle, PSME_HASH_ALGO);
+
+    std::string digest((char*)digest_read, get_hash_size());
+
+    gcry_md_close(handle);
+
+    return digest;
+}
+
 std::string salted_hash(const std::string& password, const std::string& salt) {
     gcry_error_t error;
 